@@ -15,6 +15,7 @@ int main(int argc, char** argv) {
 		// Create the procedural walking creature
 		auto creature = std::make_shared<ProceduralWalkingCreature>(0, 0, 0, 0, 8.0f);
 		creature->SetClampedToTerrain(true);
+		creature->SetAnimationCrowd(&vis.GetAnimationCrowd());
 
 		// Use a shape handler to update and return the creature for rendering
 		vis.AddShapeHandler([&creature, &vis](float time) {
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -18,8 +22,42 @@ namespace Boidsish {
 		bool        bool_value;
 	};
 
+	/**
+	 * @brief A configuration value bound once by key and kept current by ConfigManager.
+	 *
+	 * Reading is a single relaxed atomic load, so hot paths can hold a reference to the
+	 * binding instead of looking the key up every frame. Instances are owned by
+	 * ConfigManager and live for the lifetime of the program.
+	 */
+	template <typename T>
+	class ConfigVar {
+	public:
+		ConfigVar(std::string key, T default_value, T value):
+			key_(std::move(key)), default_value_(default_value), value_(value) {}
+
+		T Get() const { return value_.load(std::memory_order_relaxed); }
+
+		operator T() const { return Get(); }
+
+		const std::string& GetKey() const { return key_; }
+
+		T GetDefault() const { return default_value_; }
+
+	private:
+		friend class ConfigManager;
+
+		void Store(T value) { value_.store(value, std::memory_order_relaxed); }
+
+		std::string    key_;
+		T              default_value_;
+		std::atomic<T> value_;
+	};
+
 	class ConfigManager {
 	public:
+		using ChangeCallback = std::function<void(const std::string& key)>;
+		using ListenerId = size_t;
+
 		static ConfigManager& GetInstance();
 
 		void Initialize(const std::string& app_name);
@@ -37,6 +75,17 @@ namespace Boidsish {
 		float       GetGlobalSettingFloat(const std::string& key, float default_value);
 		bool        GetGlobalSettingBool(const std::string& key, bool default_value);
 
+		// Typed bindings resolved with the same app -> global -> default precedence as the getters.
+		// The returned reference stays valid for the lifetime of the program and is updated on every set.
+		const ConfigVar<int>&   BindAppSettingInt(const std::string& key, int default_value);
+		const ConfigVar<float>& BindAppSettingFloat(const std::string& key, float default_value);
+		const ConfigVar<bool>&  BindAppSettingBool(const std::string& key, bool default_value);
+
+		// Change notification. Callbacks run on the thread that performed the set, after bindings are
+		// updated. An empty key subscribes to every change.
+		ListenerId AddChangeListener(const std::string& key, ChangeCallback callback);
+		void       RemoveChangeListener(ListenerId id);
+
 		// Setters - always write to the app-specific section
 		void SetString(const std::string& key, const std::string& value);
 		void SetInt(const std::string& key, int value);
@@ -67,6 +116,14 @@ namespace Boidsish {
 		void
 		RegisterKey(const std::string& section, const std::string& key, ConfigValue::Type type, bool default_value);
 
+		template <typename T>
+		const ConfigVar<T>&
+		BindAppSetting(std::map<std::string, std::unique_ptr<ConfigVar<T>>>& vars, const std::string& key, T default_value);
+
+		void RefreshBindings(const std::string& key);
+		void RefreshAllBindings();
+		void NotifyChanged(const std::string& key);
+
 		static ConfigManager* m_instance;
 		static std::mutex     m_mutex;
 
@@ -77,6 +134,21 @@ namespace Boidsish {
 		// Track all keys accessed to show them in the UI
 		std::map<std::string, ConfigValue> m_registeredGlobalKeys;
 		std::map<std::string, ConfigValue> m_registeredAppKeys;
+
+		// Typed bindings and change listeners, guarded by m_bindingMutex
+		mutable std::mutex                                       m_bindingMutex;
+		std::map<std::string, std::unique_ptr<ConfigVar<int>>>   m_intVars;
+		std::map<std::string, std::unique_ptr<ConfigVar<float>>> m_floatVars;
+		std::map<std::string, std::unique_ptr<ConfigVar<bool>>>  m_boolVars;
+
+		struct Listener {
+			ListenerId     id;
+			std::string    key;
+			ChangeCallback callback;
+		};
+
+		std::vector<Listener> m_listeners;
+		ListenerId            m_nextListenerId = 1;
 	};
 
 } // namespace Boidsish
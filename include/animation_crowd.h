@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "animator.h"
+#include <glm/glm.hpp>
+#include <task_thread_pool.hpp>
+
+namespace Boidsish {
+
+	class Model;
+
+	/**
+	 * @brief Distance-based update rate reduction for crowd members.
+	 *
+	 * Members closer than full_rate_distance are evaluated every update. Beyond that the
+	 * interval between evaluations grows linearly until it reaches 1 / min_update_rate at
+	 * min_rate_distance. Playback time still accumulates while a member is skipped, so
+	 * distant members stay in phase and only their pose updates less often.
+	 */
+	struct AnimationLodSettings {
+		bool  enabled = false;
+		float full_rate_distance = 40.0f;
+		float min_rate_distance = 250.0f;
+		float min_update_rate = 5.0f; // Hz
+	};
+
+	struct AnimationCrowdStats {
+		size_t members = 0;
+		size_t evaluated = 0;
+		size_t skipped_by_lod = 0;
+		size_t batches = 0;
+		size_t bones = 0; // Nodes evaluated across all members
+	};
+
+	/**
+	 * @brief Evaluates many animators together.
+	 *
+	 * Members sharing a ModelData and playing the same animation are grouped into batches.
+	 * Each batch walks the shared compiled skeleton once per node and samples that node for
+	 * every member with structure-of-arrays kernels (lerp, polynomial slerp, TRS compose)
+	 * that the compiler can vectorize. Batches run on the thread pool.
+	 *
+	 * Members are borrowed: animators added directly must outlive the crowd or be removed,
+	 * while models are held weakly and dropped automatically once destroyed.
+	 */
+	class AnimationCrowd {
+	public:
+		using Handle = uint32_t;
+
+		explicit AnimationCrowd(task_thread_pool::task_thread_pool& thread_pool);
+
+		Handle Add(Animator* animator, const glm::vec3& position = glm::vec3(0.0f));
+		Handle Add(const std::shared_ptr<Model>& model);
+		void   Remove(Handle handle);
+		void   Clear();
+
+		// Only used for LOD. Model members track their shape position automatically.
+		void SetPosition(Handle handle, const glm::vec3& position);
+
+		void                        SetLodSettings(const AnimationLodSettings& settings) { lod_ = settings; }
+		const AnimationLodSettings& GetLodSettings() const { return lod_; }
+
+		/**
+		 * @brief Advances and evaluates all members.
+		 *
+		 * Equivalent to calling UpdateAnimation(dt) on every member (and MarkDirty on model
+		 * members), except for members held back by animation LOD. Blocks until all batches
+		 * are done.
+		 */
+		void Update(float dt, const glm::vec3& viewer_position = glm::vec3(0.0f));
+
+		size_t                     Size() const { return live_count_; }
+		const AnimationCrowdStats& GetLastStats() const { return stats_; }
+
+		static constexpr size_t kBatchWidth = 32;
+
+	private:
+		struct Member {
+			Animator*            animator = nullptr;
+			std::weak_ptr<Model> model;
+			bool                 has_model = false;
+			glm::vec3            position{0.0f};
+			float                pending_dt = 0.0f;
+			bool                 alive = false;
+		};
+
+		struct Batch {
+			const CompiledSkeleton* skeleton = nullptr;
+			const Animation*        animation = nullptr;
+			const std::vector<int>* channels = nullptr;
+			Animator*               members[kBatchWidth];
+			size_t                  count = 0;
+		};
+
+		Handle AddMember(Member member);
+		float  UpdateInterval(const glm::vec3& position, const glm::vec3& viewer) const;
+
+		static void EvaluateBatch(const Batch& batch);
+
+		task_thread_pool::task_thread_pool& thread_pool_;
+		AnimationLodSettings                lod_;
+		AnimationCrowdStats                 stats_;
+
+		std::vector<Member> members_; // Indexed by handle
+		std::vector<Handle> free_handles_;
+		size_t              live_count_ = 0;
+
+		// Scratch reused across updates
+		std::vector<size_t> due_;
+		std::vector<Batch>  batches_;
+	};
+
+} // namespace Boidsish
@@ -3,13 +3,84 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "model.h"
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace Boidsish {
 
+	/**
+	 * @brief Flattened node hierarchy of a ModelData, compiled once so that a pose can be
+	 * evaluated as a single linear pass.
+	 *
+	 * Nodes are stored in depth-first order (parents always precede their children). Bone
+	 * lookups, including the FBX/Assimp name cleansing fallback, and animation channel
+	 * bindings are resolved at compile time. Bind-pose transforms and bone offsets are read
+	 * through pointers into the source ModelData, so edits to those values are picked up
+	 * without recompiling; structural edits bump ModelData::skeleton_version instead.
+	 */
+	struct CompiledSkeleton {
+		std::vector<int>                     parents; // Index of the parent node, -1 for the root
+		std::vector<std::string>             names;
+		std::vector<const NodeData*>         nodes;
+		std::vector<const BoneInfo*>         bones;    // Resolved bone for each node, or nullptr
+		std::vector<std::vector<int>>        channels; // Per animation: node -> boneAnimations index or -1
+		std::unordered_map<std::string, int> name_to_node;
+
+		const ModelData* source = nullptr;
+		uint32_t         version = 0;
+		size_t           animation_count = 0;
+
+		static std::shared_ptr<const CompiledSkeleton> Build(const ModelData& data);
+
+		bool IsCurrentFor(const ModelData& data) const {
+			return source == &data && version == data.skeleton_version &&
+				animation_count == data.animations.size();
+		}
+
+		int FindNode(const std::string& name) const {
+			auto it = name_to_node.find(name);
+			return it != name_to_node.end() ? it->second : -1;
+		}
+
+		size_t size() const { return parents.size(); }
+	};
+
+	/**
+	 * @brief Last keyframe segment used for each track of a channel.
+	 *
+	 * Playback time only moves forward between wraps, so searching from the previous segment
+	 * makes key lookup O(1) amortized.
+	 */
+	struct ChannelCursor {
+		int position = 0;
+		int rotation = 0;
+		int scale = 0;
+	};
+
+	/**
+	 * @brief Bracketing keys of each track of a channel at a sample time.
+	 *
+	 * Tracks with a single key repeat it on both ends; missing tracks hold the identity.
+	 */
+	struct ChannelSegment {
+		glm::vec3 position0{0.0f}, position1{0.0f};
+		glm::quat rotation0{1, 0, 0, 0}, rotation1{1, 0, 0, 0};
+		glm::vec3 scale0{1.0f}, scale1{1.0f};
+		float     position_t = 0.0f;
+		float     rotation_t = 0.0f;
+		float     scale_t = 0.0f;
+	};
+
+	// Advances the cursor to the given time (in ticks) and returns the keys to interpolate.
+	ChannelSegment LocateChannelKeys(const BoneAnimation& channel, float time, ChannelCursor& cursor);
+
+	// Samples a channel at the given time (in ticks) and composes its local TRS matrix.
+	glm::mat4 SampleChannel(const BoneAnimation& channel, float time, ChannelCursor& cursor);
+
 	class Animator {
 	public:
 		Animator() = default;
@@ -33,18 +104,38 @@ namespace Boidsish {
 		glm::mat4   GetBoneModelSpaceTransform(const std::string& boneName) const;
 		std::string GetBoneParentName(const std::string& boneName) const;
 
-		void ResetLocalOverrides() { m_LocalOverrides.clear(); }
+		void ResetLocalOverrides();
 
 	private:
-		void CalculateBoneTransform(const NodeData& node, glm::mat4 parentTransform);
+		friend class AnimationCrowd;
+
+		void EnsureSkeleton();
+		void RebuildSkeleton();
+		bool IsSkeletonCurrent() const { return m_Skeleton && m_ModelData && m_Skeleton->IsCurrentFor(*m_ModelData); }
+
+		bool HasValidAnimation() const {
+			return m_ModelData && m_CurrentAnimationIndex >= 0 &&
+				(size_t)m_CurrentAnimationIndex < m_ModelData->animations.size();
+		}
+
+		void AdvanceTime(float dt);
+		void EvaluatePose();
 
 		std::vector<glm::mat4>     m_FinalBoneMatrices;
 		std::shared_ptr<ModelData> m_ModelData;
 		float                      m_CurrentTime = 0.0f;
 		int                        m_CurrentAnimationIndex = -1;
 
-		std::map<std::string, glm::mat4> m_LocalOverrides;
-		std::map<std::string, glm::mat4> m_GlobalMatrices; // Model-space transforms of nodes
+		std::shared_ptr<const CompiledSkeleton> m_Skeleton;
+		std::vector<ChannelCursor>              m_Cursors; // Per node, for the current animation
+
+		// Indexed by compiled node
+		std::vector<glm::mat4> m_LocalOverrides;
+		std::vector<uint8_t>   m_HasOverride;
+		std::vector<glm::mat4> m_GlobalMatrices; // Model-space transforms of nodes
+
+		// Overrides for names not (yet) present in the skeleton, resolved on recompile
+		std::map<std::string, glm::mat4> m_PendingOverrides;
 	};
 
 } // namespace Boidsish
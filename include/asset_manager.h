@@ -28,9 +28,28 @@ namespace Boidsish {
 
 		/**
 		 * @brief Load or retrieve a cached model.
+		 *
+		 * Unless `model_cache_enabled` is off, models are read from their binary cache under
+		 * model_cache/ when it is current, and the cache is written after an Assimp import.
 		 */
 		std::shared_ptr<ModelData> GetModelData(const std::string& path);
 
+		/**
+		 * @brief Import a model and write its binary cache without touching the in-memory cache.
+		 * @param path Source model file
+		 * @param cache_path Output file; defaults to the location GetModelData reads from
+		 * @return true if the model was imported and the cache written
+		 */
+		bool BuildModelCache(const std::string& path, const std::string& cache_path = "");
+
+		/**
+		 * @brief Skip all GPU work (texture uploads) so models can be imported without a GL context.
+		 * Texture references are kept with id 0.
+		 */
+		void SetHeadless(bool headless) { m_headless = headless; }
+
+		bool IsHeadless() const { return m_headless; }
+
 		/**
 		 * @brief Load or retrieve a cached texture.
 		 * @param path File path to the texture
@@ -62,9 +81,14 @@ namespace Boidsish {
 		AssetManager() = default;
 		~AssetManager();
 
+		std::shared_ptr<ModelData>
+		ImportModel(const std::string& path, const std::string& cache_path, bool* cache_written = nullptr);
+		std::shared_ptr<ModelData> LoadModelCache(const std::string& path);
+
 		std::map<std::string, std::shared_ptr<ModelData>>                       m_models;
 		std::map<std::string, GLuint>                                           m_textures;
 		std::map<std::string, std::shared_ptr<ma_resource_manager_data_source>> m_audio_sources;
+		bool                                                                    m_headless = false;
 	};
 
 } // namespace Boidsish
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Boidsish {
+	namespace dsp {
+
+		// Procedural sources render planar blocks of at most this many frames
+		constexpr uint32_t kBlockFrames = 256;
+
+		/**
+		 * @brief White noise from eight independent xorshift32 streams.
+		 *
+		 * Consecutive samples come from different streams, so a block is generated with the
+		 * lanes stepping in parallel instead of one serial xorshift chain.
+		 */
+		class NoiseGenerator {
+		public:
+			static constexpr int kLanes = 8;
+
+			explicit NoiseGenerator(uint32_t seed);
+
+			// Fills out with uniform noise in [-1, 1). If bits is given it receives the raw
+			// generator state behind each sample, for effects that draw extra randomness from it.
+			void Fill(float* out, uint32_t* bits, uint32_t frames);
+
+		private:
+			alignas(32) uint32_t m_state[kLanes];
+		};
+
+		/**
+		 * @brief One-pole smoother y += alpha * (x - y), evaluated four samples at a time.
+		 */
+		class OnePoleFilter {
+		public:
+			// in and out may alias
+			void Lowpass(const float* in, float* out, uint32_t frames, float alpha);
+			void Highpass(const float* in, float* out, uint32_t frames, float alpha);
+
+		private:
+			float m_low = 0.0f;
+		};
+
+		/**
+		 * @brief Chamberlin state-variable filter, evaluated four samples at a time.
+		 */
+		class StateVariableFilter {
+		public:
+			// in and out may alias
+			void Bandpass(const float* in, float* out, uint32_t frames, float cutoff, float damping);
+
+		private:
+			float m_low = 0.0f;
+			float m_band = 0.0f;
+		};
+
+		void Scale(float* samples, uint32_t frames, float gain);
+
+		// Interleaves planes into out. With fewer planes than channels the last plane fills the
+		// remaining channels; with none the output is silent.
+		void Interleave(
+			const float* const* planes,
+			uint32_t            plane_count,
+			float*              out,
+			uint32_t            channels,
+			uint32_t            frames
+		);
+
+	} // namespace dsp
+} // namespace Boidsish
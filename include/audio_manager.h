@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -17,7 +18,8 @@ namespace Boidsish {
 
 	class AudioManager {
 	public:
-		AudioManager(ServiceLocator& loc);
+		// A headless manager mixes without an output device; pull the mix with ReadFrames()
+		AudioManager(ServiceLocator& loc, bool headless = false);
 		~AudioManager();
 
 		// Non-copyable
@@ -38,6 +40,10 @@ namespace Boidsish {
 		std::shared_ptr<Sound>
 		CreateSound(const std::string& filepath, const glm::vec3& position, float volume = 1.0f, bool loop = false);
 
+		// Create a stopped 3D sound for a voice pool to restart with Sound::Play(). The file is decoded
+		// up front, and the resource manager shares the decoded data between all sounds of that file.
+		std::shared_ptr<Sound> CreateVoice(const std::string& filepath);
+
 		// Create a procedural sound
 		std::shared_ptr<Sound> CreateProceduralSound(
 			std::shared_ptr<ProceduralAudioSource> source,
@@ -60,6 +66,9 @@ namespace Boidsish {
 
 		void StopAllSounds();
 
+		// Mix the next frame_count interleaved stereo frames into out (headless managers only)
+		void ReadFrames(float* out, uint32_t frame_count);
+
 	private:
 		struct AudioManagerImpl;
 		std::unique_ptr<AudioManagerImpl> m_pimpl;
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -13,18 +15,16 @@ namespace Boidsish {
 	class ServiceLocator;
 	class Shape;
 
-	// Stores the state of a single frozen clone.
-	struct CloneState {
-		glm::mat4                    model_matrix;
-		glm::vec3                    color;
-		float                        creation_time;
-		std::shared_ptr<const Shape> shape_ptr;
-	};
-
 	// Manages the creation, lifecycle, and rendering of clones for the freeze-frame trail effect.
+	//
+	// Clones are grouped by the instance key of the shape they were taken from. Each group keeps
+	// its clones in a time-ordered ring buffer, so expired clones are popped from the front
+	// without sorting. Groups of instanceable shapes (Shape::IsMeshInstanceable) render with a
+	// single instanced draw; any other shape, such as a Model, renders each clone on its own.
 	class CloneManager {
 	public:
 		CloneManager(ServiceLocator& loc);
+		~CloneManager();
 
 		// Creates a clone of the given shape at its current state.
 		void CaptureClone(std::shared_ptr<const Shape> shape, float current_time);
@@ -32,18 +32,55 @@ namespace Boidsish {
 		// Updates the clone list, removing expired or distant clones.
 		void Update(float current_time, const glm::vec3& camera_pos);
 
-		// Renders all active clones.
+		// Renders all active clones, one instanced draw per instanceable prototype.
 		void Render(Shader& shader);
 
+		void SetMaxClones(size_t max_clones) { max_clones_global_ = max_clones; }
+
+		size_t GetCloneCount() const { return clone_count_; }
+
+		size_t GetGroupCount() const { return groups_.size(); }
+
 	private:
-		std::vector<CloneState> clones_;
+		// Clones sharing one prototype, oldest first. Storage is a power-of-two ring: a clone's
+		// slot is (head + i) & (capacity - 1). Positions are kept separately as structure-of-
+		// arrays so the distance sweep reads them contiguously.
+		struct CloneGroup {
+			std::shared_ptr<const Shape>              prototype; // Mesh and material for the group's draw
+			bool                                      instanced = false;
+			std::vector<glm::mat4>                    instances; // Model matrix, color and alpha in the bottom row
+			std::vector<std::shared_ptr<const Shape>> sources;   // Drawn one by one unless instanced
+			std::vector<float>                        creation_times;
+			std::vector<float>                        pos_x, pos_y, pos_z;
+			size_t                                    head = 0;
+			size_t                                    count = 0;
+			unsigned int                              ssbo = 0;
+			size_t                                    ssbo_capacity = 0;
+
+			size_t Capacity() const { return instances.size(); }
+
+			size_t Slot(size_t i) const { return (head + i) & (Capacity() - 1); }
+
+			void Push(const glm::mat4& instance, float creation_time, std::shared_ptr<const Shape> source);
+			void Grow();
+		};
+
+		// Removes the group's clones outside the prune radius, keeping the rest in order.
+		size_t PruneDistant(CloneGroup& group, const glm::vec3& camera_pos);
+
+		void RenderInstanced(Shader& shader, CloneGroup& group);
+
+		std::unordered_map<std::string, CloneGroup> groups_;
+		size_t                                      clone_count_ = 0;
+		std::vector<uint8_t>                        keep_;    // Per-clone sweep result, reused
+		std::vector<glm::mat4>                      staging_; // Ring unrolled for upload, reused
 
 		float  clone_lifespan_ = 5.0f;    // in seconds
 		float  capture_interval_ = 0.2f;  // in seconds
 		size_t max_clones_global_ = 2000; // This is a global limit for all clones
 		float  prune_distance_squared_ = 100.0f * 100.0f;
 
-		std::map<int, float> last_capture_time_;
+		std::unordered_map<int, float> last_capture_time_;
 	};
 
 } // namespace Boidsish
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "frustum.h"
+#include "meshlet.h"
+#include <glm/glm.hpp>
+
+namespace Boidsish {
+
+	struct ModelData;
+
+	struct ClusterCullStats {
+		size_t meshlets = 0; // Tested
+		size_t frustum_culled = 0;
+		size_t cone_culled = 0;
+		size_t triangles = 0; // Of the meshlets kept
+
+		ClusterCullStats& operator+=(const ClusterCullStats& other) {
+			meshlets += other.meshlets;
+			frustum_culled += other.frustum_culled;
+			cone_culled += other.cone_culled;
+			triangles += other.triangles;
+			return *this;
+		}
+	};
+
+	/**
+	 * @brief CPU reference for culling meshlets of an instance, as a GPU cluster pass would.
+	 *
+	 * A meshlet is dropped when its bounding sphere is outside the frustum, or when the camera
+	 * is inside the back side of its normal cone: dot(normalize(apex - camera), axis) >= cutoff,
+	 * so every triangle of it faces away. Bounds are moved to world space per instance; cones are
+	 * only tested under uniform scale, since other scales do not keep them cones.
+	 */
+	class ClusterCuller {
+	public:
+		/**
+		 * @brief Appends the indices of the meshlets that may be visible.
+		 */
+		static ClusterCullStats Cull(
+			const MeshletData&     meshlets,
+			const glm::mat4&       model_matrix,
+			const Frustum&         frustum,
+			const glm::vec3&       camera_pos,
+			std::vector<uint32_t>& out_visible
+		);
+
+		/**
+		 * @brief Culls the meshlets of every mesh of a model; out_visible gets one list per mesh.
+		 */
+		static ClusterCullStats Cull(
+			const ModelData&                    data,
+			const glm::mat4&                    model_matrix,
+			const Frustum&                      frustum,
+			const glm::vec3&                    camera_pos,
+			std::vector<std::vector<uint32_t>>& out_visible
+		);
+	};
+
+} // namespace Boidsish
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Boidsish {
+
+	/**
+	 * @brief 3D convex hull by quickhull.
+	 *
+	 * Starts from the tetrahedron of four extreme points and keeps, per face, a conflict list of
+	 * the points above it. Each step takes the farthest point of one face, walks face adjacency
+	 * to find the faces it sees and their horizon, and fans new faces from the horizon to the
+	 * point; only the conflict lists of the removed faces are redistributed. Expected time is
+	 * O(n log n). Planes are evaluated in double precision, and points within a tolerance scaled
+	 * to the input's extent of a face count as on it, so coplanar points are not hull vertices.
+	 */
+	class ConvexHull {
+	public:
+		/**
+		 * @brief Builds the hull of the points.
+		 *
+		 * Leaves the hull empty if the points are fewer than four or lie in a plane.
+		 */
+		void Build(const std::vector<glm::vec3>& points);
+
+		void Clear();
+
+		/// Triangles as indices into the built points, counter-clockwise seen from outside
+		const std::vector<std::array<int, 3>>& GetTriangles() const { return triangles_; }
+
+		bool IsEmpty() const { return triangles_.empty(); }
+
+	private:
+		struct Face {
+			std::array<int, 3> v;
+			std::array<int, 3> neighbors; // Face across the edge v[i] -> v[(i + 1) % 3]
+			glm::dvec3         normal;
+			double             offset;
+			std::vector<int>   outside; // Points above the face that no earlier face claimed
+			bool               alive = true;
+			int                visit = -1; // Last AddPoint that tested the face against its eye
+			bool               visible = false;
+		};
+
+		struct HorizonEdge {
+			int from;
+			int to;
+			int face; // The face beyond the edge, which stays
+		};
+
+		double Distance(const Face& face, int point) const {
+			return glm::dot(face.normal, points_[point]) - face.offset;
+		}
+
+		int  AddFace(int a, int b, int c);
+		bool BuildInitialTetrahedron();
+		void AddPoint(int eye, int face);
+		void CollectHorizon(int eye, int face);
+
+		std::vector<glm::dvec3>         points_;
+		std::vector<Face>               faces_;
+		std::vector<int>                visible_; // Scratch for AddPoint
+		std::vector<HorizonEdge>        horizon_;
+		std::vector<int>                new_faces_;
+		std::unordered_map<int, int>    face_from_; // New face by the horizon vertex its edge starts at
+		std::vector<std::array<int, 3>> triangles_;
+		double                          epsilon_ = 0.0;
+		int                             round_ = 0;
+	};
+
+} // namespace Boidsish
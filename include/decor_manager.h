@@ -8,6 +8,7 @@
 
 #include "biome_properties.h"
 #include "constants.h"
+#include "decor_placement.h"
 #include "frustum.h"
 #include "model.h"
 #include "procedural_generator.h"
@@ -19,6 +20,7 @@ namespace Boidsish {
 
 	class ServiceLocator;
 	class ITerrainGenerator;
+	class Terrain;
 	class TerrainRenderManager;
 	struct Camera;
 
@@ -47,28 +49,6 @@ namespace Boidsish {
 		}
 	};
 
-	// Matches std140 layout in decor_placement.comp GlobalPlacementParams UBO
-	struct alignas(16) PlacementGlobalsGPU {
-		glm::vec4 camera_and_scale; // xy=cameraPos, z=worldScale, w=maxTerrainHeight
-		glm::vec4 distance_params;  // x=densityFalloffStart, y=densityFalloffEnd, z=maxDecorDistance, w=maxInstances
-	};
-
-	// Matches std430 layout in decor_placement.comp ChunkParams SSBO
-	struct ChunkParamsGPU {
-		glm::vec4  offset_slice_size; // xy=worldOffset, z=slice, w=chunkSize
-		glm::ivec4 indices;           // x=baseInstanceIndex, yzw=unused
-	};
-
-	// Matches std140 layout in decor_placement.comp DecorTypeParams UBO
-	struct alignas(16) DecorTypeGPU {
-		glm::vec4  density_scale; // x=minDensity, y=maxDensity, z=baseScale, w=scaleVariance
-		glm::vec4  height_slope;  // x=minHeight, y=maxHeight, z=minSlope, w=maxSlope
-		glm::vec4  rotation;      // xyz=baseRotation (radians), w=detailDistance
-		glm::vec4  aabb_min;      // xyz=model AABB min, w=unused
-		glm::vec4  aabb_max;      // xyz=model AABB max, w=unused
-		glm::uvec4 flags;         // x=biomeMask, y=randomYaw, z=alignToTerrain, w=typeIndex
-	};
-
 	struct DecorType {
 		std::shared_ptr<Model> model;
 		DecorProperties        props;
@@ -200,8 +180,17 @@ namespace Boidsish {
 
 		/**
 		 * @brief Retrieves all decor instances within the specified terrain chunks.
-		 * This is an on-demand query that generates decor for the requested chunks
-		 * if they are currently registered in the render manager.
+		 * This is an on-demand query that places decor for the requested chunks if they are
+		 * currently registered in the render manager and resident in the terrain generator
+		 * (ITerrainGenerator::GetResidentChunk), whether or not they are on screen.
+		 *
+		 * Placement runs on the CPU (DecorPlacement, on the thread pool) from the chunks' CPU
+		 * surfaces, with no GPU work or readback. Results are cached per chunk until its
+		 * terrain is regenerated or the decor types change.
+		 *
+		 * The CPU surface is the un-baked terrain: the erosion and water flattening that the
+		 * bake pass applies on the GPU are not in it. Where those move the ground, heights and
+		 * height/slope rejections can differ from the decor that is drawn.
 		 *
 		 * @param chunk_keys List of (x, z) chunk coordinates to query.
 		 * @param render_manager The render manager providing terrain data.
@@ -215,8 +204,9 @@ namespace Boidsish {
 		);
 
 	private:
-		void _Initialize();
-		void _UpdateAllocation(
+		void         _Initialize();
+		DecorTypeGPU _MakeTypeParams(size_t type_index) const;
+		void         _UpdateAllocation(
 			const Camera&                         camera,
 			const Frustum&                        frustum,
 			const ITerrainGenerator&              terrain_gen,
@@ -240,6 +230,15 @@ namespace Boidsish {
 		};
 
 		std::map<std::pair<int, int>, ChunkAllocation> active_chunks_;
+
+		// CPU placement results of GetDecorInChunks
+		struct PlacedChunkDecor {
+			std::weak_ptr<Terrain>                  terrain; // The chunk the decor was placed on
+			float                                   world_scale = 0.0f;
+			std::vector<std::vector<DecorInstance>> instances; // Per decor type
+		};
+
+		std::map<std::pair<int, int>, PlacedChunkDecor> placed_chunk_decor_;
 		std::vector<int>                               free_blocks_;
 		uint32_t                                       frame_counter_ = 0;
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Boidsish {
+
+	class TerrainChunkData;
+
+	// Matches std140 layout in decor_placement.comp GlobalPlacementParams UBO
+	struct alignas(16) PlacementGlobalsGPU {
+		glm::vec4 camera_and_scale; // xy=cameraPos, z=worldScale, w=maxTerrainHeight
+		glm::vec4 distance_params;  // x=densityFalloffStart, y=densityFalloffEnd, z=maxDecorDistance, w=maxInstances
+	};
+
+	// Matches std430 layout in decor_placement.comp ChunkParams SSBO
+	struct ChunkParamsGPU {
+		glm::vec4  offset_slice_size; // xy=worldOffset, z=slice, w=chunkSize
+		glm::ivec4 indices;           // x=baseInstanceIndex, yzw=unused
+	};
+
+	// Matches std140 layout in decor_placement.comp DecorTypeParams UBO
+	struct alignas(16) DecorTypeGPU {
+		glm::vec4  density_scale; // x=minDensity, y=maxDensity, z=baseScale, w=scaleVariance
+		glm::vec4  height_slope;  // x=minHeight, y=maxHeight, z=minSlope, w=maxSlope
+		glm::vec4  rotation;      // xyz=baseRotation (radians), w=detailDistance
+		glm::vec4  aabb_min;      // xyz=model AABB min, w=unused
+		glm::vec4  aabb_max;      // xyz=model AABB max, w=unused
+		glm::uvec4 flags;         // x=biomeMask, y=randomYaw, z=alignToTerrain, w=typeIndex
+	};
+
+	/**
+	 * @brief CPU mirror of the placement rules in shaders/decor_placement.comp.
+	 *
+	 * Same jittered grid, hash, simplex noise, height/slope/biome tests and instance matrix as
+	 * the shader, evaluated on a chunk's CPU surface instead of the terrain textures. Keep the
+	 * two in step: a change to the shader's rules needs the same change here.
+	 */
+	namespace DecorPlacement {
+
+		// The shader's hash(uint): an integer mix mapped to [0, 1]
+		float Hash(uint32_t x);
+
+		// snoise(vec2) from helpers/noise.glsl, in the same float operations
+		float SimplexNoise(const glm::vec2& v);
+
+		/**
+		 * @brief Places one decor type over one chunk.
+		 *
+		 * Heights, normals and biomes are bilinearly filtered from the surface grid exactly where
+		 * the shader samples its textures. Those textures hold the baked surface, so instances
+		 * can differ where the bake moves the ground (erosion, water flattening).
+		 *
+		 * @param surface The chunk's grid, resolution grid_size + 1
+		 * @param type_index Index the shader receives as u_typeIndex; part of the placement seed
+		 * @param grid_size Placement cells along each chunk edge ([[CHUNK_SIZE]])
+		 * @param out Receives the instance matrices of the cells that place decor, in the
+		 *            shader's instance order (x fastest)
+		 */
+		void PlaceInChunk(
+			const TerrainChunkData&    surface,
+			const DecorTypeGPU&        type,
+			int                        type_index,
+			const glm::vec2&           world_offset,
+			float                      chunk_size,
+			int                        grid_size,
+			const PlacementGlobalsGPU& globals,
+			std::vector<glm::mat4>&    out
+		);
+
+	} // namespace DecorPlacement
+
+} // namespace Boidsish
@@ -6,6 +6,7 @@
 #include <optional>
 #include <vector>
 
+#include "delaunay_tetrahedralizer.h"
 #include "shape.h"
 #include <GL/glew.h>
 #include <glm/glm.hpp>
@@ -19,9 +20,10 @@ namespace Boidsish {
 	 * to drive specific control points. The mesh automatically re-tetrahedralizes as points
 	 * move, rendering only the outer surface (boundary faces) to create a dynamic "blob".
 	 *
-	 * Uses 3D Bowyer-Watson algorithm for incremental Delaunay tetrahedralization.
-	 * The rendered surface consists of triangular faces that appear on exactly one
-	 * tetrahedron (the convex hull boundary).
+	 * Uses DelaunayTetrahedralizer (incremental Bowyer-Watson with walking point location).
+	 * Adding or removing points rebuilds the tetrahedralization; moving points first tries to
+	 * keep the previous connectivity. The rendered surface consists of the triangular faces
+	 * with no neighbouring tetrahedron (the convex hull boundary).
 	 */
 	class DelaunayBlob: public Shape {
 	public:
@@ -35,7 +37,8 @@ namespace Boidsish {
 
 		/// Tetrahedron from 3D Delaunay tetrahedralization
 		struct Tetrahedron {
-			std::array<int, 4> vertices; // Point IDs (not indices)
+			std::array<int, 4> vertices;  // Point IDs (not indices)
+			std::array<int, 4> neighbors; // GetTetrahedra() index across the face opposite vertices[i], -1 on hull
 			glm::vec3          circumcenter;
 			float              circumradius_sq;
 		};
@@ -174,7 +177,7 @@ namespace Boidsish {
 		void CleanupBuffers();
 
 	private:
-		// === 3D Delaunay Algorithm (Bowyer-Watson) ===
+		// === 3D Delaunay Algorithm ===
 
 		/// Compute 3D Delaunay tetrahedralization
 		void ComputeDelaunay3D() const;
@@ -182,16 +185,6 @@ namespace Boidsish {
 		/// Extract boundary surface faces from tetrahedralization
 		void ExtractSurfaceFaces() const;
 
-		/// Check if point is inside tetrahedron's circumsphere
-		bool InCircumsphere(const glm::vec3& p, const Tetrahedron& tet) const;
-
-		/// Compute circumsphere of tetrahedron (center and radius²)
-		std::pair<glm::vec3, float>
-		ComputeCircumsphere(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d) const;
-
-		/// Create super-tetrahedron containing all points
-		std::array<glm::vec3, 4> ComputeSuperTetrahedron() const;
-
 		/// Compute face normal (outward-facing from tetrahedron)
 		glm::vec3 ComputeFaceNormal(
 			const glm::vec3& p0,
@@ -228,6 +221,9 @@ namespace Boidsish {
 		mutable bool   buffers_initialized_ = false;
 
 		// Cached tetrahedralization (mutable for lazy computation)
+		mutable DelaunayTetrahedralizer  tetrahedralizer_;
+		mutable std::vector<int>         tet_point_ids_;         // Tetrahedralizer point index -> point ID
+		mutable bool                     topology_dirty_ = true; // Points added or removed since the last build
 		mutable std::vector<Tetrahedron> tetrahedra_;
 		mutable std::vector<Face>        surface_faces_;
 
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Boidsish {
+
+	/**
+	 * @brief Incremental 3D Delaunay tetrahedralization that keeps tetrahedron adjacency.
+	 *
+	 * Points are inserted with Bowyer-Watson in BRIO order (random rounds of doubling size, each
+	 * sorted along a Hilbert curve). Each point is located by walking from the last tetrahedron
+	 * created, and its cavity is grown through neighbours, so an insertion only touches the part
+	 * of the mesh it changes. Predicates are evaluated in double precision.
+	 *
+	 * Update() is the kinetic path for moving points: if every tetrahedron is still positively
+	 * oriented and every face still locally Delaunay, the connectivity is kept and only the
+	 * circumspheres are refreshed; otherwise the mesh is rebuilt.
+	 */
+	class DelaunayTetrahedralizer {
+	public:
+		struct Tetrahedron {
+			std::array<int, 4> vertices;  // Indices into the input points, positively oriented
+			std::array<int, 4> neighbors; // Tetrahedron across the face opposite vertices[i], -1 on the hull
+			glm::vec3          circumcenter;
+			float              circumradius_sq;
+		};
+
+		/// Tetrahedralizes the points from scratch
+		void Build(const std::vector<glm::vec3>& points);
+
+		/**
+		 * @brief Moves the points of the last Build to new positions.
+		 * @param points Same count and order as the last Build
+		 * @return True if the existing connectivity was still Delaunay and was kept, false if it was rebuilt
+		 */
+		bool Update(const std::vector<glm::vec3>& points);
+
+		void Clear();
+
+		const std::vector<Tetrahedron>& GetTetrahedra() const { return output_; }
+
+		/// Points not inserted because they coincide with an earlier one
+		size_t GetSkippedPointCount() const { return skipped_; }
+
+	private:
+		struct Tet {
+			std::array<int, 4> v;
+			std::array<int, 4> n;
+			glm::dvec3         center;
+			double             radius_sq;
+			bool               alive;
+		};
+
+		void   Insert(int point);
+		int    Locate(const glm::dvec3& p);
+		int    Allocate(const Tet& tet);
+		void   ComputeSphere(Tet& tet) const;
+		double Orient(const Tet& tet) const;
+		double OrientReplacing(const Tet& tet, int face, const glm::dvec3& p) const;
+		void   Extract();
+
+		bool InSphere(const Tet& tet, const glm::dvec3& p) const {
+			glm::dvec3 d = p - tet.center;
+			return glm::dot(d, d) < tet.radius_sq;
+		}
+
+		std::vector<glm::dvec3> points_; // Input points followed by the four super-tetrahedron vertices
+		std::vector<Tet>        tets_;
+		std::vector<int>        free_;
+		size_t                  input_count_ = 0;
+		size_t                  skipped_ = 0;
+		int                     last_ = -1;
+		glm::dvec3              super_center_{0.0};
+		double                  super_size_ = 0.0;
+		uint32_t                walk_state_ = 0x9e3779b9u;
+
+		// Per-insertion scratch, kept to avoid reallocating
+		std::vector<uint32_t> cavity_mark_;
+		uint32_t              epoch_ = 0;
+		std::vector<int>      cavity_;
+
+		struct EdgeLink {
+			int a, b;
+			int tet;
+			int face;
+		};
+
+		std::vector<EdgeLink> edge_links_;
+
+		std::vector<Tetrahedron> output_;
+	};
+
+} // namespace Boidsish
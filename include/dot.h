@@ -47,5 +47,7 @@ namespace Boidsish {
 
 		// All Dots share the same sphere mesh, so they can be instanced together
 		std::string GetInstanceKey() const override { return "Dot"; }
+
+		bool IsMeshInstanceable() const override { return true; }
 	};
 } // namespace Boidsish
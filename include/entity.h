@@ -6,6 +6,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <typeindex>
 #include <typeinfo>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "rigid_body.h"
 #include "shape.h"
 #include "task_thread_pool.hpp"
+#include "terrain_generator_interface.h"
 #include "vector.h"
 
 namespace Boidsish {
@@ -174,6 +176,7 @@ namespace Boidsish {
 		void SetPathConstraint(std::shared_ptr<Path> path, float radius) {
 			constraint_path_ = path;
 			constraint_radius_ = radius;
+			constraint_segment_ = -1;
 		}
 
 		glm::vec3 ObjectToWorld(const glm::vec3& v) const { return rigid_body_.GetOrientation() * v; }
@@ -206,6 +209,7 @@ namespace Boidsish {
 		// Path constraint
 		std::shared_ptr<Path> constraint_path_;
 		float                 constraint_radius_ = 0.0f;
+		int                   constraint_segment_ = -1; // Last closest segment, warm-starts the next query
 	};
 
 	// Template-based entity class that takes a shape
@@ -434,6 +438,31 @@ namespace Boidsish {
 		 */
 		bool IsTerrainCached(float x, float z) const;
 
+		// ========== Batched Terrain Queries ==========
+		// One call per frame for a whole flock instead of one locked lookup per entity.
+		// Call from PreTimestep/PostTimestep rather than from inside UpdateEntity.
+
+		/**
+		 * @brief Batched GetTerrainPropertiesAtPoint.
+		 * @param points World XZ positions
+		 * @param out One sample per point, same size as points
+		 */
+		void GetTerrainPropertiesBatch(std::span<const glm::vec2> points, std::span<TerrainSample> out) const;
+
+		/**
+		 * @brief Batched GetDistanceAboveTerrain.
+		 * @param points World positions
+		 * @param out One signed distance per point, same size as points
+		 */
+		void GetDistanceAboveTerrainBatch(std::span<const glm::vec3> points, std::span<float> out) const;
+
+		/**
+		 * @brief Batched RaycastTerrain.
+		 * @param rays Rays to cast
+		 * @param out One result per ray, same size as rays
+		 */
+		void RaycastTerrainBatch(std::span<const TerrainRay> rays, std::span<TerrainRayHit> out) const;
+
 		/**
 		 * @brief Get a valid placement for an entity, ensuring clearance from terrain and ground.
 		 * @param suggested_pos The desired position
@@ -559,6 +588,9 @@ namespace Boidsish {
 		virtual void OnEntityUpdated(std::shared_ptr<EntityBase> entity) { (void)entity; }
 
 	private:
+		// Advances every path-following entity, batched per path
+		void UpdatePathFollowers(const std::vector<std::shared_ptr<EntityBase>>& entities, float delta_time);
+
 		std::map<int, std::shared_ptr<EntityBase>> entities_;
 		float                                      last_time_;
 		mutable std::atomic<int>                   next_id_;
@@ -107,6 +107,15 @@ namespace Boidsish {
 			}
 			return true;
 		}
+
+		bool IsSphereInFrustum(const glm::vec3& center, float radius) const {
+			for (int i = 0; i < 6; ++i) {
+				if (glm::dot(planes[i].normal, center) + planes[i].distance < -radius) {
+					return false;
+				}
+			}
+			return true;
+		}
 	};
 
 } // namespace Boidsish
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -30,6 +32,47 @@ namespace Boidsish {
 		float m_Weights[MAX_BONE_INFLUENCE] = {0.0f, 0.0f, 0.0f, 0.0f};
 	};
 
+	/**
+	 * @brief A coarser index buffer over the same vertices as its mesh.
+	 */
+	struct MeshLod {
+		std::vector<unsigned int> indices;
+		float                     error = 0.0f;    // Mesh-space deviation from the full mesh
+		uint32_t                  first_index = 0; // Offset in the mesh's element buffer, set on upload
+	};
+
+	/**
+	 * @brief The element range drawn for one level of detail.
+	 */
+	struct LodRange {
+		uint32_t first_index = 0;
+		uint32_t index_count = 0;
+		float    error = 0.0f; // Mesh-space deviation from the full mesh
+	};
+
+	/**
+	 * @brief Up to kMaxLods levels of detail, finest first, held by value.
+	 */
+	struct LodRanges {
+		static constexpr size_t kMaxLods = 4; // The full mesh and mesh_lod_count's default of 3
+
+		std::array<LodRange, kMaxLods> ranges{};
+		size_t                         count = 0;
+
+		// Keeps the full mesh and the coarsest levels of meshes with more than fit
+		void Assign(std::span<const LodRange> lods) {
+			count = std::min(lods.size(), kMaxLods);
+			if (count == 0)
+				return;
+			ranges[0] = lods[0];
+			std::copy(lods.end() - (count - 1), lods.end(), ranges.begin() + 1);
+		}
+
+		std::span<const LodRange> View() const { return {ranges.data(), count}; }
+
+		bool empty() const { return count == 0; }
+	};
+
 	/**
 	 * @brief GPU indirect draw command structures.
 	 */
@@ -234,6 +277,14 @@ namespace Boidsish {
 
 		// Skeletal Animation
 		std::vector<glm::mat4> bone_matrices;
+
+		// Levels of detail, finest first; empty for a single level. LodSelector::Apply points
+		// first_index/index_count at one of them by its error projected from this bounding sphere.
+		// Copied from the mesh so cached packets stay valid when the mesh is re-uploaded.
+		LodRanges lods;
+		float     lod_error_scale = 1.0f; // Mesh to world space
+		glm::vec3 lod_center = glm::vec3(0.0f);
+		float     lod_radius = 0.0f;
 	};
 
 	/**
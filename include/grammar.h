@@ -2,6 +2,7 @@
 #define GRAMMAR_HPP
 
 #include <algorithm>
+#include <bit>
 #include <cctype>
 #include <cmath>
 #include <fstream>
@@ -183,12 +184,51 @@ private:
 		int      original_idx;
 	};
 
+	// A binary rule A -> B C as seen from its left child B, with dense nonterminal ids
+	struct BinaryRef {
+		uint32_t rhs2;
+		uint32_t lhs;
+		uint32_t rule;
+	};
+
+	// A unary rule A -> B as seen from B
+	struct UnaryRef {
+		uint32_t lhs;
+		uint32_t rule;
+	};
+
+	// Best derivation of one nonterminal over one span. Only valid where the cell's bit is set.
+	struct ChartEntry {
+		double   log_prob;
+		uint32_t rule;
+		uint32_t split;
+	};
+
 	std::unordered_map<uint32_t, RuleSet> grammar_;
 	std::vector<BinarizedRule>            binarized_grammar_;
 	bool                                  needs_binarization_ = true;
 	WordInterner                          interner_;
 	std::mt19937                          rng_;
 
+	// Parser indexes, rebuilt with the binarized grammar. Nonterminals get dense ids so chart
+	// cells are flat arrays; binary rules are grouped by left child and sorted by right child,
+	// unary rules grouped by their child (offsets index the groups by dense id).
+	std::unordered_map<uint32_t, uint32_t>              nt_index_;
+	std::vector<uint32_t>                               nt_symbols_;
+	std::unordered_map<uint32_t, std::vector<uint32_t>> lexical_rules_;
+	std::vector<uint32_t>                               binary_offsets_;
+	std::vector<BinaryRef>                              binary_rules_;
+	std::vector<uint32_t>                               unary_offsets_;
+	std::vector<UnaryRef>                               unary_rules_;
+
+	// Chart storage reused between parses: n * n cells of one entry per nonterminal, plus a
+	// bitset per cell of the nonterminals present
+	std::vector<ChartEntry> chart_;
+	std::vector<uint64_t>   chart_present_;
+	std::vector<uint32_t>   agenda_;
+	size_t                  chart_size_ = 0;
+	size_t                  chart_words_ = 0;
+
 	std::vector<uint32_t> tokenize(const std::string& text) {
 		std::vector<uint32_t> tokens;
 		std::string           current;
@@ -284,9 +324,154 @@ private:
 				}
 			}
 		}
+		build_parse_index();
 		needs_binarization_ = false;
 	}
 
+	uint32_t dense_id(uint32_t symbol) {
+		auto [it, inserted] = nt_index_.try_emplace(symbol, static_cast<uint32_t>(nt_symbols_.size()));
+		if (inserted)
+			nt_symbols_.push_back(symbol);
+		return it->second;
+	}
+
+	void build_parse_index() {
+		nt_index_.clear();
+		nt_symbols_.clear();
+		lexical_rules_.clear();
+
+		std::vector<std::pair<uint32_t, BinaryRef>> binary;
+		std::vector<std::pair<uint32_t, UnaryRef>>  unary;
+		for (uint32_t r = 0; r < binarized_grammar_.size(); ++r) {
+			const BinarizedRule& rule = binarized_grammar_[r];
+			uint32_t             lhs = dense_id(rule.lhs);
+			if (rule.is_terminal) {
+				lexical_rules_[rule.rhs1].push_back(r);
+			} else if (rule.rhs2 == 0) {
+				unary.push_back({dense_id(rule.rhs1), {lhs, r}});
+			} else {
+				uint32_t rhs1 = dense_id(rule.rhs1);
+				binary.push_back({rhs1, {dense_id(rule.rhs2), lhs, r}});
+			}
+		}
+
+		std::sort(binary.begin(), binary.end(), [](const auto& a, const auto& b) {
+			return a.first != b.first ? a.first < b.first : a.second.rhs2 < b.second.rhs2;
+		});
+		std::stable_sort(unary.begin(), unary.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		// Counting offsets: group g spans [offsets[g], offsets[g + 1])
+		auto group = [&](const auto& sorted, auto& offsets, auto& out) {
+			offsets.assign(nt_symbols_.size() + 1, 0);
+			out.clear();
+			for (const auto& [key, ref] : sorted) {
+				++offsets[key + 1];
+				out.push_back(ref);
+			}
+			for (size_t i = 1; i < offsets.size(); ++i)
+				offsets[i] += offsets[i - 1];
+		};
+		group(binary, binary_offsets_, binary_rules_);
+		group(unary, unary_offsets_, unary_rules_);
+	}
+
+	// Keeps the better of the cell's current entry for nt and the candidate; true if it changed
+	bool relax(size_t cell, uint32_t nt, double log_prob, uint32_t rule, uint32_t split) {
+		uint64_t&   word = chart_present_[cell * chart_words_ + nt / 64];
+		uint64_t    bit = uint64_t(1) << (nt % 64);
+		ChartEntry& entry = chart_[cell * nt_symbols_.size() + nt];
+		if ((word & bit) && log_prob <= entry.log_prob)
+			return false;
+		word |= bit;
+		entry = {log_prob, rule, split};
+		return true;
+	}
+
+	bool present(size_t cell, uint32_t nt) const {
+		return (chart_present_[cell * chart_words_ + nt / 64] >> (nt % 64)) & 1;
+	}
+
+	// Calls f(nt) for every nonterminal present in the cell
+	template <typename F>
+	void for_each_present(size_t cell, F&& f) const {
+		for (size_t w = 0; w < chart_words_; ++w) {
+			for (uint64_t bits = chart_present_[cell * chart_words_ + w]; bits; bits &= bits - 1) {
+				f(static_cast<uint32_t>(w * 64 + std::countr_zero(bits)));
+			}
+		}
+	}
+
+	// Closes the cell under unit productions, following only entries that just improved
+	void close_unary(size_t cell) {
+		agenda_.clear();
+		for_each_present(cell, [&](uint32_t nt) { agenda_.push_back(nt); });
+		while (!agenda_.empty()) {
+			uint32_t child = agenda_.back();
+			agenda_.pop_back();
+			double child_log_prob = chart_[cell * nt_symbols_.size() + child].log_prob;
+			for (uint32_t u = unary_offsets_[child]; u < unary_offsets_[child + 1]; ++u) {
+				const UnaryRef& ref = unary_rules_[u];
+				double          log_prob = binarized_grammar_[ref.rule].log_prob + child_log_prob;
+				if (relax(cell, ref.lhs, log_prob, ref.rule, 0))
+					agenda_.push_back(ref.lhs);
+			}
+		}
+	}
+
+	// Viterbi CYK over the tokens. Cell (i, j) covers tokens i..j and lives at i * n + j.
+	void fill_chart(const std::vector<uint32_t>& tokens) {
+		size_t n = tokens.size();
+		size_t nt_count = nt_symbols_.size();
+		chart_size_ = n;
+		chart_words_ = (nt_count + 63) / 64;
+		if (chart_.size() < n * n * nt_count)
+			chart_.resize(n * n * nt_count);
+		chart_present_.assign(n * n * chart_words_, 0);
+
+		for (size_t i = 0; i < n; ++i) {
+			auto lexical = lexical_rules_.find(tokens[i]);
+			if (lexical != lexical_rules_.end()) {
+				for (uint32_t r : lexical->second) {
+					const BinarizedRule& rule = binarized_grammar_[r];
+					relax(i * n + i, nt_index_[rule.lhs], rule.log_prob, r, 0);
+				}
+			}
+			close_unary(i * n + i);
+		}
+
+		for (size_t len = 2; len <= n; ++len) {
+			for (size_t i = 0; i + len <= n; ++i) {
+				size_t j = i + len - 1;
+				size_t cell = i * n + j;
+				for (size_t k = i; k < j; ++k) {
+					size_t left = i * n + k;
+					size_t right = (k + 1) * n + j;
+					for_each_present(left, [&](uint32_t rhs1) {
+						double left_log_prob = chart_[left * nt_count + rhs1].log_prob;
+						for (uint32_t b = binary_offsets_[rhs1]; b < binary_offsets_[rhs1 + 1]; ++b) {
+							const BinaryRef& ref = binary_rules_[b];
+							if (!present(right, ref.rhs2))
+								continue;
+							double log_prob = binarized_grammar_[ref.rule].log_prob + left_log_prob +
+								chart_[right * nt_count + ref.rhs2].log_prob;
+							relax(cell, ref.lhs, log_prob, ref.rule, static_cast<uint32_t>(k));
+						}
+					});
+				}
+				close_unary(cell);
+			}
+		}
+	}
+
+	// Best log probability of the whole token span as `start`, -infinity if it does not parse
+	double root_log_prob(uint32_t start_id) const {
+		auto it = nt_index_.find(start_id);
+		size_t root = chart_size_ - 1;
+		if (chart_size_ == 0 || it == nt_index_.end() || !present(root, it->second))
+			return -std::numeric_limits<double>::infinity();
+		return chart_[root * nt_symbols_.size() + it->second].log_prob;
+	}
+
 	void generate_recursive(uint32_t symbol_id, GenerationContext& ctx, std::string& output) {
 		auto it = grammar_.find(symbol_id);
 		if (it == grammar_.end()) {
@@ -461,123 +646,36 @@ public:
 			return {};
 
 		size_t n = tokens.size();
-
-		// table[i][j][lhs] = {log_prob, rule_ptr}
-		struct Entry {
-			double               log_prob = -std::numeric_limits<double>::infinity();
-			const BinarizedRule* rule = nullptr;
-			size_t               split = 0;
-			uint32_t             rhs1_entry_id = 0;
-			uint32_t             rhs2_entry_id = 0;
-		};
-
-		std::vector<std::vector<std::unordered_map<uint32_t, Entry>>> table(
-			n,
-			std::vector<std::unordered_map<uint32_t, Entry>>(n)
-		);
-
-		// Leaf nodes
-		for (size_t i = 0; i < n; ++i) {
-			for (const auto& rule : binarized_grammar_) {
-				if (rule.is_terminal && rule.rhs1 == tokens[i]) {
-					if (rule.log_prob > table[i][i][rule.lhs].log_prob) {
-						table[i][i][rule.lhs] = {rule.log_prob, &rule};
-					}
-				}
-			}
-			// Handle unit productions (A -> B) at leaf level
-			bool changed = true;
-			while (changed) {
-				changed = false;
-				for (const auto& rule : binarized_grammar_) {
-					if (!rule.is_terminal && rule.rhs2 == 0) {
-						auto it = table[i][i].find(rule.rhs1);
-						if (it != table[i][i].end()) {
-							double lp = rule.log_prob + it->second.log_prob;
-							if (lp > table[i][i][rule.lhs].log_prob) {
-								table[i][i][rule.lhs] = {lp, &rule};
-								changed = true;
-							}
-						}
-					}
-				}
-			}
-		}
-
-		// Fill table
-		for (size_t len = 1; len <= n; ++len) {
-			for (size_t i = 0; i <= n - len; ++i) {
-				size_t j = i + len - 1;
-
-				if (len > 1) {
-					for (size_t k = i; k < j; ++k) {
-						for (const auto& rule : binarized_grammar_) {
-							if (!rule.is_terminal && rule.rhs2 != 0) {
-								auto it1 = table[i][k].find(rule.rhs1);
-								auto it2 = table[k + 1][j].find(rule.rhs2);
-								if (it1 != table[i][k].end() && it2 != table[k + 1][j].end()) {
-									double lp = rule.log_prob + it1->second.log_prob + it2->second.log_prob;
-									if (lp > table[i][j][rule.lhs].log_prob) {
-										table[i][j][rule.lhs] = {lp, &rule, k};
-									}
-								}
-							}
-						}
-					}
-				}
-
-				// Handle unit productions for this span
-				bool changed = true;
-				while (changed) {
-					changed = false;
-					for (const auto& rule : binarized_grammar_) {
-						if (!rule.is_terminal && rule.rhs2 == 0) {
-							auto it = table[i][j].find(rule.rhs1);
-							if (it != table[i][j].end()) {
-								double lp = rule.log_prob + it->second.log_prob;
-								if (lp > table[i][j][rule.lhs].log_prob) {
-									table[i][j][rule.lhs] = {lp, &rule};
-									changed = true;
-								}
-							}
-						}
-					}
-				}
-			}
-		}
+		fill_chart(tokens);
 
 		uint32_t start_id = interner_.get_or_intern(start);
-		if (table[0][n - 1].count(start_id)) {
+		if (root_log_prob(start_id) > -std::numeric_limits<double>::infinity()) {
 			// Backtrack and modify weights
-			std::vector<std::pair<size_t, size_t>> q;
-			std::vector<uint32_t>                  syms;
-			q.push_back({0, n - 1});
-			syms.push_back(start_id);
+			struct Span {
+				size_t   i, j;
+				uint32_t nt;
+			};
+			std::vector<Span> q;
+			q.push_back({0, n - 1, nt_index_[start_id]});
 
 			while (!q.empty()) {
-				auto [i, j] = q.back();
-				uint32_t sym = syms.back();
+				auto [i, j, nt] = q.back();
 				q.pop_back();
-				syms.pop_back();
 
-				const Entry& entry = table[i][j][sym];
-				if (!entry.rule)
-					continue;
+				const ChartEntry&    entry = chart_[(i * n + j) * nt_symbols_.size() + nt];
+				const BinarizedRule& rule = binarized_grammar_[entry.rule];
 
-				if (entry.rule->original_idx != -1) {
-					grammar_[entry.rule->original_lhs].base_weights[entry.rule->original_idx] *= 2.0;
+				if (rule.original_idx != -1) {
+					grammar_[rule.original_lhs].base_weights[rule.original_idx] *= 2.0;
 					needs_binarization_ = true;
 				}
 
-				if (!entry.rule->is_terminal) {
-					if (entry.rule->rhs2 != 0) {
-						q.push_back({entry.split + 1, j});
-						syms.push_back(entry.rule->rhs2);
-						q.push_back({i, entry.split});
-						syms.push_back(entry.rule->rhs1);
+				if (!rule.is_terminal) {
+					if (rule.rhs2 != 0) {
+						q.push_back({entry.split + 1, j, nt_index_[rule.rhs2]});
+						q.push_back({i, entry.split, nt_index_[rule.rhs1]});
 					} else {
-						q.push_back({i, j});
-						syms.push_back(entry.rule->rhs1);
+						q.push_back({i, j, nt_index_[rule.rhs1]});
 					}
 				}
 			}
@@ -586,6 +684,16 @@ public:
 		return tokens;
 	}
 
+	// Log probability of the sentence's most likely parse, -infinity if it does not parse
+	double log_probability(const std::string& sentence, const std::string& start = "ROOT") {
+		binarize();
+		std::vector<uint32_t> tokens = tokenize(sentence);
+		if (tokens.empty())
+			return -std::numeric_limits<double>::infinity();
+		fill_chart(tokens);
+		return root_log_prob(interner_.get_or_intern(start));
+	}
+
 	WordInterner& get_interner() { return interner_; }
 
 	void dump_rules(const std::string& filename) const {
@@ -36,6 +36,7 @@ namespace Boidsish {
 		class IWidget;
 		class UIConfigManager;
 	} // namespace UI
+	class AnimationCrowd;
 	class EntityBase;
 	class CurvedText;
 	class ArcadeText;
@@ -576,6 +577,7 @@ namespace Boidsish {
 		std::shared_ptr<T> SetTerrainGenerator(Args&&... args);
 
 		task_thread_pool::task_thread_pool&    GetThreadPool();
+		AnimationCrowd&                        GetAnimationCrowd(); // Evaluated each frame after the shapes update
 		LightManager&                          GetLightManager();
 		FireEffectManager*                     GetFireEffectManager();
 		DecorManager*                          GetDecorManager();
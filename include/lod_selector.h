@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "geometry.h"
+#include "render_context.h"
+#include <glm/glm.hpp>
+
+namespace Boidsish {
+
+	/**
+	 * @brief Picks a level of detail per instance from its projected screen-space error.
+	 *
+	 * A level's world-space error is projected at the nearest point of the instance's bounding
+	 * sphere, so it is never underestimated, and measured as a fraction of the viewport height.
+	 * The coarsest level under RenderContext::lod_screen_error is drawn.
+	 */
+	class LodSelector {
+	public:
+		/// Projected size of a world-space error as a fraction of the viewport height
+		static float ScreenError(float error, const glm::vec3& center, float radius, const RenderContext& context);
+
+		/// Index into lods of the level to draw; error_scale takes the levels' errors to world space
+		static size_t Select(
+			std::span<const LodRange> lods,
+			const glm::vec3&          center,
+			float                     radius,
+			const RenderContext&      context,
+			float                     error_scale = 1.0f
+		);
+
+		/// Points the packet's draw range at its selected level; packets without levels are left alone
+		static void Apply(RenderPacket& packet, const RenderContext& context);
+	};
+
+} // namespace Boidsish
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
 #include <concepts>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #if __has_include(<source_location>)
 	#include <source_location>
 #endif
@@ -13,6 +22,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -60,25 +70,54 @@ namespace logger {
 	};
 
 	inline const std::string format(const LogMessage& msg) {
-		std::stringstream str;
-		str << "[" << levelString(msg.level) << "] " << msg.message;
+		std::string_view level = levelString(msg.level);
+		char             line_buf[16];
+		auto             line_end = std::to_chars(line_buf, line_buf + sizeof(line_buf), msg.line_number).ptr;
+
+		std::string str;
+		str.reserve(
+			level.size() + msg.message.size() + msg.tags.size() + msg.file_name.size() + (line_end - line_buf) + 8
+		);
+		str += '[';
+		str += level;
+		str += "] ";
+		str += msg.message;
 		if (!msg.tags.empty()) {
-			str << " " << msg.tags;
+			str += ' ';
+			str += msg.tags;
 		}
-		str << " (" << msg.file_name << ":" << msg.line_number << ")";
-
-		// if (msg.file_name.length() && bool(msg.line_number) && msg.function_name.length()) {
-		// 	str << " (" << msg.file_name << ":" << msg.line_number << " :: " << msg.function_name << ")";
-		// }
-		return str.str();
+		str += " (";
+		str += msg.file_name;
+		str += ':';
+		str.append(line_buf, line_end);
+		str += ')';
+		return str;
 	}
 
+	namespace detail {
+		// Substitutes the next "{}" in message with replacement, or appends it to tags when none remain.
+		inline void applyArgument(std::string& message, size_t& searchPos, std::string& tags, std::string_view replacement) {
+			size_t pos = message.find("{}", searchPos);
+			if (pos != std::string::npos) {
+				message.replace(pos, 2, replacement);
+				searchPos = pos + replacement.length();
+			} else {
+				tags += '[';
+				tags += replacement;
+				tags += "] ";
+			}
+		}
+	} // namespace detail
+
 	class Backend { // abstract base class for backend
 	public:
 		virtual ~Backend() = default;
 		virtual bool render(const LogLevel level, const std::string_view& str) = 0;
 		virtual bool isEnabled(LogLevel level) const = 0;
 		virtual void setLogLevel(LogLevel level, bool enabled) = 0;
+
+		// Called after a line (synchronous logging) or a batch of lines (asynchronous logging)
+		virtual void flush() {}
 	};
 
 	class BaseBackend: public Backend {
@@ -103,9 +142,11 @@ namespace logger {
 		bool render(const LogLevel level, const std::string_view& str) override {
 			if (!isEnabled(level))
 				return false;
-			std::cout << str << std::endl;
+			std::cout << str << '\n';
 			return true;
 		}
+
+		void flush() override { std::cout.flush(); }
 	};
 
 	class FileBackend: public BaseBackend {
@@ -118,11 +159,16 @@ namespace logger {
 			if (!isEnabled(level))
 				return false;
 			if (file.is_open()) {
-				file << str << std::endl;
+				file << str << '\n';
 				return true;
 			}
 			return false;
 		}
+
+		void flush() override {
+			if (file.is_open())
+				file.flush();
+		}
 	};
 
 	class MultiBackend: public Backend {
@@ -158,6 +204,12 @@ namespace logger {
 			}
 		}
 
+		void flush() override {
+			for (auto& b : backends) {
+				b->flush();
+			}
+		}
+
 		auto& getBackends() { return backends; }
 	};
 
@@ -185,6 +237,275 @@ namespace logger {
 			msg(m), loc(l) {}
 	};
 
+	namespace detail {
+		template <typename T>
+		void formatArgument(std::ostream& os, T&& arg) {
+			using U = std::remove_cvref_t<T>;
+
+			if constexpr (is_tuple_like_v<U>) {
+				if constexpr (std::tuple_size_v<U> == 2) {
+					os << std::get<0>(arg) << " => [" << std::get<1>(arg) << "]";
+				} else {
+					os << "{ tuple-like size=" << std::tuple_size_v<U> << " }";
+				}
+			} else if constexpr (requires { os << arg; }) {
+				os << std::forward<T>(arg);
+			} else {
+				os << "{ unprintable type }";
+			}
+		}
+
+		template <typename T>
+		std::string formatArgument(T&& arg) {
+			using U = std::remove_cvref_t<T>;
+			if constexpr (std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>) {
+				return std::string(arg);
+			} else {
+				std::ostringstream ss;
+				formatArgument(ss, std::forward<T>(arg));
+				return ss.str();
+			}
+		}
+	} // namespace detail
+
+	// What the asynchronous path does when a producer thread's ring is full
+	enum class OverflowPolicy : uint8_t {
+		Drop, // discard the record and count it
+		Block // spin until the writer frees a slot
+	};
+
+	struct AsyncOptions {
+		size_t                    slots_per_thread = 1024; // rounded up to a power of two
+		OverflowPolicy            overflow = OverflowPolicy::Drop;
+		std::chrono::milliseconds flush_interval{2}; // writer idle wait between passes
+	};
+
+	struct AsyncStats {
+		uint64_t enqueued = 0;  // records accepted into a ring
+		uint64_t written = 0;   // records rendered by the writer thread
+		uint64_t dropped = 0;   // records discarded because a ring was full
+		uint64_t blocked = 0;   // producer stalls waiting for space
+		uint64_t truncated = 0; // records whose arguments did not fit in a slot
+		uint64_t batches = 0;   // backend flushes issued by the writer
+	};
+
+	namespace detail {
+		// Tags for arguments captured raw and formatted later on the writer thread
+		enum class ArgTag : uint8_t { Int, UInt, Double, Bool, Char, String };
+
+		struct RecordHeader {
+			const char* file;
+			uint32_t    line;
+			uint16_t    size;
+			uint8_t     arg_count;
+			LogLevel    level;
+			bool        truncated;
+		};
+
+		constexpr size_t kRecordSlotSize = 256;
+
+		struct alignas(64) RecordSlot {
+			RecordHeader header;
+			uint8_t      payload[kRecordSlotSize - sizeof(RecordHeader)];
+		};
+
+		static_assert(sizeof(RecordSlot) == kRecordSlotSize);
+
+		class RecordEncoder {
+		public:
+			explicit RecordEncoder(RecordSlot& slot): slot_(slot) {
+				slot_.header.size = 0;
+				slot_.header.arg_count = 0;
+				slot_.header.truncated = false;
+			}
+
+			// The format string is stored first, without a tag
+			void putMessage(std::string_view msg) { putBytes(msg); }
+
+			template <typename T>
+			void putArgument(T&& arg) {
+				using U = std::remove_cvref_t<T>;
+				if (slot_.header.truncated)
+					return;
+
+				if constexpr (std::is_same_v<U, bool>) {
+					putScalar(ArgTag::Bool, static_cast<uint64_t>(arg));
+				} else if constexpr (
+					std::is_same_v<U, char> || std::is_same_v<U, signed char> || std::is_same_v<U, unsigned char>
+				) {
+					// ostream prints all narrow character types as characters
+					putScalar(ArgTag::Char, static_cast<uint64_t>(static_cast<unsigned char>(arg)));
+				} else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+					putScalar(ArgTag::Int, static_cast<int64_t>(arg));
+				} else if constexpr (std::is_integral_v<U>) {
+					putScalar(ArgTag::UInt, static_cast<uint64_t>(arg));
+				} else if constexpr (std::is_floating_point_v<U>) {
+					putScalar(ArgTag::Double, static_cast<double>(arg));
+				} else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+					putString(arg ? std::string_view(arg) : std::string_view("(null)"));
+				} else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+					putString(std::string_view(arg));
+				} else {
+					// Arbitrary types may reference caller state, so they are formatted eagerly
+					putString(formatArgument(std::forward<T>(arg)));
+				}
+			}
+
+		private:
+			size_t remaining() const { return sizeof(slot_.payload) - slot_.header.size; }
+
+			template <typename V>
+			void putScalar(ArgTag tag, V value) {
+				if (remaining() < 1 + sizeof(V)) {
+					slot_.header.truncated = true;
+					return;
+				}
+				uint8_t* out = slot_.payload + slot_.header.size;
+				out[0] = static_cast<uint8_t>(tag);
+				std::memcpy(out + 1, &value, sizeof(V));
+				slot_.header.size += static_cast<uint16_t>(1 + sizeof(V));
+				++slot_.header.arg_count;
+			}
+
+			void putString(std::string_view str) {
+				if (remaining() < 1 + sizeof(uint16_t)) {
+					slot_.header.truncated = true;
+					return;
+				}
+				slot_.payload[slot_.header.size++] = static_cast<uint8_t>(ArgTag::String);
+				putBytes(str);
+				++slot_.header.arg_count;
+			}
+
+			// [u16 length][bytes], cut short when the slot is full
+			void putBytes(std::string_view str) {
+				size_t available = remaining() >= sizeof(uint16_t) ? remaining() - sizeof(uint16_t) : 0;
+				if (str.size() > available) {
+					str = str.substr(0, available);
+					slot_.header.truncated = true;
+				}
+				uint16_t len = static_cast<uint16_t>(str.size());
+				std::memcpy(slot_.payload + slot_.header.size, &len, sizeof(len));
+				std::memcpy(slot_.payload + slot_.header.size + sizeof(len), str.data(), len);
+				slot_.header.size += static_cast<uint16_t>(sizeof(len) + len);
+			}
+
+			RecordSlot& slot_;
+		};
+
+		// Single-producer single-consumer ring owned by one logging thread and drained by the writer
+		struct ProducerRing {
+			explicit ProducerRing(size_t capacity): slots(std::bit_ceil(std::max<size_t>(capacity, 2))) {
+				mask = slots.size() - 1;
+			}
+
+			RecordSlot* tryAcquire() {
+				uint64_t t = tail.load(std::memory_order_relaxed);
+				if (t - head.load(std::memory_order_acquire) >= slots.size())
+					return nullptr;
+				return &slots[t & mask];
+			}
+
+			void commit() {
+				tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+				enqueued.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			std::vector<RecordSlot> slots;
+			size_t                  mask = 0;
+
+			alignas(64) std::atomic<uint64_t> head{0}; // advanced by the writer
+			alignas(64) std::atomic<uint64_t> tail{0}; // advanced by the producer
+
+			alignas(64) std::atomic<uint64_t> enqueued{0};
+			std::atomic<uint64_t> dropped{0};
+			std::atomic<uint64_t> blocked{0};
+			std::atomic<uint64_t> truncated{0};
+			std::atomic<bool>     orphaned{false}; // set when the owning queue is destroyed
+		};
+	} // namespace detail
+
+	/**
+	 * @brief Lock-free front end that defers formatting and output to a background writer thread.
+	 *
+	 * Each logging thread gets its own SPSC ring of fixed-size slots. Arithmetic and string arguments are
+	 * copied raw and formatted by the writer; other types are formatted on the calling thread. The writer
+	 * renders to the backend in batches and flushes once per batch. The backend must not be reconfigured
+	 * while a queue is attached to it.
+	 */
+	class AsyncLogQueue {
+	public:
+		AsyncLogQueue(Backend& backend, const AsyncOptions& options = {});
+		~AsyncLogQueue(); // drains outstanding records, then joins the writer
+
+		AsyncLogQueue(const AsyncLogQueue&) = delete;
+		AsyncLogQueue& operator=(const AsyncLogQueue&) = delete;
+
+		template <typename... Ts>
+		void enqueue(LogLevel level, const LogSource& src, Ts&&... args) {
+			detail::ProducerRing& ring = localRing();
+			detail::RecordSlot*   slot = ring.tryAcquire();
+			if (!slot) {
+				if (options_.overflow == OverflowPolicy::Drop) {
+					ring.dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				ring.blocked.fetch_add(1, std::memory_order_relaxed);
+				wake();
+				while (!(slot = ring.tryAcquire())) {
+					std::this_thread::yield();
+				}
+			}
+
+			slot->header.level = level;
+			slot->header.file = src.loc.file_name();
+			slot->header.line = src.loc.line();
+
+			detail::RecordEncoder encoder(*slot);
+			encoder.putMessage(src.msg);
+			(encoder.putArgument(std::forward<Ts>(args)), ...);
+			if (slot->header.truncated)
+				ring.truncated.fetch_add(1, std::memory_order_relaxed);
+
+			ring.commit();
+		}
+
+		// Blocks until every record enqueued before the call has been rendered and flushed
+		void flush();
+
+		AsyncStats stats() const;
+
+	private:
+		detail::ProducerRing& localRing();
+		void                  wake();
+		void                  writerLoop();
+		size_t                drainOnce();
+		void                  renderRecord(const detail::RecordSlot& slot);
+
+		Backend&     backend_;
+		AsyncOptions options_;
+		uint64_t     id_;
+
+		mutable std::mutex                                 rings_mutex_;
+		std::vector<std::shared_ptr<detail::ProducerRing>> rings_;
+		AsyncStats                                         retired_; // counters of pruned rings
+
+		std::mutex              wake_mutex_;
+		std::condition_variable wake_cv_;
+		bool                    wake_pending_ = false;
+		std::atomic<bool>       stop_{false};
+
+		std::mutex              flush_mutex_;
+		std::condition_variable flush_cv_;
+		uint64_t                passes_ = 0;
+		bool                    writer_done_ = false;
+
+		std::atomic<uint64_t> written_{0};
+		std::atomic<uint64_t> batches_{0};
+
+		std::thread writer_;
+	};
+
 	template <class B>
 	class Logger {
 		static_assert(std::is_base_of_v<Backend, B>, "Backend must derive from logger::Backend");
@@ -192,38 +513,47 @@ namespace logger {
 	public:
 		B backend;
 
+		// Switches to asynchronous output. Start and stop while no other thread is logging.
+		void startAsync(const AsyncOptions& options = {}) {
+			stopAsync();
+			async_ = std::make_unique<AsyncLogQueue>(backend, options);
+		}
+
+		void stopAsync() { async_.reset(); }
+
+		bool isAsync() const { return async_ != nullptr; }
+
+		void flush() {
+			if (async_)
+				async_->flush();
+			else
+				backend.flush();
+		}
+
+		AsyncStats asyncStats() const { return async_ ? async_->stats() : AsyncStats{}; }
+
 	private:
+		// Declared after backend so it is destroyed (and drained) first
+		std::unique_ptr<AsyncLogQueue> async_;
+
 		template <typename... Ts>
 		void doLogging(const LogLevel& level, const LogSource& src, Ts&&... flags) {
-			std::string       message(src.msg);
-			std::stringstream tags;
+			if (async_) {
+				async_->enqueue(level, src, std::forward<Ts>(flags)...);
+				return;
+			}
+
+			std::string message(src.msg);
+			std::string tags;
 
 			size_t searchPos = 0;
 			auto   process = [&](auto&& arg) {
-				std::stringstream ss;
-				std::ostream&     os = ss;
-				using T = std::remove_cvref_t<decltype(arg)>;
-
-				if constexpr (is_tuple_like_v<T>) {
-					if constexpr (std::tuple_size_v<T> == 2) {
-						os << std::get<0>(arg) << " => [" << std::get<1>(arg) << "]";
-					} else {
-						os << "{ tuple-like size=" << std::tuple_size_v<T> << " }";
-					}
-				} else if constexpr (requires { os << arg; }) {
-					os << std::forward<decltype(arg)>(arg);
-				} else {
-					os << "{ unprintable type }";
-				}
-
-				std::string replacement = ss.str();
-				size_t      pos = message.find("{}", searchPos);
-				if (pos != std::string::npos) {
-					message.replace(pos, 2, replacement);
-					searchPos = pos + replacement.length();
-				} else {
-					tags << "[" << replacement << "] ";
-				}
+				detail::applyArgument(
+					message,
+					searchPos,
+					tags,
+					detail::formatArgument(std::forward<decltype(arg)>(arg))
+				);
 			};
 
 			(process(std::forward<Ts>(flags)), ...);
@@ -233,12 +563,13 @@ namespace logger {
 				.message = message,
 				.file_name = src.loc.file_name(),
 				// .function_name = src.loc.function_name(),
-				.tags = tags.str(),
+				.tags = tags,
 				.line_number = src.loc.line(),
 			};
 
 			std::string logStr = format(log);
-			backend.render(level, logStr);
+			if (backend.render(level, logStr))
+				backend.flush();
 		}
 
 	public:
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Boidsish {
+
+	/**
+	 * @brief Deterministic, context-free L-system over byte symbols.
+	 *
+	 * Rules live in a flat table indexed by symbol. A symbol without a rule rewrites to itself.
+	 * The expansion is walked symbol by symbol with Symbols(), which keeps one frame per
+	 * iteration instead of the expanded string.
+	 */
+	class LSystem {
+	public:
+		LSystem() = default;
+
+		explicit LSystem(std::string axiom): axiom_(std::move(axiom)) {}
+
+		void SetAxiom(std::string axiom) { axiom_ = std::move(axiom); }
+
+		const std::string& GetAxiom() const { return axiom_; }
+
+		void SetRule(char symbol, std::string replacement) {
+			rules_[Index(symbol)] = std::move(replacement);
+			has_rule_.set(Index(symbol));
+		}
+
+		// Rules in "A=replacement" form; malformed strings are ignored
+		void SetRules(const std::vector<std::string>& rule_strings);
+
+		bool HasRule(char symbol) const { return has_rule_.test(Index(symbol)); }
+
+		const std::string& GetRule(char symbol) const { return rules_[Index(symbol)]; }
+
+		// Length of the axiom after the given number of iterations, without expanding it
+		size_t ExpandedLength(int iterations) const;
+
+		/**
+		 * @brief Walks the expansion in order without building it.
+		 *
+		 * Input range over the expanded symbols: `for (char c : lsys.Symbols(n))`. It holds
+		 * references to the L-system's axiom and rules, which must outlive it and stay unchanged.
+		 */
+		class SymbolStream {
+		public:
+			class Iterator {
+			public:
+				using iterator_category = std::input_iterator_tag;
+				using value_type = char;
+				using difference_type = std::ptrdiff_t;
+
+				explicit Iterator(SymbolStream* stream = nullptr): stream_(stream) {}
+
+				char operator*() const { return stream_->current_; }
+
+				Iterator& operator++() {
+					stream_->Advance();
+					return *this;
+				}
+
+				void operator++(int) { ++*this; }
+
+				bool operator==(std::default_sentinel_t) const { return stream_->frames_.empty(); }
+
+			private:
+				SymbolStream* stream_;
+			};
+
+			SymbolStream(const LSystem& lsystem, std::string_view text, int iterations);
+
+			Iterator begin() { return Iterator(this); }
+
+			std::default_sentinel_t end() const { return {}; }
+
+			// Fetches the next symbol; false once the expansion is exhausted
+			bool Next(char& symbol) {
+				if (frames_.empty())
+					return false;
+				symbol = current_;
+				Advance();
+				return true;
+			}
+
+		private:
+			struct Frame {
+				std::string_view text;
+				size_t           position;
+				int              iterations; // Rewrites still to apply to the symbols of text
+			};
+
+			void Advance();
+
+			const LSystem*     lsystem_;
+			std::vector<Frame> frames_;
+			char               current_ = 0;
+		};
+
+		SymbolStream Symbols(int iterations) const { return SymbolStream(*this, axiom_, iterations); }
+
+	private:
+		static size_t Index(char symbol) { return static_cast<unsigned char>(symbol); }
+
+		// Per iteration count d, the length every symbol expands to after d rewrites
+		std::vector<std::array<size_t, 256>> LengthTable(int iterations) const;
+
+		std::string                  axiom_;
+		std::array<std::string, 256> rules_;
+		std::bitset<256>             has_rule_;
+	};
+
+} // namespace Boidsish
@@ -2,6 +2,8 @@
 #include <vector>
 
 #include "geometry.h"
+#include "meshlet.h"
+#include "packed_vertex.h"
 
 namespace Boidsish {
 
@@ -45,6 +47,54 @@ namespace Boidsish {
 			const std::vector<unsigned int>& indices,
 			std::vector<unsigned int>&       out_shadow_indices
 		);
+
+		/**
+		 * @brief Builds a chain of coarser index buffers over the mesh's vertices.
+		 * Each level halves the triangle count of the one before it, simplifying from it with the
+		 * borders locked so meshes of one model stay joined. Errors are mesh-space distances and
+		 * accumulate down the chain. Stops early once simplification stalls.
+		 * @param max_levels Number of levels to generate after the full mesh
+		 */
+		static void GenerateLods(
+			const std::vector<Vertex>&       vertices,
+			const std::vector<unsigned int>& indices,
+			std::vector<MeshLod>&            out_lods,
+			int                              max_levels = 3,
+			const std::string&               model_name = "unknown"
+		);
+
+		/**
+		 * @brief Splits a mesh into meshlets and computes their bounding spheres and normal cones.
+		 * Each meshlet's triangles are reordered for locality, but the mesh's own buffers are not touched.
+		 */
+		static void BuildMeshlets(
+			const std::vector<Vertex>&       vertices,
+			const std::vector<unsigned int>& indices,
+			MeshletData&                     out
+		);
+
+		/**
+		 * @brief Packs vertices into the compressed streams of VertexFormat::Packed.
+		 * Positions become half floats, so the mesh is rejected when that loses more than
+		 * max_position_error of its largest AABB extent, as it does far from its origin.
+		 * Bone ids must be below PackedSkin::kNoBone.
+		 * @return false if the vertices cannot be packed within those limits; out is then unspecified
+		 */
+		static bool PackVertices(
+			const std::vector<Vertex>& vertices,
+			PackedVertexData&          out,
+			float                      max_position_error = 1.0f / 1024.0f
+		);
+
+		/**
+		 * @brief Decodes packed streams back to vertices, as the GPU reads them.
+		 */
+		static void UnpackVertices(const PackedVertexData& packed, std::vector<Vertex>& out_vertices);
+
+		/**
+		 * @brief The vertex format new model and procedural meshes get (`packed_vertex_format_enabled`).
+		 */
+		static VertexFormat ConfiguredVertexFormat();
 	};
 
 } // namespace Boidsish
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Boidsish {
+
+	/**
+	 * @brief A cluster of up to MeshletData::kMaxTriangles triangles with its culling bounds.
+	 * Layout matches std430 so the array can be uploaded as is.
+	 */
+	struct Meshlet {
+		glm::vec3 center; // Bounding sphere, mesh space
+		float     radius;
+		glm::vec3 cone_apex;   // Normal cone, tested as in ClusterCuller
+		float     cone_cutoff; // 1 when the triangles face too many ways to ever be culled
+		glm::vec3 cone_axis;
+		uint32_t  triangle_count;
+		uint32_t  vertex_offset;   // Into MeshletData::vertices
+		uint32_t  triangle_offset; // Into MeshletData::triangles
+		uint32_t  vertex_count;
+		uint32_t  padding = 0;
+	};
+
+	static_assert(sizeof(Meshlet) == 64);
+
+	/**
+	 * @brief The meshlets of one mesh.
+	 */
+	struct MeshletData {
+		static constexpr size_t kMaxVertices = 64;
+		static constexpr size_t kMaxTriangles = 124;
+
+		std::vector<Meshlet>  meshlets;
+		std::vector<uint32_t> vertices;  // Mesh vertex indices, kMaxVertices at most per meshlet
+		std::vector<uint8_t>  triangles; // Meshlet-local vertex indices, three per triangle
+
+		bool empty() const { return meshlets.empty(); }
+
+		size_t ByteSize() const {
+			return meshlets.size() * sizeof(Meshlet) + vertices.size() * sizeof(uint32_t) + triangles.size();
+		}
+	};
+
+} // namespace Boidsish
@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include "meshlet.h"
+#include "packed_vertex.h"
 #include "shape.h"
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
@@ -30,6 +32,7 @@ namespace Boidsish {
 		std::vector<unsigned int> indices;
 		std::vector<unsigned int> shadow_indices;
 		std::vector<Texture>      textures;
+		std::vector<MeshLod>      lods; // Coarser levels, finest first, uploaded after the shadow indices
 
 		// Material Data
 		glm::vec3 diffuseColor = glm::vec3(1.0f);
@@ -45,7 +48,9 @@ namespace Boidsish {
 			std::vector<Vertex>       vertices,
 			std::vector<unsigned int> indices,
 			std::vector<Texture>      textures,
-			std::vector<unsigned int> shadow_indices = {}
+			std::vector<unsigned int> shadow_indices = {},
+			std::vector<MeshLod>      lods = {},
+			VertexFormat              vertex_format = VertexFormat::Full
 		);
 
 		// Copying meshes should not copy GPU handles
@@ -72,15 +77,40 @@ namespace Boidsish {
 
 		unsigned int getShadowEBO() const { return shadow_EBO; }
 
+		VertexFormat GetVertexFormat() const { return vertex_format; }
+
+		/// Draw ranges of the full mesh and each LOD as uploaded; empty until the LODs are on the GPU
+		const std::vector<LodRange>& GetLodRanges() const { return lod_ranges; }
+
+		/**
+		 * @brief Selects the GPU vertex layout, re-uploading the mesh if it has its own buffers.
+		 * Packed meshes keep their own buffers instead of the megabuffer; a mesh that cannot be
+		 * packed (see MeshOptimizerUtil::PackVertices) is uploaded as Full. Static megabuffer
+		 * allocations can't be freed, so a mesh already in the megabuffer keeps its format. Pass
+		 * the format to the constructor where it is known up front, so the mesh uploads once.
+		 */
+		void SetVertexFormat(VertexFormat format);
+
+		/// Bytes the mesh's vertices take on the GPU in its format; packs them to find out
+		size_t GetVertexBytes() const;
+
 		MegabufferAllocation allocation;
 		MegabufferAllocation shadow_allocation;
+		MegabufferAllocation lod_allocation;
 
 	private:
 		// Render data
-		unsigned int VAO = 0, VBO = 0, EBO = 0, shadow_EBO = 0;
+		unsigned int          VAO = 0, VBO = 0, EBO = 0, shadow_EBO = 0, skin_VBO = 0;
+		VertexFormat          vertex_format = VertexFormat::Full;
+		std::vector<LodRange> lod_ranges;
 
 		// Initializes all the buffer objects/arrays
 		void setupMesh(Megabuffer* megabuffer = nullptr);
+		void SetupPackedAttributes(const PackedVertexData& packed);
+		// Every LOD's indices back to back, setting each first_index relative to the result
+		std::vector<unsigned int> ConcatenateLods();
+		// Fills lod_ranges once the LODs are uploaded; first_index is where the full mesh starts
+		void BuildLodRanges(uint32_t first_index);
 
 		friend class Model;
 	};
@@ -182,6 +212,9 @@ namespace Boidsish {
 		std::string          model_path;
 		AABB                 aabb;
 
+		// Meshlets for cluster culling, parallel to meshes; empty until BuildMeshlets()
+		std::vector<MeshletData> meshlets;
+
 		// Animation Data
 		std::map<std::string, BoneInfo> bone_info_map;
 		int                             bone_count = 0;
@@ -189,6 +222,12 @@ namespace Boidsish {
 		std::vector<Animation>          animations;
 		NodeData                        root_node;
 
+		// Bumped on structural edits to root_node/bone_info_map so animators recompile their skeleton
+		uint32_t skeleton_version = 0;
+
+		// Rebuilds meshlets from the current meshes
+		void BuildMeshlets();
+
 		void AddBone(const std::string& name, const std::string& parentName, const glm::mat4& localTransform) {
 			if (bone_info_map.find(name) != bone_info_map.end())
 				return;
@@ -234,6 +273,7 @@ namespace Boidsish {
 			}
 			info.offset = glm::inverse(parentGlobal * localTransform);
 			bone_info_map[name] = info;
+			++skeleton_version;
 		}
 	};
 
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "packed_vertex.h"
+
+namespace Boidsish {
+
+	struct ModelData;
+
+	/**
+	 * @brief Versioned binary snapshot of an imported ModelData.
+	 *
+	 * Vertex, index and shadow-index arrays are stored in their in-memory layout (the same
+	 * layout the VBO/EBO upload uses), 16-byte aligned, so loading is an mmap followed by one
+	 * bulk copy per array instead of an Assimp import. Meshlets, bones, the node hierarchy and
+	 * animation keys follow the same scheme. Embedded textures are stored as their encoded payloads and
+	 * handed to the texture resolver straight from the mapping.
+	 *
+	 * A cache file is only valid for the machine layout and import settings that wrote it:
+	 * the header records struct sizes, the source file's size and modification time, and a
+	 * hash of the import options. Any mismatch makes Read() fail so the caller re-imports.
+	 */
+	class ModelCache {
+	public:
+		static constexpr uint32_t kMagic = 0x4C444D42; // "BMDL"
+		static constexpr uint32_t kVersion = 3;
+
+		struct EmbeddedTexture {
+			std::string                key; // Material texture path as referenced by the meshes
+			uint32_t                   width = 0;
+			uint32_t                   height = 0; // 0 if `bytes` holds a compressed image of `width` bytes
+			std::vector<unsigned char> bytes;
+		};
+
+		struct TextureSource {
+			const std::string&   type;
+			const std::string&   path;
+			const unsigned char* embedded = nullptr; // Points into the mapped file, valid during the call
+			size_t               embedded_size = 0;
+			uint32_t             width = 0;
+			uint32_t             height = 0;
+		};
+
+		/// Creates the texture for a cached mesh texture reference. Returning false drops the reference.
+		using TextureResolver = std::function<bool(const TextureSource& source, unsigned int& texture_id)>;
+
+		/**
+		 * @brief Default cache location for a source model, under model_cache/.
+		 */
+		static std::string CachePathFor(const std::string& source_path);
+
+		/**
+		 * @brief Writes the cache for a model imported from source_path.
+		 * @param options_hash Hash of the import settings the data was produced with
+		 * @return true if the file was written (atomically, via a temporary file)
+		 */
+		static bool Write(
+			const ModelData&                    data,
+			const std::vector<EmbeddedTexture>& embedded_textures,
+			const std::string&                  source_path,
+			uint64_t                            options_hash,
+			const std::string&                  cache_path
+		);
+
+		/**
+		 * @brief Loads a cache file if it is current for source_path and options_hash.
+		 * Meshes are created with vertex_format, so they upload once in that layout.
+		 * @return The model, or nullptr if the cache is missing, stale or corrupt
+		 */
+		static std::shared_ptr<ModelData> Read(
+			const std::string&     cache_path,
+			const std::string&     source_path,
+			uint64_t               options_hash,
+			const TextureResolver& resolve_texture,
+			VertexFormat           vertex_format = VertexFormat::Full
+		);
+	};
+
+} // namespace Boidsish
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Boidsish {
+
+	/**
+	 * @brief GPU vertex layout of a mesh.
+	 *
+	 * Full uploads `Vertex` as is (76 bytes) and can share the megabuffer. Packed uploads a
+	 * `PackedVertex` stream plus a `PackedSkin` stream (one constant element for unskinned
+	 * meshes), in buffers of the mesh's own. Both decode to the same shader inputs, so shaders need no variants.
+	 */
+	enum class VertexFormat : uint8_t { Full = 0, Packed = 1 };
+
+	/**
+	 * @brief Compressed static vertex attributes, 20 bytes.
+	 */
+	struct PackedVertex {
+		uint16_t position[4];   // Half floats, w unused
+		uint32_t normal;        // Snorm 2_10_10_10_REV, xyz
+		uint16_t tex_coords[2]; // Unorm16, or half floats when the mesh's UVs leave [0, 1]
+		uint8_t  color[4];      // Unorm8 rgb, a = 255
+	};
+
+	static_assert(sizeof(PackedVertex) == 20);
+
+	/**
+	 * @brief Bone influences of a packed vertex, 8 bytes.
+	 */
+	struct PackedSkin {
+		uint8_t bone_ids[4]; // kNoBone for unused slots
+		uint8_t weights[4];  // Unorm8
+
+		static constexpr uint8_t kNoBone = 0xFF;
+	};
+
+	static_assert(sizeof(PackedSkin) == 8);
+
+	/**
+	 * @brief The packed streams of one mesh.
+	 */
+	struct PackedVertexData {
+		std::vector<PackedVertex> vertices;
+		std::vector<PackedSkin>   skin; // Empty if no vertex has a bone influence
+		bool                      half_tex_coords = false;
+
+		size_t ByteSize() const { return vertices.size() * sizeof(PackedVertex) + skin.size() * sizeof(PackedSkin); }
+	};
+
+} // namespace Boidsish
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
+#include "collision.h"
 #include "shape.h"
 #include "vector.h"
 #include <GL/glew.h>
@@ -22,6 +24,15 @@ namespace Boidsish {
 		float     new_t;
 	};
 
+	// Per-entity traversal state for Path::CalculateUpdates
+	struct PathFollower {
+		Vector3 position;
+		int     segment_index;
+		float   t; // Fraction of the segment's arc length covered, like PathUpdateResult::new_t
+		int     direction;
+		float   speed;
+	};
+
 	class Path: public Shape, public std::enable_shared_from_this<Path> {
 	public:
 		struct Waypoint {
@@ -57,10 +68,14 @@ namespace Boidsish {
 			waypoints_.emplace_back(Waypoint{pos, up.Normalized(), size, r, g, b, a});
 			// Mark buffers as dirty to force recalculation
 			buffers_initialized_ = false;
+			segments_dirty_ = true;
 			MarkDirty();
 			return waypoints_.back();
 		}
 
+		// Advances a follower by path_speed * delta_time along the spline's arc length, so the speed
+		// is constant regardless of waypoint spacing. current_t and new_t are the fraction of the
+		// segment's arc length covered, not the spline parameter.
 		PathUpdateResult CalculateUpdate(
 			const Vector3&   current_position,
 			const glm::quat& current_orientation,
@@ -71,13 +86,27 @@ namespace Boidsish {
 			float            delta_time
 		) const;
 
-		glm::vec3 FindClosestPoint(const Vector3& point) const;
+		// Advances every follower on this path in one pass; out must be as large as followers.
+		void CalculateUpdates(
+			std::span<const PathFollower> followers,
+			float                         delta_time,
+			std::span<PathUpdateResult>   out
+		) const;
+
+		// Returns the point on the spline closest to `point`. Callers that query repeatedly, such as
+		// constrained entities, can pass the segment found last time as `segment_hint` (-1 if none);
+		// the search starts there and the hint is updated to the segment of the result.
+		glm::vec3 FindClosestPoint(const Vector3& point, int* segment_hint = nullptr) const;
+
+		// Arc length of the whole spline
+		float GetLength() const;
 
 		PathMode GetMode() const { return mode_; }
 
 		void SetMode(PathMode mode) {
 			mode_ = mode;
 			buffers_initialized_ = false;
+			segments_dirty_ = true;
 			MarkDirty();
 		}
 
@@ -85,11 +114,58 @@ namespace Boidsish {
 
 		void SetVisible(bool visible) { visible_ = visible; }
 
-		std::vector<Waypoint>& GetWaypoints() { return waypoints_; }
+		// Waypoints may be edited through the returned reference, so the segment cache is rebuilt
+		std::vector<Waypoint>& GetWaypoints() {
+			segments_dirty_ = true;
+			return waypoints_;
+		}
 
 		const std::vector<Waypoint>& GetWaypoints() const { return waypoints_; }
 
 	private:
+		// A Catmull-Rom segment as the cubic a + b t + c t^2 + d t^3, with its exact bounds and
+		// the arc length of the path up to its start
+		struct Segment {
+			glm::vec3 a, b, c, d;
+			AABB      bounds;
+			float     arc_start;
+			float     arc_length;
+
+			glm::vec3 Evaluate(float t) const { return a + t * (b + t * (c + t * d)); }
+
+			glm::vec3 Derivative(float t) const { return b + t * (2.0f * c + 3.0f * t * d); }
+
+			float Speed(float t) const { return glm::length(Derivative(t)); }
+		};
+
+		// Arc length table: the distance from the segment start and the speed at kArcSamples + 1
+		// evenly spaced parameters per segment, for mapping distance travelled to the parameter
+		static constexpr int kArcSamples = 16;
+
+		struct ArcSample {
+			float distance;
+			float speed;
+		};
+
+		// Node of the segment BVH. Leaves have count > 0 and cover segments [first, first + count);
+		// inner nodes have count == 0 and their children at first and first + 1.
+		struct SegmentNode {
+			AABB bounds;
+			int  first;
+			int  count;
+		};
+
+		void RebuildSegments() const;
+		void BuildSegmentNode(int node, int begin, int end) const;
+
+		// Spline parameter at the given arc length from the start of the segment
+		float SegmentParameter(int segment, float distance) const;
+
+		PathUpdateResult Advance(const PathFollower& follower, float delta_time) const;
+
+		// Closest point on one segment, refined with Newton's method from the best coarse sample
+		static float ClosestOnSegment(const Segment& segment, const glm::vec3& point, glm::vec3& closest);
+
 		std::vector<Waypoint> waypoints_;
 		PathMode              mode_ = PathMode::ONCE;
 		bool                  visible_ = false;
@@ -100,6 +176,12 @@ namespace Boidsish {
 		mutable bool                 buffers_initialized_ = false;
 		mutable std::vector<Vector3> cached_waypoint_positions_;
 		mutable MegabufferAllocation allocation_;
+
+		mutable bool                     segments_dirty_ = true;
+		mutable std::vector<Segment>     segments_;
+		mutable std::vector<SegmentNode> segment_nodes_;
+		mutable std::vector<ArcSample>   arc_table_;
+		mutable float                    length_ = 0.0f;
 	};
 
 	class PathHandler {
@@ -47,6 +47,7 @@ namespace Boidsish {
 		void PrepareResources(Megabuffer* megabuffer = nullptr) const override;
 
 		MeshInfo GetMeshInfo(Megabuffer* megabuffer = nullptr) const override;
+		bool     IsMeshInstanceable() const override { return true; }
 		bool     ShouldDisableCulling() const override;
 
 		static void InitPolyhedronMesh(PolyhedronType type, Megabuffer* megabuffer = nullptr);
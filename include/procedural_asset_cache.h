@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "procedural_generator.h"
+
+namespace Boidsish {
+
+	struct ModelData;
+
+	/**
+	 * @brief Disk cache of meshed procedural models.
+	 *
+	 * Procedural decor is regenerated from fixed seeds on every launch, so the meshed result is
+	 * stored with ModelCache and keyed by generator type, seed, a hash of everything else that
+	 * shapes the output (the type's default config and the mesh settings), and kGeneratorVersion.
+	 * Load() and Store() touch no GL state and may be called from worker threads.
+	 */
+	class ProceduralAssetCache {
+	public:
+		// Bump whenever a generator, the refiner or the mesher changes its output
+		static constexpr uint32_t kGeneratorVersion = 2;
+
+		explicit ProceduralAssetCache(std::string directory = "model_cache/procedural");
+
+		/**
+		 * @brief Hash of the configuration Generate(type, seed, config) builds a model with.
+		 *
+		 * Reads the mesh settings through ConfigManager, which registers them on first use. Call it
+		 * on the main thread before generating on workers, so that they only look the settings up.
+		 */
+		static uint64_t ConfigHash(ProceduralType type, const GeneratorConfig& config = {});
+
+		std::string PathFor(ProceduralType type, unsigned int seed, uint64_t config_hash) const;
+
+		/**
+		 * @brief Reads a cached model.
+		 * @return The model data without GL resources, or nullptr if it is missing or stale
+		 */
+		std::shared_ptr<ModelData> Load(ProceduralType type, unsigned int seed, uint64_t config_hash) const;
+
+		bool Store(const ModelData& data, ProceduralType type, unsigned int seed, uint64_t config_hash) const;
+
+	private:
+		std::string directory_;
+	};
+
+} // namespace Boidsish
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "miniaudio.h"
+#include "audio_dsp.h"
 #include "audio_types.h"
 #include <vector>
 
@@ -15,7 +16,8 @@ namespace Boidsish {
 		ProceduralAudioSource(const ProceduralAudioSource&) = delete;
 		ProceduralAudioSource& operator=(const ProceduralAudioSource&) = delete;
 
-		virtual void OnRead(float* pOutput, ma_uint64 frameCount) = 0;
+		// Renders planar blocks of up to dsp::kBlockFrames through OnRenderBlock and interleaves them
+		virtual void OnRead(float* pOutput, ma_uint64 frameCount);
 		virtual void OnUpdate(float deltaTime, const AudioState& state) {}
 
 		ma_data_source* GetDataSource() { return &m_base.ds; }
@@ -30,9 +32,15 @@ namespace Boidsish {
 		};
 
 	protected:
-		MiniaudioSource m_base;
-		ma_uint32       m_channels;
-		ma_uint32       m_sampleRate;
+		// Fills up to m_channels planes of frameCount samples and returns how many it wrote.
+		// A single plane is copied to every channel; returning zero outputs silence.
+		virtual ma_uint32 OnRenderBlock(float* const* pPlanes, ma_uint32 frameCount) { return 0; }
+
+		MiniaudioSource     m_base;
+		ma_uint32           m_channels;
+		ma_uint32           m_sampleRate;
+		std::vector<float>  m_planarBuffer; // Allocated up front, OnRead runs on the audio thread
+		std::vector<float*> m_planes;
 	};
 
 } // namespace Boidsish
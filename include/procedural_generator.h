@@ -2,6 +2,7 @@
 
 #include <map>
 #include <memory>
+#include <span>
 #include <stack>
 #include <string>
 #include <vector>
@@ -11,6 +12,7 @@
 
 namespace Boidsish {
 
+	class ProceduralAssetCache;
 	class Visualizer;
 
 	enum class ProceduralType {
@@ -39,9 +41,39 @@ namespace Boidsish {
 		int   max_branches = 3;
 	};
 
+	struct SpaceColonizationConfig {
+		float attractor_density = 1.0f; // Scales the number of attractors each tree variant places
+		int   max_iterations = 200;
+	};
+
+	// Growth settings for Generate(); types without a config of their own ignore it
+	struct GeneratorConfig {
+		SpringPlantConfig       spring_plant;
+		SpaceColonizationConfig space_colonization;
+	};
+
 	class ProceduralGenerator {
 	public:
-		static std::shared_ptr<Model> Generate(ProceduralType type, unsigned int seed);
+		static std::shared_ptr<Model>
+		Generate(ProceduralType type, unsigned int seed, const GeneratorConfig& config = {});
+
+		/**
+		 * @brief Generates one model per seed on the thread pool.
+		 *
+		 * Variants found in the cache are loaded instead of generated, and generated ones are
+		 * written to it. Models come back without GL resources; they are uploaded on the main
+		 * thread by PrepareResources, as for any other model.
+		 *
+		 * @param cache Disk cache to read and fill, or nullptr to always generate
+		 * @param config Growth settings every variant is generated with
+		 * @return Models in seed order
+		 */
+		static std::vector<std::shared_ptr<Model>> GenerateVariants(
+			ProceduralType                type,
+			std::span<const unsigned int> seeds,
+			const ProceduralAssetCache*   cache = nullptr,
+			const GeneratorConfig&        config = {}
+		);
 
 		static std::shared_ptr<Model> GenerateRock(unsigned int seed);
 		static std::shared_ptr<Model> GenerateGrass(unsigned int seed);
@@ -57,7 +89,8 @@ namespace Boidsish {
 			const std::vector<std::string>& rules = {},
 			int                             iterations = 3
 		);
-		static std::shared_ptr<Model> GenerateSpaceColonizationTree(unsigned int seed);
+		static std::shared_ptr<Model>
+		GenerateSpaceColonizationTree(unsigned int seed, const SpaceColonizationConfig& config = {});
 		static std::shared_ptr<Model> GenerateSpringPlant(unsigned int seed, const SpringPlantConfig& config = {});
 		static std::shared_ptr<Model> GenerateCritter(
 			unsigned int                    seed,
@@ -79,7 +112,8 @@ namespace Boidsish {
 			const std::vector<std::string>& rules = {},
 			int                             iterations = 3
 		);
-		static ProceduralIR GenerateSpaceColonizationTreeIR(unsigned int seed);
+		static ProceduralIR
+		GenerateSpaceColonizationTreeIR(unsigned int seed, const SpaceColonizationConfig& config = {});
 		static ProceduralIR GenerateSpringPlantIR(unsigned int seed, const SpringPlantConfig& config = {});
 		static ProceduralIR GenerateCritterIR(
 			unsigned int                    seed,
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 
+#include "animation_crowd.h"
 #include "model.h"
 #include "procedural_ir.h"
 #include <glm/glm.hpp>
@@ -26,6 +27,14 @@ namespace Boidsish {
 
 		void SetTarget(const glm::vec3& target) { target_pos_ = target; }
 
+		/**
+		 * @brief Hands pose evaluation to a crowd, e.g. Visualizer::GetAnimationCrowd().
+		 * Update() then only solves IK and the crowd evaluates the pose in its next Update.
+		 * The crowd holds the model weakly, so destroying the creature leaves it. Pass nullptr
+		 * to evaluate on Update() again.
+		 */
+		void SetAnimationCrowd(AnimationCrowd* crowd);
+
 	private:
 		struct Leg {
 			std::string name;
@@ -45,6 +54,8 @@ namespace Boidsish {
 
 		std::vector<Leg>       legs_;
 		std::shared_ptr<Model> model_;
+		AnimationCrowd*        crowd_ = nullptr;
+		AnimationCrowd::Handle crowd_handle_ = 0;
 
 		glm::vec3 current_pos_;
 		float     current_yaw_ = 0.0f;
@@ -12,20 +12,26 @@ namespace Boidsish {
 		RainAudioEffect(AudioManager& audioManager);
 		virtual ~RainAudioEffect() = default;
 
-		void OnRead(float* pOutput, ma_uint64 frameCount) override;
 		void OnUpdate(float deltaTime, const AudioState& state) override;
 
+	protected:
+		ma_uint32 OnRenderBlock(float* const* pPlanes, ma_uint32 frameCount) override;
+
 	private:
 		AudioManager& m_audioManager;
 
-		uint32_t m_xorshiftState;
-		float NextWhiteNoise();
+		dsp::NoiseGenerator m_noise;
 
 		std::atomic<float> m_intensity{0.0f};
 
 		// Filter state
-		float m_lowWash = 0.0f;
-		float m_lowPatter = 0.0f;
+		dsp::OnePoleFilter m_wash;
+		dsp::OnePoleFilter m_patter;
+
+		// Block scratch (audio thread only)
+		float    m_white[dsp::kBlockFrames];
+		uint32_t m_bits[dsp::kBlockFrames];
+		float    m_drops[dsp::kBlockFrames];
 	};
 
 } // namespace Boidsish
@@ -21,6 +21,7 @@ namespace Boidsish {
 		Frustum            frustum;
 		const ShaderTable* shader_table = nullptr;
 		Megabuffer*        megabuffer = nullptr;
+		float              lod_screen_error = 0.0f; // Fraction of the viewport height; 0 keeps full detail
 
 		// Optional: helper to project a world position to screen space or calculate depth
 		float CalculateNormalizedDepth(const glm::vec3& world_pos) const {
@@ -12,21 +12,22 @@ namespace Boidsish {
 		RustleAudioEffect(AudioManager& audioManager);
 		virtual ~RustleAudioEffect() = default;
 
-		void OnRead(float* pOutput, ma_uint64 frameCount) override;
 		void OnUpdate(float deltaTime, const AudioState& state) override;
 
+	protected:
+		ma_uint32 OnRenderBlock(float* const* pPlanes, ma_uint32 frameCount) override;
+
 	private:
 		AudioManager& m_audioManager;
 
-		uint32_t m_xorshiftState;
-		float NextWhiteNoise();
+		dsp::NoiseGenerator m_noise;
 		float timeStep{0.0f};
 
 		std::atomic<float> m_gain{0.0f};
 		std::atomic<float> m_lowPassAlpha{0.1f};
 
 		// Filter state
-		float m_low = 0.0f;
+		dsp::OnePoleFilter m_filter;
 	};
 
 } // namespace Boidsish
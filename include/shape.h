@@ -360,6 +360,13 @@ namespace Boidsish {
 		 */
 		virtual MeshInfo GetMeshInfo(Megabuffer* megabuffer = nullptr) const;
 
+		/**
+		 * @brief Whether render(shader, model_matrix) draws exactly GetMeshInfo() with the shape's
+		 * flat color and material, so copies can be drawn instanced from it (see CloneManager).
+		 * Shapes that override render or OnPreRender must leave this false.
+		 */
+		virtual bool IsMeshInstanceable() const { return false; }
+
 		/**
 		 * @brief Determines if backface culling should be disabled for this shape.
 		 */
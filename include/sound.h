@@ -19,7 +19,9 @@ namespace Boidsish {
 			float              volume = 1.0f,
 			bool               spatialized = true,
 			const glm::vec3&   position = {0, 0, 0},
-			ma_sound_group*    group = nullptr
+			ma_sound_group*    group = nullptr,
+			ma_uint32          flags = 0,
+			bool               start = true
 		);
 		Sound(
 			ma_engine*                            engine,
@@ -44,6 +46,13 @@ namespace Boidsish {
 		void SetLooping(bool loop);
 		bool IsDone();
 
+		bool IsValid() const { return _initialized; }
+
+		float GetLengthSeconds() const;
+
+		// Seek and start; used to restart a pooled voice without re-initializing it
+		void Play(float start_seconds = 0.0f);
+
 		void Stop();
 
 	private:
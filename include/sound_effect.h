@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string>
 
 #include <glm/glm.hpp>
 
@@ -8,29 +10,55 @@ namespace Boidsish {
 
 	class Sound; // Forward declaration
 
+	/**
+	 * @brief A positional one-shot or looping sound owned by SoundEffectManager.
+	 *
+	 * Effects are virtual voices: the manager only attaches a pooled Sound while the effect is
+	 * among the most audible ones. A virtual effect keeps its position and playback time, so it
+	 * resumes at the right point when it becomes audible again.
+	 */
 	class SoundEffect {
 	public:
 		SoundEffect(
-			std::shared_ptr<Sound> sound_handle,
-			const glm::vec3&       position,
-			const glm::vec3&       velocity = glm::vec3(0.0f),
-			float                  lifetime = -1.0f
+			const std::string& filepath,
+			const glm::vec3&   position,
+			const glm::vec3&   velocity = glm::vec3(0.0f),
+			float              volume = 1.0f,
+			bool               loop = false,
+			float              lifetime = -1.0f,
+			int                priority = 0
 		);
 
 		void SetPosition(const glm::vec3& pos);
 
 		void SetVelocity(const glm::vec3& vel) { velocity_ = vel; }
 
+		void SetVolume(float volume);
+
 		void SetActive(bool active) { active_ = active; }
 
 		const glm::vec3& GetPosition() const { return position_; }
 
 		const glm::vec3& GetVelocity() const { return velocity_; }
 
+		const std::string& GetFilepath() const { return filepath_; }
+
+		float GetVolume() const { return volume_; }
+
+		bool IsLooping() const { return loop_; }
+
+		int GetPriority() const { return priority_; }
+
 		int GetId() const { return id_; }
 
 		bool IsActive() const { return active_; }
 
+		// True while the effect is tracked but not mixed
+		bool IsVirtual() const { return !sound_handle_; }
+
+		// Seconds since the effect started, whether or not it was audible
+		float GetPlaybackTime() const { return playback_time_; }
+
 		float GetLifetime() const { return lifetime_; }
 
 		void SetLifetime(float lifetime) { lifetime_ = lifetime; }
@@ -42,14 +70,24 @@ namespace Boidsish {
 		std::shared_ptr<Sound> GetSoundHandle() { return sound_handle_; }
 
 	private:
+		friend class SoundEffectManager;
+
 		inline static int      count = 1;
-		std::shared_ptr<Sound> sound_handle_;
+		std::shared_ptr<Sound> sound_handle_; // Pooled voice, null while virtual
+		std::string            filepath_;
 		glm::vec3              position_;
 		glm::vec3              velocity_;
+		float                  volume_;
+		bool                   loop_;
+		int                    priority_;
 		int                    id_;
 		bool                   active_{true};
 		float                  lifetime_ = -1.0f;
 		float                  lived_ = 0.0f;
+		float                  playback_time_ = 0.0f;
+		float                  length_ = 0.0f; // Source length in seconds
+		int                    voice_ = -1;    // Index into the manager's voice pool
+		uint64_t               audible_frame_ = 0; // Last manager frame that ranked it audible
 	};
 
 } // namespace Boidsish
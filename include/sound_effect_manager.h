@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "sound_effect.h"
@@ -12,10 +15,23 @@ namespace Boidsish {
 
 	class ServiceLocator;
 	class AudioManager; // Forward declaration
+	class Sound;
 
+	/**
+	 * @brief Plays positional sound effects through a fixed pool of reusable voices.
+	 *
+	 * Every effect is tracked, but only the most audible ones, up to the audible-voice budget,
+	 * are mixed. Effects are ranked by priority and then by volume over distance to the
+	 * listener. The others stay virtual until they rank high enough again. Voices keep their
+	 * decoded source when released, so replaying the same file restarts an idle voice instead
+	 * of creating a new sound.
+	 */
 	class SoundEffectManager {
 	public:
-		SoundEffectManager(ServiceLocator& loc);
+		static constexpr size_t kDefaultVoiceCount = 48;
+		static constexpr size_t kDefaultMaxAudibleVoices = 32;
+
+		SoundEffectManager(ServiceLocator& loc, size_t voice_count = kDefaultVoiceCount);
 		~SoundEffectManager();
 
 		std::shared_ptr<SoundEffect> AddEffect(
@@ -24,17 +40,45 @@ namespace Boidsish {
 			const glm::vec3&   velocity = glm::vec3(0.0f),
 			float              volume = 1.0f,
 			bool               loop = false,
-			float              lifetime = -1.0f
+			float              lifetime = -1.0f,
+			int                priority = 0
 		);
 
 		void RemoveEffect(const std::shared_ptr<SoundEffect>& effect);
 
 		void Update(float delta_time);
 
+		// Clamped to the voice pool size
+		void SetMaxAudibleVoices(size_t count);
+
+		size_t GetMaxAudibleVoices() const { return _max_audible; }
+
+		size_t GetEffectCount() const;
+
+		size_t GetAudibleCount() const;
+
 	private:
-		AudioManager*                             _audio_manager;
-		std::vector<std::shared_ptr<SoundEffect>> _effects;
-		mutable std::mutex                        _mutex;
+		struct Voice {
+			std::shared_ptr<Sound> sound;
+			std::string            filepath; // Source the sound was created for
+			SoundEffect*           owner = nullptr;
+			uint64_t               last_used = 0;
+		};
+
+		float Audibility(const SoundEffect& effect, const glm::vec3& listener) const;
+		bool  AttachVoice(SoundEffect& effect);
+		void  DetachVoice(SoundEffect& effect);
+		float SourceLength(const std::string& filepath);
+
+		AudioManager*                               _audio_manager;
+		std::vector<std::shared_ptr<SoundEffect>>   _effects;
+		std::vector<Voice>                          _voices;
+		std::unordered_map<std::string, float>      _source_lengths;
+		std::vector<std::pair<float, SoundEffect*>> _ranked; // Audibility and effect, per-frame scratch
+		size_t                                      _max_audible = kDefaultMaxAudibleVoices;
+		size_t                                      _audible_count = 0;
+		uint64_t                                    _frame = 0;
+		mutable std::mutex                          _mutex;
 	};
 
 } // namespace Boidsish
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+namespace Boidsish {
+
+	/**
+	 * @brief Uniform hash grid over indexed points, for radius and nearest-neighbour queries.
+	 *
+	 * Built for growth simulations: points are inserted as they are created and never move, or the
+	 * grid is cleared and refilled each step. Cells are keyed by their packed integer coordinates,
+	 * so the grid is unbounded. Queries visit every cell overlapping the query sphere; a cell size
+	 * close to the usual query radius keeps that to 27 cells.
+	 *
+	 * Radius tests are strict (distance < radius), and queries report points in a fixed order, so
+	 * callers get the same answers as a linear scan over the points in index order.
+	 */
+	class SpatialHashGrid {
+	public:
+		explicit SpatialHashGrid(float cell_size): cell_size_(cell_size), inv_cell_size_(1.0f / cell_size) {}
+
+		void Clear() {
+			for (auto& [key, cell] : cells_) {
+				cell.clear(); // Keeps the buckets and their capacity for refilling
+			}
+			size_ = 0;
+		}
+
+		void Insert(int index, const glm::vec3& position) {
+			cells_[Key(CellOf(position))].push_back({index, position});
+			++size_;
+		}
+
+		size_t GetSize() const { return size_; }
+
+		float GetCellSize() const { return cell_size_; }
+
+		/**
+		 * @brief Finds the point closest to a position within a radius.
+		 * @return The index of the closest point, the lowest index on ties, or -1 if none is in range
+		 */
+		int FindNearest(const glm::vec3& position, float radius) const {
+			int   nearest = -1;
+			float best = radius * radius;
+			ForEachWithin(position, radius, [&](int index, float distance_sq) {
+				if (distance_sq < best || (distance_sq == best && index < nearest)) {
+					best = distance_sq;
+					nearest = index;
+				}
+			});
+			return nearest;
+		}
+
+		bool AnyWithin(const glm::vec3& position, float radius) const {
+			return VisitWithin(position, radius, [](int, float) { return true; });
+		}
+
+		/**
+		 * @brief Calls fn(index, distance_sq) for every point strictly within radius of position.
+		 *
+		 * Points are visited cell by cell, in insertion order within a cell.
+		 */
+		template <typename F>
+		void ForEachWithin(const glm::vec3& position, float radius, F&& fn) const {
+			VisitWithin(position, radius, [&](int index, float distance_sq) {
+				fn(index, distance_sq);
+				return false;
+			});
+		}
+
+	private:
+		struct Entry {
+			int       index;
+			glm::vec3 position;
+		};
+
+		glm::ivec3 CellOf(const glm::vec3& position) const {
+			return glm::ivec3(glm::floor(position * inv_cell_size_));
+		}
+
+		static uint64_t Key(const glm::ivec3& cell) {
+			// 21 bits per axis, two's complement wrapped
+			constexpr uint64_t mask = (1ull << 21) - 1;
+			return (static_cast<uint64_t>(cell.x) & mask) | ((static_cast<uint64_t>(cell.y) & mask) << 21) |
+				((static_cast<uint64_t>(cell.z) & mask) << 42);
+		}
+
+		// Visits points within radius until visit returns true; returns whether it did
+		template <typename F>
+		bool VisitWithin(const glm::vec3& position, float radius, F&& visit) const {
+			if (size_ == 0) {
+				return false;
+			}
+			const float      radius_sq = radius * radius;
+			const glm::ivec3 lo = CellOf(position - glm::vec3(radius));
+			const glm::ivec3 hi = CellOf(position + glm::vec3(radius));
+			for (int x = lo.x; x <= hi.x; ++x) {
+				for (int y = lo.y; y <= hi.y; ++y) {
+					for (int z = lo.z; z <= hi.z; ++z) {
+						auto it = cells_.find(Key({x, y, z}));
+						if (it == cells_.end()) {
+							continue;
+						}
+						for (const Entry& entry : it->second) {
+							float distance_sq = glm::distance2(position, entry.position);
+							if (distance_sq < radius_sq && visit(entry.index, distance_sq)) {
+								return true;
+							}
+						}
+					}
+				}
+			}
+			return false;
+		}
+
+		float                                            cell_size_;
+		float                                            inv_cell_size_;
+		size_t                                           size_ = 0;
+		std::unordered_map<uint64_t, std::vector<Entry>> cells_;
+	};
+
+} // namespace Boidsish
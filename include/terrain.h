@@ -4,6 +4,8 @@
 
 #include "field.h"
 #include "shape.h"
+#include "terrain_chunk_data.h"
+#include "terrain_height_pyramid.h"
 #include <glm/glm.hpp>
 
 namespace Boidsish {
@@ -12,15 +14,7 @@ namespace Boidsish {
 
 	class Terrain: public Shape {
 	public:
-		Terrain(
-			const std::vector<unsigned int>& indices,
-			const std::vector<glm::vec3>&    vertices,
-			const std::vector<glm::vec3>&    normals,
-			const std::vector<glm::vec2>&    biomes,
-			const PatchProxy&                proxy,
-			std::vector<float>               packed_height_normal = {},
-			std::vector<uint8_t>             packed_biomes = {}
-		);
+		Terrain(TerrainChunkData surface, const PatchProxy& proxy);
 		~Terrain();
 
 		// Legacy per-chunk GPU setup (deprecated - use TerrainRenderManager instead)
@@ -38,12 +32,9 @@ namespace Boidsish {
 		static ShaderHandle            terrain_shader_handle;
 
 		// Public members for field calculations
-		PatchProxy             proxy;
-		std::vector<glm::vec3> vertices;
-		std::vector<glm::vec3> normals;
-		std::vector<glm::vec2> biomes;
-		std::vector<float>     packed_height_normal;
-		std::vector<uint8_t>   packed_biomes;
+		PatchProxy           proxy;
+		TerrainChunkData     surface;        // The chunk's only copy of its heights, normals and biomes
+		TerrainHeightPyramid height_pyramid; // Built with the chunk, used to accelerate raycasts
 
 		/**
 		 * @brief Get interleaved vertex data for batched rendering.
@@ -57,9 +48,11 @@ namespace Boidsish {
 		/**
 		 * @brief Get index data for batched rendering.
 		 *
+		 * A single quad patch over the chunk's four corner vertices.
+		 *
 		 * @return Index data
 		 */
-		const std::vector<unsigned int>& GetIndices() const { return indices_; }
+		std::vector<unsigned int> GetIndices() const;
 
 		/**
 		 * @brief Check if this chunk uses legacy per-chunk GPU resources.
@@ -74,9 +67,6 @@ namespace Boidsish {
 		bool IsManagedByRenderManager() const { return managed_by_render_manager_; }
 
 	private:
-		std::vector<float>        vertex_data_; // Interleaved for GPU
-		std::vector<unsigned int> indices_;
-
 		unsigned int vao_ = 0, vbo_ = 0, ebo_ = 0;
 		int          index_count_;
 
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Boidsish {
+
+	/**
+	 * @brief Compact, quantized surface of one terrain chunk.
+	 *
+	 * The single resident copy of a chunk's grid, shared by the CPU height queries and the
+	 * render manager's texture upload. Positions are implicit from the grid, so each vertex
+	 * stores only:
+	 * - height: 16 bits spanning [min_y, max_y] of the chunk
+	 * - normal: octahedral encoding, two snorm16 components in one word
+	 * - biome: low biome index in the low byte, blend weight * 255 in the high byte
+	 *
+	 * That is 8 bytes per vertex. All arrays are X-major: vertex (x, z) is at x * resolution + z.
+	 */
+	class TerrainChunkData {
+	public:
+		TerrainChunkData() = default;
+
+		/**
+		 * @brief Quantizes a chunk grid.
+		 * @param resolution Vertices along each chunk edge (chunk_size + 1)
+		 * @param cell_size World distance between neighbouring vertices
+		 * @param heights X-major heights, resolution^2 elements
+		 * @param normals X-major unit normals
+		 * @param biomes X-major (low biome index, blend weight) pairs
+		 */
+		TerrainChunkData(
+			int                        resolution,
+			float                      cell_size,
+			std::span<const float>     heights,
+			std::span<const glm::vec3> normals,
+			std::span<const glm::vec2> biomes
+		);
+
+		bool IsEmpty() const { return heights_.empty(); }
+
+		int GetResolution() const { return resolution_; }
+
+		float GetCellSize() const { return cell_size_; }
+
+		float GetMinY() const { return min_y_; }
+
+		float GetMaxY() const { return max_y_; }
+
+		float GetHeight(int x, int z) const { return min_y_ + heights_[Index(x, z)] * height_step_; }
+
+		// Chunk-local position of vertex (x, z)
+		glm::vec3 GetPosition(int x, int z) const { return glm::vec3(x * cell_size_, GetHeight(x, z), z * cell_size_); }
+
+		glm::vec3 GetNormal(int x, int z) const { return DecodeNormal(normals_[Index(x, z)]); }
+
+		glm::vec2 GetBiome(int x, int z) const {
+			uint16_t biome = biomes_[Index(x, z)];
+			return glm::vec2(static_cast<float>(biome & 0xff), static_cast<float>(biome >> 8) / 255.0f);
+		}
+
+		// All heights, X-major, for building the chunk's height pyramid
+		std::vector<float> GetHeights() const;
+
+		/**
+		 * @brief Expands the chunk into the renderer's texture layouts.
+		 *
+		 * Both outputs are Z-major (row z holds x = 0..resolution - 1), matching the heightmap
+		 * and biome texture array slices. The vectors are resized, so callers can reuse them.
+		 *
+		 * @param height_normal RGBA float texels: height, normal.xyz
+		 * @param biomes RGBA8 texels: low biome index, blend weight, bake flag (0), unused
+		 */
+		void Unpack(std::vector<float>& height_normal, std::vector<uint8_t>& biomes) const;
+
+		// Resident bytes of the quantized arrays
+		size_t GetMemoryUsage() const;
+
+		static uint32_t  EncodeNormal(const glm::vec3& normal);
+		static glm::vec3 DecodeNormal(uint32_t encoded);
+
+	private:
+		size_t Index(int x, int z) const { return static_cast<size_t>(x) * resolution_ + z; }
+
+		int                   resolution_ = 0;
+		float                 cell_size_ = 1.0f;
+		float                 min_y_ = 0.0f;
+		float                 max_y_ = 0.0f;
+		float                 height_step_ = 0.0f; // (max_y - min_y) / 65535
+		std::vector<uint16_t> heights_;
+		std::vector<uint32_t> normals_;
+		std::vector<uint16_t> biomes_;
+	};
+
+} // namespace Boidsish
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <optional>
@@ -25,16 +26,12 @@ namespace Boidsish {
 namespace Boidsish {
 
 	struct TerrainGenerationResult {
-		std::vector<unsigned int> indices;
-		std::vector<glm::vec3>    positions;
-		std::vector<glm::vec3>    normals;
-		std::vector<glm::vec2>    biomes;
-		std::vector<float>        packed_height_normal;
-		std::vector<uint8_t>      packed_biomes;
-		PatchProxy                proxy;
-		int                       chunk_x;
-		int                       chunk_z;
-		bool                      has_terrain;
+		TerrainChunkData     surface;
+		PatchProxy           proxy;
+		int                  chunk_x;
+		int                  chunk_z;
+		bool                 has_terrain;
+		TerrainHeightPyramid height_pyramid;
 	};
 
 	class TerrainGenerator: public ITerrainGenerator {
@@ -49,6 +46,10 @@ namespace Boidsish {
 		const std::vector<std::shared_ptr<Terrain>>& GetVisibleChunks() const override;
 		std::vector<std::shared_ptr<Terrain>>        GetVisibleChunksCopy() const override;
 
+		std::shared_ptr<Terrain> GetResidentChunk(std::pair<int, int> chunk_key) const override {
+			return FindCachedChunk(chunk_key.first, chunk_key.second);
+		}
+
 		// Legacy method names for compatibility (call the interface methods)
 		void update(const Frustum& frustum, const Camera& camera) { Update(frustum, camera); }
 
@@ -188,6 +189,22 @@ namespace Boidsish {
 			glm::vec3&       out_normal
 		) const override;
 
+		/**
+		 * @brief Batched cache-preferring height/normal queries.
+		 *
+		 * Queries are sorted by chunk, every chunk is resolved once under a single lock, and
+		 * the per-chunk groups are evaluated in parallel on the shared pool, or serially when
+		 * called from a pool task. Results are identical to GetTerrainPropertiesAtPoint.
+		 */
+		void GetTerrainPropertiesBatch(std::span<const glm::vec2> points, std::span<TerrainSample> out) const override;
+
+		void GetDistanceAboveTerrainBatch(std::span<const glm::vec3> points, std::span<float> out) const override;
+
+		/**
+		 * @brief Batched RaycastCached, grouped by the chunk each ray starts in and run in parallel.
+		 */
+		void RaycastBatch(std::span<const TerrainRay> rays, std::span<TerrainRayHit> out) const override;
+
 		/**
 		 * @brief Check if a world position is within the currently cached terrain area.
 		 *
@@ -281,12 +298,34 @@ namespace Boidsish {
 		void ProcessPendingDeformations();
 
 	private:
+		using ChunkTable = std::map<std::pair<int, int>, std::shared_ptr<Terrain>>;
+
 		void      ProcessCompletedChunks();
+		void      PublishChunkSnapshot();
 		glm::vec2 findClosestPointOnPath(glm::vec2 sample_pos) const;
 		glm::vec3 getPathInfluence(float x, float z) const;
 
-		// Helper for cache-based interpolation
+		// A run of batched queries that fall in the same chunk
+		struct ChunkQueryGroup {
+			int                      chunk_x;
+			int                      chunk_z;
+			size_t                   begin; // Range into the sorted query order
+			size_t                   end;
+			std::shared_ptr<Terrain> terrain; // Null if the chunk is not cached
+		};
+
+		std::vector<ChunkQueryGroup>
+		GroupQueriesByChunk(std::span<const glm::vec2> positions, std::vector<uint32_t>& order) const;
+
+		std::shared_ptr<const ChunkTable> LoadChunkSnapshot() const {
+			return chunk_snapshot_.load(std::memory_order_acquire);
+		}
+
+		// Helpers for cache-based interpolation
 		std::optional<std::tuple<float, glm::vec3>> InterpolateFromCachedChunk(float x, float z) const;
+		std::shared_ptr<Terrain>                    FindCachedChunk(int chunk_x, int chunk_z) const;
+		std::optional<std::tuple<float, glm::vec3>>
+		SampleCachedChunk(const Terrain& terrain, int chunk_x, int chunk_z, float x, float z) const;
 
 		// Phong tessellation helpers (matching the shader)
 		glm::vec3 projectPointOnPlane(glm::vec3 q, glm::vec3 v, glm::vec3 n) const {
@@ -343,7 +382,7 @@ namespace Boidsish {
 
 		// Cache and async management
 		ThreadPool                                                         thread_pool_;
-		std::map<std::pair<int, int>, std::shared_ptr<Terrain>>            chunk_cache_;
+		ChunkTable                                                         chunk_cache_;
 		std::vector<std::shared_ptr<Terrain>>                              visible_chunks_;
 		std::map<std::pair<int, int>, TaskHandle<TerrainGenerationResult>> pending_chunks_;
 
@@ -357,6 +396,11 @@ namespace Boidsish {
 		std::random_device           rd_;
 		std::mt19937                 eng_;
 
+		// Immutable copy of chunk_cache_ that height queries read without locking. The writer marks
+		// chunk_cache_ dirty on insert/evict/regenerate and republishes at most once per Update.
+		std::atomic<std::shared_ptr<const ChunkTable>> chunk_snapshot_{std::make_shared<const ChunkTable>()};
+		bool                                           chunk_snapshot_dirty_ = false;
+
 		// Instanced terrain render manager (optional, when set uses GPU heightmap lookup)
 		std::shared_ptr<TerrainRenderManager> render_manager_;
 
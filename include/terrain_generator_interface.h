@@ -3,6 +3,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <tuple>
 #include <vector>
 
@@ -16,6 +17,23 @@ namespace Boidsish {
 	struct Frustum;
 	struct Camera;
 
+	struct TerrainSample {
+		float     height = 0.0f;
+		glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+	};
+
+	struct TerrainRay {
+		glm::vec3 origin;
+		glm::vec3 direction; // Should be normalized
+		float     max_distance;
+	};
+
+	struct TerrainRayHit {
+		bool      hit = false;
+		float     distance = 0.0f;
+		glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+	};
+
 	/**
 	 * @brief Interface for terrain generation systems.
 	 *
@@ -92,6 +110,17 @@ namespace Boidsish {
 		 */
 		virtual std::vector<std::shared_ptr<Terrain>> GetVisibleChunksCopy() const = 0;
 
+		/**
+		 * @brief Get a resident chunk by its (x, z) chunk coordinates.
+		 *
+		 * Unlike the visible chunk list this is not frustum-culled: any chunk currently held by
+		 * the generator is returned. Safe to call from any thread.
+		 *
+		 * @param chunk_key Chunk coordinates
+		 * @return The chunk, or nullptr if it is not resident
+		 */
+		virtual std::shared_ptr<Terrain> GetResidentChunk(std::pair<int, int> chunk_key) const = 0;
+
 		// ==================== Render Manager Integration ====================
 
 		/**
@@ -208,6 +237,54 @@ namespace Boidsish {
 			glm::vec3&       out_normal
 		) const = 0;
 
+		// ==================== Batched Queries ====================
+
+		/**
+		 * @brief Cached terrain properties for many points at once.
+		 *
+		 * Equivalent to calling GetTerrainPropertiesAtPoint for each point, but lets the
+		 * implementation amortize locking and chunk lookups across the whole batch and spread
+		 * the work over threads. Meant for per-frame passes over all entities from the main
+		 * thread (e.g. EntityHandler::PreTimestep); inside a pool task (InPoolTask()) it runs
+		 * serially.
+		 *
+		 * @param points World XZ positions
+		 * @param out One sample per point; must be the same size as points
+		 */
+		virtual void GetTerrainPropertiesBatch(std::span<const glm::vec2> points, std::span<TerrainSample> out) const {
+			for (size_t i = 0; i < points.size(); ++i) {
+				auto [height, normal] = GetTerrainPropertiesAtPoint(points[i].x, points[i].y);
+				out[i] = {height, normal};
+			}
+		}
+
+		/**
+		 * @brief Signed vertical distance above the terrain for many points at once.
+		 *
+		 * Batched GetDistanceAboveTerrain; a negative value means the point is below the surface.
+		 *
+		 * @param points World positions
+		 * @param out One distance per point; must be the same size as points
+		 */
+		virtual void GetDistanceAboveTerrainBatch(std::span<const glm::vec3> points, std::span<float> out) const {
+			for (size_t i = 0; i < points.size(); ++i) {
+				out[i] = GetDistanceAboveTerrain(points[i]);
+			}
+		}
+
+		/**
+		 * @brief Batched RaycastCached.
+		 *
+		 * @param rays Rays to cast
+		 * @param out One result per ray; must be the same size as rays
+		 */
+		virtual void RaycastBatch(std::span<const TerrainRay> rays, std::span<TerrainRayHit> out) const {
+			for (size_t i = 0; i < rays.size(); ++i) {
+				out[i].hit =
+					RaycastCached(rays[i].origin, rays[i].direction, rays[i].max_distance, out[i].distance, out[i].normal);
+			}
+		}
+
 		// ==================== Terrain Deformation ====================
 
 		/**
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Boidsish {
+
+	/**
+	 * @brief Max-height mip pyramid over one terrain chunk's height grid.
+	 *
+	 * Level 0 stores, per grid cell, the highest of the cell's four corner heights, which bounds
+	 * the bilinear surface the cached height queries interpolate. Each further level stores the
+	 * maximum of a 2x2 block of the level below, up to a single value for the whole chunk.
+	 * Raymarchers use it to jump over stretches of a ray that are provably above the terrain.
+	 */
+	class TerrainHeightPyramid {
+	public:
+		TerrainHeightPyramid() = default;
+
+		/**
+		 * @brief Builds the pyramid for a chunk.
+		 * @param vertices X-major grid of (cells + 1)^2 vertices, as produced by TerrainGenerator
+		 * @param cells Number of grid cells along each chunk edge
+		 */
+		TerrainHeightPyramid(const std::vector<glm::vec3>& vertices, int cells);
+
+		/**
+		 * @brief Builds the pyramid from the heights alone.
+		 * @param heights X-major grid of (cells + 1)^2 heights
+		 * @param cells Number of grid cells along each chunk edge
+		 */
+		TerrainHeightPyramid(const std::vector<float>& heights, int cells);
+
+		bool IsEmpty() const { return level_sizes_.empty(); }
+
+		int GetLevelCount() const { return static_cast<int>(level_sizes_.size()); }
+
+		int GetLevelSize(int level) const { return level_sizes_[level]; }
+
+		float GetMaxHeight(int level, int x, int z) const {
+			return heights_[level_offsets_[level] + static_cast<size_t>(x) * level_sizes_[level] + z];
+		}
+
+		/**
+		 * @brief Advances along a ray for as long as it stays above every cell it crosses.
+		 *
+		 * Walks down from the coarsest level at each step and jumps to the exit of the largest
+		 * node the ray segment clears, so open sky is crossed in a handful of iterations.
+		 *
+		 * @param origin Ray origin relative to the chunk's minimum corner
+		 * @param dir Ray direction
+		 * @param t Current distance along the ray; origin + dir * t should lie over the chunk
+		 * @param t_end Distance not to advance past
+		 * @param cell_size World size of one grid cell
+		 * @return The first distance >= t at which the ray may be below the terrain, or t_end
+		 */
+		float Skip(const glm::vec3& origin, const glm::vec3& dir, float t, float t_end, float cell_size) const;
+
+	private:
+		int                 cells_ = 0;
+		std::vector<int>    level_sizes_;
+		std::vector<size_t> level_offsets_;
+		std::vector<float>  heights_; // All levels, each X-major
+	};
+
+} // namespace Boidsish
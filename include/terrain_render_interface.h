@@ -5,6 +5,7 @@
 #include <optional>
 #include <vector>
 
+#include "terrain_chunk_data.h"
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
@@ -28,29 +29,19 @@ namespace Boidsish {
 		 * @brief Register a terrain chunk for rendering.
 		 *
 		 * The data format varies by implementation:
-		 * - V1 (batched): Uses pre-computed vertex mesh data
+		 * - V1 (batched): Builds vertex mesh data from the surface grid
 		 * - V2 (instanced): Uses heightmap for GPU displacement
 		 *
 		 * @param chunk_key Unique identifier (chunk_x, chunk_z)
-		 * @param positions Position data (chunk_size+1)^2 elements
-		 * @param normals Normal vectors (chunk_size+1)^2 elements
-		 * @param indices Index data for mesh topology
-		 * @param min_y Minimum height in chunk
-		 * @param max_y Maximum height in chunk
+		 * @param surface Quantized heights, normals and biomes, (chunk_size+1)^2 vertices
 		 * @param world_offset World position offset for this chunk
+		 * @param world_scale World distance between neighbouring vertices
 		 */
 		virtual void RegisterChunk(
-			std::pair<int, int>              chunk_key,
-			const std::vector<glm::vec3>&    positions,
-			const std::vector<glm::vec3>&    normals,
-			const std::vector<glm::vec2>&    biomes,
-			const std::vector<float>&        packed_height_normal,
-			const std::vector<uint8_t>&      packed_biomes,
-			const std::vector<unsigned int>& indices,
-			float                            min_y,
-			float                            max_y,
-			const glm::vec3&                 world_offset,
-			float                            world_scale
+			std::pair<int, int>     chunk_key,
+			const TerrainChunkData& surface,
+			const glm::vec3&        world_offset,
+			float                   world_scale
 		) = 0;
 
 		/**
@@ -9,6 +9,7 @@
 
 #include "constants.h"
 #include "persistent_buffer.h"
+#include "terrain_chunk_data.h"
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
@@ -65,20 +66,13 @@ namespace Boidsish {
 		/**
 		 * @brief Register a terrain chunk for rendering.
 		 *
-		 * Extracts heights from positions and uploads to texture array.
+		 * Expands the chunk's quantized surface and uploads it to the texture arrays.
 		 */
 		void RegisterChunk(
-			std::pair<int, int>              chunk_key,
-			const std::vector<glm::vec3>&    positions,
-			const std::vector<glm::vec3>&    normals,
-			const std::vector<glm::vec2>&    biomes,
-			const std::vector<float>&        packed_height_normal,
-			const std::vector<uint8_t>&      packed_biomes,
-			const std::vector<unsigned int>& indices,
-			float                            min_y,
-			float                            max_y,
-			const glm::vec3&                 world_offset,
-			float                            world_scale
+			std::pair<int, int>     chunk_key,
+			const TerrainChunkData& surface,
+			const glm::vec3&        world_offset,
+			float                   world_scale
 		);
 
 		/**
@@ -355,11 +349,7 @@ namespace Boidsish {
 		void EnsureTextureCapacity(int required_slices);
 
 		// Upload heightmap data to a texture slice
-		void UploadHeightmapSlice(
-			int                        slice,
-			const std::vector<float>&  packed_height_normal,
-			const std::vector<uint8_t>& packed_biomes
-		);
+		void UploadHeightmapSlice(int slice, const TerrainChunkData& surface);
 
 		// Configuration
 		int chunk_size_;           // Grid size per chunk (e.g., 32)
@@ -433,6 +423,10 @@ namespace Boidsish {
 
 		std::vector<BakeTask> bake_queue_;
 
+		// Chunk surfaces expanded to texel layout for upload, reused between chunks
+		std::vector<float>   upload_height_normal_;
+		std::vector<uint8_t> upload_biomes_;
+
 		// Per-frame instance data
 		std::vector<InstanceData> visible_instances_;
 		size_t                    instance_buffer_capacity_ = 0;
@@ -17,6 +17,30 @@ namespace Boidsish {
 
 	static inline task_thread_pool::task_thread_pool pool;
 
+	namespace detail {
+		inline thread_local int pool_task_depth = 0;
+	}
+
+	/**
+	 * @brief Marks the current thread as running a pool task for the scope's lifetime.
+	 *
+	 * poolSTL algorithms wait for their chunks without running any themselves, so a parallel
+	 * algorithm started from inside a pool task can leave every worker blocked. Tasks that call
+	 * into code which fans out on the pool open a scope; that code checks InPoolTask() and runs
+	 * serially instead.
+	 */
+	class PoolTaskScope {
+	public:
+		PoolTaskScope() { ++detail::pool_task_depth; }
+
+		~PoolTaskScope() { --detail::pool_task_depth; }
+
+		PoolTaskScope(const PoolTaskScope&) = delete;
+		PoolTaskScope& operator=(const PoolTaskScope&) = delete;
+	};
+
+	inline bool InPoolTask() { return detail::pool_task_depth > 0; }
+
 	enum class TaskPriority { LOW, MEDIUM, HIGH };
 
 	// Forward declaration
@@ -13,15 +13,16 @@ namespace Boidsish {
 		WindAudioEffect(AudioManager& audioManager);
 		virtual ~WindAudioEffect() = default;
 
-		void OnRead(float* pOutput, ma_uint64 frameCount) override;
 		void OnUpdate(float deltaTime, const AudioState& state) override;
 
+	protected:
+		ma_uint32 OnRenderBlock(float* const* pPlanes, ma_uint32 frameCount) override;
+
 	private:
 		AudioManager& m_audioManager;
 
-		// Audio thread RNG (fast Xorshift)
-		uint32_t m_xorshiftState;
-		float NextWhiteNoise();
+		// Audio thread RNG
+		dsp::NoiseGenerator m_noise;
 
 		std::atomic<float> m_gain{0.0f};
 		std::atomic<float> m_freq{0.01f};
@@ -30,8 +31,7 @@ namespace Boidsish {
 		float m_currentWindStrength = 0.0f;
 
 		// State Variable Filter state (audio thread only)
-		float m_low = 0.0f;
-		float m_band = 0.0f;
+		dsp::StateVariableFilter m_filter;
 	};
 
 } // namespace Boidsish
@@ -78,6 +78,7 @@ void main() {
 	bool  use_ssbo = uUseMDI && vUniformIndex >= 0;
 	vec3  c_objectColor = use_ssbo ? uniforms_data[vUniformIndex].color.rgb : objectColor;
 	float c_objectAlpha = use_ssbo ? uniforms_data[vUniformIndex].color.a : objectAlpha;
+	c_objectAlpha *= InstanceColor.a;
 	bool  c_usePBR = use_ssbo ? (uniforms_data[vUniformIndex].use_pbr != 0) : usePBR;
 	float c_roughness = use_ssbo ? uniforms_data[vUniformIndex].roughness : roughness;
 	float c_metallic = use_ssbo ? uniforms_data[vUniformIndex].metallic : metallic;
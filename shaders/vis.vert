@@ -50,6 +50,7 @@ uniform vec4  clipPlane;
 uniform float ripple_strength;
 uniform bool  isColossal = false;
 uniform bool  useSSBOInstancing = false;
+uniform bool  useInstanceColor = false; // Instance matrices carry color and alpha in their bottom row (clones)
 uniform bool  isLine = false;
 uniform bool  enableFrustumCulling = false;
 uniform float frustumCullRadius = 5.0; // Approximate object radius for sphere test
@@ -165,8 +166,19 @@ void main() {
 	}
 
 	mat4 modelMatrix;
+	vec3 instanceTint = vec3(0.0);
+	InstanceColor = vec4(1.0);
 	if (current_useSSBOInstancing) {
 		modelMatrix = ssboInstanceMatrices[gl_InstanceID];
+		if (useInstanceColor) {
+			// Affine matrices leave the bottom row free; restore it after reading the color
+			instanceTint = vec3(modelMatrix[0][3], modelMatrix[1][3], modelMatrix[2][3]);
+			InstanceColor = vec4(instanceTint, modelMatrix[3][3]);
+			modelMatrix[0][3] = 0.0;
+			modelMatrix[1][3] = 0.0;
+			modelMatrix[2][3] = 0.0;
+			modelMatrix[3][3] = 1.0;
+		}
 	} else {
 		modelMatrix = current_model;
 	}
@@ -225,7 +237,7 @@ void main() {
 
 	// Apply shockwave displacement (sway for decor)
 	// Calculate at instanceCenter to prevent warping, scale by world-relative height
-	if (current_useSSBOInstancing) {
+	if (current_useSSBOInstancing && !useInstanceColor) {
 		// Calculate the center of the base in world space (the pivot point)
 		vec3 localBaseCenter = vec3((u_aabbMin.x + u_aabbMax.x) * 0.5, u_aabbMin.y, (u_aabbMin.z + u_aabbMax.z) * 0.5);
 		vec3 worldBaseCenter = vec3(modelMatrix * vec4(localBaseCenter, 1.0));
@@ -311,7 +323,7 @@ void main() {
 
 	Normal = mat3(transpose(inverse(modelMatrix))) * displacedNormal;
 	TexCoords = aTexCoords;
-	vs_color = aVertexColor;
+	vs_color = useInstanceColor ? instanceTint : aVertexColor;
 	// if (wireframe_enabled == 1) {
 	barycentric = getBarycentric();
 	// }
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cctype>
 #include <iostream>
+#include <type_traits>
 
 #include "constants.h"
 #include "logger.h"
@@ -104,6 +105,11 @@ namespace Boidsish {
 		// Mesh optimization settings
 		GetAppSettingBool("mesh_optimizer_enabled", true);
 		GetAppSettingBool("mesh_simplifier_enabled", false);
+		GetAppSettingBool("packed_vertex_format_enabled", false);
+		GetAppSettingBool("meshlets_enabled", false);
+		GetAppSettingBool("mesh_lod_enabled", true);
+		GetAppSettingInt("mesh_lod_count", 3);
+		GetAppSettingFloat("mesh_lod_screen_error", 0.001f);
 		GetAppSettingFloat("mesh_simplifier_target_ratio", 0.5f); // Keep as a limit
 
 		GetAppSettingFloat("mesh_simplifier_error_prebuild", 0.01f);
@@ -169,6 +175,9 @@ namespace Boidsish {
 		registerTarget("cloud_color_r");
 		registerTarget("cloud_color_g");
 		registerTarget("cloud_color_b");
+
+		// Bindings made before the section name was known resolved against the wrong section
+		RefreshAllBindings();
 	}
 
 	void ConfigManager::Shutdown() {
@@ -219,26 +228,82 @@ namespace Boidsish {
 		return m_config.GetBool("global", key, default_value);
 	}
 
+	// --- Typed Bindings ---
+
+	template <typename T>
+	const ConfigVar<T>& ConfigManager::BindAppSetting(
+		std::map<std::string, std::unique_ptr<ConfigVar<T>>>& vars,
+		const std::string&                                    key,
+		T                                                     default_value
+	) {
+		std::lock_guard<std::mutex> lock(m_bindingMutex);
+		auto                        it = vars.find(key);
+		if (it != vars.end()) {
+			return *it->second;
+		}
+
+		T value;
+		if constexpr (std::is_same_v<T, int>) {
+			value = GetAppSettingInt(key, default_value);
+		} else if constexpr (std::is_same_v<T, float>) {
+			value = GetAppSettingFloat(key, default_value);
+		} else {
+			value = GetAppSettingBool(key, default_value);
+		}
+
+		auto& var = vars[key];
+		var = std::make_unique<ConfigVar<T>>(key, default_value, value);
+		return *var;
+	}
+
+	const ConfigVar<int>& ConfigManager::BindAppSettingInt(const std::string& key, int default_value) {
+		return BindAppSetting(m_intVars, key, default_value);
+	}
+
+	const ConfigVar<float>& ConfigManager::BindAppSettingFloat(const std::string& key, float default_value) {
+		return BindAppSetting(m_floatVars, key, default_value);
+	}
+
+	const ConfigVar<bool>& ConfigManager::BindAppSettingBool(const std::string& key, bool default_value) {
+		return BindAppSetting(m_boolVars, key, default_value);
+	}
+
+	ConfigManager::ListenerId ConfigManager::AddChangeListener(const std::string& key, ChangeCallback callback) {
+		std::lock_guard<std::mutex> lock(m_bindingMutex);
+		ListenerId                  id = m_nextListenerId++;
+		m_listeners.push_back({id, key, std::move(callback)});
+		return id;
+	}
+
+	void ConfigManager::RemoveChangeListener(ListenerId id) {
+		std::lock_guard<std::mutex> lock(m_bindingMutex);
+		std::erase_if(m_listeners, [id](const Listener& l) { return l.id == id; });
+	}
+
 	// --- Setters ---
 
 	void ConfigManager::SetString(const std::string& key, const std::string& value) {
 		m_config.SetString(m_appSection, key, value);
 		m_config.Save();
+		NotifyChanged(key);
 	}
 
 	void ConfigManager::SetInt(const std::string& key, int value) {
 		m_config.SetInt(m_appSection, key, value);
 		m_config.Save();
+		NotifyChanged(key);
 	}
 
 	void ConfigManager::SetFloat(const std::string& key, float value) {
 		m_config.SetFloat(m_appSection, key, value);
 		m_config.Save();
+		NotifyChanged(key);
 	}
 
 	void ConfigManager::SetBool(const std::string& key, bool value) {
 		m_config.SetBool(m_appSection, key, value);
 		m_config.Save();
+		NotifyChanged(key);
 	}
 
 	// --- UI Helpers ---
@@ -266,6 +331,53 @@ namespace Boidsish {
 
 	// --- Private Methods ---
 
+	void ConfigManager::RefreshBindings(const std::string& key) {
+		// Caller holds m_bindingMutex. Reads go straight to m_config so no keys are re-registered.
+		if (auto it = m_intVars.find(key); it != m_intVars.end()) {
+			int def = it->second->GetDefault();
+			it->second->Store(m_config.GetInt(m_appSection, key, m_config.GetInt("global", key, def)));
+		}
+		if (auto it = m_floatVars.find(key); it != m_floatVars.end()) {
+			float def = it->second->GetDefault();
+			it->second->Store(m_config.GetFloat(m_appSection, key, m_config.GetFloat("global", key, def)));
+		}
+		if (auto it = m_boolVars.find(key); it != m_boolVars.end()) {
+			bool def = it->second->GetDefault();
+			it->second->Store(m_config.GetBool(m_appSection, key, m_config.GetBool("global", key, def)));
+		}
+	}
+
+	void ConfigManager::RefreshAllBindings() {
+		std::lock_guard<std::mutex> lock(m_bindingMutex);
+		for (const auto& [key, var] : m_intVars) {
+			RefreshBindings(key);
+		}
+		for (const auto& [key, var] : m_floatVars) {
+			RefreshBindings(key);
+		}
+		for (const auto& [key, var] : m_boolVars) {
+			RefreshBindings(key);
+		}
+	}
+
+	void ConfigManager::NotifyChanged(const std::string& key) {
+		std::vector<ChangeCallback> to_call;
+		{
+			std::lock_guard<std::mutex> lock(m_bindingMutex);
+			RefreshBindings(key);
+			for (const auto& listener : m_listeners) {
+				if (listener.key.empty() || listener.key == key) {
+					to_call.push_back(listener.callback);
+				}
+			}
+		}
+
+		// Invoke outside the lock so callbacks may read bindings or set further values
+		for (const auto& callback : to_call) {
+			callback(key);
+		}
+	}
+
 	void ConfigManager::RegisterKey(
 		const std::string& section,
 		const std::string& key,
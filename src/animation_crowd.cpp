@@ -0,0 +1,335 @@
+#include "animation_crowd.h"
+
+#include <algorithm>
+#include <array>
+#include <future>
+
+#include "model.h"
+
+namespace Boidsish {
+
+	namespace {
+		constexpr size_t kWidth = AnimationCrowd::kBatchWidth;
+
+		// One channel sampled for every member of a batch, one array per component
+		struct alignas(64) ChannelLanes {
+			float p0[3][kWidth], p1[3][kWidth], pt[kWidth];
+			float q0[4][kWidth], q1[4][kWidth], qt[kWidth];
+			float s0[3][kWidth], s1[3][kWidth], st[kWidth];
+
+			// Composed local transform, upper 3x4 in column-major order
+			float m[12][kWidth];
+		};
+
+		void StoreSegment(ChannelLanes& lanes, size_t l, const ChannelSegment& seg) {
+			for (int c = 0; c < 3; ++c) {
+				lanes.p0[c][l] = seg.position0[c];
+				lanes.p1[c][l] = seg.position1[c];
+				lanes.s0[c][l] = seg.scale0[c];
+				lanes.s1[c][l] = seg.scale1[c];
+			}
+			lanes.q0[0][l] = seg.rotation0.x;
+			lanes.q0[1][l] = seg.rotation0.y;
+			lanes.q0[2][l] = seg.rotation0.z;
+			lanes.q0[3][l] = seg.rotation0.w;
+			lanes.q1[0][l] = seg.rotation1.x;
+			lanes.q1[1][l] = seg.rotation1.y;
+			lanes.q1[2][l] = seg.rotation1.z;
+			lanes.q1[3][l] = seg.rotation1.w;
+			lanes.pt[l] = seg.position_t;
+			lanes.qt[l] = seg.rotation_t;
+			lanes.st[l] = seg.scale_t;
+		}
+
+		// Coefficients of Eberly's polynomial slerp ("A Fast and Accurate Algorithm for Computing
+		// SLERP"): u_i = 1 / (i(2i + 1)), v_i = i / (2i + 1), with the last term scaled by mu.
+		constexpr int   kSlerpTerms = 12;
+		constexpr float kSlerpMu = 1.8937177f; // Fitted for 12 terms, max weight error ~7e-7
+
+		constexpr std::array<float, kSlerpTerms> SlerpCoefficients(bool v) {
+			std::array<float, kSlerpTerms> c{};
+			for (int i = 1; i <= kSlerpTerms; ++i) {
+				float value = v ? float(i) / float(2 * i + 1) : 1.0f / float(i * (2 * i + 1));
+				c[i - 1] = i == kSlerpTerms ? value * kSlerpMu : value;
+			}
+			return c;
+		}
+
+		/**
+		 * Interpolates and composes T * R * S for n lanes.
+		 *
+		 * The polynomial slerp needs no acos/sin and no branches beyond the shortest-path sign
+		 * flip, so every loop here is a straight-line lane loop. Against the trigonometric form
+		 * the interpolation weights differ by under 1e-6 across the whole [0, 1] range of dot
+		 * products.
+		 */
+		void ComposeLanes(ChannelLanes& lanes, size_t n) {
+			constexpr auto kU = SlerpCoefficients(false);
+			constexpr auto kV = SlerpCoefficients(true);
+
+			alignas(64) float cos_theta[kWidth], sign[kWidth];
+			alignas(64) float t2[kWidth], d2[kWidth], acc_t[kWidth], acc_d[kWidth];
+
+			for (size_t l = 0; l < n; ++l) {
+				float d = lanes.q0[0][l] * lanes.q1[0][l] + lanes.q0[1][l] * lanes.q1[1][l] +
+					lanes.q0[2][l] * lanes.q1[2][l] + lanes.q0[3][l] * lanes.q1[3][l];
+				sign[l] = d < 0.0f ? -1.0f : 1.0f;
+				cos_theta[l] = std::min(d * sign[l], 1.0f);
+
+				float t = lanes.qt[l];
+				t2[l] = t * t;
+				d2[l] = (1.0f - t) * (1.0f - t);
+				acc_t[l] = 1.0f;
+				acc_d[l] = 1.0f;
+			}
+
+			for (int k = kSlerpTerms - 1; k >= 0; --k) {
+				for (size_t l = 0; l < n; ++l) {
+					float xm1 = cos_theta[l] - 1.0f;
+					acc_t[l] = 1.0f + (kU[k] * t2[l] - kV[k]) * xm1 * acc_t[l];
+					acc_d[l] = 1.0f + (kU[k] * d2[l] - kV[k]) * xm1 * acc_d[l];
+				}
+			}
+
+			for (size_t l = 0; l < n; ++l) {
+				float wa = (1.0f - lanes.qt[l]) * acc_d[l];
+				float wb = lanes.qt[l] * acc_t[l] * sign[l];
+				float x = wa * lanes.q0[0][l] + wb * lanes.q1[0][l];
+				float y = wa * lanes.q0[1][l] + wb * lanes.q1[1][l];
+				float z = wa * lanes.q0[2][l] + wb * lanes.q1[2][l];
+				float w = wa * lanes.q0[3][l] + wb * lanes.q1[3][l];
+
+				float sx = lanes.s0[0][l] + (lanes.s1[0][l] - lanes.s0[0][l]) * lanes.st[l];
+				float sy = lanes.s0[1][l] + (lanes.s1[1][l] - lanes.s0[1][l]) * lanes.st[l];
+				float sz = lanes.s0[2][l] + (lanes.s1[2][l] - lanes.s0[2][l]) * lanes.st[l];
+
+				float xx = x * x, yy = y * y, zz = z * z;
+				float xy = x * y, xz = x * z, yz = y * z;
+				float wx = w * x, wy = w * y, wz = w * z;
+
+				lanes.m[0][l] = (1.0f - 2.0f * (yy + zz)) * sx;
+				lanes.m[1][l] = 2.0f * (xy + wz) * sx;
+				lanes.m[2][l] = 2.0f * (xz - wy) * sx;
+				lanes.m[3][l] = 2.0f * (xy - wz) * sy;
+				lanes.m[4][l] = (1.0f - 2.0f * (xx + zz)) * sy;
+				lanes.m[5][l] = 2.0f * (yz + wx) * sy;
+				lanes.m[6][l] = 2.0f * (xz + wy) * sz;
+				lanes.m[7][l] = 2.0f * (yz - wx) * sz;
+				lanes.m[8][l] = (1.0f - 2.0f * (xx + yy)) * sz;
+				lanes.m[9][l] = lanes.p0[0][l] + (lanes.p1[0][l] - lanes.p0[0][l]) * lanes.pt[l];
+				lanes.m[10][l] = lanes.p0[1][l] + (lanes.p1[1][l] - lanes.p0[1][l]) * lanes.pt[l];
+				lanes.m[11][l] = lanes.p0[2][l] + (lanes.p1[2][l] - lanes.p0[2][l]) * lanes.pt[l];
+			}
+		}
+
+		glm::mat4 LoadLane(const ChannelLanes& lanes, size_t l) {
+			glm::mat4 m(1.0f);
+			for (int c = 0; c < 4; ++c) {
+				m[c][0] = lanes.m[c * 3 + 0][l];
+				m[c][1] = lanes.m[c * 3 + 1][l];
+				m[c][2] = lanes.m[c * 3 + 2][l];
+			}
+			return m;
+		}
+	} // namespace
+
+	AnimationCrowd::AnimationCrowd(task_thread_pool::task_thread_pool& thread_pool): thread_pool_(thread_pool) {}
+
+	AnimationCrowd::Handle AnimationCrowd::Add(Animator* animator, const glm::vec3& position) {
+		Member member;
+		member.animator = animator;
+		member.position = position;
+		return AddMember(member);
+	}
+
+	AnimationCrowd::Handle AnimationCrowd::Add(const std::shared_ptr<Model>& model) {
+		Member member;
+		member.model = model;
+		member.has_model = true;
+		member.position = model->GetPosition();
+		return AddMember(member);
+	}
+
+	AnimationCrowd::Handle AnimationCrowd::AddMember(Member member) {
+		member.alive = true;
+		++live_count_;
+		if (!free_handles_.empty()) {
+			Handle handle = free_handles_.back();
+			free_handles_.pop_back();
+			members_[handle] = std::move(member);
+			return handle;
+		}
+		members_.push_back(std::move(member));
+		return static_cast<Handle>(members_.size() - 1);
+	}
+
+	void AnimationCrowd::Remove(Handle handle) {
+		if (handle >= members_.size() || !members_[handle].alive)
+			return;
+		members_[handle] = Member{};
+		free_handles_.push_back(handle);
+		--live_count_;
+	}
+
+	void AnimationCrowd::Clear() {
+		members_.clear();
+		free_handles_.clear();
+		live_count_ = 0;
+	}
+
+	void AnimationCrowd::SetPosition(Handle handle, const glm::vec3& position) {
+		if (handle < members_.size() && members_[handle].alive) {
+			members_[handle].position = position;
+		}
+	}
+
+	float AnimationCrowd::UpdateInterval(const glm::vec3& position, const glm::vec3& viewer) const {
+		if (!lod_.enabled)
+			return 0.0f;
+
+		float distance = glm::distance(position, viewer);
+		if (distance <= lod_.full_rate_distance)
+			return 0.0f;
+
+		float range = std::max(lod_.min_rate_distance - lod_.full_rate_distance, 1e-3f);
+		float factor = std::min((distance - lod_.full_rate_distance) / range, 1.0f);
+		return factor / std::max(lod_.min_update_rate, 1e-3f);
+	}
+
+	void AnimationCrowd::Update(float dt, const glm::vec3& viewer_position) {
+		stats_ = AnimationCrowdStats{};
+		due_.clear();
+		batches_.clear();
+
+		// Keep model members alive until their batches are done
+		std::vector<std::shared_ptr<Model>> locked_models;
+
+		for (Handle handle = 0; handle < members_.size(); ++handle) {
+			Member& member = members_[handle];
+			if (!member.alive)
+				continue;
+
+			if (member.has_model) {
+				auto model = member.model.lock();
+				if (!model) {
+					Remove(handle);
+					continue;
+				}
+				member.animator = model->GetAnimator();
+				member.position = model->GetPosition();
+				locked_models.push_back(std::move(model));
+			}
+
+			member.pending_dt += dt;
+			if (member.pending_dt < UpdateInterval(member.position, viewer_position)) {
+				++stats_.skipped_by_lod;
+				continue;
+			}
+
+			Animator* animator = member.animator;
+			float     elapsed = member.pending_dt;
+			member.pending_dt = 0.0f;
+			if (!animator || !animator->m_ModelData)
+				continue;
+
+			// Recompiling allocates, so it stays on this thread
+			animator->EnsureSkeleton();
+			animator->AdvanceTime(elapsed);
+			due_.push_back(handle);
+		}
+		stats_.members = live_count_;
+
+		auto batch_key = [this](Handle handle) {
+			const Animator* animator = members_[handle].animator;
+			int animation = animator->HasValidAnimation() ? animator->m_CurrentAnimationIndex : -1;
+			return std::make_pair(animator->m_ModelData.get(), animation);
+		};
+		std::sort(due_.begin(), due_.end(), [&](Handle a, Handle b) { return batch_key(a) < batch_key(b); });
+
+		for (size_t i = 0; i < due_.size(); ++i) {
+			Animator* animator = members_[due_[i]].animator;
+			if (batches_.empty() || batches_.back().count == kBatchWidth || batch_key(due_[i]) != batch_key(due_[i - 1])) {
+				Batch batch;
+				// Members on the same ModelData compile identical skeletons, so any of them can stand in
+				batch.skeleton = animator->m_Skeleton.get();
+				if (animator->HasValidAnimation()) {
+					batch.animation = &animator->m_ModelData->animations[animator->m_CurrentAnimationIndex];
+					batch.channels = &batch.skeleton->channels[animator->m_CurrentAnimationIndex];
+				}
+				batches_.push_back(batch);
+			}
+			Batch& batch = batches_.back();
+			batch.members[batch.count++] = animator;
+			stats_.bones += batch.skeleton->size();
+		}
+		stats_.evaluated = due_.size();
+		stats_.batches = batches_.size();
+
+		if (batches_.size() == 1) {
+			EvaluateBatch(batches_[0]);
+		} else if (!batches_.empty()) {
+			std::vector<std::future<void>> futures;
+			futures.reserve(batches_.size());
+			for (const Batch& batch : batches_) {
+				futures.push_back(thread_pool_.submit([&batch]() { EvaluateBatch(batch); }));
+			}
+			for (auto& f : futures) {
+				f.get();
+			}
+		}
+
+		for (Handle handle : due_) {
+			if (members_[handle].has_model) {
+				if (auto model = members_[handle].model.lock()) {
+					model->MarkDirty();
+				}
+			}
+		}
+	}
+
+	void AnimationCrowd::EvaluateBatch(const Batch& batch) {
+		const CompiledSkeleton& skeleton = *batch.skeleton;
+		const size_t            n = batch.count;
+		ChannelLanes            lanes;
+
+		for (size_t i = 0; i < skeleton.size(); ++i) {
+			int channel = batch.channels ? (*batch.channels)[i] : -1;
+
+			if (channel >= 0) {
+				const BoneAnimation& track = batch.animation->boneAnimations[channel];
+				for (size_t l = 0; l < n; ++l) {
+					Animator& animator = *batch.members[l];
+					// Overridden nodes keep their cursor untouched, as in Animator::EvaluatePose
+					ChannelSegment segment = animator.m_HasOverride[i]
+						? ChannelSegment{}
+						: LocateChannelKeys(track, animator.m_CurrentTime, animator.m_Cursors[i]);
+					StoreSegment(lanes, l, segment);
+				}
+				ComposeLanes(lanes, n);
+			}
+
+			int             parent = skeleton.parents[i];
+			const BoneInfo* bone = skeleton.bones[i];
+			for (size_t l = 0; l < n; ++l) {
+				Animator& animator = *batch.members[l];
+
+				glm::mat4 nodeTransform;
+				if (animator.m_HasOverride[i]) {
+					nodeTransform = animator.m_LocalOverrides[i];
+				} else if (channel >= 0) {
+					nodeTransform = LoadLane(lanes, l);
+				} else {
+					nodeTransform = skeleton.nodes[i]->transformation;
+				}
+
+				glm::mat4& global = animator.m_GlobalMatrices[i];
+				global = parent >= 0 ? animator.m_GlobalMatrices[parent] * nodeTransform : nodeTransform;
+
+				if (bone && bone->id >= 0 && (size_t)bone->id < animator.m_FinalBoneMatrices.size()) {
+					animator.m_FinalBoneMatrices[bone->id] = global * bone->offset;
+				}
+			}
+		}
+	}
+
+} // namespace Boidsish
@@ -4,6 +4,7 @@
 #ifndef GLM_ENABLE_EXPERIMENTAL
 	#define GLM_ENABLE_EXPERIMENTAL
 #endif
+#include <algorithm>
 #include <cmath>
 #include <functional>
 
@@ -11,6 +12,151 @@
 
 namespace Boidsish {
 
+	namespace {
+		// Robust name matching for Assimp/FBX.
+		// FBX often adds prefixes/suffixes or namespaces (e.g., "ModelName:BoneName")
+		// or Assimp might add "_$AssimpFbx$_"
+		std::string CleanseNodeName(const std::string& name) {
+			std::string s = name;
+			// Remove FBX namespace prefix
+			size_t colon = s.find_last_of(':');
+			if (colon != std::string::npos)
+				s = s.substr(colon + 1);
+
+			// Remove Assimp FBX magic suffix
+			size_t magic = s.find("_$AssimpFbx$_");
+			if (magic != std::string::npos)
+				s = s.substr(0, magic);
+
+			return s;
+		}
+
+		// Returns the segment [i, i+1] containing time, resuming from the cached segment.
+		// Matches a fresh scan for the first key whose successor lies after time, except that
+		// times past the final key stay on the last segment.
+		template <typename Key>
+		int AdvanceCursor(const std::vector<Key>& keys, int count, float time, int cursor) {
+			if (cursor > count - 2 || time < keys[cursor].timeStamp) {
+				cursor = 0; // Wrapped around or switched animation
+			}
+			while (cursor < count - 2 && time >= keys[cursor + 1].timeStamp) {
+				++cursor;
+			}
+			return cursor;
+		}
+
+		template <typename Key>
+		float SegmentFactor(const std::vector<Key>& keys, int i, float time) {
+			float t0 = keys[i].timeStamp;
+			float t1 = keys[i + 1].timeStamp;
+			return t1 > t0 ? std::clamp((time - t0) / (t1 - t0), 0.0f, 1.0f) : 0.0f;
+		}
+	} // namespace
+
+	std::shared_ptr<const CompiledSkeleton> CompiledSkeleton::Build(const ModelData& data) {
+		auto skeleton = std::make_shared<CompiledSkeleton>();
+		skeleton->source = &data;
+		skeleton->version = data.skeleton_version;
+		skeleton->animation_count = data.animations.size();
+
+		std::unordered_map<std::string, const BoneInfo*> cleansed_bones;
+		for (const auto& [boneName, info] : data.bone_info_map) {
+			// First match in map order wins, as with the per-frame scan this replaces
+			cleansed_bones.emplace(CleanseNodeName(boneName), &info);
+		}
+
+		std::function<void(const NodeData&, int)> visit = [&](const NodeData& node, int parent) {
+			int index = static_cast<int>(skeleton->parents.size());
+			skeleton->parents.push_back(parent);
+			skeleton->names.push_back(node.name);
+			skeleton->nodes.push_back(&node);
+			skeleton->name_to_node[node.name] = index;
+
+			const BoneInfo* bone = nullptr;
+			auto            it = data.bone_info_map.find(node.name);
+			if (it != data.bone_info_map.end()) {
+				bone = &it->second;
+			} else {
+				auto cit = cleansed_bones.find(CleanseNodeName(node.name));
+				if (cit != cleansed_bones.end()) {
+					bone = cit->second;
+				}
+			}
+			skeleton->bones.push_back(bone);
+
+			for (const auto& child : node.children) {
+				visit(child, index);
+			}
+		};
+		visit(data.root_node, -1);
+
+		skeleton->channels.resize(data.animations.size());
+		for (size_t a = 0; a < data.animations.size(); ++a) {
+			auto& channels = skeleton->channels[a];
+			channels.assign(skeleton->size(), -1);
+
+			const auto& boneAnimations = data.animations[a].boneAnimations;
+			for (size_t n = 0; n < skeleton->size(); ++n) {
+				const std::string& nodeName = skeleton->names[n];
+				for (size_t c = 0; c < boneAnimations.size(); ++c) {
+					if (boneAnimations[c].name == nodeName) {
+						channels[n] = static_cast<int>(c);
+						break;
+					}
+				}
+			}
+		}
+
+		return skeleton;
+	}
+
+	ChannelSegment LocateChannelKeys(const BoneAnimation& channel, float time, ChannelCursor& cursor) {
+		ChannelSegment segment;
+
+		if (channel.numPositions == 1) {
+			segment.position0 = segment.position1 = channel.positions[0].position;
+		} else if (channel.numPositions > 1) {
+			cursor.position = AdvanceCursor(channel.positions, channel.numPositions, time, cursor.position);
+			int i = cursor.position;
+			segment.position0 = channel.positions[i].position;
+			segment.position1 = channel.positions[i + 1].position;
+			segment.position_t = SegmentFactor(channel.positions, i, time);
+		}
+
+		if (channel.numRotations == 1) {
+			segment.rotation0 = segment.rotation1 = channel.rotations[0].orientation;
+		} else if (channel.numRotations > 1) {
+			cursor.rotation = AdvanceCursor(channel.rotations, channel.numRotations, time, cursor.rotation);
+			int i = cursor.rotation;
+			segment.rotation0 = channel.rotations[i].orientation;
+			segment.rotation1 = channel.rotations[i + 1].orientation;
+			segment.rotation_t = SegmentFactor(channel.rotations, i, time);
+		}
+
+		if (channel.numScalings == 1) {
+			segment.scale0 = segment.scale1 = channel.scales[0].scale;
+		} else if (channel.numScalings > 1) {
+			cursor.scale = AdvanceCursor(channel.scales, channel.numScalings, time, cursor.scale);
+			int i = cursor.scale;
+			segment.scale0 = channel.scales[i].scale;
+			segment.scale1 = channel.scales[i + 1].scale;
+			segment.scale_t = SegmentFactor(channel.scales, i, time);
+		}
+
+		return segment;
+	}
+
+	glm::mat4 SampleChannel(const BoneAnimation& channel, float time, ChannelCursor& cursor) {
+		ChannelSegment segment = LocateChannelKeys(channel, time, cursor);
+
+		glm::vec3 translation = glm::mix(segment.position0, segment.position1, segment.position_t);
+		glm::quat rotation = glm::slerp(segment.rotation0, segment.rotation1, segment.rotation_t);
+		glm::vec3 scale = glm::mix(segment.scale0, segment.scale1, segment.scale_t);
+
+		return glm::translate(glm::mat4(1.0f), translation) * glm::toMat4(rotation) *
+			glm::scale(glm::mat4(1.0f), scale);
+	}
+
 	Animator::Animator(std::shared_ptr<ModelData> modelData) {
 		SetModelData(modelData);
 	}
@@ -19,26 +165,85 @@ namespace Boidsish {
 		m_ModelData = modelData;
 		m_FinalBoneMatrices.clear();
 		m_FinalBoneMatrices.resize(100, glm::mat4(1.0f));
+		// Always rebuild: a new ModelData may reuse the old one's address and version
+		RebuildSkeleton();
+	}
+
+	void Animator::EnsureSkeleton() {
+		if (m_ModelData && !IsSkeletonCurrent()) {
+			RebuildSkeleton();
+		}
+	}
+
+	void Animator::RebuildSkeleton() {
+		// Carry manual overrides and the last evaluated pose across the rebuild by name.
+		// The old node pointers may dangle by now.
+		std::shared_ptr<const CompiledSkeleton> old_skeleton = m_Skeleton;
+		std::vector<glm::mat4>                  old_globals = std::move(m_GlobalMatrices);
+		if (old_skeleton) {
+			for (size_t i = 0; i < old_skeleton->size(); ++i) {
+				if (m_HasOverride[i]) {
+					m_PendingOverrides[old_skeleton->names[i]] = m_LocalOverrides[i];
+				}
+			}
+		}
+
+		if (!m_ModelData) {
+			m_Skeleton.reset();
+			return;
+		}
+		m_Skeleton = CompiledSkeleton::Build(*m_ModelData);
+
+		size_t count = m_Skeleton->size();
+		m_Cursors.assign(count, ChannelCursor{});
+		m_LocalOverrides.assign(count, glm::mat4(1.0f));
+		m_HasOverride.assign(count, 0);
+		m_GlobalMatrices.assign(count, glm::mat4(1.0f));
+
+		if (old_skeleton) {
+			for (size_t i = 0; i < count; ++i) {
+				int old_index = old_skeleton->FindNode(m_Skeleton->names[i]);
+				if (old_index >= 0) {
+					m_GlobalMatrices[i] = old_globals[old_index];
+				}
+			}
+		}
+
+		for (auto it = m_PendingOverrides.begin(); it != m_PendingOverrides.end();) {
+			int index = m_Skeleton->FindNode(it->first);
+			if (index >= 0) {
+				m_LocalOverrides[index] = it->second;
+				m_HasOverride[index] = 1;
+				it = m_PendingOverrides.erase(it);
+			} else {
+				++it;
+			}
+		}
 	}
 
 	void Animator::UpdateAnimation(float dt) {
-		m_GlobalMatrices.clear();
-		if (m_ModelData && m_CurrentAnimationIndex >= 0 &&
-		    (size_t)m_CurrentAnimationIndex < m_ModelData->animations.size()) {
+		if (!m_ModelData)
+			return;
+
+		EnsureSkeleton();
+		AdvanceTime(dt);
+		// Even if no animation is playing, we should still update bone matrices to bind pose
+		EvaluatePose();
+	}
+
+	void Animator::AdvanceTime(float dt) {
+		if (HasValidAnimation()) {
 			auto& animation = m_ModelData->animations[m_CurrentAnimationIndex];
 			float ticksPerSecond = (animation.ticksPerSecond != 0) ? (float)animation.ticksPerSecond : 24.0f;
 			m_CurrentTime += ticksPerSecond * dt;
 			m_CurrentTime = std::fmod(m_CurrentTime, animation.duration);
-			CalculateBoneTransform(m_ModelData->root_node, glm::mat4(1.0f));
-		} else if (m_ModelData) {
-			// Even if no animation is playing, we should still update bone matrices to bind pose
-			CalculateBoneTransform(m_ModelData->root_node, glm::mat4(1.0f));
 		}
 	}
 
 	void Animator::PlayAnimation(int animationIndex) {
 		m_CurrentAnimationIndex = animationIndex;
 		m_CurrentTime = 0.0f;
+		std::fill(m_Cursors.begin(), m_Cursors.end(), ChannelCursor{});
 	}
 
 	void Animator::PlayAnimation(const std::string& name) {
@@ -53,12 +258,26 @@ namespace Boidsish {
 	}
 
 	void Animator::SetBoneLocalTransform(const std::string& boneName, const glm::mat4& transform) {
-		m_LocalOverrides[boneName] = transform;
+		EnsureSkeleton();
+		int index = m_Skeleton ? m_Skeleton->FindNode(boneName) : -1;
+		if (index >= 0) {
+			m_LocalOverrides[index] = transform;
+			m_HasOverride[index] = 1;
+		} else {
+			m_PendingOverrides[boneName] = transform;
+		}
 	}
 
 	glm::mat4 Animator::GetBoneLocalTransform(const std::string& boneName) const {
-		auto it = m_LocalOverrides.find(boneName);
-		if (it != m_LocalOverrides.end()) {
+		if (IsSkeletonCurrent()) {
+			int index = m_Skeleton->FindNode(boneName);
+			if (index >= 0) {
+				return m_HasOverride[index] ? m_LocalOverrides[index] : m_Skeleton->nodes[index]->transformation;
+			}
+		}
+
+		auto it = m_PendingOverrides.find(boneName);
+		if (it != m_PendingOverrides.end()) {
 			return it->second;
 		}
 		if (m_ModelData) {
@@ -71,17 +290,27 @@ namespace Boidsish {
 	}
 
 	glm::mat4 Animator::GetBoneModelSpaceTransform(const std::string& boneName) const {
-		auto it = m_GlobalMatrices.find(boneName);
-		if (it != m_GlobalMatrices.end()) {
-			return it->second;
+		// Matrices are only valid for the skeleton they were evaluated with, even if it has since gone stale
+		int index = m_Skeleton ? m_Skeleton->FindNode(boneName) : -1;
+		if (index >= 0) {
+			return m_GlobalMatrices[index];
 		}
-		// If not cached, it might be because CalculateBoneTransform hasn't run or node doesn't exist
+		// If not evaluated, it might be because UpdateAnimation hasn't run or node doesn't exist
 		return glm::mat4(1.0f);
 	}
 
 	std::string Animator::GetBoneParentName(const std::string& boneName) const {
 		if (!m_ModelData)
 			return "";
+
+		if (IsSkeletonCurrent()) {
+			int index = m_Skeleton->FindNode(boneName);
+			if (index < 0)
+				return "";
+			int parent = m_Skeleton->parents[index];
+			return parent >= 0 ? m_Skeleton->names[parent] : "";
+		}
+
 		// Recursive search for parent
 		std::function<std::string(const NodeData&, const std::string&)> findParent =
 			[&](const NodeData& node, const std::string& target) -> std::string {
@@ -98,143 +327,43 @@ namespace Boidsish {
 		return findParent(m_ModelData->root_node, boneName);
 	}
 
-	void Animator::CalculateBoneTransform(const NodeData& node, glm::mat4 parentTransform) {
-		std::string nodeName = node.name;
-		glm::mat4   nodeTransform = node.transformation;
-
-		// Check for manual overrides first
-		auto overIt = m_LocalOverrides.find(nodeName);
-		if (overIt != m_LocalOverrides.end()) {
-			nodeTransform = overIt->second;
-		} else if (m_CurrentAnimationIndex >= 0 && (size_t)m_CurrentAnimationIndex < m_ModelData->animations.size()) {
-			auto& animation = m_ModelData->animations[m_CurrentAnimationIndex];
-			// Find BoneAnimation for this node
-			for (const auto& boneAnim : animation.boneAnimations) {
-				if (boneAnim.name == nodeName) {
-					// Interpolate Position
-					glm::vec3 translation(0.0f);
-					if (boneAnim.numPositions > 0) {
-						if (boneAnim.numPositions == 1) {
-							translation = boneAnim.positions[0].position;
-						} else {
-							int p0Index = 0;
-							for (int i = 0; i < boneAnim.numPositions - 1; i++) {
-								if (m_CurrentTime < boneAnim.positions[i + 1].timeStamp) {
-									p0Index = i;
-									break;
-								}
-							}
-							int   p1Index = p0Index + 1;
-							float t0 = boneAnim.positions[p0Index].timeStamp;
-							float t1 = boneAnim.positions[p1Index].timeStamp;
-							float factor = (m_CurrentTime - t0) / (t1 - t0);
-							translation = glm::mix(
-								boneAnim.positions[p0Index].position,
-								boneAnim.positions[p1Index].position,
-								factor
-							);
-						}
-					}
+	void Animator::ResetLocalOverrides() {
+		std::fill(m_HasOverride.begin(), m_HasOverride.end(), 0);
+		m_PendingOverrides.clear();
+	}
 
-					// Interpolate Rotation
-					glm::quat rotation(1, 0, 0, 0);
-					if (boneAnim.numRotations > 0) {
-						if (boneAnim.numRotations == 1) {
-							rotation = boneAnim.rotations[0].orientation;
-						} else {
-							int r0Index = 0;
-							for (int i = 0; i < boneAnim.numRotations - 1; i++) {
-								if (m_CurrentTime < boneAnim.rotations[i + 1].timeStamp) {
-									r0Index = i;
-									break;
-								}
-							}
-							int   r1Index = r0Index + 1;
-							float t0 = boneAnim.rotations[r0Index].timeStamp;
-							float t1 = boneAnim.rotations[r1Index].timeStamp;
-							float factor = (m_CurrentTime - t0) / (t1 - t0);
-							rotation = glm::slerp(
-								boneAnim.rotations[r0Index].orientation,
-								boneAnim.rotations[r1Index].orientation,
-								factor
-							);
-						}
-					}
+	void Animator::EvaluatePose() {
+		const CompiledSkeleton& skeleton = *m_Skeleton;
 
-					// Interpolate Scale
-					glm::vec3 scale(1.0f);
-					if (boneAnim.numScalings > 0) {
-						if (boneAnim.numScalings == 1) {
-							scale = boneAnim.scales[0].scale;
-						} else {
-							int s0Index = 0;
-							for (int i = 0; i < boneAnim.numScalings - 1; i++) {
-								if (m_CurrentTime < boneAnim.scales[i + 1].timeStamp) {
-									s0Index = i;
-									break;
-								}
-							}
-							int   s1Index = s0Index + 1;
-							float t0 = boneAnim.scales[s0Index].timeStamp;
-							float t1 = boneAnim.scales[s1Index].timeStamp;
-							float factor = (m_CurrentTime - t0) / (t1 - t0);
-							scale = glm::mix(boneAnim.scales[s0Index].scale, boneAnim.scales[s1Index].scale, factor);
-						}
-					}
+		const Animation*        animation = nullptr;
+		const std::vector<int>* channels = nullptr;
+		if (HasValidAnimation()) {
+			animation = &m_ModelData->animations[m_CurrentAnimationIndex];
+			channels = &skeleton.channels[m_CurrentAnimationIndex];
+		}
 
-					nodeTransform = glm::translate(glm::mat4(1.0f), translation) * glm::toMat4(rotation) *
-						glm::scale(glm::mat4(1.0f), scale);
-					break;
-				}
+		for (size_t i = 0; i < skeleton.size(); ++i) {
+			glm::mat4 nodeTransform;
+			int       channel = channels ? (*channels)[i] : -1;
+			// Check for manual overrides first
+			if (m_HasOverride[i]) {
+				nodeTransform = m_LocalOverrides[i];
+			} else if (channel >= 0) {
+				nodeTransform = SampleChannel(animation->boneAnimations[channel], m_CurrentTime, m_Cursors[i]);
+			} else {
+				nodeTransform = skeleton.nodes[i]->transformation;
 			}
-		}
 
-		glm::mat4 globalTransformation = parentTransform * nodeTransform;
-		m_GlobalMatrices[nodeName] = globalTransformation;
+			int parent = skeleton.parents[i];
+			m_GlobalMatrices[i] = parent >= 0 ? m_GlobalMatrices[parent] * nodeTransform : nodeTransform;
 
-		auto it = m_ModelData->bone_info_map.find(nodeName);
-		if (it != m_ModelData->bone_info_map.end()) {
-			int       index = it->second.id;
-			glm::mat4 offset = it->second.offset;
-			if (index >= 0 && (size_t)index < (int)m_FinalBoneMatrices.size()) {
-				m_FinalBoneMatrices[index] = globalTransformation * offset;
-			}
-		} else {
-			// Robust name matching for Assimp/FBX.
-			// FBX often adds prefixes/suffixes or namespaces (e.g., "ModelName:BoneName")
-			// or Assimp might add "_$AssimpFbx$_"
-			auto cleanse = [](const std::string& name) {
-				std::string s = name;
-				// Remove FBX namespace prefix
-				size_t colon = s.find_last_of(':');
-				if (colon != std::string::npos)
-					s = s.substr(colon + 1);
-
-				// Remove Assimp FBX magic suffix
-				size_t magic = s.find("_$AssimpFbx$_");
-				if (magic != std::string::npos)
-					s = s.substr(0, magic);
-
-				return s;
-			};
-
-			std::string cleanNode = cleanse(nodeName);
-
-			for (auto const& [boneName, info] : m_ModelData->bone_info_map) {
-				if (cleanNode == cleanse(boneName)) {
-					int       index = info.id;
-					glm::mat4 offset = info.offset;
-					if (index >= 0 && (size_t)index < m_FinalBoneMatrices.size()) {
-						m_FinalBoneMatrices[index] = globalTransformation * offset;
-					}
-					break;
+			if (const BoneInfo* bone = skeleton.bones[i]) {
+				int index = bone->id;
+				if (index >= 0 && (size_t)index < m_FinalBoneMatrices.size()) {
+					m_FinalBoneMatrices[index] = m_GlobalMatrices[i] * bone->offset;
 				}
 			}
 		}
-
-		for (const auto& child : node.children) {
-			CalculateBoneTransform(child, globalTransformation);
-		}
 	}
 
 } // namespace Boidsish
@@ -8,6 +8,7 @@
 #include "mesh_optimizer_util.h"
 #include "miniaudio.h"
 #include "model.h"
+#include "model_cache.h"
 #include "profiler.h"
 #include "stb_image.h"
 #include "stb_image_write.h"
@@ -82,6 +83,61 @@ namespace Boidsish {
 			return nullptr;
 		}
 
+		// Uploads an Assimp embedded texture: height 0 means `data` is a compressed image of `width` bytes,
+		// otherwise it holds width * height BGRA8888 texels.
+		GLuint UploadEmbeddedTexture(const unsigned char* data, unsigned int width, unsigned int height, const char* name) {
+			GLuint id = 0;
+			if (height == 0) {
+				// Compressed texture (e.g. png, jpg)
+				// Force 4 components (RGBA) for consistency
+				int            w, h, nrComponents;
+				unsigned char* imageData = stbi_load_from_memory(data, width, &w, &h, &nrComponents, 4);
+				if (!imageData) {
+					logger::ERROR("Failed to load compressed embedded texture: {}", name);
+					return 0;
+				}
+
+				glGenTextures(1, &id);
+				glBindTexture(GL_TEXTURE_2D, id);
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, imageData);
+				stbi_image_free(imageData);
+				logger::LOG("Compressed embedded texture loaded: {}", name);
+			} else {
+				// Uncompressed texture (Assimp uses ARGB8888 or BGRA8888)
+				// Assimp documentation says: "Each pixel is stored in 32-bit (8 bits per channel)"
+				// Most common is BGRA.
+				glGenTextures(1, &id);
+				glBindTexture(GL_TEXTURE_2D, id);
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA, GL_UNSIGNED_BYTE, data);
+				logger::LOG("Raw embedded texture loaded: {} ({}x{})", name, width, height);
+			}
+			glGenerateMipmap(GL_TEXTURE_2D);
+
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			return id;
+		}
+
+		// Robust file-based texture lookup
+		GLuint LoadFileTexture(const std::string& texture_path, const std::string& directory) {
+			GLuint id = AssetManager::GetInstance().GetTexture(texture_path, directory);
+			if (id == 0) {
+				// Try resolving filename only in model directory
+				size_t      last_sep = texture_path.find_last_of("/\\");
+				std::string filename = (last_sep != std::string::npos) ? texture_path.substr(last_sep + 1)
+																	   : texture_path;
+				if (filename != texture_path) {
+					logger::LOG("Texture failed to load, trying fallback: {}/{}", directory, filename);
+					id = AssetManager::GetInstance().GetTexture(filename, directory);
+				}
+			}
+			return id;
+		}
+
 		std::vector<Texture> LoadMaterialTextures(
 			aiMaterial*        mat,
 			aiTextureType      type,
@@ -108,101 +164,21 @@ namespace Boidsish {
 				}
 				if (!skip) {
 					Texture texture;
+					texture.id = 0;
 					if (embeddedTexture) {
-						// Load embedded texture
-						int            width, height, nrComponents;
-						unsigned char* imageData = nullptr;
-						if (embeddedTexture->mHeight == 0) {
-							// Compressed texture (e.g. png, jpg)
-							// Force 4 components (RGBA) for consistency
-							imageData = stbi_load_from_memory(
-								reinterpret_cast<unsigned char*>(embeddedTexture->pcData),
-								embeddedTexture->mWidth,
-								&width,
-								&height,
-								&nrComponents,
-								4
-							);
-
-							if (imageData) {
-								glGenTextures(1, &texture.id);
-								GLenum format = GL_RGBA;
-
-								glBindTexture(GL_TEXTURE_2D, texture.id);
-								glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-								glTexImage2D(
-									GL_TEXTURE_2D,
-									0,
-									format,
-									width,
-									height,
-									0,
-									format,
-									GL_UNSIGNED_BYTE,
-									imageData
-								);
-								glGenerateMipmap(GL_TEXTURE_2D);
-
-								glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-								glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-								glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-								glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-								stbi_image_free(imageData);
-								logger::LOG("Compressed embedded texture loaded: {}", str.C_Str());
-							} else {
-								logger::ERROR("Failed to load compressed embedded texture: {}", str.C_Str());
-								texture.id = 0;
-							}
-						} else {
-							// Uncompressed texture (Assimp uses ARGB8888 or BGRA8888)
-							// Assimp documentation says: "Each pixel is stored in 32-bit (8 bits per channel)"
-							// Most common is BGRA.
-							glGenTextures(1, &texture.id);
-							glBindTexture(GL_TEXTURE_2D, texture.id);
-							glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-							glTexImage2D(
-								GL_TEXTURE_2D,
-								0,
-								GL_RGBA,
+						if (!AssetManager::GetInstance().IsHeadless()) {
+							texture.id = UploadEmbeddedTexture(
+								reinterpret_cast<const unsigned char*>(embeddedTexture->pcData),
 								embeddedTexture->mWidth,
 								embeddedTexture->mHeight,
-								0,
-								GL_BGRA,
-								GL_UNSIGNED_BYTE,
-								embeddedTexture->pcData
+								str.C_Str()
 							);
-							glGenerateMipmap(GL_TEXTURE_2D);
-
-							glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-							glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-							glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-							glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-							logger::LOG(
-								"Raw embedded texture loaded: {} ({}x{})",
-								str.C_Str(),
-								embeddedTexture->mWidth,
-								embeddedTexture->mHeight
-							);
-						}
-					} else {
-						// Robust file-based texture lookup
-						std::string texture_path = str.C_Str();
-						texture.id = AssetManager::GetInstance().GetTexture(texture_path, directory);
-
-						if (texture.id == 0) {
-							// Try resolving filename only in model directory
-							size_t      last_sep = texture_path.find_last_of("/\\");
-							std::string filename = (last_sep != std::string::npos) ? texture_path.substr(last_sep + 1)
-																				   : texture_path;
-							if (filename != texture_path) {
-								logger::LOG("Texture failed to load, trying fallback: {}/{}", directory, filename);
-								texture.id = AssetManager::GetInstance().GetTexture(filename, directory);
-							}
 						}
+					} else if (!AssetManager::GetInstance().IsHeadless()) {
+						texture.id = LoadFileTexture(str.C_Str(), directory);
 					}
-					if (texture.id != 0) {
+					// Headless imports keep the reference so it can be resolved when the cache is loaded
+					if (texture.id != 0 || AssetManager::GetInstance().IsHeadless()) {
 						texture.type = typeName;
 						texture.path = str.C_Str();
 						textures.push_back(texture);
@@ -429,6 +405,11 @@ namespace Boidsish {
 					MeshOptimizerUtil::GenerateShadowIndices(vertices, indices, shadow_indices);
 				}
 			}
+			std::vector<MeshLod> lods;
+			if (config.GetAppSettingBool("mesh_lod_enabled", true)) {
+				int levels = config.GetAppSettingInt("mesh_lod_count", 3);
+				MeshOptimizerUtil::GenerateLods(vertices, indices, lods, levels, data.model_path);
+			}
 
 			aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
 
@@ -514,7 +495,14 @@ namespace Boidsish {
 				LoadMaterialTextures(material, aiTextureType_DISPLACEMENT, "texture_height", data, directory, scene);
 			textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
 
-			Mesh out_mesh(vertices, indices, textures, shadow_indices);
+			Mesh out_mesh(
+				vertices,
+				indices,
+				textures,
+				shadow_indices,
+				std::move(lods),
+				MeshOptimizerUtil::ConfiguredVertexFormat()
+			);
 			out_mesh.has_vertex_colors = mesh->HasVertexColors(0);
 
 			aiColor3D color(1.0f, 1.0f, 1.0f);
@@ -892,6 +880,32 @@ namespace Boidsish {
 		}
 	} // namespace
 
+	namespace {
+		std::string DirectoryOf(const std::string& path) {
+			size_t last_slash = path.find_last_of("/\\");
+			return last_slash != std::string::npos ? path.substr(0, last_slash) : ".";
+		}
+
+		// Everything in ProcessMesh that changes the imported geometry must be part of this hash
+		uint64_t ImportOptionsHash() {
+			auto&       config = ConfigManager::GetInstance();
+			std::string options = std::to_string(config.GetAppSettingBool("mesh_simplifier_enabled", false)) + "|" +
+				std::to_string(config.GetAppSettingFloat("mesh_simplifier_error_prebuild", 0.01f)) + "|" +
+				std::to_string(config.GetAppSettingFloat("mesh_simplifier_target_ratio", 0.5f)) + "|" +
+				std::to_string(config.GetAppSettingInt("mesh_simplifier_aggression_prebuild", 0)) + "|" +
+				std::to_string(config.GetAppSettingBool("mesh_optimizer_enabled", true)) + "|" +
+				std::to_string(config.GetAppSettingBool("mesh_optimizer_shadow_indices_enabled", true)) + "|" +
+				std::to_string(config.GetAppSettingBool("mesh_lod_enabled", true)) + "|" +
+				std::to_string(config.GetAppSettingInt("mesh_lod_count", 3));
+			uint64_t hash = 0xcbf29ce484222325ull;
+			for (unsigned char c : options) {
+				hash ^= c;
+				hash *= 0x100000001b3ull;
+			}
+			return hash;
+		}
+	} // namespace
+
 	std::shared_ptr<ModelData> AssetManager::GetModelData(const std::string& path) {
 		PROJECT_PROFILE_SCOPE("AssetManager::GetModelData");
 		auto it = m_models.find(path);
@@ -899,6 +913,86 @@ namespace Boidsish {
 			return it->second;
 		}
 
+		std::shared_ptr<ModelData> data;
+		if (ConfigManager::GetInstance().GetAppSettingBool("model_cache_enabled", true)) {
+			data = LoadModelCache(path);
+			if (!data) {
+				data = ImportModel(path, ModelCache::CachePathFor(path));
+			}
+		} else {
+			data = ImportModel(path, "");
+		}
+
+		if (data) {
+			// Caches written with meshlets turned off have none
+			if (data->meshlets.empty() && ConfigManager::GetInstance().GetAppSettingBool("meshlets_enabled", false)) {
+				data->BuildMeshlets();
+			}
+			logger::LOG("Model cached: {} with {} meshes", path, data->meshes.size());
+			m_models[path] = data;
+		}
+		return data;
+	}
+
+	bool AssetManager::BuildModelCache(const std::string& path, const std::string& cache_path) {
+		bool written = false;
+		ImportModel(path, cache_path.empty() ? ModelCache::CachePathFor(path) : cache_path, &written);
+		return written;
+	}
+
+	std::shared_ptr<ModelData> AssetManager::LoadModelCache(const std::string& path) {
+		PROJECT_PROFILE_SCOPE("AssetManager::LoadModelCache");
+		std::string directory = DirectoryOf(path);
+
+		// Meshes sharing a texture get the same GL texture, as with textures_loaded during import
+		std::map<std::string, Texture> resolved;
+		auto resolve = [&](const ModelCache::TextureSource& source, unsigned int& id) {
+			auto found = resolved.find(source.path);
+			if (found != resolved.end()) {
+				id = found->second.id;
+				return true;
+			}
+
+			id = 0;
+			if (!m_headless) {
+				id = source.embedded
+					? UploadEmbeddedTexture(source.embedded, source.width, source.height, source.path.c_str())
+					: LoadFileTexture(source.path, directory);
+				if (id == 0) {
+					logger::WARNING("Texture failed to load and was skipped: {}", source.path);
+					return false;
+				}
+			}
+			resolved[source.path] = Texture{id, source.type, source.path};
+			return true;
+		};
+
+		auto data = ModelCache::Read(
+			ModelCache::CachePathFor(path),
+			path,
+			ImportOptionsHash(),
+			resolve,
+			MeshOptimizerUtil::ConfiguredVertexFormat()
+		);
+		if (!data)
+			return nullptr;
+
+		data->model_path = path;
+		data->directory = directory;
+		for (const auto& [texture_path, texture] : resolved) {
+			data->textures_loaded.push_back(texture);
+		}
+		logger::LOG(
+			"Model loaded from cache: {} ({} bones, {} animations)",
+			path,
+			data->bone_count,
+			data->animations.size()
+		);
+		return data;
+	}
+
+	std::shared_ptr<ModelData>
+	AssetManager::ImportModel(const std::string& path, const std::string& cache_path, bool* cache_written) {
 		logger::LOG("Model loading from disk: {}", path);
 		Assimp::Importer importer;
 		const aiScene*   scene = importer.ReadFile(
@@ -915,12 +1009,7 @@ namespace Boidsish {
 		auto data = std::make_shared<ModelData>();
 		data->model_path = path;
 		logger::LOG("Attempting to load model: {}", path);
-		size_t last_slash = path.find_last_of("/\\");
-		if (last_slash != std::string::npos) {
-			data->directory = path.substr(0, last_slash);
-		} else {
-			data->directory = ".";
-		}
+		data->directory = DirectoryOf(path);
 
 		data->global_inverse_transform = glm::mat4(1.0f); // Pre-transformed to root, so identity is fine
 
@@ -949,8 +1038,36 @@ namespace Boidsish {
 			data->aabb = AABB(glm::vec3(0.0f), glm::vec3(0.0f));
 		}
 
-		logger::LOG("Model cached: {} with {} meshes", path, data->meshes.size());
-		m_models[path] = data;
+		// Built before the cache is written, so loads from the cache skip it
+		if (ConfigManager::GetInstance().GetAppSettingBool("meshlets_enabled", false)) {
+			data->BuildMeshlets();
+		}
+
+		if (!cache_path.empty()) {
+			// Embedded textures only live in the scene, so their payloads go into the cache
+			std::vector<ModelCache::EmbeddedTexture> embedded;
+			for (const auto& texture : data->textures_loaded) {
+				const aiTexture* source = FindEmbeddedTexture(scene, texture.path.c_str());
+				if (!source)
+					continue;
+				ModelCache::EmbeddedTexture entry;
+				entry.key = texture.path;
+				entry.width = source->mWidth;
+				entry.height = source->mHeight;
+				size_t size = source->mHeight == 0 ? source->mWidth : size_t(source->mWidth) * source->mHeight * 4;
+				const unsigned char* bytes = reinterpret_cast<const unsigned char*>(source->pcData);
+				entry.bytes.assign(bytes, bytes + size);
+				embedded.push_back(std::move(entry));
+			}
+
+			bool written = ModelCache::Write(*data, embedded, path, ImportOptionsHash(), cache_path);
+			if (written) {
+				logger::LOG("Model cache written: {}", cache_path);
+			}
+			if (cache_written) {
+				*cache_written = written;
+			}
+		}
 		return data;
 	}
 
@@ -1008,6 +1125,10 @@ namespace Boidsish {
 			return it->second;
 		}
 
+		if (m_headless) {
+			return 0;
+		}
+
 		logger::LOG("Attempting to load texture: {}", fullPath);
 
 		unsigned int textureID;
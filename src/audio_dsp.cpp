@@ -0,0 +1,258 @@
+#include "audio_dsp.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace Boidsish {
+	namespace dsp {
+
+		namespace {
+			/**
+			 * Four-sample lookahead form of a two-state recurrence s[n] = A s[n-1] + B x[n].
+			 *
+			 * Expanded over a group of four samples every output depends only on the state before
+			 * the group, so the four outputs are independent of each other and the group costs a
+			 * few vector multiply-adds instead of four serially dependent steps.
+			 */
+			struct Lookahead {
+				float A[2][2];
+				float B[2];
+				int   row;                // State component that is the filter output
+				float state_gain[2][4];   // [i][k]: weight of s_i in output k
+				float input_gain[4][4];   // [j][k]: weight of x_j in output k
+				float next_gain[2][2];    // A^4
+				float next_input[2][4];   // [r][j]: weight of x_j in the next state's component r
+
+				Lookahead(float a00, float a01, float a10, float a11, float b0, float b1, int output_row):
+					A{{a00, a01}, {a10, a11}}, B{b0, b1}, row(output_row) {
+					float power[4][2][2]; // A^(k+1)
+					float impulse[4][2];  // A^m B
+					power[0][0][0] = a00;
+					power[0][0][1] = a01;
+					power[0][1][0] = a10;
+					power[0][1][1] = a11;
+					impulse[0][0] = b0;
+					impulse[0][1] = b1;
+					for (int k = 1; k < 4; ++k) {
+						for (int r = 0; r < 2; ++r) {
+							for (int c = 0; c < 2; ++c) {
+								power[k][r][c] = A[r][0] * power[k - 1][0][c] + A[r][1] * power[k - 1][1][c];
+							}
+							impulse[k][r] = A[r][0] * impulse[k - 1][0] + A[r][1] * impulse[k - 1][1];
+						}
+					}
+
+					for (int k = 0; k < 4; ++k) {
+						state_gain[0][k] = power[k][row][0];
+						state_gain[1][k] = power[k][row][1];
+						for (int j = 0; j < 4; ++j) {
+							input_gain[j][k] = j <= k ? impulse[k - j][row] : 0.0f;
+						}
+					}
+					for (int r = 0; r < 2; ++r) {
+						next_gain[r][0] = power[3][r][0];
+						next_gain[r][1] = power[3][r][1];
+						for (int j = 0; j < 4; ++j) {
+							next_input[r][j] = impulse[3 - j][r];
+						}
+					}
+				}
+
+				void Run(const float* in, float* out, uint32_t frames, float& state0, float& state1) const {
+					// Locals, so the state cannot alias the output
+					float    s0 = state0, s1 = state1;
+					uint32_t i = 0;
+					for (; i + 4 <= frames; i += 4) {
+						float x[4] = {in[i], in[i + 1], in[i + 2], in[i + 3]};
+
+						// Input terms first, they do not depend on the state
+						float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+						float n0 = 0.0f, n1 = 0.0f;
+						for (int j = 0; j < 4; ++j) {
+							for (int k = 0; k < 4; ++k) {
+								y[k] += input_gain[j][k] * x[j];
+							}
+							n0 += next_input[0][j] * x[j];
+							n1 += next_input[1][j] * x[j];
+						}
+
+						// State terms last, leaving two multiply-adds per group on the serial path
+						for (int k = 0; k < 4; ++k) {
+							y[k] += state_gain[0][k] * s0 + state_gain[1][k] * s1;
+						}
+						n0 += next_gain[0][0] * s0 + next_gain[0][1] * s1;
+						n1 += next_gain[1][0] * s0 + next_gain[1][1] * s1;
+						s0 = n0;
+						s1 = n1;
+						for (int k = 0; k < 4; ++k) {
+							out[i + k] = y[k];
+						}
+					}
+
+					// Remainder, one step at a time
+					for (; i < frames; ++i) {
+						float n0 = A[0][0] * s0 + A[0][1] * s1 + B[0] * in[i];
+						float n1 = A[1][0] * s0 + A[1][1] * s1 + B[1] * in[i];
+						s0 = n0;
+						s1 = n1;
+						out[i] = row == 0 ? s0 : s1;
+					}
+					state0 = s0;
+					state1 = s1;
+				}
+			};
+
+			inline float UnitNoise(uint32_t s) {
+				// Top 23 bits as the mantissa of a float in [1, 2), remapped to [-1, 1)
+				return std::bit_cast<float>((s >> 9) | 0x3F800000u) * 2.0f - 3.0f;
+			}
+
+			// Steps all lanes once per group of kLanes samples; the lane loop has no dependencies and vectorizes
+			template <bool kWithBits>
+			void FillLanes(uint32_t* lanes, float* out, uint32_t* bits, uint32_t frames) {
+				constexpr int kLanes = NoiseGenerator::kLanes;
+				alignas(32) uint32_t state[kLanes];
+				std::copy(lanes, lanes + kLanes, state);
+
+				for (uint32_t i = 0; i < frames; i += kLanes) {
+					alignas(32) uint32_t group[kLanes];
+					for (int l = 0; l < kLanes; ++l) {
+						uint32_t s = state[l];
+						s ^= s << 13;
+						s ^= s >> 17;
+						s ^= s << 5;
+						state[l] = s;
+						group[l] = s;
+					}
+
+					if (i + kLanes <= frames) {
+						for (int l = 0; l < kLanes; ++l) {
+							out[i + l] = UnitNoise(group[l]);
+							if constexpr (kWithBits) {
+								bits[i + l] = group[l];
+							}
+						}
+					} else {
+						for (uint32_t l = 0; l < frames - i; ++l) {
+							out[i + l] = UnitNoise(group[l]);
+							if constexpr (kWithBits) {
+								bits[i + l] = group[l];
+							}
+						}
+					}
+				}
+				std::copy(state, state + kLanes, lanes);
+			}
+		} // namespace
+
+		NoiseGenerator::NoiseGenerator(uint32_t seed) {
+			// Decorrelate the lanes with a splitmix-style hash of the seed
+			for (int l = 0; l < kLanes; ++l) {
+				uint32_t z = seed + 0x9E3779B9u * static_cast<uint32_t>(l + 1);
+				z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+				z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+				z ^= z >> 16;
+				m_state[l] = z ? z : 0x6D2B79F5u;
+			}
+		}
+
+		void NoiseGenerator::Fill(float* out, uint32_t* bits, uint32_t frames) {
+			if (bits) {
+				FillLanes<true>(m_state, out, bits, frames);
+			} else {
+				FillLanes<false>(m_state, out, bits, frames);
+			}
+		}
+
+		void OnePoleFilter::Lowpass(const float* in, float* out, uint32_t frames, float alpha) {
+			// Same lookahead expansion as the two-state filters, with a scalar state
+			float c = 1.0f - alpha;
+			float decay[4];     // c^(k+1)
+			float gain[4][4];   // [j][k]: weight of x_j in output k
+			for (int k = 0; k < 4; ++k) {
+				decay[k] = k == 0 ? c : decay[k - 1] * c;
+				for (int j = 0; j < 4; ++j) {
+					gain[j][k] = j <= k ? alpha * (k == j ? 1.0f : decay[k - j - 1]) : 0.0f;
+				}
+			}
+
+			float    s = m_low;
+			uint32_t i = 0;
+			for (; i + 4 <= frames; i += 4) {
+				float x[4] = {in[i], in[i + 1], in[i + 2], in[i + 3]};
+				float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+				for (int j = 0; j < 4; ++j) {
+					for (int k = 0; k < 4; ++k) {
+						y[k] += gain[j][k] * x[j];
+					}
+				}
+				for (int k = 0; k < 4; ++k) {
+					y[k] += decay[k] * s;
+					out[i + k] = y[k];
+				}
+				s = y[3];
+			}
+			for (; i < frames; ++i) {
+				s += alpha * (in[i] - s);
+				out[i] = s;
+			}
+			m_low = s;
+		}
+
+		void OnePoleFilter::Highpass(const float* in, float* out, uint32_t frames, float alpha) {
+			// Lowpass a block at a time through a stack buffer so in and out may still alias
+			float low[kBlockFrames];
+			for (uint32_t i = 0; i < frames; i += kBlockFrames) {
+				uint32_t count = std::min(kBlockFrames, frames - i);
+				Lowpass(in + i, low, count, alpha);
+				for (uint32_t k = 0; k < count; ++k) {
+					out[i + k] = in[i + k] - low[k];
+				}
+			}
+		}
+
+		void StateVariableFilter::Bandpass(const float* in, float* out, uint32_t frames, float cutoff, float damping) {
+			// low += f * band; high = x - low - d * band; band += f * high, written as one linear step
+			float     f = cutoff;
+			Lookahead filter(1.0f, f, -f, 1.0f - f * f - f * damping, 0.0f, f, 1);
+			filter.Run(in, out, frames, m_low, m_band);
+		}
+
+		void Scale(float* samples, uint32_t frames, float gain) {
+			for (uint32_t i = 0; i < frames; ++i) {
+				samples[i] *= gain;
+			}
+		}
+
+		void Interleave(
+			const float* const* planes,
+			uint32_t            plane_count,
+			float*              out,
+			uint32_t            channels,
+			uint32_t            frames
+		) {
+			if (plane_count == 0) {
+				std::fill(out, out + static_cast<size_t>(frames) * channels, 0.0f);
+				return;
+			}
+
+			if (channels == 2) {
+				const float* left = planes[0];
+				const float* right = planes[std::min<uint32_t>(1, plane_count - 1)];
+				for (uint32_t i = 0; i < frames; ++i) {
+					out[2 * i] = left[i];
+					out[2 * i + 1] = right[i];
+				}
+				return;
+			}
+
+			for (uint32_t c = 0; c < channels; ++c) {
+				const float* plane = planes[std::min(c, plane_count - 1)];
+				for (uint32_t i = 0; i < frames; ++i) {
+					out[static_cast<size_t>(i) * channels + c] = plane[i];
+				}
+			}
+		}
+
+	} // namespace dsp
+} // namespace Boidsish
@@ -46,10 +46,11 @@ namespace Boidsish {
 		std::thread                                   m_audio_thread;
 		std::atomic<bool>                             m_running{false};
 
-		AudioManagerImpl() {
+		explicit AudioManagerImpl(bool headless) {
 			ma_engine_config engineConfig = ma_engine_config_init();
 			engineConfig.channels = 2;
 			engineConfig.sampleRate = 48000;
+			engineConfig.noDevice = headless ? MA_TRUE : MA_FALSE;
 
 			ma_result result = ma_engine_init(&engineConfig, &engine);
 			if (result != MA_SUCCESS) {
@@ -151,7 +152,8 @@ namespace Boidsish {
 		}
 	};
 
-	AudioManager::AudioManager(ServiceLocator& /*loc*/): m_pimpl(std::make_unique<AudioManagerImpl>()) {}
+	AudioManager::AudioManager(ServiceLocator& /*loc*/, bool headless):
+		m_pimpl(std::make_unique<AudioManagerImpl>(headless)) {}
 
 	AudioManager::~AudioManager() = default;
 
@@ -221,6 +223,26 @@ namespace Boidsish {
 		return sound;
 	}
 
+	std::shared_ptr<Sound> AudioManager::CreateVoice(const std::string& filepath) {
+		if (!m_pimpl->initialized) return nullptr;
+
+		auto sound = std::make_shared<Sound>(
+			&m_pimpl->engine,
+			filepath,
+			false,
+			1.0f,
+			true,
+			glm::vec3(0.0f),
+			m_pimpl->groups_initialized ? &m_pimpl->sfx_group : nullptr,
+			MA_SOUND_FLAG_DECODE,
+			false
+		);
+
+		std::lock_guard<std::mutex> lock(m_pimpl->m_sounds_mutex);
+		m_pimpl->sounds.push_back(sound);
+		return sound;
+	}
+
 	std::shared_ptr<Sound> AudioManager::CreateProceduralSound(
 		std::shared_ptr<ProceduralAudioSource> source,
 		const glm::vec3&                       position,
@@ -306,4 +328,9 @@ namespace Boidsish {
 		m_pimpl->m_procedural_sources.clear();
 	}
 
+	void AudioManager::ReadFrames(float* out, uint32_t frame_count) {
+		if (!m_pimpl->initialized) return;
+		ma_engine_read_pcm_frames(&m_pimpl->engine, out, frame_count, NULL);
+	}
+
 } // namespace Boidsish
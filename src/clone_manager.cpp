@@ -5,16 +5,73 @@
 #include "service_locator.h"
 #include <vector>
 
+#include "constants.h"
 #include "profiler.h"
 #include "shader.h"
 #include "shape.h"
+#include <GL/glew.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/norm.hpp>
 
 namespace Boidsish {
 
+	namespace {
+		constexpr size_t kInitialGroupCapacity = 16;
+	}
+
+	void CloneManager::CloneGroup::Push(
+		const glm::mat4&             instance,
+		float                        creation_time,
+		std::shared_ptr<const Shape> source
+	) {
+		if (count == Capacity()) {
+			Grow();
+		}
+		size_t slot = Slot(count);
+		instances[slot] = instance;
+		sources[slot] = std::move(source);
+		creation_times[slot] = creation_time;
+		pos_x[slot] = instance[3].x;
+		pos_y[slot] = instance[3].y;
+		pos_z[slot] = instance[3].z;
+		++count;
+	}
+
+	void CloneManager::CloneGroup::Grow() {
+		// Double the ring and unroll it so the oldest clone lands in slot 0
+		size_t capacity = std::max(kInitialGroupCapacity, Capacity() * 2);
+		auto unroll = [&](auto& values) {
+			std::remove_reference_t<decltype(values)> grown(capacity);
+			for (size_t i = 0; i < count; ++i) {
+				grown[i] = values[Slot(i)];
+			}
+			return grown;
+		};
+		auto grown_instances = unroll(instances);
+		auto grown_sources = unroll(sources);
+		auto grown_times = unroll(creation_times);
+		auto grown_x = unroll(pos_x);
+		auto grown_y = unroll(pos_y);
+		auto grown_z = unroll(pos_z);
+		instances = std::move(grown_instances);
+		sources = std::move(grown_sources);
+		creation_times = std::move(grown_times);
+		pos_x = std::move(grown_x);
+		pos_y = std::move(grown_y);
+		pos_z = std::move(grown_z);
+		head = 0;
+	}
+
 	CloneManager::CloneManager(ServiceLocator& /*loc*/) {}
 
+	CloneManager::~CloneManager() {
+		for (auto& [key, group] : groups_) {
+			if (group.ssbo) {
+				glDeleteBuffers(1, &group.ssbo);
+			}
+		}
+	}
+
 	void CloneManager::CaptureClone(std::shared_ptr<const Shape> shape, float current_time) {
 		if (shape->GetId() < 0)
 			return;
@@ -24,54 +81,207 @@ namespace Boidsish {
 			return;
 		}
 
-		if (clones_.size() >= max_clones_global_) {
+		if (clone_count_ >= max_clones_global_) {
 			return;
 		}
 
 		last_capture_time_[shape->GetId()] = current_time;
 
-		CloneState new_clone;
-		new_clone.model_matrix = shape->GetModelMatrix();
-		new_clone.color = glm::vec3(shape->GetR(), shape->GetG(), shape->GetB());
-		new_clone.creation_time = current_time;
-		new_clone.shape_ptr = shape;
+		glm::mat4   instance = shape->GetModelMatrix();
+		std::string key = shape->GetInstanceKey();
+		bool        instanced = shape->IsMeshInstanceable();
+		if (instanced) {
+			// Model matrices are affine, so the bottom row is free to carry the clone's color and
+			// alpha. The material is per draw, so it has to match across the group.
+			instance[0][3] = shape->GetR();
+			instance[1][3] = shape->GetG();
+			instance[2][3] = shape->GetB();
+			instance[3][3] = shape->GetA();
+			if (shape->UsePBR()) {
+				key += "|pbr:" + std::to_string(shape->GetRoughness()) + "," + std::to_string(shape->GetMetallic()) +
+					"," + std::to_string(shape->GetAO());
+			}
+		}
+
+		auto& group = groups_[key];
+		if (!group.prototype) {
+			group.prototype = shape;
+			group.instanced = instanced;
+		}
+		group.Push(instance, current_time, shape);
+		++clone_count_;
+	}
+
+	size_t CloneManager::PruneDistant(CloneGroup& group, const glm::vec3& camera_pos) {
+		size_t n = group.count;
+		keep_.resize(n);
+
+		// The ring is at most two contiguous runs; each sweep is branch-free and vectorizes
+		size_t kept = 0;
+		auto sweep = [&](size_t begin, size_t length, uint8_t* keep) {
+			const float* x = group.pos_x.data() + begin;
+			const float* y = group.pos_y.data() + begin;
+			const float* z = group.pos_z.data() + begin;
+			size_t       inside = 0;
+			for (size_t i = 0; i < length; ++i) {
+				float dx = x[i] - camera_pos.x;
+				float dy = y[i] - camera_pos.y;
+				float dz = z[i] - camera_pos.z;
+				keep[i] = dx * dx + dy * dy + dz * dz <= prune_distance_squared_;
+				inside += keep[i];
+			}
+			kept += inside;
+		};
+		size_t first_run = std::min(n, group.Capacity() - group.head);
+		sweep(group.head, first_run, keep_.data());
+		sweep(0, n - first_run, keep_.data() + first_run);
 
-		clones_.push_back(new_clone);
+		if (kept == n) {
+			return 0;
+		}
+
+		// Close the gaps, keeping the survivors in creation order
+		size_t write = 0;
+		for (size_t read = 0; read < n; ++read) {
+			if (!keep_[read])
+				continue;
+			if (write != read) {
+				size_t from = group.Slot(read), to = group.Slot(write);
+				group.instances[to] = group.instances[from];
+				group.sources[to] = std::move(group.sources[from]);
+				group.creation_times[to] = group.creation_times[from];
+				group.pos_x[to] = group.pos_x[from];
+				group.pos_y[to] = group.pos_y[from];
+				group.pos_z[to] = group.pos_z[from];
+			}
+			++write;
+		}
+		for (size_t i = kept; i < n; ++i) {
+			group.sources[group.Slot(i)].reset();
+		}
+		group.count = kept;
+		return n - kept;
 	}
 
 	void CloneManager::Update(float current_time, const glm::vec3& camera_pos) {
 		PROJECT_PROFILE_SCOPE("CloneManager::Update");
-		clones_.erase(
-			std::remove_if(
-				clones_.begin(),
-				clones_.end(),
-				[&](const CloneState& clone) {
-					if (current_time - clone.creation_time > clone_lifespan_) {
-						return true;
-					}
-					glm::vec3 clone_pos = glm::vec3(clone.model_matrix[3]);
-					if (glm::length2(camera_pos - clone_pos) > prune_distance_squared_) {
-						return true;
-					}
-					return false;
-				}
-			),
-			clones_.end()
-		);
+		for (auto it = groups_.begin(); it != groups_.end();) {
+			auto& group = it->second;
 
-		if (clones_.size() > max_clones_global_) {
-			std::sort(clones_.begin(), clones_.end(), [](const CloneState& a, const CloneState& b) {
-				return a.creation_time > b.creation_time;
-			});
-			clones_.resize(max_clones_global_);
+			// Clones are pushed in capture order, so the expired ones are all at the front
+			size_t mask = group.Capacity() - 1;
+			while (group.count > 0 && current_time - group.creation_times[group.head] > clone_lifespan_) {
+				group.sources[group.head].reset();
+				group.head = (group.head + 1) & mask;
+				--group.count;
+				--clone_count_;
+			}
+
+			if (group.count > 0) {
+				clone_count_ -= PruneDistant(group, camera_pos);
+			}
+
+			if (group.count == 0) {
+				if (group.ssbo) {
+					glDeleteBuffers(1, &group.ssbo);
+				}
+				it = groups_.erase(it);
+			} else {
+				++it;
+			}
 		}
 	}
 
 	void CloneManager::Render(Shader& shader) {
 		shader.use();
-		for (const auto& clone : clones_) {
-			if (clone.shape_ptr) {
-				clone.shape_ptr->render(shader, clone.model_matrix);
+
+		// Shapes with their own render path draw each clone as the live shape would
+		for (auto& [key, group] : groups_) {
+			if (group.instanced)
+				continue;
+			for (size_t i = 0; i < group.count; ++i) {
+				size_t slot = group.Slot(i);
+				group.sources[slot]->render(shader, group.instances[slot]);
+			}
+		}
+
+		shader.setMat4("model", glm::mat4(1.0f));
+		shader.setBool("useSSBOInstancing", true);
+		shader.setBool("useInstanceColor", true);
+		shader.setInt("useVertexColor", 1);
+		shader.setBool("use_texture", false);
+		shader.setFloat("objectAlpha", 1.0f);
+
+		for (auto& [key, group] : groups_) {
+			if (group.instanced && group.count > 0) {
+				RenderInstanced(shader, group);
+			}
+		}
+
+		glBindVertexArray(0);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Constants::SsboBinding::DecorInstances(), 0);
+		shader.setBool("useSSBOInstancing", false);
+		shader.setBool("useInstanceColor", false);
+		shader.setInt("useVertexColor", 0);
+	}
+
+	void CloneManager::RenderInstanced(Shader& shader, CloneGroup& group) {
+		MeshInfo mesh = group.prototype->GetMeshInfo();
+		if (mesh.vao == 0)
+			return;
+
+		// Unroll the ring into upload order
+		staging_.resize(group.count);
+		for (size_t i = 0; i < group.count; ++i) {
+			staging_[i] = group.instances[group.Slot(i)];
+		}
+
+		size_t bytes = group.count * sizeof(glm::mat4);
+		if (!group.ssbo) {
+			glGenBuffers(1, &group.ssbo);
+		}
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, group.ssbo);
+		if (bytes > group.ssbo_capacity) {
+			group.ssbo_capacity = group.Capacity() * sizeof(glm::mat4);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, group.ssbo_capacity, nullptr, GL_DYNAMIC_DRAW);
+		}
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bytes, staging_.data());
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Constants::SsboBinding::DecorInstances(), group.ssbo);
+
+		// Color and alpha travel per instance; the material is shared by the group's key
+		const Shape& prototype = *group.prototype;
+		shader.setBool("usePBR", prototype.UsePBR());
+		if (prototype.UsePBR()) {
+			shader.setFloat("roughness", prototype.GetRoughness());
+			shader.setFloat("metallic", prototype.GetMetallic());
+			shader.setFloat("ao", prototype.GetAO());
+		}
+
+		GLsizei instances = static_cast<GLsizei>(group.count);
+		glBindVertexArray(mesh.vao);
+		if (mesh.allocation.valid) {
+			if (mesh.index_count > 0) {
+				glDrawElementsInstancedBaseVertex(
+					mesh.draw_mode,
+					mesh.index_count,
+					GL_UNSIGNED_INT,
+					(void*)(uintptr_t)(mesh.allocation.first_index * sizeof(unsigned int)),
+					instances,
+					mesh.allocation.base_vertex
+				);
+			} else {
+				glDrawArraysInstanced(
+					mesh.draw_mode,
+					(GLint)mesh.allocation.base_vertex,
+					(GLsizei)mesh.vertex_count,
+					instances
+				);
+			}
+		} else {
+			if (mesh.index_count > 0) {
+				glDrawElementsInstanced(mesh.draw_mode, mesh.index_count, GL_UNSIGNED_INT, 0, instances);
+			} else {
+				glDrawArraysInstanced(mesh.draw_mode, 0, mesh.vertex_count, instances);
 			}
 		}
 	}
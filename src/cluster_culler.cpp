@@ -0,0 +1,68 @@
+#include "cluster_culler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "model.h"
+
+namespace Boidsish {
+
+	ClusterCullStats ClusterCuller::Cull(
+		const MeshletData&     meshlets,
+		const glm::mat4&       model_matrix,
+		const Frustum&         frustum,
+		const glm::vec3&       camera_pos,
+		std::vector<uint32_t>& out_visible
+	) {
+		ClusterCullStats stats;
+		stats.meshlets = meshlets.meshlets.size();
+
+		const glm::mat3 linear(model_matrix);
+		const glm::vec3 scales(glm::length(linear[0]), glm::length(linear[1]), glm::length(linear[2]));
+		const float     max_scale = std::max({scales.x, scales.y, scales.z});
+		const float     min_scale = std::min({scales.x, scales.y, scales.z});
+		const bool      test_cones = max_scale > 0.0f && max_scale - min_scale <= max_scale * 1e-3f;
+
+		for (uint32_t i = 0; i < meshlets.meshlets.size(); ++i) {
+			const Meshlet& meshlet = meshlets.meshlets[i];
+
+			glm::vec3 center = glm::vec3(model_matrix * glm::vec4(meshlet.center, 1.0f));
+			if (!frustum.IsSphereInFrustum(center, meshlet.radius * max_scale)) {
+				++stats.frustum_culled;
+				continue;
+			}
+
+			if (test_cones && meshlet.cone_cutoff < 1.0f) {
+				glm::vec3 apex = glm::vec3(model_matrix * glm::vec4(meshlet.cone_apex, 1.0f));
+				glm::vec3 axis = linear * meshlet.cone_axis / max_scale;
+				glm::vec3 view = apex - camera_pos;
+				float     distance = glm::length(view);
+				if (distance > 0.0f && glm::dot(view, axis) >= meshlet.cone_cutoff * distance) {
+					++stats.cone_culled;
+					continue;
+				}
+			}
+
+			out_visible.push_back(i);
+			stats.triangles += meshlet.triangle_count;
+		}
+		return stats;
+	}
+
+	ClusterCullStats ClusterCuller::Cull(
+		const ModelData&                    data,
+		const glm::mat4&                    model_matrix,
+		const Frustum&                      frustum,
+		const glm::vec3&                    camera_pos,
+		std::vector<std::vector<uint32_t>>& out_visible
+	) {
+		ClusterCullStats stats;
+		out_visible.resize(data.meshlets.size());
+		for (size_t m = 0; m < data.meshlets.size(); ++m) {
+			out_visible[m].clear();
+			stats += Cull(data.meshlets[m], model_matrix, frustum, camera_pos, out_visible[m]);
+		}
+		return stats;
+	}
+
+} // namespace Boidsish
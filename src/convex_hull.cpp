@@ -0,0 +1,233 @@
+#include "convex_hull.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Boidsish {
+
+	void ConvexHull::Clear() {
+		points_.clear();
+		faces_.clear();
+		triangles_.clear();
+		epsilon_ = 0.0;
+		round_ = 0;
+	}
+
+	void ConvexHull::Build(const std::vector<glm::vec3>& points) {
+		Clear();
+		if (points.size() < 4)
+			return;
+
+		points_.assign(points.begin(), points.end());
+
+		// Inputs are floats, so coplanarity is only known to float precision at their magnitude
+		glm::dvec3 max_abs(0.0);
+		for (const auto& p : points_) {
+			max_abs = glm::max(max_abs, glm::abs(p));
+		}
+		epsilon_ = (max_abs.x + max_abs.y + max_abs.z) * 8.0 * FLT_EPSILON;
+
+		if (!BuildInitialTetrahedron()) {
+			faces_.clear();
+			return;
+		}
+
+		// New faces are appended, so this reaches them too
+		for (int f = 0; f < static_cast<int>(faces_.size()); ++f) {
+			if (!faces_[f].alive || faces_[f].outside.empty())
+				continue;
+
+			int    eye = -1;
+			double farthest = 0.0;
+			for (int p : faces_[f].outside) {
+				double d = Distance(faces_[f], p);
+				if (d > farthest) {
+					farthest = d;
+					eye = p;
+				}
+			}
+			AddPoint(eye, f);
+		}
+
+		for (const auto& face : faces_) {
+			if (face.alive) {
+				triangles_.push_back(face.v);
+			}
+		}
+	}
+
+	int ConvexHull::AddFace(int a, int b, int c) {
+		Face face;
+		face.v = {a, b, c};
+		face.neighbors = {-1, -1, -1};
+		face.normal = glm::normalize(glm::cross(points_[b] - points_[a], points_[c] - points_[a]));
+		face.offset = glm::dot(face.normal, points_[a]);
+		faces_.push_back(std::move(face));
+		return static_cast<int>(faces_.size()) - 1;
+	}
+
+	bool ConvexHull::BuildInitialTetrahedron() {
+		const int count = static_cast<int>(points_.size());
+
+		// The two farthest apart of the extreme points along each axis
+		std::array<int, 6> extremes = {0, 0, 0, 0, 0, 0};
+		for (int i = 1; i < count; ++i) {
+			for (int axis = 0; axis < 3; ++axis) {
+				if (points_[i][axis] < points_[extremes[axis * 2]][axis])
+					extremes[axis * 2] = i;
+				if (points_[i][axis] > points_[extremes[axis * 2 + 1]][axis])
+					extremes[axis * 2 + 1] = i;
+			}
+		}
+		int    a = 0, b = 0;
+		double best = 0.0;
+		for (int i = 0; i < 6; ++i) {
+			for (int j = i + 1; j < 6; ++j) {
+				glm::dvec3 d = points_[extremes[j]] - points_[extremes[i]];
+				if (glm::dot(d, d) > best) {
+					best = glm::dot(d, d);
+					a = extremes[i];
+					b = extremes[j];
+				}
+			}
+		}
+		if (best <= epsilon_ * epsilon_)
+			return false;
+
+		// Farthest from the line ab
+		glm::dvec3 ab = glm::normalize(points_[b] - points_[a]);
+		int        c = -1;
+		best = epsilon_ * epsilon_;
+		for (int i = 0; i < count; ++i) {
+			glm::dvec3 d = points_[i] - points_[a];
+			glm::dvec3 off_line = d - ab * glm::dot(d, ab);
+			if (glm::dot(off_line, off_line) > best) {
+				best = glm::dot(off_line, off_line);
+				c = i;
+			}
+		}
+		if (c < 0)
+			return false;
+
+		// Farthest from the plane abc
+		glm::dvec3 n = glm::normalize(glm::cross(points_[b] - points_[a], points_[c] - points_[a]));
+		int        d = -1;
+		best = epsilon_;
+		for (int i = 0; i < count; ++i) {
+			double distance = std::abs(glm::dot(n, points_[i] - points_[a]));
+			if (distance > best) {
+				best = distance;
+				d = i;
+			}
+		}
+		if (d < 0)
+			return false;
+
+		// Wind abc away from d, then the other faces follow
+		if (glm::dot(n, points_[d] - points_[a]) > 0.0)
+			std::swap(b, c);
+		AddFace(a, b, c);
+		AddFace(a, d, b);
+		AddFace(b, d, c);
+		AddFace(c, d, a);
+
+		for (int f = 0; f < 4; ++f) {
+			for (int i = 0; i < 3; ++i) {
+				int from = faces_[f].v[i], to = faces_[f].v[(i + 1) % 3];
+				for (int g = 0; g < 4; ++g) {
+					for (int j = 0; j < 3; ++j) {
+						if (faces_[g].v[j] == to && faces_[g].v[(j + 1) % 3] == from)
+							faces_[f].neighbors[i] = g;
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < count; ++i) {
+			if (i == a || i == b || i == c || i == d)
+				continue;
+			for (int f = 0; f < 4; ++f) {
+				if (Distance(faces_[f], i) > epsilon_) {
+					faces_[f].outside.push_back(i);
+					break;
+				}
+			}
+		}
+		return true;
+	}
+
+	void ConvexHull::CollectHorizon(int eye, int face) {
+		visible_.clear();
+		horizon_.clear();
+
+		faces_[face].visit = round_;
+		faces_[face].visible = true;
+		std::vector<int> stack = {face};
+		while (!stack.empty()) {
+			int f = stack.back();
+			stack.pop_back();
+			visible_.push_back(f);
+
+			for (int i = 0; i < 3; ++i) {
+				int   n = faces_[f].neighbors[i];
+				Face& neighbor = faces_[n];
+				if (neighbor.visit != round_) {
+					neighbor.visit = round_;
+					neighbor.visible = Distance(neighbor, eye) > epsilon_;
+					if (neighbor.visible) {
+						stack.push_back(n);
+						continue;
+					}
+				}
+				if (!neighbor.visible) {
+					horizon_.push_back({faces_[f].v[i], faces_[f].v[(i + 1) % 3], n});
+				}
+			}
+		}
+	}
+
+	void ConvexHull::AddPoint(int eye, int face) {
+		++round_;
+		CollectHorizon(eye, face);
+
+		// Fan the horizon to the eye: face (from, to, eye) keeps the remaining face across from -> to
+		new_faces_.clear();
+		face_from_.clear();
+		for (const auto& edge : horizon_) {
+			int f = AddFace(edge.from, edge.to, eye);
+			faces_[f].neighbors[0] = edge.face;
+			for (int j = 0; j < 3; ++j) {
+				Face& beyond = faces_[edge.face];
+				if (beyond.v[j] == edge.to && beyond.v[(j + 1) % 3] == edge.from)
+					beyond.neighbors[j] = f;
+			}
+			new_faces_.push_back(f);
+			face_from_[edge.from] = f;
+		}
+		for (int f : new_faces_) {
+			// Edge to -> eye borders the new face that starts at to, across its edge eye -> to
+			int next = face_from_[faces_[f].v[1]];
+			faces_[f].neighbors[1] = next;
+			faces_[next].neighbors[2] = f;
+		}
+
+		// Hand the removed faces' points to the new faces; points above none of them are inside
+		for (int v : visible_) {
+			Face& removed = faces_[v];
+			removed.alive = false;
+			for (int p : removed.outside) {
+				if (p == eye)
+					continue;
+				for (int f : new_faces_) {
+					if (Distance(faces_[f], p) > epsilon_) {
+						faces_[f].outside.push_back(p);
+						break;
+					}
+				}
+			}
+			std::vector<int>().swap(removed.outside);
+		}
+	}
+
+} // namespace Boidsish
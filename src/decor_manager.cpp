@@ -1,6 +1,7 @@
 #include "decor_manager.h"
 
 #include <algorithm>
+#include <numeric>
 
 #include "shadow_manager.h"
 #include "service_locator.h"
@@ -12,13 +13,17 @@
 #include "geometry.h"
 #include "graphics.h"
 #include "logger.h"
+#include "procedural_asset_cache.h"
 #include "profiler.h"
+#include "terrain.h"
 #include "terrain_generator_interface.h"
 #include "terrain_render_manager.h"
+#include "thread_pool.h"
 #include <GL/glew.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
+#include <poolstl/poolstl.hpp>
 
 namespace Boidsish {
 
@@ -111,6 +116,7 @@ namespace Boidsish {
 		DecorType type;
 		type.model = model;
 		type.props = props;
+		placed_chunk_decor_.clear();
 
 		// Main instance storage (persistent)
 		glGenBuffers(1, &type.ssbo);
@@ -168,8 +174,18 @@ namespace Boidsish {
 		float variant_min_density = props.min_density / variants;
 		float variant_max_density = props.max_density / variants;
 
-		for (int i = 0; i < variants; ++i) {
-			auto            model = ProceduralGenerator::Generate(type, 1337 + i);
+		std::vector<unsigned int> seeds(variants);
+		std::iota(seeds.begin(), seeds.end(), 1337u);
+
+		std::optional<ProceduralAssetCache> cache;
+		if (ConfigManager::GetInstance().GetAppSettingBool("model_cache_enabled", true)) {
+			cache.emplace();
+		}
+		auto models = ProceduralGenerator::GenerateVariants(type, seeds, cache ? &*cache : nullptr);
+
+		for (auto& model : models) {
+			if (!model)
+				continue;
 			DecorProperties variant_props = props;
 			variant_props.min_density = variant_min_density;
 			variant_props.max_density = variant_max_density;
@@ -337,6 +353,24 @@ namespace Boidsish {
 		return props;
 	}
 
+	DecorTypeGPU DecorManager::_MakeTypeParams(size_t type_index) const {
+		const auto&  t = decor_types_[type_index];
+		DecorTypeGPU g;
+		g.density_scale =
+			glm::vec4(t.props.min_density, t.props.max_density, t.props.base_scale, t.props.scale_variance);
+		g.height_slope = glm::vec4(t.props.min_height, t.props.max_height, t.props.min_slope, t.props.max_slope);
+		g.rotation = glm::vec4(glm::radians(t.props.base_rotation), t.props.detail_distance);
+		g.aabb_min = glm::vec4(t.model->GetData()->aabb.min, 0.0f);
+		g.aabb_max = glm::vec4(t.model->GetData()->aabb.max, 0.0f);
+		g.flags = glm::uvec4(
+			static_cast<uint32_t>(t.props.biomes),
+			t.props.random_yaw ? 1u : 0u,
+			t.props.align_to_terrain ? 1u : 0u,
+			static_cast<uint32_t>(type_index)
+		);
+		return g;
+	}
+
 	void DecorManager::PrepareResources(Megabuffer* mb) {
 		for (auto& type : decor_types_) {
 			if (mb) {
@@ -401,20 +435,7 @@ namespace Boidsish {
 		static constexpr int      kMaxDecorTypes = 32;
 		std::vector<DecorTypeGPU> gpu_types(decor_types_.size());
 		for (size_t i = 0; i < decor_types_.size(); ++i) {
-			auto& t = decor_types_[i];
-			auto& g = gpu_types[i];
-			g.density_scale =
-				glm::vec4(t.props.min_density, t.props.max_density, t.props.base_scale, t.props.scale_variance);
-			g.height_slope = glm::vec4(t.props.min_height, t.props.max_height, t.props.min_slope, t.props.max_slope);
-			g.rotation = glm::vec4(glm::radians(t.props.base_rotation), t.props.detail_distance);
-			g.aabb_min = glm::vec4(t.model->GetData()->aabb.min, 0.0f);
-			g.aabb_max = glm::vec4(t.model->GetData()->aabb.max, 0.0f);
-			g.flags = glm::uvec4(
-				static_cast<uint32_t>(t.props.biomes),
-				t.props.random_yaw ? 1u : 0u,
-				t.props.align_to_terrain ? 1u : 0u,
-				static_cast<uint32_t>(i)
-			);
+			gpu_types[i] = _MakeTypeParams(i);
 		}
 
 		if (decor_props_ubo_ == 0) {
@@ -789,137 +810,92 @@ namespace Boidsish {
 		float world_scale = terrain_gen.GetWorldScale();
 		auto  all_chunks = render_manager->GetDecorChunkData(world_scale);
 
-		// 1. Find the chunk data for the requested keys
-		std::vector<TerrainRenderManager::DecorChunkData> requested_chunk_data;
+		std::erase_if(placed_chunk_decor_, [](const auto& entry) { return entry.second.terrain.expired(); });
+
+		// 1. Find the requested chunks and the ones whose decor is not cached
+		struct PlacementJob {
+			const TerrainRenderManager::DecorChunkData* chunk;
+			const Terrain*                              terrain;
+			PlacedChunkDecor*                           placed;
+			int                                         type_index;
+		};
+
+		const int                      num_types = static_cast<int>(decor_types_.size());
+		std::vector<PlacedChunkDecor*> requested;
+		std::vector<PlacementJob>      jobs;
 		for (const auto& key : chunk_keys) {
 			auto it = std::find_if(all_chunks.begin(), all_chunks.end(), [&](const auto& cd) { return cd.key == key; });
-			if (it != all_chunks.end()) {
-				requested_chunk_data.push_back(*it);
+			if (it == all_chunks.end())
+				continue;
+
+			// Resident, not just visible: off-screen chunks are queried as well
+			auto terrain = terrain_gen.GetResidentChunk(key);
+			if (!terrain)
+				continue;
+
+			PlacedChunkDecor& placed = placed_chunk_decor_[key];
+			if (placed.terrain.lock() != terrain || placed.world_scale != world_scale) {
+				placed.terrain = terrain;
+				placed.world_scale = world_scale;
+				placed.instances.assign(num_types, {});
+				for (int i = 0; i < num_types; ++i) {
+					jobs.push_back({&*it, terrain.get(), &placed, i});
+				}
 			}
+			requested.push_back(&placed);
 		}
 
-		if (requested_chunk_data.empty())
+		if (requested.empty())
 			return {};
 
-		int num_requested_chunks = (int)requested_chunk_data.size();
-
-		// 2. Prepare temporary GPU resources
-		GLuint temp_instance_ssbo;
-		glGenBuffers(1, &temp_instance_ssbo);
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, temp_instance_ssbo);
-		glBufferData(
-			GL_SHADER_STORAGE_BUFFER,
-			num_requested_chunks * kInstancesPerChunk * sizeof(glm::mat4),
-			nullptr,
-			GL_DYNAMIC_DRAW
-		);
-
-		GLuint temp_chunk_params_ssbo;
-		glGenBuffers(1, &temp_chunk_params_ssbo);
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, temp_chunk_params_ssbo);
-		std::vector<ChunkParamsGPU> chunk_gpu(num_requested_chunks);
-		for (int i = 0; i < num_requested_chunks; ++i) {
-			const auto& cd = requested_chunk_data[i];
-			chunk_gpu[i].offset_slice_size = glm::vec4(cd.world_offset, cd.slice, cd.chunk_size);
-			chunk_gpu[i].indices = glm::ivec4(i * kInstancesPerChunk, 0, 0, 0);
-		}
-		glBufferData(
-			GL_SHADER_STORAGE_BUFFER,
-			num_requested_chunks * sizeof(ChunkParamsGPU),
-			chunk_gpu.data(),
-			GL_STREAM_DRAW
-		);
-
+		// 2. Place the missing decor on the thread pool, one chunk and type per task.
+		// A dummy camera at the origin with large distances places all decor, as the GPU query did.
 		PlacementGlobalsGPU globals;
-		// Use a dummy camera position and large distances to ensure all decor is generated.
-		// Avoid equal values for falloff parameters to prevent smoothstep(a, a, x) issues.
 		globals.camera_and_scale = glm::vec4(0.0f, 0.0f, world_scale, terrain_gen.GetMaxHeight());
 		globals.distance_params = glm::vec4(1e6f, 2e6f, 3e6f, (float)kMaxInstancesPerType);
 
-		GLuint temp_globals_ubo;
-		glGenBuffers(1, &temp_globals_ubo);
-		glBindBuffer(GL_UNIFORM_BUFFER, temp_globals_ubo);
-		glBufferData(GL_UNIFORM_BUFFER, sizeof(PlacementGlobalsGPU), &globals, GL_STREAM_DRAW);
-
-		// 3. Dispatch placement for each type
-		placement_shader_->use();
-		glActiveTexture(GL_TEXTURE0 + Constants::TextureUnit::TerrainHeightmap());
-		glBindTexture(GL_TEXTURE_2D_ARRAY, render_manager->GetHeightmapTexture());
-		placement_shader_->setInt("u_heightmapArray", Constants::TextureUnit::TerrainHeightmap());
-
-		glActiveTexture(GL_TEXTURE0 + Constants::TextureUnit::TerrainBiomeMap());
-		glBindTexture(GL_TEXTURE_2D_ARRAY, render_manager->GetBiomeTexture());
-		placement_shader_->setInt("u_biomeMap", Constants::TextureUnit::TerrainBiomeMap());
-
-		glBindBufferBase(GL_UNIFORM_BUFFER, Constants::UboBinding::DecorProps(), decor_props_ubo_);
-		glBindBufferBase(GL_UNIFORM_BUFFER, Constants::UboBinding::DecorPlacementGlobals(), temp_globals_ubo);
-		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Constants::SsboBinding::DecorChunkParams(), temp_chunk_params_ssbo);
-		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, Constants::SsboBinding::DecorAllInstances(), temp_instance_ssbo);
-
-		int                           num_types = (int)decor_types_.size();
-		std::vector<DecorTypeResults> results(num_types);
-		size_t                        instances_per_type = num_requested_chunks * kInstancesPerChunk;
-
-		// Re-allocate temp buffer if it's too small for all types
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, temp_instance_ssbo);
-		glBufferData(
-			GL_SHADER_STORAGE_BUFFER,
-			num_types * instances_per_type * sizeof(glm::mat4),
-			nullptr,
-			GL_DYNAMIC_DRAW
-		);
-
+		std::vector<DecorTypeGPU> type_params(num_types);
 		for (int i = 0; i < num_types; ++i) {
-			results[i].model_path = decor_types_[i].model->GetModelPath();
-
-			// Update chunk params for this type's offset
-			for (int j = 0; j < num_requested_chunks; ++j) {
-				const auto& cd = requested_chunk_data[j];
-				chunk_gpu[j].indices.x = (i * num_requested_chunks + j) * kInstancesPerChunk;
-			}
-			glBindBuffer(GL_SHADER_STORAGE_BUFFER, temp_chunk_params_ssbo);
-			glBufferSubData(
-				GL_SHADER_STORAGE_BUFFER,
-				0,
-				num_requested_chunks * sizeof(ChunkParamsGPU),
-				chunk_gpu.data()
-			);
-
-			placement_shader_->setInt("u_typeIndex", i);
-			int dispatch_size = (Constants::Class::Terrain::ChunkSize() + 7) / 8;
-			glDispatchCompute(dispatch_size, dispatch_size, num_requested_chunks);
+			type_params[i] = _MakeTypeParams(i);
 		}
 
-		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
-
-		// 4. Single read back and process
-		std::vector<glm::mat4> all_matrices(num_types * instances_per_type);
-		glBindBuffer(GL_SHADER_STORAGE_BUFFER, temp_instance_ssbo);
-		glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, all_matrices.size() * sizeof(glm::mat4), all_matrices.data());
-
-		for (int i = 0; i < num_types; ++i) {
-			for (size_t j = 0; j < instances_per_type; ++j) {
-				const auto& m = all_matrices[i * instances_per_type + j];
-				if (m[3][3] < 0.5f)
-					continue; // Not a valid instance (scale is 0)
+		std::for_each(poolstl::par.on(pool), jobs.begin(), jobs.end(), [&](const PlacementJob& job) {
+			std::vector<glm::mat4> matrices;
+			DecorPlacement::PlaceInChunk(
+				job.terrain->surface,
+				type_params[job.type_index],
+				job.type_index,
+				job.chunk->world_offset,
+				job.chunk->chunk_size,
+				Constants::Class::Terrain::ChunkSize(),
+				globals,
+				matrices
+			);
 
+			const AABB& model_aabb = decor_types_[job.type_index].model->GetData()->aabb;
+			auto&       instances = job.placed->instances[job.type_index];
+			instances.reserve(matrices.size());
+			for (const auto& m : matrices) {
 				DecorInstance inst;
 				glm::vec3     skew;
 				glm::vec4     perspective;
 				glm::decompose(m, inst.scale, inst.rotation, inst.center, skew, perspective);
 
 				// Calculate world-space AABB
-				inst.aabb = decor_types_[i].model->GetData()->aabb.Transform(m);
+				inst.aabb = model_aabb.Transform(m);
+				instances.push_back(inst);
+			}
+		});
 
-				results[i].instances.push_back(inst);
+		// 3. Gather per type, in request order
+		std::vector<DecorTypeResults> results(num_types);
+		for (int i = 0; i < num_types; ++i) {
+			results[i].model_path = decor_types_[i].model->GetModelPath();
+			for (const PlacedChunkDecor* placed : requested) {
+				const auto& instances = placed->instances[i];
+				results[i].instances.insert(results[i].instances.end(), instances.begin(), instances.end());
 			}
 		}
-
-		// 5. Cleanup
-		glDeleteBuffers(1, &temp_instance_ssbo);
-		glDeleteBuffers(1, &temp_chunk_params_ssbo);
-		glDeleteBuffers(1, &temp_globals_ubo);
-
 		return results;
 	}
 
@@ -0,0 +1,278 @@
+#include "decor_placement.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "terrain_chunk_data.h"
+
+namespace Boidsish {
+	namespace DecorPlacement {
+
+		namespace {
+			template <typename T>
+			T Mod289(const T& x) {
+				return x - glm::floor(x * (1.0f / 289.0f)) * 289.0f;
+			}
+
+			glm::vec3 Permute(const glm::vec3& v) {
+				return Mod289(((v * 34.0f) + 1.0f) * v);
+			}
+
+			// Build rotation matrix from Euler angles, as rotationFromEuler in the shader
+			glm::mat3 RotationFromEuler(const glm::vec3& angles) {
+				float cx = std::cos(angles.x), sx = std::sin(angles.x);
+				float cy = std::cos(angles.y), sy = std::sin(angles.y);
+				float cz = std::cos(angles.z), sz = std::sin(angles.z);
+
+				glm::mat3 rx(1, 0, 0, 0, cx, -sx, 0, sx, cx);
+				glm::mat3 ry(cy, 0, sy, 0, 1, 0, -sy, 0, cy);
+				glm::mat3 rz(cz, -sz, 0, sz, cz, 0, 0, 0, 1);
+
+				return ry * rx * rz; // YXZ order (typical for games)
+			}
+
+			// What a linearly filtered, clamp-to-edge texture fetch returns at the shader's remapped UV
+			struct SurfaceSample {
+				float     height;
+				glm::vec3 normal; // Interpolated, not renormalized
+				float     biome_low;
+				float     biome_t;
+			};
+
+			SurfaceSample Sample(const TerrainChunkData& surface, const glm::vec2& uv, int grid_size) {
+				// remappedUV = (uv * N + 0.5) / (N + 1) puts texel centers at uv * N
+				glm::vec2 texel = uv * static_cast<float>(grid_size);
+				glm::vec2 base = glm::floor(texel);
+				glm::vec2 f = texel - base;
+				int       x0 = std::clamp(static_cast<int>(base.x), 0, grid_size);
+				int       z0 = std::clamp(static_cast<int>(base.y), 0, grid_size);
+				int       x1 = std::min(x0 + 1, grid_size);
+				int       z1 = std::min(z0 + 1, grid_size);
+
+				auto fetch = [&](int x, int z) {
+					glm::vec2 biome = surface.GetBiome(x, z);
+					return SurfaceSample{surface.GetHeight(x, z), surface.GetNormal(x, z), biome.x / 255.0f, biome.y};
+				};
+				auto mix = [](const SurfaceSample& a, const SurfaceSample& b, float t) {
+					return SurfaceSample{
+						glm::mix(a.height, b.height, t),
+						glm::mix(a.normal, b.normal, t),
+						glm::mix(a.biome_low, b.biome_low, t),
+						glm::mix(a.biome_t, b.biome_t, t)
+					};
+				};
+				return mix(mix(fetch(x0, z0), fetch(x1, z0), f.x), mix(fetch(x0, z1), fetch(x1, z1), f.x), f.y);
+			}
+		} // namespace
+
+		float Hash(uint32_t x) {
+			x = ((x >> 16) ^ x) * 0x45d9f3bu;
+			x = ((x >> 16) ^ x) * 0x45d9f3bu;
+			x = (x >> 16) ^ x;
+			return static_cast<float>(x) / 4294967295.0f;
+		}
+
+		float SimplexNoise(const glm::vec2& v) {
+			const glm::vec4 C(
+				0.211324865405187f,  // (3.0-sqrt(3.0))/6.0
+				0.366025403784439f,  // 0.5*(sqrt(3.0)-1.0)
+				-0.577350269189626f, // -1.0 + 2.0 * C.x
+				0.024390243902439f   // 1.0 / 41.0
+			);
+
+			// First corner
+			glm::vec2 i = glm::floor(v + glm::dot(v, glm::vec2(C.y)));
+			glm::vec2 x0 = v - i + glm::dot(i, glm::vec2(C.x));
+
+			// Other corners
+			glm::vec2 i1 = (x0.x > x0.y) ? glm::vec2(1.0f, 0.0f) : glm::vec2(0.0f, 1.0f);
+			glm::vec4 x12 = glm::vec4(x0.x, x0.y, x0.x, x0.y) + glm::vec4(C.x, C.x, C.z, C.z);
+			x12.x -= i1.x;
+			x12.y -= i1.y;
+
+			// Permutations
+			i = Mod289(i);
+			glm::vec3 p = Permute(Permute(i.y + glm::vec3(0.0f, i1.y, 1.0f)) + i.x + glm::vec3(0.0f, i1.x, 1.0f));
+
+			glm::vec3 m = glm::max(
+				0.5f -
+					glm::vec3(
+						glm::dot(x0, x0),
+						glm::dot(glm::vec2(x12.x, x12.y), glm::vec2(x12.x, x12.y)),
+						glm::dot(glm::vec2(x12.z, x12.w), glm::vec2(x12.z, x12.w))
+					),
+				0.0f
+			);
+			m = m * m;
+			m = m * m;
+
+			// Gradients: 41 points uniformly over a unit circle
+			glm::vec3 x = 2.0f * glm::fract(p * C.w) - 1.0f;
+			glm::vec3 h = glm::abs(x) - 0.5f;
+			glm::vec3 ox = glm::floor(x + 0.5f);
+			glm::vec3 a0 = x - ox;
+
+			// Normalization factor
+			m *= 1.79284291400159f - 0.85373472095314f * (a0 * a0 + h * h);
+
+			glm::vec3 g(a0.x * x0.x + h.x * x0.y, a0.y * x12.x + h.y * x12.y, a0.z * x12.z + h.z * x12.w);
+			return 130.0f * glm::dot(m, g);
+		}
+
+		void PlaceInChunk(
+			const TerrainChunkData&    surface,
+			const DecorTypeGPU&        type,
+			int                        type_index,
+			const glm::vec2&           world_offset,
+			float                      chunk_size,
+			int                        grid_size,
+			const PlacementGlobalsGPU& globals,
+			std::vector<glm::mat4>&    out
+		) {
+			if (surface.IsEmpty() || surface.GetResolution() != grid_size + 1)
+				return;
+
+			const glm::vec2 camera_pos(globals.camera_and_scale.x, globals.camera_and_scale.y);
+			const float     world_scale = globals.camera_and_scale.z;
+			const float     density_falloff_start = globals.distance_params.x;
+			const float     density_falloff_end = globals.distance_params.y;
+			const float     max_decor_distance = globals.distance_params.z;
+
+			const float     min_density = type.density_scale.x;
+			const float     max_density = type.density_scale.y;
+			const float     base_scale = type.density_scale.z;
+			const float     scale_variance = type.density_scale.w;
+			const float     min_height = type.height_slope.x;
+			const float     max_height = type.height_slope.y;
+			const float     min_slope = type.height_slope.z;
+			const float     max_slope = type.height_slope.w;
+			const glm::vec3 base_rotation = glm::vec3(type.rotation);
+			const float     detail_distance = type.rotation.w;
+			const uint32_t  biome_mask = type.flags.x;
+			const bool      random_yaw = type.flags.y != 0u;
+			const bool      align_to_terrain = type.flags.z != 0u;
+
+			const glm::vec3 aabb_min = glm::vec3(type.aabb_min);
+			const glm::vec3 aabb_max = glm::vec3(type.aabb_max);
+			const glm::vec3 local_bottom(
+				(aabb_min.x + aabb_max.x) * 0.5f,
+				aabb_min.y,
+				(aabb_min.z + aabb_max.z) * 0.5f
+			);
+
+			const float step = chunk_size / static_cast<float>(grid_size);
+
+			for (int y = 0; y < grid_size; ++y) {
+				for (int x = 0; x < grid_size; ++x) {
+					glm::vec2 world_pos = world_offset + glm::vec2(static_cast<float>(x), static_cast<float>(y)) * step;
+
+					uint32_t seed_x = static_cast<uint32_t>(std::abs(world_pos.x));
+					uint32_t seed_y = static_cast<uint32_t>(std::abs(world_pos.y));
+					uint32_t seed = (seed_x * 1973u + seed_y * 9277u + static_cast<uint32_t>(type_index) * 26699u) | 1u;
+
+					world_pos += glm::vec2(Hash(seed), Hash(seed + 1234u)) * step * 0.9f;
+
+					glm::vec2 scaled_world_pos = world_pos / world_scale;
+
+					if (world_pos.x < world_offset.x || world_pos.x >= world_offset.x + chunk_size ||
+					    world_pos.y < world_offset.y || world_pos.y >= world_offset.y + chunk_size)
+						continue;
+
+					glm::vec2     uv = (world_pos - world_offset) / chunk_size;
+					SurfaceSample terrain = Sample(surface, uv, grid_size);
+
+					if (terrain.height < min_height * world_scale || terrain.height > max_height * world_scale)
+						continue;
+					float slope = 1.0f - terrain.normal.y;
+					if (slope < min_slope || slope > max_slope)
+						continue;
+
+					float biome_noise = SimplexNoise(scaled_world_pos * 0.0005f);
+					float noise_val = SimplexNoise(scaled_world_pos * 0.02f);
+					float combined_noise = (biome_noise * 0.85f + noise_val * 0.15f + 1.0f) * 0.5f;
+					combined_noise = std::clamp(combined_noise, 0.0f, 1.0f);
+
+					float effective_density = glm::mix(min_density, max_density, combined_noise);
+
+					float dist_to_cam = glm::distance(world_pos, camera_pos);
+					if (detail_distance > 0.0f && dist_to_cam > detail_distance * world_scale)
+						continue;
+
+					float distance_factor = 1.0f -
+						glm::smoothstep(density_falloff_start, density_falloff_end, dist_to_cam);
+					effective_density *= glm::mix(0.2f, 1.0f, distance_factor);
+
+					if (dist_to_cam > max_decor_distance)
+						continue;
+
+					int   low_idx = static_cast<int>(terrain.biome_low * 255.0f + 0.5f);
+					int   high_idx = std::min(low_idx + 1, 7);
+					float t = terrain.biome_t;
+
+					float allowed_weight = 0.0f;
+					if ((biome_mask & (1u << static_cast<uint32_t>(low_idx))) != 0u)
+						allowed_weight += (1.0f - t);
+					if ((biome_mask & (1u << static_cast<uint32_t>(high_idx))) != 0u)
+						allowed_weight += t;
+
+					if (allowed_weight < 0.01f)
+						continue;
+
+					effective_density *= allowed_weight;
+
+					if (Hash(seed + 5678u) > effective_density)
+						continue;
+
+					glm::vec3 world_pos_3d(world_pos.x, terrain.height, world_pos.y);
+
+					float scale_noise = (SimplexNoise(scaled_world_pos * 0.1f) + 1.0f) * 0.5f;
+					float s = base_scale * world_scale + (scale_noise * 2.0f - 1.0f) * (scale_variance * world_scale);
+
+					glm::vec3 rot = base_rotation;
+					if (random_yaw) {
+						rot.y += Hash(seed + 3456u) * 6.28318f;
+					}
+					glm::mat3 rot_mat = RotationFromEuler(rot);
+
+					if (align_to_terrain) {
+						glm::vec3 up(0.0f, 1.0f, 0.0f);
+						glm::vec3 terrain_up = glm::normalize(terrain.normal);
+
+						if (std::abs(glm::dot(up, terrain_up)) < 0.999f) {
+							glm::vec3 axis = glm::normalize(glm::cross(up, terrain_up));
+							float     angle = std::acos(std::clamp(glm::dot(up, terrain_up), -1.0f, 1.0f));
+
+							float c = std::cos(angle);
+							float s_angle = std::sin(angle);
+							float tc = 1.0f - c;
+
+							glm::mat3 terrain_rot(
+								tc * axis.x * axis.x + c,
+								tc * axis.x * axis.y - s_angle * axis.z,
+								tc * axis.x * axis.z + s_angle * axis.y,
+								tc * axis.x * axis.y + s_angle * axis.z,
+								tc * axis.y * axis.y + c,
+								tc * axis.y * axis.z - s_angle * axis.x,
+								tc * axis.x * axis.z - s_angle * axis.y,
+								tc * axis.y * axis.z + s_angle * axis.x,
+								tc * axis.z * axis.z + c
+							);
+
+							rot_mat = terrain_rot * rot_mat;
+						}
+					}
+
+					glm::mat3 scaled_rot = rot_mat * s;
+
+					glm::mat4 m(1.0f);
+					m[0] = glm::vec4(scaled_rot[0], 0.0f);
+					m[1] = glm::vec4(scaled_rot[1], 0.0f);
+					m[2] = glm::vec4(scaled_rot[2], 0.0f);
+					m[3] = glm::vec4(world_pos_3d - scaled_rot * local_bottom, 1.0f);
+					out.push_back(m);
+				}
+			}
+		}
+
+	} // namespace DecorPlacement
+} // namespace Boidsish
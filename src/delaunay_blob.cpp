@@ -64,6 +64,9 @@ namespace Boidsish {
 		smooth_normals_ = other.smooth_normals_;
 		auto_retetrahedralize_ = other.auto_retetrahedralize_;
 		mesh_dirty_ = other.mesh_dirty_;
+		tetrahedralizer_ = std::move(other.tetrahedralizer_);
+		tet_point_ids_ = std::move(other.tet_point_ids_);
+		topology_dirty_ = other.topology_dirty_;
 		tetrahedra_ = std::move(other.tetrahedra_);
 		surface_faces_ = std::move(other.surface_faces_);
 
@@ -98,6 +101,9 @@ namespace Boidsish {
 			smooth_normals_ = other.smooth_normals_;
 			auto_retetrahedralize_ = other.auto_retetrahedralize_;
 			mesh_dirty_ = other.mesh_dirty_;
+			tetrahedralizer_ = std::move(other.tetrahedralizer_);
+			tet_point_ids_ = std::move(other.tet_point_ids_);
+			topology_dirty_ = other.topology_dirty_;
 			tetrahedra_ = std::move(other.tetrahedra_);
 			surface_faces_ = std::move(other.surface_faces_);
 
@@ -125,6 +131,7 @@ namespace Boidsish {
 	int DelaunayBlob::AddPoint(const glm::vec3& position) {
 		int id = next_point_id_++;
 		points_[id] = ControlPoint{id, position, glm::vec3(0.0f), glm::vec4(GetR(), GetG(), GetB(), alpha_)};
+		topology_dirty_ = true;
 
 		if (auto_retetrahedralize_) {
 			MarkDirty();
@@ -141,6 +148,7 @@ namespace Boidsish {
 		points_[point_id] =
 			ControlPoint{point_id, position, glm::vec3(0.0f), glm::vec4(GetR(), GetG(), GetB(), alpha_)};
 		next_point_id_ = std::max(next_point_id_, point_id + 1);
+		topology_dirty_ = true;
 
 		if (auto_retetrahedralize_) {
 			MarkDirty();
@@ -150,8 +158,11 @@ namespace Boidsish {
 	}
 
 	void DelaunayBlob::RemovePoint(int point_id) {
-		if (points_.erase(point_id) > 0 && auto_retetrahedralize_) {
-			MarkDirty();
+		if (points_.erase(point_id) > 0) {
+			topology_dirty_ = true;
+			if (auto_retetrahedralize_) {
+				MarkDirty();
+			}
 		}
 	}
 
@@ -238,6 +249,8 @@ namespace Boidsish {
 
 	void DelaunayBlob::Clear() {
 		points_.clear();
+		tetrahedralizer_.Clear();
+		topology_dirty_ = true;
 		tetrahedra_.clear();
 		surface_faces_.clear();
 		MarkDirty();
@@ -253,77 +266,6 @@ namespace Boidsish {
 
 	// === 3D Delaunay Algorithm ===
 
-	std::pair<glm::vec3, float> DelaunayBlob::ComputeCircumsphere(
-		const glm::vec3& a,
-		const glm::vec3& b,
-		const glm::vec3& c,
-		const glm::vec3& d
-	) const {
-		// Compute circumsphere using determinant method
-		// Reference: https://mathworld.wolfram.com/Circumsphere.html
-
-		glm::vec3 ba = b - a;
-		glm::vec3 ca = c - a;
-		glm::vec3 da = d - a;
-
-		float len_ba = glm::dot(ba, ba);
-		float len_ca = glm::dot(ca, ca);
-		float len_da = glm::dot(da, da);
-
-		glm::vec3 cross_cd = glm::cross(ca, da);
-		glm::vec3 cross_db = glm::cross(da, ba);
-		glm::vec3 cross_bc = glm::cross(ba, ca);
-
-		float denom = 2.0f * glm::dot(ba, cross_cd);
-
-		if (std::abs(denom) < 1e-10f) {
-			// Degenerate tetrahedron (coplanar points)
-			glm::vec3 center = (a + b + c + d) * 0.25f;
-			float     max_dist = std::max(
-				{glm::distance(center, a), glm::distance(center, b), glm::distance(center, c), glm::distance(center, d)}
-			);
-			return {center, max_dist * max_dist * 1e6f}; // Large radius for degenerate case
-		}
-
-		glm::vec3 offset = (len_ba * cross_cd + len_ca * cross_db + len_da * cross_bc) / denom;
-		glm::vec3 center = a + offset;
-		float     radius_sq = glm::dot(offset, offset);
-
-		return {center, radius_sq};
-	}
-
-	bool DelaunayBlob::InCircumsphere(const glm::vec3& p, const Tetrahedron& tet) const {
-		float dist_sq = glm::dot(p - tet.circumcenter, p - tet.circumcenter);
-		return dist_sq < tet.circumradius_sq * (1.0f + 1e-6f); // Small epsilon for numerical stability
-	}
-
-	std::array<glm::vec3, 4> DelaunayBlob::ComputeSuperTetrahedron() const {
-		// Find bounding box of all points
-		glm::vec3 min_pt(std::numeric_limits<float>::max());
-		glm::vec3 max_pt(std::numeric_limits<float>::lowest());
-
-		for (const auto& [_, cp] : points_) {
-			min_pt = glm::min(min_pt, cp.position);
-			max_pt = glm::max(max_pt, cp.position);
-		}
-
-		// Expand bounds
-		glm::vec3 delta = max_pt - min_pt;
-		float     dmax = std::max({delta.x, delta.y, delta.z}) * 3.0f;
-		glm::vec3 mid = (min_pt + max_pt) * 0.5f;
-
-		// Create super-tetrahedron vertices that contain all points with margin
-		// Using a regular tetrahedron scaled and centered
-		float s = dmax * 2.0f;
-
-		return {
-			{mid + glm::vec3(s, s, s),
-		     mid + glm::vec3(s, -s, -s),
-		     mid + glm::vec3(-s, s, -s),
-		     mid + glm::vec3(-s, -s, s)}
-		};
-	}
-
 	DelaunayBlob::Face DelaunayBlob::MakeFace(int v0, int v1, int v2) const {
 		Face f;
 		f.vertices = {v0, v1, v2};
@@ -336,125 +278,43 @@ namespace Boidsish {
 		tetrahedra_.clear();
 
 		if (points_.size() < 4) {
+			tetrahedralizer_.Clear();
+			topology_dirty_ = true;
 			return; // Need at least 4 points for a tetrahedron
 		}
 
-		// Build ordered list of point IDs and positions
-		std::vector<int>       point_ids;
-		std::vector<glm::vec3> positions;
-		std::map<int, size_t>  id_to_index;
+		if (topology_dirty_) {
+			tet_point_ids_.clear();
+			for (const auto& [id, cp] : points_) {
+				tet_point_ids_.push_back(id);
+			}
+		}
 
+		std::vector<glm::vec3> positions;
+		positions.reserve(points_.size());
 		for (const auto& [id, cp] : points_) {
-			id_to_index[id] = point_ids.size();
-			point_ids.push_back(id);
 			positions.push_back(cp.position);
 		}
 
-		// Create super-tetrahedron with special negative IDs
-		auto      super = ComputeSuperTetrahedron();
-		const int SUPER_0 = -1, SUPER_1 = -2, SUPER_2 = -3, SUPER_3 = -4;
-
-		// Helper to get position by ID
-		auto get_pos = [&](int id) -> glm::vec3 {
-			if (id == SUPER_0)
-				return super[0];
-			if (id == SUPER_1)
-				return super[1];
-			if (id == SUPER_2)
-				return super[2];
-			if (id == SUPER_3)
-				return super[3];
-			return positions[id_to_index[id]];
-		};
-
-		// Working tetrahedra list
-		struct WorkTet {
-			std::array<int, 4> v;
-			glm::vec3          center;
-			float              radius_sq;
-		};
-
-		std::vector<WorkTet> work_tets;
-
-		// Initialize with super-tetrahedron
-		{
-			auto [center, rsq] = ComputeCircumsphere(super[0], super[1], super[2], super[3]);
-			work_tets.push_back({{SUPER_0, SUPER_1, SUPER_2, SUPER_3}, center, rsq});
-		}
-
-		// Insert each point using Bowyer-Watson
-		for (size_t i = 0; i < point_ids.size(); ++i) {
-			int       new_id = point_ids[i];
-			glm::vec3 new_pos = positions[i];
-
-			// Find tetrahedra whose circumsphere contains the new point
-			std::vector<WorkTet> bad_tets;
-			std::vector<WorkTet> good_tets;
-
-			for (const auto& tet : work_tets) {
-				float dist_sq = glm::dot(new_pos - tet.center, new_pos - tet.center);
-				if (dist_sq < tet.radius_sq * (1.0f + 1e-6f)) {
-					bad_tets.push_back(tet);
-				} else {
-					good_tets.push_back(tet);
-				}
-			}
-
-			// Collect boundary faces of the cavity (faces that appear exactly once)
-			std::map<std::array<int, 3>, int> face_count;
-
-			auto add_face = [&](int a, int b, int c) {
-				std::array<int, 3> face = {a, b, c};
-				std::sort(face.begin(), face.end());
-				face_count[face]++;
-			};
-
-			for (const auto& tet : bad_tets) {
-				// Each tetrahedron has 4 faces
-				add_face(tet.v[0], tet.v[1], tet.v[2]);
-				add_face(tet.v[0], tet.v[1], tet.v[3]);
-				add_face(tet.v[0], tet.v[2], tet.v[3]);
-				add_face(tet.v[1], tet.v[2], tet.v[3]);
-			}
-
-			// Boundary faces appear exactly once
-			std::vector<std::array<int, 3>> boundary_faces;
-			for (const auto& [face, count] : face_count) {
-				if (count == 1) {
-					boundary_faces.push_back(face);
-				}
-			}
-
-			// Create new tetrahedra connecting boundary faces to the new point
-			work_tets = std::move(good_tets);
-
-			for (const auto& face : boundary_faces) {
-				glm::vec3 p0 = get_pos(face[0]);
-				glm::vec3 p1 = get_pos(face[1]);
-				glm::vec3 p2 = get_pos(face[2]);
-
-				auto [center, rsq] = ComputeCircumsphere(p0, p1, p2, new_pos);
-				work_tets.push_back({{face[0], face[1], face[2], new_id}, center, rsq});
-			}
+		// Moved points keep the previous connectivity for as long as it is still Delaunay
+		if (topology_dirty_) {
+			tetrahedralizer_.Build(positions);
+			topology_dirty_ = false;
+		} else {
+			tetrahedralizer_.Update(positions);
 		}
 
-		// Remove tetrahedra that include super-tetrahedron vertices
-		for (const auto& tet : work_tets) {
-			bool has_super = false;
-			for (int v : tet.v) {
-				if (v < 0) {
-					has_super = true;
-					break;
-				}
-			}
-
-			if (!has_super) {
-				Tetrahedron out_tet;
-				out_tet.vertices = tet.v;
-				out_tet.circumcenter = tet.center;
-				out_tet.circumradius_sq = tet.radius_sq;
-				tetrahedra_.push_back(out_tet);
+		const auto& tets = tetrahedralizer_.GetTetrahedra();
+		tetrahedra_.reserve(tets.size());
+		for (const auto& tet : tets) {
+			Tetrahedron out_tet;
+			for (int i = 0; i < 4; ++i) {
+				out_tet.vertices[i] = tet_point_ids_[tet.vertices[i]];
 			}
+			out_tet.neighbors = tet.neighbors;
+			out_tet.circumcenter = tet.circumcenter;
+			out_tet.circumradius_sq = tet.circumradius_sq;
+			tetrahedra_.push_back(out_tet);
 		}
 	}
 
@@ -484,33 +344,12 @@ namespace Boidsish {
 			return;
 		}
 
-		// Count face occurrences - boundary faces appear exactly once
-		std::map<std::array<int, 3>, std::vector<std::pair<size_t, int>>> face_to_tet;
-
+		// Boundary faces are the ones with no tetrahedron on the other side
 		for (size_t ti = 0; ti < tetrahedra_.size(); ++ti) {
 			const auto& tet = tetrahedra_[ti];
-
-			// 4 faces per tetrahedron, with opposite vertex index
-			std::array<std::tuple<int, int, int, int>, 4> faces = {{
-				{tet.vertices[1], tet.vertices[2], tet.vertices[3], 0}, // opposite to v0
-				{tet.vertices[0], tet.vertices[2], tet.vertices[3], 1}, // opposite to v1
-				{tet.vertices[0], tet.vertices[1], tet.vertices[3], 2}, // opposite to v2
-				{tet.vertices[0], tet.vertices[1], tet.vertices[2], 3}  // opposite to v3
-			}};
-
-			for (const auto& [a, b, c, opp_idx] : faces) {
-				std::array<int, 3> key = {a, b, c};
-				std::sort(key.begin(), key.end());
-				face_to_tet[key].push_back({ti, opp_idx});
-			}
-		}
-
-		// Extract boundary faces (those appearing exactly once)
-		for (const auto& [key, tet_list] : face_to_tet) {
-			if (tet_list.size() == 1) {
-				size_t      ti = tet_list[0].first;
-				int         opp_idx = tet_list[0].second;
-				const auto& tet = tetrahedra_[ti];
+			for (int opp_idx = 0; opp_idx < 4; ++opp_idx) {
+				if (tet.neighbors[opp_idx] >= 0)
+					continue;
 
 				// Get the original (unsorted) vertex order from the tetrahedron
 				std::array<int, 3> original_verts;
@@ -0,0 +1,400 @@
+#include "delaunay_tetrahedralizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+namespace Boidsish {
+
+	namespace {
+		double Orient3D(const glm::dvec3& a, const glm::dvec3& b, const glm::dvec3& c, const glm::dvec3& d) {
+			return glm::dot(b - a, glm::cross(c - a, d - a));
+		}
+
+		// Position along a 3D Hilbert curve of `bits` bits per axis (Skilling's transpose method)
+		uint32_t HilbertIndex(std::array<uint32_t, 3> x, int bits) {
+			const uint32_t m = 1u << (bits - 1);
+			for (uint32_t q = m; q > 1; q >>= 1) {
+				uint32_t p = q - 1;
+				for (int i = 0; i < 3; ++i) {
+					if (x[i] & q) {
+						x[0] ^= p;
+					} else {
+						uint32_t t = (x[0] ^ x[i]) & p;
+						x[0] ^= t;
+						x[i] ^= t;
+					}
+				}
+			}
+			for (int i = 1; i < 3; ++i) {
+				x[i] ^= x[i - 1];
+			}
+			uint32_t t = 0;
+			for (uint32_t q = m; q > 1; q >>= 1) {
+				if (x[2] & q) {
+					t ^= q - 1;
+				}
+			}
+			for (int i = 0; i < 3; ++i) {
+				x[i] ^= t;
+			}
+
+			uint32_t index = 0;
+			for (int b = bits - 1; b >= 0; --b) {
+				for (int i = 0; i < 3; ++i) {
+					index = (index << 1) | ((x[i] >> b) & 1u);
+				}
+			}
+			return index;
+		}
+	} // namespace
+
+	void DelaunayTetrahedralizer::Clear() {
+		points_.clear();
+		tets_.clear();
+		free_.clear();
+		output_.clear();
+		input_count_ = 0;
+		skipped_ = 0;
+		last_ = -1;
+	}
+
+	void DelaunayTetrahedralizer::Build(const std::vector<glm::vec3>& points) {
+		Clear();
+		if (points.size() < 4) {
+			return; // Need at least 4 points for a tetrahedron
+		}
+
+		input_count_ = points.size();
+		points_.reserve(input_count_ + 4);
+
+		glm::dvec3 min_pt(std::numeric_limits<double>::max());
+		glm::dvec3 max_pt(std::numeric_limits<double>::lowest());
+		for (const auto& p : points) {
+			points_.emplace_back(p);
+			min_pt = glm::min(min_pt, points_.back());
+			max_pt = glm::max(max_pt, points_.back());
+		}
+
+		// Super-tetrahedron: a regular tetrahedron holding every point with |d.x|+|d.y|+|d.z| < super_size_
+		glm::dvec3 delta = max_pt - min_pt;
+		super_center_ = (min_pt + max_pt) * 0.5;
+		super_size_ = std::max({delta.x, delta.y, delta.z, 1e-3}) * 6.0;
+		const double s = super_size_;
+		points_.push_back(super_center_ + glm::dvec3(s, s, s));
+		points_.push_back(super_center_ + glm::dvec3(s, -s, -s));
+		points_.push_back(super_center_ + glm::dvec3(-s, s, -s));
+		points_.push_back(super_center_ + glm::dvec3(-s, -s, s));
+
+		const int super0 = static_cast<int>(input_count_);
+		Tet       root{{super0, super0 + 1, super0 + 2, super0 + 3}, {-1, -1, -1, -1}, glm::dvec3(0.0), 0.0, true};
+		if (Orient(root) < 0.0) {
+			std::swap(root.v[0], root.v[1]);
+		}
+		last_ = Allocate(root);
+
+		// BRIO: shuffled rounds of doubling size, each ordered along a Hilbert curve for walk locality
+		std::vector<int> order(input_count_);
+		std::iota(order.begin(), order.end(), 0);
+		std::shuffle(order.begin(), order.end(), std::mt19937(1337));
+
+		constexpr int bits = 10;
+		glm::dvec3    scale = glm::dvec3(static_cast<double>((1 << bits) - 1)) / glm::max(delta, glm::dvec3(1e-9));
+		auto          hilbert_key = [&](int i) {
+			glm::dvec3 q = (points_[i] - min_pt) * scale;
+			return HilbertIndex({uint32_t(q.x), uint32_t(q.y), uint32_t(q.z)}, bits);
+		};
+
+		std::vector<std::pair<uint32_t, int>> keyed;
+		for (size_t begin = 0, end = std::min<size_t>(32, input_count_); begin < input_count_;
+		     begin = end, end = std::min(end * 2, input_count_)) {
+			keyed.clear();
+			for (size_t i = begin; i < end; ++i) {
+				keyed.push_back({hilbert_key(order[i]), order[i]});
+			}
+			std::sort(keyed.begin(), keyed.end());
+			for (size_t i = begin; i < end; ++i) {
+				order[i] = keyed[i - begin].second;
+			}
+		}
+
+		for (int point : order) {
+			Insert(point);
+		}
+		Extract();
+	}
+
+	bool DelaunayTetrahedralizer::Update(const std::vector<glm::vec3>& points) {
+		auto rebuild = [&] {
+			Build(points);
+			return false;
+		};
+
+		if (tets_.empty() || points.size() != input_count_ || skipped_ > 0) {
+			return rebuild();
+		}
+
+		// The super-tetrahedron stays put, so points must stay well inside it
+		for (size_t i = 0; i < input_count_; ++i) {
+			glm::dvec3 d = glm::dvec3(points[i]) - super_center_;
+			if (std::abs(d.x) + std::abs(d.y) + std::abs(d.z) > 0.5 * super_size_) {
+				return rebuild();
+			}
+			points_[i] = points[i];
+		}
+
+		for (auto& tet : tets_) {
+			if (!tet.alive)
+				continue;
+			if (Orient(tet) <= 0.0) {
+				return rebuild();
+			}
+			ComputeSphere(tet);
+		}
+
+		// Locally Delaunay on every face and positively oriented everywhere implies Delaunay
+		for (int t = 0; t < static_cast<int>(tets_.size()); ++t) {
+			const Tet& tet = tets_[t];
+			if (!tet.alive)
+				continue;
+			for (int i = 0; i < 4; ++i) {
+				int u = tet.n[i];
+				if (u < t)
+					continue; // Hull face, or the pair was checked from the other side
+				const Tet& other = tets_[u];
+				for (int j = 0; j < 4; ++j) {
+					if (other.n[j] == t && InSphere(tet, points_[other.v[j]])) {
+						return rebuild();
+					}
+				}
+			}
+		}
+
+		Extract();
+		return true;
+	}
+
+	int DelaunayTetrahedralizer::Allocate(const Tet& tet) {
+		int index;
+		if (!free_.empty()) {
+			index = free_.back();
+			free_.pop_back();
+			tets_[index] = tet;
+		} else {
+			index = static_cast<int>(tets_.size());
+			tets_.push_back(tet);
+			cavity_mark_.push_back(0);
+		}
+		ComputeSphere(tets_[index]);
+		return index;
+	}
+
+	void DelaunayTetrahedralizer::ComputeSphere(Tet& tet) const {
+		const glm::dvec3& a = points_[tet.v[0]];
+		glm::dvec3        ba = points_[tet.v[1]] - a;
+		glm::dvec3        ca = points_[tet.v[2]] - a;
+		glm::dvec3        da = points_[tet.v[3]] - a;
+
+		double denom = 2.0 * glm::dot(ba, glm::cross(ca, da));
+		if (!(denom > 0.0)) {
+			// Flat tetrahedron: treat its circumsphere as unbounded so any insertion replaces it
+			tet.center = a;
+			tet.radius_sq = std::numeric_limits<double>::infinity();
+			return;
+		}
+
+		glm::dvec3 offset = (glm::dot(ba, ba) * glm::cross(ca, da) + glm::dot(ca, ca) * glm::cross(da, ba) +
+		                     glm::dot(da, da) * glm::cross(ba, ca)) /
+			denom;
+		tet.center = a + offset;
+		tet.radius_sq = glm::dot(offset, offset);
+	}
+
+	double DelaunayTetrahedralizer::Orient(const Tet& tet) const {
+		return Orient3D(points_[tet.v[0]], points_[tet.v[1]], points_[tet.v[2]], points_[tet.v[3]]);
+	}
+
+	double DelaunayTetrahedralizer::OrientReplacing(const Tet& tet, int face, const glm::dvec3& p) const {
+		std::array<glm::dvec3, 4> v;
+		for (int i = 0; i < 4; ++i) {
+			v[i] = i == face ? p : points_[tet.v[i]];
+		}
+		return Orient3D(v[0], v[1], v[2], v[3]);
+	}
+
+	int DelaunayTetrahedralizer::Locate(const glm::dvec3& p) {
+		// Visibility walk: step through any face that has p on its far side. Starting at a random
+		// face each step keeps the walk from cycling.
+		int       t = last_;
+		const int max_steps = static_cast<int>(tets_.size()) + 16;
+		for (int step = 0; step < max_steps && t >= 0; ++step) {
+			walk_state_ ^= walk_state_ << 13;
+			walk_state_ ^= walk_state_ >> 17;
+			walk_state_ ^= walk_state_ << 5;
+			const int start = static_cast<int>(walk_state_ & 3u);
+
+			int next = t;
+			for (int k = 0; k < 4; ++k) {
+				int i = (start + k) & 3;
+				if (OrientReplacing(tets_[t], i, p) < 0.0) {
+					next = tets_[t].n[i];
+					break;
+				}
+			}
+			if (next == t) {
+				return t;
+			}
+			t = next;
+		}
+
+		// Rounding defeated the walk; any tetrahedron containing p will do
+		for (int i = 0; i < static_cast<int>(tets_.size()); ++i) {
+			if (!tets_[i].alive)
+				continue;
+			bool inside = true;
+			for (int f = 0; f < 4 && inside; ++f) {
+				inside = OrientReplacing(tets_[i], f, p) >= 0.0;
+			}
+			if (inside) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	void DelaunayTetrahedralizer::Insert(int point) {
+		const glm::dvec3 p = points_[point];
+		const int        seed = Locate(p);
+		if (seed < 0) {
+			++skipped_;
+			return;
+		}
+
+		for (int v : tets_[seed].v) {
+			glm::dvec3 d = points_[v] - p;
+			if (glm::dot(d, d) <= 1e-18 * super_size_ * super_size_) {
+				++skipped_; // Coincides with an existing vertex
+				return;
+			}
+		}
+
+		// Grow the cavity from the containing tetrahedron through neighbours whose circumsphere holds p
+		++epoch_;
+		cavity_.clear();
+		cavity_.push_back(seed);
+		cavity_mark_[seed] = epoch_;
+		for (size_t k = 0; k < cavity_.size(); ++k) {
+			for (int u : tets_[cavity_[k]].n) {
+				if (u >= 0 && cavity_mark_[u] != epoch_ && InSphere(tets_[u], p)) {
+					cavity_mark_[u] = epoch_;
+					cavity_.push_back(u);
+				}
+			}
+		}
+
+		// Rounding can produce a cavity that is not star-shaped from p; shrink it until every
+		// boundary face would give a positively oriented new tetrahedron.
+		for (bool changed = true; changed;) {
+			changed = false;
+			for (size_t k = 0; k < cavity_.size(); ++k) {
+				int t = cavity_[k];
+				if (t == seed)
+					continue;
+				for (int i = 0; i < 4; ++i) {
+					int u = tets_[t].n[i];
+					if ((u < 0 || cavity_mark_[u] != epoch_) && OrientReplacing(tets_[t], i, p) <= 0.0) {
+						cavity_mark_[t] = 0;
+						cavity_[k--] = cavity_.back();
+						cavity_.pop_back();
+						changed = true;
+						break;
+					}
+				}
+			}
+		}
+
+		// Cone every boundary face to p, linking the new tetrahedra to the outside and to each other
+		edge_links_.clear();
+		for (int t : cavity_) {
+			for (int i = 0; i < 4; ++i) {
+				int u = tets_[t].n[i];
+				if (u >= 0 && cavity_mark_[u] == epoch_)
+					continue;
+
+				Tet tet = tets_[t];
+				tet.v[i] = point;
+				tet.n = {-1, -1, -1, -1};
+				tet.n[i] = u;
+				tet.alive = true;
+				int created = Allocate(tet);
+				cavity_mark_[created] = 0;
+				if (u >= 0) {
+					for (int& back : tets_[u].n) {
+						if (back == t) {
+							back = created;
+						}
+					}
+				}
+
+				// The other three faces contain p and one edge of the boundary face
+				for (int j = 0; j < 4; ++j) {
+					if (j == i)
+						continue;
+					int a = -1, b = -1;
+					for (int k = 0; k < 4; ++k) {
+						if (k != i && k != j) {
+							(a < 0 ? a : b) = tets_[created].v[k];
+						}
+					}
+					if (a > b)
+						std::swap(a, b);
+
+					auto link = std::find_if(edge_links_.begin(), edge_links_.end(), [&](const EdgeLink& l) {
+						return l.a == a && l.b == b;
+					});
+					if (link != edge_links_.end()) {
+						tets_[created].n[j] = link->tet;
+						tets_[link->tet].n[link->face] = created;
+						*link = edge_links_.back();
+						edge_links_.pop_back();
+					} else {
+						edge_links_.push_back({a, b, created, j});
+					}
+				}
+				last_ = created;
+			}
+		}
+
+		for (int t : cavity_) {
+			tets_[t].alive = false;
+			cavity_mark_[t] = 0;
+			free_.push_back(t);
+		}
+	}
+
+	void DelaunayTetrahedralizer::Extract() {
+		output_.clear();
+		std::vector<int> remap(tets_.size(), -1);
+		std::vector<int> source;
+		const int        first_super = static_cast<int>(input_count_);
+
+		for (int t = 0; t < static_cast<int>(tets_.size()); ++t) {
+			const Tet& tet = tets_[t];
+			if (!tet.alive || std::any_of(tet.v.begin(), tet.v.end(), [&](int v) { return v >= first_super; }))
+				continue;
+			remap[t] = static_cast<int>(output_.size());
+			source.push_back(t);
+			output_.push_back({tet.v, {-1, -1, -1, -1}, glm::vec3(tet.center), static_cast<float>(tet.radius_sq)});
+		}
+
+		for (size_t o = 0; o < output_.size(); ++o) {
+			for (int i = 0; i < 4; ++i) {
+				int u = tets_[source[o]].n[i];
+				output_[o].neighbors[i] = u >= 0 ? remap[u] : -1;
+			}
+		}
+	}
+
+} // namespace Boidsish
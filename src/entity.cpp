@@ -50,26 +50,10 @@ namespace Boidsish {
 		// Update all entities
 		std::for_each(poolstl::par.on(thread_pool_), entities.begin(), entities.end(), [&](auto& entity) {
 			entity->UpdateEntity(*this, time, delta_time);
-			if (entity->path_) {
-				auto update = entity->path_->CalculateUpdate(
-					entity->GetPosition(),
-					entity->rigid_body_.GetOrientation(),
-					entity->path_segment_index_,
-					entity->path_t_,
-					entity->path_direction_,
-					entity->path_speed_,
-					delta_time
-				);
-				entity->SetVelocity(update.velocity * entity->path_speed_);
-				entity->rigid_body_.SetOrientation(
-					glm::slerp(entity->rigid_body_.GetOrientation(), update.orientation, 0.1f)
-				);
-				entity->path_direction_ = update.new_direction;
-				entity->path_segment_index_ = update.new_segment_index;
-				entity->path_t_ = update.new_t;
-			}
 		});
 
+		UpdatePathFollowers(entities, delta_time);
+
 		// Call post-timestep hook
 		PostTimestep(time, delta_time);
 
@@ -109,7 +93,8 @@ namespace Boidsish {
 
 			// Apply path constraint
 			if (entity->constraint_path_) {
-				glm::vec3 closest_point_glm = entity->constraint_path_->FindClosestPoint(entity->GetPosition());
+				glm::vec3 closest_point_glm =
+					entity->constraint_path_->FindClosestPoint(entity->GetPosition(), &entity->constraint_segment_);
 				Vector3   closest_point(closest_point_glm.x, closest_point_glm.y, closest_point_glm.z);
 				Vector3   to_path = closest_point - entity->GetPosition();
 				float     distance_from_path = to_path.Magnitude();
@@ -131,6 +116,72 @@ namespace Boidsish {
 		return {};
 	}
 
+	void
+	EntityHandler::UpdatePathFollowers(const std::vector<std::shared_ptr<EntityBase>>& entities, float delta_time) {
+		struct PathBatch {
+			const Path* path;
+			size_t      begin;
+			size_t      end;
+		};
+		constexpr size_t kBatchSize = 1024;
+
+		// Followers sorted by path and split into batches, so each batch walks one path's tables
+		std::vector<EntityBase*> followers_by_path;
+		for (const auto& entity : entities) {
+			if (entity->path_) {
+				followers_by_path.push_back(entity.get());
+			}
+		}
+		if (followers_by_path.empty())
+			return;
+		std::sort(followers_by_path.begin(), followers_by_path.end(), [](const EntityBase* a, const EntityBase* b) {
+			return a->path_.get() < b->path_.get();
+		});
+
+		std::vector<PathFollower>     followers(followers_by_path.size());
+		std::vector<PathUpdateResult> results(followers_by_path.size());
+		std::vector<PathBatch>        batches;
+		for (size_t i = 0; i < followers_by_path.size(); ++i) {
+			const EntityBase* entity = followers_by_path[i];
+			const Path*       path = entity->path_.get();
+			followers[i] = {
+				entity->GetPosition(),
+				entity->path_segment_index_,
+				entity->path_t_,
+				entity->path_direction_,
+				entity->path_speed_
+			};
+			bool new_path = batches.empty() || batches.back().path != path;
+			if (new_path) {
+				path->GetLength(); // Builds the segment cache before batches read it concurrently
+			}
+			if (new_path || batches.back().end - batches.back().begin == kBatchSize) {
+				batches.push_back({path, i, i});
+			}
+			batches.back().end = i + 1;
+		}
+
+		std::for_each(poolstl::par.on(thread_pool_), batches.begin(), batches.end(), [&](const PathBatch& batch) {
+			size_t count = batch.end - batch.begin;
+			batch.path->CalculateUpdates(
+				std::span(followers).subspan(batch.begin, count),
+				delta_time,
+				std::span(results).subspan(batch.begin, count)
+			);
+			for (size_t i = batch.begin; i < batch.end; ++i) {
+				EntityBase*             entity = followers_by_path[i];
+				const PathUpdateResult& update = results[i];
+				entity->SetVelocity(update.velocity * entity->path_speed_);
+				entity->rigid_body_.SetOrientation(
+					glm::slerp(entity->rigid_body_.GetOrientation(), update.orientation, 0.1f)
+				);
+				entity->path_direction_ = update.new_direction;
+				entity->path_segment_index_ = update.new_segment_index;
+				entity->path_t_ = update.new_t;
+			}
+		});
+	}
+
 	std::tuple<float, glm::vec3> EntityHandler::CalculateTerrainPropertiesAtPoint(float x, float y) const {
 		if (vis) {
 			return vis->CalculateTerrainPropertiesAtPoint(x, y);
@@ -199,6 +250,33 @@ namespace Boidsish {
 		return false;
 	}
 
+	void EntityHandler::GetTerrainPropertiesBatch(std::span<const glm::vec2> points, std::span<TerrainSample> out) const {
+		if (auto terrain = vis ? vis->GetTerrain() : nullptr) {
+			terrain->GetTerrainPropertiesBatch(points, out);
+			return;
+		}
+		std::fill(out.begin(), out.end(), TerrainSample{});
+	}
+
+	void EntityHandler::GetDistanceAboveTerrainBatch(std::span<const glm::vec3> points, std::span<float> out) const {
+		if (auto terrain = vis ? vis->GetTerrain() : nullptr) {
+			terrain->GetDistanceAboveTerrainBatch(points, out);
+			return;
+		}
+		// Assume terrain at y=0 if no generator
+		for (size_t i = 0; i < points.size(); ++i) {
+			out[i] = points[i].y;
+		}
+	}
+
+	void EntityHandler::RaycastTerrainBatch(std::span<const TerrainRay> rays, std::span<TerrainRayHit> out) const {
+		if (auto terrain = vis ? vis->GetTerrain() : nullptr) {
+			terrain->RaycastBatch(rays, out);
+			return;
+		}
+		std::fill(out.begin(), out.end(), TerrainRayHit{});
+	}
+
 	glm::vec3 EntityHandler::GetValidPlacement(const glm::vec3& suggested_pos, float clearance) const {
 		float terrain_h = 0.0f;
 		if (vis) {
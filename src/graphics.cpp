@@ -17,6 +17,7 @@
 #include "SceneManager.h"
 #include "UIConfigManager.h"
 #include "akira_effect.h"
+#include "animation_crowd.h"
 #include "arcade_text.h"
 #include "atmosphere_manager.h"
 #include "audio_manager.h"
@@ -34,6 +35,7 @@
 #include "hud_manager.h"
 #include "light_manager.h"
 #include "line.h"
+#include "lod_selector.h"
 #include "logger.h"
 #include "mesh_explosion_manager.h"
 #include "path.h"
@@ -538,10 +540,49 @@ namespace Boidsish {
 		LightingUbo           lighting_ubo_data_;
 		FrameConfigCache      frame_config_;
 
+		// Typed config bindings read by RefreshFrameConfig and other per-frame paths
+		struct ConfigBindings {
+			const ConfigVar<bool>*  enable_effects = nullptr;
+			const ConfigVar<bool>*  render_terrain = nullptr;
+			const ConfigVar<bool>*  render_skybox = nullptr;
+			const ConfigVar<bool>*  render_floor = nullptr;
+			const ConfigVar<bool>*  force_both_floor_and_terrain = nullptr;
+			const ConfigVar<bool>*  render_decor = nullptr;
+			const ConfigVar<bool>*  grass_enabled = nullptr;
+			const ConfigVar<bool>*  artistic_ripple = nullptr;
+			const ConfigVar<bool>*  artistic_color_shift = nullptr;
+			const ConfigVar<bool>*  artistic_black_and_white = nullptr;
+			const ConfigVar<bool>*  artistic_negative = nullptr;
+			const ConfigVar<bool>*  artistic_shimmery = nullptr;
+			const ConfigVar<bool>*  artistic_glitched = nullptr;
+			const ConfigVar<bool>*  artistic_wireframe = nullptr;
+			const ConfigVar<bool>*  erosion_enabled = nullptr;
+			const ConfigVar<float>* erosion_strength = nullptr;
+			const ConfigVar<float>* erosion_scale = nullptr;
+			const ConfigVar<float>* erosion_detail = nullptr;
+			const ConfigVar<float>* erosion_gully_weight = nullptr;
+			const ConfigVar<float>* erosion_max_dist = nullptr;
+			const ConfigVar<float>* ambient_particle_density = nullptr;
+			const ConfigVar<bool>*  enable_shadows = nullptr;
+			const ConfigVar<float>* sh_probe_scaling = nullptr;
+			const ConfigVar<float>* sh_probe_convergence_speed = nullptr;
+			const ConfigVar<int>*   sh_probe_ray_count_multiplier = nullptr;
+			const ConfigVar<float>* wind_strength = nullptr;
+			const ConfigVar<float>* wind_speed = nullptr;
+			const ConfigVar<float>* wind_frequency = nullptr;
+			const ConfigVar<bool>*  particles_enabled = nullptr;
+			const ConfigVar<float>* cloud_shadow_intensity = nullptr;
+			const ConfigVar<float>* foliage_culling_pixel_threshold = nullptr;
+			const ConfigVar<float>* mesh_lod_screen_error = nullptr;
+		};
+
+		ConfigBindings config_;
+
 		bool last_render_terrain_ = true;
 		bool last_render_floor_ = true;
 
 		task_thread_pool::task_thread_pool thread_pool;
+		AnimationCrowd                     animation_crowd{thread_pool};
 		std::shared_ptr<AudioManager>      audio_manager;
 
 		// Canonical frame data — temporal chain lives here between frames
@@ -617,6 +658,7 @@ namespace Boidsish {
 			RegisterShaderConstants();
 
 			ConfigManager::GetInstance().Initialize(title);
+			BindConfig();
 			enable_hdr_ = ConfigManager::GetInstance().GetAppSettingBool("enable_hdr", true);
 
 			last_render_terrain_ = ConfigManager::GetInstance().GetAppSettingBool("render_terrain", true);
@@ -1184,13 +1226,52 @@ namespace Boidsish {
 			}
 		}
 
+		void BindConfig() {
+			auto& cfg = ConfigManager::GetInstance();
+			config_.enable_effects = &cfg.BindAppSettingBool("enable_effects", true);
+			config_.render_terrain = &cfg.BindAppSettingBool("render_terrain", true);
+			config_.render_skybox = &cfg.BindAppSettingBool("render_skybox", true);
+			config_.render_floor = &cfg.BindAppSettingBool("render_floor", true);
+			config_.force_both_floor_and_terrain = &cfg.BindAppSettingBool("force_both_floor_and_terrain", false);
+			config_.render_decor = &cfg.BindAppSettingBool("render_decor", true);
+			config_.grass_enabled = &cfg.BindAppSettingBool("grass_enabled", true);
+			config_.artistic_ripple = &cfg.BindAppSettingBool("artistic_effect_ripple", false);
+			config_.artistic_color_shift = &cfg.BindAppSettingBool("artistic_effect_color_shift", false);
+			config_.artistic_black_and_white = &cfg.BindAppSettingBool("artistic_effect_black_and_white", false);
+			config_.artistic_negative = &cfg.BindAppSettingBool("artistic_effect_negative", false);
+			config_.artistic_shimmery = &cfg.BindAppSettingBool("artistic_effect_shimmery", false);
+			config_.artistic_glitched = &cfg.BindAppSettingBool("artistic_effect_glitched", false);
+			config_.artistic_wireframe = &cfg.BindAppSettingBool("artistic_effect_wireframe", false);
+			config_.erosion_enabled = &cfg.BindAppSettingBool("erosion_enabled", true);
+			config_.erosion_strength = &cfg.BindAppSettingFloat("erosion_strength", 0.12f);
+			config_.erosion_scale = &cfg.BindAppSettingFloat("erosion_scale", 0.15f);
+			config_.erosion_detail = &cfg.BindAppSettingFloat("erosion_detail", 1.5f);
+			config_.erosion_gully_weight = &cfg.BindAppSettingFloat("erosion_gully_weight", 0.5f);
+			config_.erosion_max_dist = &cfg.BindAppSettingFloat("erosion_max_dist", 450.0f);
+			config_.ambient_particle_density = &cfg.BindAppSettingFloat(
+				"ambient_particle_density",
+				Constants::Class::Particles::DefaultAmbientDensity()
+			);
+			config_.enable_shadows = &cfg.BindAppSettingBool("enable_shadows", true);
+			config_.sh_probe_scaling = &cfg.BindAppSettingFloat("sh_probe_scaling", 0.125f);
+			config_.sh_probe_convergence_speed = &cfg.BindAppSettingFloat("sh_probe_convergence_speed", 0.5f);
+			config_.sh_probe_ray_count_multiplier = &cfg.BindAppSettingInt("sh_probe_ray_count_multiplier", 1);
+			config_.wind_strength = &cfg.BindAppSettingFloat("wind_strength", 0.065f);
+			config_.wind_speed = &cfg.BindAppSettingFloat("wind_speed", 0.075f);
+			config_.wind_frequency = &cfg.BindAppSettingFloat("wind_frequency", 0.01f);
+			config_.particles_enabled = &cfg.BindAppSettingBool("particles_enabled", true);
+			config_.cloud_shadow_intensity = &cfg.BindAppSettingFloat("cloud_shadow_intensity", 0.5f);
+			config_.foliage_culling_pixel_threshold = &cfg.BindAppSettingFloat("foliage_culling_pixel_threshold", 8.0f);
+			config_.mesh_lod_screen_error = &cfg.BindAppSettingFloat("mesh_lod_screen_error", 0.001f);
+		}
+
 		void RefreshFrameConfig() {
 			auto& cfg = ConfigManager::GetInstance();
-			frame_config_.effects_enabled = cfg.GetAppSettingBool("enable_effects", true);
-			frame_config_.render_terrain = cfg.GetAppSettingBool("render_terrain", true);
-			frame_config_.render_skybox = cfg.GetAppSettingBool("render_skybox", true);
-			frame_config_.render_floor = cfg.GetAppSettingBool("render_floor", true);
-			frame_config_.force_both_floor_and_terrain = cfg.GetAppSettingBool("force_both_floor_and_terrain", false);
+			frame_config_.effects_enabled = *config_.enable_effects;
+			frame_config_.render_terrain = *config_.render_terrain;
+			frame_config_.render_skybox = *config_.render_skybox;
+			frame_config_.render_floor = *config_.render_floor;
+			frame_config_.force_both_floor_and_terrain = *config_.force_both_floor_and_terrain;
 
 			// Mutual exclusion logic
 			if (!frame_config_.force_both_floor_and_terrain) {
@@ -1215,38 +1296,35 @@ namespace Boidsish {
 			last_render_terrain_ = frame_config_.render_terrain;
 			last_render_floor_ = frame_config_.render_floor;
 
-			frame_config_.render_decor = cfg.GetAppSettingBool("render_decor", true);
-			frame_config_.render_grass = cfg.GetAppSettingBool("grass_enabled", true);
-			frame_config_.artistic_ripple = cfg.GetAppSettingBool("artistic_effect_ripple", false);
-			frame_config_.artistic_color_shift = cfg.GetAppSettingBool("artistic_effect_color_shift", false);
-			frame_config_.artistic_black_and_white = cfg.GetAppSettingBool("artistic_effect_black_and_white", false);
-			frame_config_.artistic_negative = cfg.GetAppSettingBool("artistic_effect_negative", false);
-			frame_config_.artistic_shimmery = cfg.GetAppSettingBool("artistic_effect_shimmery", false);
-			frame_config_.artistic_glitched = cfg.GetAppSettingBool("artistic_effect_glitched", false);
-			frame_config_.artistic_wireframe = cfg.GetAppSettingBool("artistic_effect_wireframe", false);
-			frame_config_.erosion_enabled = cfg.GetAppSettingBool("erosion_enabled", true);
-			frame_config_.erosion_strength = cfg.GetAppSettingFloat("erosion_strength", 0.12f);
-			frame_config_.erosion_scale = cfg.GetAppSettingFloat("erosion_scale", 0.15f);
-			frame_config_.erosion_detail = cfg.GetAppSettingFloat("erosion_detail", 1.5f);
-			frame_config_.erosion_gully_weight = cfg.GetAppSettingFloat("erosion_gully_weight", 0.5f);
-			frame_config_.erosion_max_dist = cfg.GetAppSettingFloat("erosion_max_dist", 450.0f);
-			frame_config_.ambient_particle_density = cfg.GetAppSettingFloat(
-				"ambient_particle_density",
-				Constants::Class::Particles::DefaultAmbientDensity()
-			);
-			frame_config_.enable_shadows = cfg.GetAppSettingBool("enable_shadows", true);
-
-			frame_config_.sh_probe_scaling = cfg.GetAppSettingFloat("sh_probe_scaling", 0.125f);
-			frame_config_.sh_probe_convergence_speed = cfg.GetAppSettingFloat("sh_probe_convergence_speed", 0.5f);
-			frame_config_.sh_probe_ray_count_multiplier = cfg.GetAppSettingInt("sh_probe_ray_count_multiplier", 1);
+			frame_config_.render_decor = *config_.render_decor;
+			frame_config_.render_grass = *config_.grass_enabled;
+			frame_config_.artistic_ripple = *config_.artistic_ripple;
+			frame_config_.artistic_color_shift = *config_.artistic_color_shift;
+			frame_config_.artistic_black_and_white = *config_.artistic_black_and_white;
+			frame_config_.artistic_negative = *config_.artistic_negative;
+			frame_config_.artistic_shimmery = *config_.artistic_shimmery;
+			frame_config_.artistic_glitched = *config_.artistic_glitched;
+			frame_config_.artistic_wireframe = *config_.artistic_wireframe;
+			frame_config_.erosion_enabled = *config_.erosion_enabled;
+			frame_config_.erosion_strength = *config_.erosion_strength;
+			frame_config_.erosion_scale = *config_.erosion_scale;
+			frame_config_.erosion_detail = *config_.erosion_detail;
+			frame_config_.erosion_gully_weight = *config_.erosion_gully_weight;
+			frame_config_.erosion_max_dist = *config_.erosion_max_dist;
+			frame_config_.ambient_particle_density = *config_.ambient_particle_density;
+			frame_config_.enable_shadows = *config_.enable_shadows;
+
+			frame_config_.sh_probe_scaling = *config_.sh_probe_scaling;
+			frame_config_.sh_probe_convergence_speed = *config_.sh_probe_convergence_speed;
+			frame_config_.sh_probe_ray_count_multiplier = *config_.sh_probe_ray_count_multiplier;
 
 			light_manager->SetProbeScaling(frame_config_.sh_probe_scaling);
 			light_manager->SetProbeConvergenceSpeed(frame_config_.sh_probe_convergence_speed);
 			light_manager->SetProbeRayCountMultiplier(frame_config_.sh_probe_ray_count_multiplier);
 
-			frame_config_.wind_strength = cfg.GetAppSettingFloat("wind_strength", 0.065f);
-			frame_config_.wind_speed = cfg.GetAppSettingFloat("wind_speed", 0.075f);
-			frame_config_.wind_frequency = cfg.GetAppSettingFloat("wind_frequency", 0.01f);
+			frame_config_.wind_strength = *config_.wind_strength;
+			frame_config_.wind_speed = *config_.wind_speed;
+			frame_config_.wind_frequency = *config_.wind_frequency;
 
 			if (decor_manager) {
 				decor_manager->SetEnabled(frame_config_.render_decor);
@@ -1781,7 +1859,7 @@ namespace Boidsish {
 			if (is_shadow_pass) {
 				return;
 			}
-			if (!terrain_generator || !ConfigManager::GetInstance().GetAppSettingBool("render_terrain", true))
+			if (!terrain_generator || !*config_.render_terrain)
 				return;
 
 			// Determine quality
@@ -1836,7 +1914,7 @@ namespace Boidsish {
 		}
 
 		void RenderSky(const glm::mat4& view) {
-			if (!sky_shader || !ConfigManager::GetInstance().GetAppSettingBool("render_skybox", true)) {
+			if (!sky_shader || !*config_.render_skybox) {
 				return;
 			}
 			// Enable depth test with LEQUAL to allow sky at depth 1.0 to pass
@@ -1880,7 +1958,7 @@ namespace Boidsish {
 		}
 
 		void RenderPlane(const glm::mat4& view) {
-			if (!plane_shader || !ConfigManager::GetInstance().GetAppSettingBool("render_floor", true)) {
+			if (!plane_shader || !*config_.render_floor) {
 				return;
 			}
 
@@ -1943,13 +2021,23 @@ namespace Boidsish {
 				shapes.push_back(pair.second);
 			}
 
-			// Handle terrain clamping for shapes
+			// Handle terrain clamping for shapes, with one batched query for all of them
+			std::vector<Shape*>    clamped_shapes;
+			std::vector<glm::vec2> clamp_points;
 			for (auto& shape : shapes) {
 				if (shape->IsClampedToTerrain()) {
-					float     height;
-					glm::vec3 normal;
-					std::tie(height, normal) = parent->GetTerrainPropertiesAtPoint(shape->GetX(), shape->GetZ());
-					shape->SetPosition(shape->GetX(), height + shape->GetGroundOffset(), shape->GetZ());
+					clamped_shapes.push_back(shape.get());
+					clamp_points.emplace_back(shape->GetX(), shape->GetZ());
+				}
+			}
+			if (!clamped_shapes.empty()) {
+				std::vector<TerrainSample> samples(clamped_shapes.size()); // Flat ground without terrain
+				if (terrain_generator) {
+					terrain_generator->GetTerrainPropertiesBatch(clamp_points, samples);
+				}
+				for (size_t i = 0; i < clamped_shapes.size(); ++i) {
+					Shape* shape = clamped_shapes[i];
+					shape->SetPosition(shape->GetX(), samples[i].height + shape->GetGroundOffset(), shape->GetZ());
 				}
 			}
 		}
@@ -2044,7 +2132,7 @@ namespace Boidsish {
 				atmosphere_manager->SetColorVarianceScale(atmosphere_effect->GetColorVarianceScale());
 				atmosphere_manager->SetColorVarianceStrength(atmosphere_effect->GetColorVarianceStrength());
 
-			float cloudShadowIntensity = ConfigManager::GetInstance().GetAppSettingFloat("cloud_shadow_intensity", 0.5f);
+			float cloudShadowIntensity = *config_.cloud_shadow_intensity;
 			atmosphere_manager->SetCloudShadowIntensity(cloudShadowIntensity);
 			}
 
@@ -2306,8 +2394,7 @@ namespace Boidsish {
 				}
 
 				if (atmosphere_effect) {
-					auto& cfg = ConfigManager::GetInstance();
-					lighting_ubo_data_.cloudShadowIntensity = cfg.GetAppSettingFloat("cloud_shadow_intensity", 0.5f);
+					lighting_ubo_data_.cloudShadowIntensity = *config_.cloud_shadow_intensity;
 
 					lighting_ubo_data_.cloudAltitude = atmosphere_effect->GetCloudAltitude();
 					lighting_ubo_data_.cloudThickness = atmosphere_effect->GetCloudThickness();
@@ -2426,6 +2513,7 @@ namespace Boidsish {
 			context.frustum = Frustum::FromViewProjection(current_view_matrix, projection);
 			context.shader_table = &shader_table;
 			context.megabuffer = megabuffer.get();
+			context.lod_screen_error = *config_.mesh_lod_screen_error;
 
 			const size_t num_shapes = shapes.size();
 			const size_t chunk_size = 64;
@@ -2440,7 +2528,10 @@ namespace Boidsish {
 					for (size_t j = i; j < end; ++j) {
 						auto& shape = shapes[j];
 						if (auto* cached = shape->GetCachedPackets(); cached && !cached->empty()) {
-							for (auto packet : *cached) {
+							for (const auto& cached_packet : *cached) {
+								RenderPacket& packet = local_packets.emplace_back(cached_packet);
+								// The camera moves between frames even when the shape does not
+								LodSelector::Apply(packet, context);
 								glm::vec3   world_pos = glm::vec3(packet.uniforms.model[3]);
 								float       normalized_depth = context.CalculateNormalizedDepth(world_pos);
 								RenderLayer layer = (packet.uniforms.color.a < 0.99f) ? RenderLayer::Transparent
@@ -2454,7 +2545,6 @@ namespace Boidsish {
 									packet.material_handle,
 									normalized_depth
 								);
-								local_packets.push_back(std::move(packet));
 							}
 						} else {
 							std::vector<RenderPacket> new_packets;
@@ -2544,7 +2634,7 @@ namespace Boidsish {
 			fire_effect_manager->Update(
 				simulation_delta_time,
 				simulation_time,
-				ConfigManager::GetInstance().GetAppSettingBool("particles_enabled", true),
+				*config_.particles_enabled,
 				frame_config_.ambient_particle_density,
 				terrain_render_manager ? terrain_render_manager->GetChunkInfo(terrain_generator->GetWorldScale())
 									   : std::vector<glm::vec4>{},
@@ -2576,9 +2666,7 @@ namespace Boidsish {
 			shockwave_manager->BindUBO(Constants::UboBinding::Shockwaves());
 
 			if (decor_manager && terrain_generator && terrain_render_manager) {
-				decor_manager->SetMinPixelSize(
-					ConfigManager::GetInstance().GetAppSettingFloat("foliage_culling_pixel_threshold", 8.0f)
-				);
+				decor_manager->SetMinPixelSize(*config_.foliage_culling_pixel_threshold);
 				if (atmosphere_manager) {
 					decor_manager->SetAtmosphereManager(atmosphere_manager.get());
 				}
@@ -3612,6 +3700,7 @@ namespace Boidsish {
 
 		// Logical updates migrated from Render
 		impl->GatherShapes();
+		impl->animation_crowd.Update(impl->simulation_delta_time, impl->camera.pos());
 		impl->UpdateCamera();
 		impl->UpdateAudio();
 		impl->UpdateAtmosphere();
@@ -4346,6 +4435,10 @@ namespace Boidsish {
 		return impl->thread_pool;
 	}
 
+	AnimationCrowd& Visualizer::GetAnimationCrowd() {
+		return impl->animation_crowd;
+	}
+
 	LightManager& Visualizer::GetLightManager() {
 		return *impl->light_manager;
 	}
@@ -4879,31 +4972,31 @@ namespace Boidsish {
 	}
 
 	bool Visualizer::IsRippleEffectEnabled() const {
-		return ConfigManager::GetInstance().GetAppSettingBool("artistic_effect_ripple", false);
+		return *impl->config_.artistic_ripple;
 	}
 
 	bool Visualizer::IsColorShiftEffectEnabled() const {
-		return ConfigManager::GetInstance().GetAppSettingBool("artistic_effect_color_shift", false);
+		return *impl->config_.artistic_color_shift;
 	}
 
 	bool Visualizer::IsBlackAndWhiteEffectEnabled() const {
-		return ConfigManager::GetInstance().GetAppSettingBool("artistic_effect_black_and_white", false);
+		return *impl->config_.artistic_black_and_white;
 	}
 
 	bool Visualizer::IsNegativeEffectEnabled() const {
-		return ConfigManager::GetInstance().GetAppSettingBool("artistic_effect_negative", false);
+		return *impl->config_.artistic_negative;
 	}
 
 	bool Visualizer::IsShimmeryEffectEnabled() const {
-		return ConfigManager::GetInstance().GetAppSettingBool("artistic_effect_shimmery", false);
+		return *impl->config_.artistic_shimmery;
 	}
 
 	bool Visualizer::IsGlitchedEffectEnabled() const {
-		return ConfigManager::GetInstance().GetAppSettingBool("artistic_effect_glitched", false);
+		return *impl->config_.artistic_glitched;
 	}
 
 	bool Visualizer::IsWireframeEffectEnabled() const {
-		return ConfigManager::GetInstance().GetAppSettingBool("artistic_effect_wireframe", false);
+		return *impl->config_.artistic_wireframe;
 	}
 
 	UI::UIConfigManager& Visualizer::GetUIConfigManager() {
@@ -0,0 +1,44 @@
+#include "lod_selector.h"
+
+#include <limits>
+
+namespace Boidsish {
+
+	float LodSelector::ScreenError(float error, const glm::vec3& center, float radius, const RenderContext& context) {
+		// projection[1][1] is cot(fov / 2): the viewport spans 2 / projection[1][1] at unit depth
+		float scale = context.projection[1][1] * 0.5f;
+		if (context.projection[2][3] == 0.0f) // Orthographic
+			return error * scale;
+
+		float distance = glm::distance(context.view_pos, center) - radius;
+		if (distance <= 1e-3f)
+			return std::numeric_limits<float>::infinity();
+		return error * scale / distance;
+	}
+
+	size_t LodSelector::Select(
+		std::span<const LodRange> lods,
+		const glm::vec3&          center,
+		float                     radius,
+		const RenderContext&      context,
+		float                     error_scale
+	) {
+		if (context.lod_screen_error <= 0.0f)
+			return 0;
+		for (size_t i = lods.size(); i-- > 1;) {
+			if (ScreenError(lods[i].error * error_scale, center, radius, context) <= context.lod_screen_error)
+				return i;
+		}
+		return 0;
+	}
+
+	void LodSelector::Apply(RenderPacket& packet, const RenderContext& context) {
+		if (packet.lods.empty())
+			return;
+		std::span<const LodRange> lods = packet.lods.View();
+		const LodRange& lod = lods[Select(lods, packet.lod_center, packet.lod_radius, context, packet.lod_error_scale)];
+		packet.first_index = lod.first_index;
+		packet.index_count = lod.index_count;
+	}
+
+} // namespace Boidsish
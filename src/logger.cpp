@@ -6,6 +6,228 @@
 
 namespace logger {
 
+	namespace {
+		std::atomic<uint64_t> g_nextQueueId{1};
+
+		struct ThreadRingEntry {
+			uint64_t                              queue_id;
+			std::shared_ptr<detail::ProducerRing> ring;
+		};
+
+		thread_local std::vector<ThreadRingEntry> t_rings;
+
+		template <typename T>
+		T readValue(const uint8_t*& in) {
+			T value;
+			std::memcpy(&value, in, sizeof(T));
+			in += sizeof(T);
+			return value;
+		}
+
+		std::string_view readBytes(const uint8_t*& in) {
+			uint16_t len = readValue<uint16_t>(in);
+			std::string_view str(reinterpret_cast<const char*>(in), len);
+			in += len;
+			return str;
+		}
+	} // namespace
+
+	AsyncLogQueue::AsyncLogQueue(Backend& backend, const AsyncOptions& options):
+		backend_(backend), options_(options), id_(g_nextQueueId.fetch_add(1, std::memory_order_relaxed)) {
+		writer_ = std::thread([this]() { writerLoop(); });
+	}
+
+	AsyncLogQueue::~AsyncLogQueue() {
+		stop_.store(true, std::memory_order_release);
+		wake();
+		if (writer_.joinable())
+			writer_.join();
+
+		std::lock_guard<std::mutex> lock(rings_mutex_);
+		for (auto& ring : rings_) {
+			ring->orphaned.store(true, std::memory_order_release);
+		}
+	}
+
+	detail::ProducerRing& AsyncLogQueue::localRing() {
+		for (auto& entry : t_rings) {
+			if (entry.queue_id == id_)
+				return *entry.ring;
+		}
+
+		// First record from this thread: drop rings of destroyed queues and register a new one
+		std::erase_if(t_rings, [](const ThreadRingEntry& e) {
+			return e.ring->orphaned.load(std::memory_order_acquire);
+		});
+		auto ring = std::make_shared<detail::ProducerRing>(options_.slots_per_thread);
+		{
+			std::lock_guard<std::mutex> lock(rings_mutex_);
+			rings_.push_back(ring);
+		}
+		t_rings.push_back({id_, ring});
+		return *ring;
+	}
+
+	void AsyncLogQueue::wake() {
+		{
+			std::lock_guard<std::mutex> lock(wake_mutex_);
+			wake_pending_ = true;
+		}
+		wake_cv_.notify_one();
+	}
+
+	void AsyncLogQueue::flush() {
+		std::unique_lock<std::mutex> lock(flush_mutex_);
+		// A pass already in flight may have missed records committed just before this call,
+		// so wait for one full pass that starts afterwards.
+		uint64_t target = passes_ + 2;
+		lock.unlock();
+		wake();
+		lock.lock();
+		flush_cv_.wait(lock, [&]() { return passes_ >= target || writer_done_; });
+	}
+
+	AsyncStats AsyncLogQueue::stats() const {
+		std::lock_guard<std::mutex> lock(rings_mutex_);
+		AsyncStats                  result = retired_;
+		for (const auto& ring : rings_) {
+			result.enqueued += ring->enqueued.load(std::memory_order_relaxed);
+			result.dropped += ring->dropped.load(std::memory_order_relaxed);
+			result.blocked += ring->blocked.load(std::memory_order_relaxed);
+			result.truncated += ring->truncated.load(std::memory_order_relaxed);
+		}
+		result.written = written_.load(std::memory_order_relaxed);
+		result.batches = batches_.load(std::memory_order_relaxed);
+		return result;
+	}
+
+	void AsyncLogQueue::writerLoop() {
+		while (true) {
+			bool   stopping = stop_.load(std::memory_order_acquire);
+			size_t count = drainOnce();
+
+			{
+				std::lock_guard<std::mutex> lock(flush_mutex_);
+				++passes_;
+			}
+			flush_cv_.notify_all();
+
+			// Producers have stopped by the time the queue is destroyed, so an empty pass
+			// observed after the stop request means everything has been written.
+			if (stopping && count == 0)
+				break;
+
+			if (count == 0) {
+				std::unique_lock<std::mutex> lock(wake_mutex_);
+				wake_cv_.wait_for(lock, options_.flush_interval, [&]() {
+					return wake_pending_ || stop_.load(std::memory_order_acquire);
+				});
+				wake_pending_ = false;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(flush_mutex_);
+			writer_done_ = true;
+		}
+		flush_cv_.notify_all();
+	}
+
+	size_t AsyncLogQueue::drainOnce() {
+		std::vector<std::shared_ptr<detail::ProducerRing>> rings;
+		{
+			std::lock_guard<std::mutex> lock(rings_mutex_);
+			// Rings whose thread has exited are only referenced here; retire them once empty
+			std::erase_if(rings_, [&](const std::shared_ptr<detail::ProducerRing>& ring) {
+				bool retire = ring.use_count() == 1 && ring->head.load(std::memory_order_relaxed) ==
+														   ring->tail.load(std::memory_order_acquire);
+				if (retire) {
+					retired_.enqueued += ring->enqueued.load(std::memory_order_relaxed);
+					retired_.dropped += ring->dropped.load(std::memory_order_relaxed);
+					retired_.blocked += ring->blocked.load(std::memory_order_relaxed);
+					retired_.truncated += ring->truncated.load(std::memory_order_relaxed);
+				}
+				return retire;
+			});
+			rings = rings_;
+		}
+
+		size_t count = 0;
+		for (auto& ring : rings) {
+			uint64_t head = ring->head.load(std::memory_order_relaxed);
+			uint64_t tail = ring->tail.load(std::memory_order_acquire);
+			for (uint64_t i = head; i < tail; ++i) {
+				renderRecord(ring->slots[i & ring->mask]);
+			}
+			ring->head.store(tail, std::memory_order_release);
+			count += tail - head;
+		}
+
+		if (count > 0) {
+			backend_.flush();
+			written_.fetch_add(count, std::memory_order_relaxed);
+			batches_.fetch_add(1, std::memory_order_relaxed);
+		}
+		return count;
+	}
+
+	void AsyncLogQueue::renderRecord(const detail::RecordSlot& slot) {
+		const detail::RecordHeader& header = slot.header;
+		const uint8_t*              in = slot.payload;
+
+		std::string message(readBytes(in));
+		std::string tags;
+		size_t      searchPos = 0;
+		char        buf[32];
+
+		for (uint8_t i = 0; i < header.arg_count; ++i) {
+			auto             tag = static_cast<detail::ArgTag>(*in++);
+			std::string_view replacement;
+			switch (tag) {
+			case detail::ArgTag::Int: {
+				auto end = std::to_chars(buf, buf + sizeof(buf), readValue<int64_t>(in)).ptr;
+				replacement = std::string_view(buf, end - buf);
+				break;
+			}
+			case detail::ArgTag::UInt: {
+				auto end = std::to_chars(buf, buf + sizeof(buf), readValue<uint64_t>(in)).ptr;
+				replacement = std::string_view(buf, end - buf);
+				break;
+			}
+			case detail::ArgTag::Double: {
+				// %g matches the default ostream formatting used by the synchronous path
+				int len = std::snprintf(buf, sizeof(buf), "%g", readValue<double>(in));
+				replacement = std::string_view(buf, std::max(len, 0));
+				break;
+			}
+			case detail::ArgTag::Bool:
+				replacement = readValue<uint64_t>(in) ? "1"sv : "0"sv;
+				break;
+			case detail::ArgTag::Char:
+				buf[0] = static_cast<char>(readValue<uint64_t>(in));
+				replacement = std::string_view(buf, 1);
+				break;
+			case detail::ArgTag::String:
+				replacement = readBytes(in);
+				break;
+			}
+			detail::applyArgument(message, searchPos, tags, replacement);
+		}
+
+		if (header.truncated) {
+			tags += "[truncated] ";
+		}
+
+		LogMessage log{
+			.level = header.level,
+			.message = message,
+			.file_name = header.file,
+			.tags = tags,
+			.line_number = header.line,
+		};
+		backend_.render(header.level, format(log));
+	}
+
 	static LogLevel stringToLogLevel(const std::string& str) {
 		std::string s = str;
 		std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
@@ -47,10 +269,18 @@ namespace logger {
 			}
 		}
 
+		if (!cfg.HasKey("logging", "async_enabled"))
+			cfg.SetBool("logging", "async_enabled", false);
+		if (!cfg.HasKey("logging", "async_overflow_policy"))
+			cfg.SetString("logging", "async_overflow_policy", "drop");
+
 		// Save the config if we added any defaults
 		// This makes the config file self-documenting for logging
 		cfg.Save();
 
+		// Backends may only be replaced while no writer thread is using them
+		defaultLogger.stopAsync();
+
 		auto& multi = defaultLogger.backend;
 		multi.clearBackends();
 
@@ -81,6 +311,16 @@ namespace logger {
 			}
 			multi.addBackend(std::move(file));
 		}
+
+		if (cfg.GetBool("logging", "async_enabled", false)) {
+			AsyncOptions options;
+			std::string  policy = cfg.GetString("logging", "async_overflow_policy", "drop");
+			std::transform(policy.begin(), policy.end(), policy.begin(), [](unsigned char c) {
+				return std::tolower(c);
+			});
+			options.overflow = policy == "block" ? OverflowPolicy::Block : OverflowPolicy::Drop;
+			defaultLogger.startAsync(options);
+		}
 	}
 
 } // namespace logger
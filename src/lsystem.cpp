@@ -0,0 +1,71 @@
+#include "lsystem.h"
+
+#include <algorithm>
+
+namespace Boidsish {
+
+	LSystem::SymbolStream::SymbolStream(const LSystem& lsystem, std::string_view text, int iterations):
+		lsystem_(&lsystem) {
+		frames_.reserve(static_cast<size_t>(std::max(iterations, 0)) + 1);
+		frames_.push_back({text, 0, std::max(iterations, 0)});
+		Advance();
+	}
+
+	void LSystem::SymbolStream::Advance() {
+		while (!frames_.empty()) {
+			Frame& top = frames_.back();
+			if (top.position == top.text.size()) {
+				frames_.pop_back();
+				continue;
+			}
+
+			char c = top.text[top.position++];
+			if (top.iterations > 0 && lsystem_->HasRule(c)) {
+				// May reallocate, so top is not used past this point
+				frames_.push_back({lsystem_->GetRule(c), 0, top.iterations - 1});
+				continue;
+			}
+
+			current_ = c;
+			return;
+		}
+	}
+
+	void LSystem::SetRules(const std::vector<std::string>& rule_strings) {
+		for (const auto& rule : rule_strings) {
+			size_t pos = rule.find('=');
+			if (pos != std::string::npos && pos > 0) {
+				SetRule(rule[0], rule.substr(pos + 1));
+			}
+		}
+	}
+
+	std::vector<std::array<size_t, 256>> LSystem::LengthTable(int iterations) const {
+		std::vector<std::array<size_t, 256>> lengths(static_cast<size_t>(std::max(iterations, 0)) + 1);
+		lengths[0].fill(1);
+		for (size_t d = 1; d < lengths.size(); ++d) {
+			for (size_t s = 0; s < 256; ++s) {
+				if (!has_rule_.test(s)) {
+					lengths[d][s] = 1;
+					continue;
+				}
+				size_t length = 0;
+				for (char c : rules_[s]) {
+					length += lengths[d - 1][Index(c)];
+				}
+				lengths[d][s] = length;
+			}
+		}
+		return lengths;
+	}
+
+	size_t LSystem::ExpandedLength(int iterations) const {
+		auto   lengths = LengthTable(iterations);
+		size_t length = 0;
+		for (char c : axiom_) {
+			length += lengths.back()[Index(c)];
+		}
+		return length;
+	}
+
+} // namespace Boidsish
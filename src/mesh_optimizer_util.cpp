@@ -1,13 +1,33 @@
 #include "mesh_optimizer_util.h"
 
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <vector>
 
+#include "ConfigManager.h"
 #include "logger.h"
 #include <meshoptimizer.h>
 
 namespace Boidsish {
 
+	namespace {
+		uint32_t PackNormal(glm::vec3 n) {
+			float length = glm::length(n);
+			n = length > 0.0f ? n / length : glm::vec3(0.0f, 0.0f, 1.0f);
+			uint32_t x = uint32_t(meshopt_quantizeSnorm(n.x, 10)) & 0x3FF;
+			uint32_t y = uint32_t(meshopt_quantizeSnorm(n.y, 10)) & 0x3FF;
+			uint32_t z = uint32_t(meshopt_quantizeSnorm(n.z, 10)) & 0x3FF;
+			return x | (y << 10) | (z << 20);
+		}
+
+		// Signed normalized decode as GL does it for GL_INT_2_10_10_10_REV
+		float UnpackSnorm10(uint32_t bits) {
+			int value = int32_t(bits << 22) >> 22;
+			return std::max(value / 511.0f, -1.0f);
+		}
+	} // namespace
+
 	void MeshOptimizerUtil::Optimize(
 		std::vector<Vertex>&       vertices,
 		std::vector<unsigned int>& indices,
@@ -138,4 +158,223 @@ namespace Boidsish {
 		);
 	}
 
+	void MeshOptimizerUtil::GenerateLods(
+		const std::vector<Vertex>&       vertices,
+		const std::vector<unsigned int>& indices,
+		std::vector<MeshLod>&            out_lods,
+		int                              max_levels,
+		const std::string&               model_name
+	) {
+		out_lods.clear();
+		if (indices.empty() || vertices.empty() || max_levels <= 0)
+			return;
+
+		const float* positions = &vertices[0].Position.x;
+		const float  scale = meshopt_simplifyScale(positions, vertices.size(), sizeof(Vertex));
+
+		// Reserved so source stays valid while levels are appended
+		out_lods.reserve(max_levels);
+		const std::vector<unsigned int>* source = &indices;
+		float                            error = 0.0f;
+		for (int level = 0; level < max_levels; ++level) {
+			size_t target_index_count = source->size() / 6 * 3;
+			if (target_index_count < 3)
+				break;
+
+			MeshLod lod;
+			lod.indices.resize(source->size());
+			float  level_error = 0.0f;
+			size_t count = meshopt_simplify(
+				lod.indices.data(),
+				source->data(),
+				source->size(),
+				positions,
+				vertices.size(),
+				sizeof(Vertex),
+				target_index_count,
+				FLT_MAX,
+				meshopt_SimplifyLockBorder,
+				&level_error
+			);
+			// Not worth a level of its own
+			if (count == 0 || count > source->size() * 9 / 10)
+				break;
+
+			lod.indices.resize(count);
+			meshopt_optimizeVertexCache(lod.indices.data(), lod.indices.data(), count, vertices.size());
+			error += level_error * scale;
+			lod.error = error;
+			out_lods.push_back(std::move(lod));
+			source = &out_lods.back().indices;
+		}
+
+		logger::LOG(
+			"Generated {} LODs for model: {} ({} indices down to {})",
+			out_lods.size(),
+			model_name,
+			indices.size(),
+			out_lods.empty() ? indices.size() : out_lods.back().indices.size()
+		);
+	}
+
+	void MeshOptimizerUtil::BuildMeshlets(
+		const std::vector<Vertex>&       vertices,
+		const std::vector<unsigned int>& indices,
+		MeshletData&                     out
+	) {
+		out = MeshletData{};
+		if (indices.empty() || vertices.empty())
+			return;
+
+		const size_t max_vertices = MeshletData::kMaxVertices;
+		const size_t max_triangles = MeshletData::kMaxTriangles;
+		const float  cone_weight = 0.25f; // Trades some locality for tighter normal cones
+
+		std::vector<meshopt_Meshlet> meshlets(meshopt_buildMeshletsBound(indices.size(), max_vertices, max_triangles));
+		out.vertices.resize(meshlets.size() * max_vertices);
+		out.triangles.resize(meshlets.size() * max_triangles * 3);
+
+		size_t count = meshopt_buildMeshlets(
+			meshlets.data(),
+			out.vertices.data(),
+			out.triangles.data(),
+			indices.data(),
+			indices.size(),
+			&vertices[0].Position.x,
+			vertices.size(),
+			sizeof(Vertex),
+			max_vertices,
+			max_triangles,
+			cone_weight
+		);
+		meshlets.resize(count);
+
+		const meshopt_Meshlet& last = meshlets.back();
+		out.vertices.resize(last.vertex_offset + last.vertex_count);
+		out.triangles.resize(last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3u));
+
+		out.meshlets.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			const meshopt_Meshlet& m = meshlets[i];
+			meshopt_optimizeMeshlet(
+				&out.vertices[m.vertex_offset],
+				&out.triangles[m.triangle_offset],
+				m.triangle_count,
+				m.vertex_count
+			);
+			meshopt_Bounds bounds = meshopt_computeMeshletBounds(
+				&out.vertices[m.vertex_offset],
+				&out.triangles[m.triangle_offset],
+				m.triangle_count,
+				&vertices[0].Position.x,
+				vertices.size(),
+				sizeof(Vertex)
+			);
+
+			Meshlet& meshlet = out.meshlets[i];
+			meshlet.center = glm::vec3(bounds.center[0], bounds.center[1], bounds.center[2]);
+			meshlet.radius = bounds.radius;
+			meshlet.cone_apex = glm::vec3(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2]);
+			meshlet.cone_cutoff = bounds.cone_cutoff;
+			meshlet.cone_axis = glm::vec3(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]);
+			meshlet.triangle_count = m.triangle_count;
+			meshlet.vertex_offset = m.vertex_offset;
+			meshlet.triangle_offset = m.triangle_offset;
+			meshlet.vertex_count = m.vertex_count;
+		}
+	}
+
+	bool MeshOptimizerUtil::PackVertices(
+		const std::vector<Vertex>& vertices,
+		PackedVertexData&          out,
+		float                      max_position_error
+	) {
+		out.vertices.resize(vertices.size());
+		out.skin.clear();
+		out.half_tex_coords = false;
+		if (vertices.empty())
+			return true;
+
+		glm::vec3 min = vertices[0].Position, max = vertices[0].Position;
+		bool      skinned = false;
+		for (const auto& v : vertices) {
+			min = glm::min(min, v.Position);
+			max = glm::max(max, v.Position);
+			out.half_tex_coords |= v.TexCoords.x < 0.0f || v.TexCoords.x > 1.0f || v.TexCoords.y < 0.0f ||
+				v.TexCoords.y > 1.0f;
+			for (int id : v.m_BoneIDs) {
+				if (id >= PackedSkin::kNoBone)
+					return false;
+				skinned |= id >= 0;
+			}
+		}
+		const glm::vec3 extent = max - min;
+		const float     tolerance = std::max({extent.x, extent.y, extent.z}) * max_position_error;
+
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			const Vertex& v = vertices[i];
+			PackedVertex& p = out.vertices[i];
+			for (int c = 0; c < 3; ++c) {
+				p.position[c] = meshopt_quantizeHalf(v.Position[c]);
+				if (std::abs(meshopt_dequantizeHalf(p.position[c]) - v.Position[c]) > tolerance)
+					return false;
+			}
+			p.position[3] = meshopt_quantizeHalf(1.0f);
+			p.normal = PackNormal(v.Normal);
+			for (int c = 0; c < 2; ++c) {
+				p.tex_coords[c] = out.half_tex_coords ? meshopt_quantizeHalf(v.TexCoords[c])
+													  : uint16_t(meshopt_quantizeUnorm(v.TexCoords[c], 16));
+			}
+			for (int c = 0; c < 3; ++c) {
+				p.color[c] = uint8_t(meshopt_quantizeUnorm(glm::clamp(v.Color[c], 0.0f, 1.0f), 8));
+			}
+			p.color[3] = 255;
+		}
+
+		if (skinned) {
+			out.skin.resize(vertices.size());
+			for (size_t i = 0; i < vertices.size(); ++i) {
+				for (int j = 0; j < MAX_BONE_INFLUENCE; ++j) {
+					bool used = vertices[i].m_BoneIDs[j] >= 0;
+					out.skin[i].bone_ids[j] = used ? uint8_t(vertices[i].m_BoneIDs[j]) : PackedSkin::kNoBone;
+					out.skin[i].weights[j] = used
+						? uint8_t(meshopt_quantizeUnorm(glm::clamp(vertices[i].m_Weights[j], 0.0f, 1.0f), 8))
+						: 0;
+				}
+			}
+		}
+		return true;
+	}
+
+	void MeshOptimizerUtil::UnpackVertices(const PackedVertexData& packed, std::vector<Vertex>& out_vertices) {
+		out_vertices.resize(packed.vertices.size());
+		for (size_t i = 0; i < packed.vertices.size(); ++i) {
+			const PackedVertex& p = packed.vertices[i];
+			Vertex&             v = out_vertices[i];
+			v = Vertex{};
+			for (int c = 0; c < 3; ++c) {
+				v.Position[c] = meshopt_dequantizeHalf(p.position[c]);
+				v.Normal[c] = UnpackSnorm10(p.normal >> (10 * c));
+				v.Color[c] = p.color[c] / 255.0f;
+			}
+			for (int c = 0; c < 2; ++c) {
+				v.TexCoords[c] = packed.half_tex_coords ? meshopt_dequantizeHalf(p.tex_coords[c])
+														: p.tex_coords[c] / 65535.0f;
+			}
+			if (i < packed.skin.size()) {
+				for (int j = 0; j < MAX_BONE_INFLUENCE; ++j) {
+					uint8_t id = packed.skin[i].bone_ids[j];
+					v.m_BoneIDs[j] = id == PackedSkin::kNoBone ? -1 : id;
+					v.m_Weights[j] = packed.skin[i].weights[j] / 255.0f;
+				}
+			}
+		}
+	}
+
+	VertexFormat MeshOptimizerUtil::ConfiguredVertexFormat() {
+		return ConfigManager::GetInstance().GetAppSettingBool("packed_vertex_format_enabled", false)
+			? VertexFormat::Packed
+			: VertexFormat::Full;
+	}
+
 } // namespace Boidsish
@@ -8,7 +8,9 @@
 
 #include "animator.h"
 #include "asset_manager.h"
+#include "lod_selector.h"
 #include "logger.h"
+#include "mesh_optimizer_util.h"
 #include "shader.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -28,12 +30,16 @@ namespace Boidsish {
 		std::vector<Vertex>       vertices,
 		std::vector<unsigned int> indices,
 		std::vector<Texture>      textures,
-		std::vector<unsigned int> shadow_indices
+		std::vector<unsigned int> shadow_indices,
+		std::vector<MeshLod>      lods,
+		VertexFormat              vertex_format
 	) {
-		this->vertices = vertices;
-		this->indices = indices;
-		this->textures = textures;
-		this->shadow_indices = shadow_indices;
+		this->vertices = std::move(vertices);
+		this->indices = std::move(indices);
+		this->textures = std::move(textures);
+		this->shadow_indices = std::move(shadow_indices);
+		this->lods = std::move(lods);
+		this->vertex_format = vertex_format;
 
 		setupMesh(nullptr); // Initial setup (legacy if no megabuffer yet)
 	}
@@ -50,11 +56,14 @@ namespace Boidsish {
 		ao = other.ao;
 		emissiveColor = other.emissiveColor;
 		has_vertex_colors = other.has_vertex_colors;
+		vertex_format = other.vertex_format;
+		lods = other.lods;
 
 		// Do not copy VAO/VBO/EBO handles - setupMesh will create new ones if needed
-		VAO = VBO = EBO = shadow_EBO = 0;
+		VAO = VBO = EBO = shadow_EBO = skin_VBO = 0;
 		allocation.valid = false;
 		shadow_allocation.valid = false;
+		lod_allocation.valid = false;
 	}
 
 	Mesh& Mesh::operator=(const Mesh& other) {
@@ -71,12 +80,15 @@ namespace Boidsish {
 			ao = other.ao;
 			emissiveColor = other.emissiveColor;
 			has_vertex_colors = other.has_vertex_colors;
+			vertex_format = other.vertex_format;
+			lods = other.lods;
 		}
 		return *this;
 	}
 
 	void Mesh::setupMesh(Megabuffer* mb) {
-		if (mb) {
+		// The megabuffer only holds full vertices, so packed meshes keep their own buffers
+		if (mb && vertex_format == VertexFormat::Full) {
 			if (allocation.valid)
 				return;
 
@@ -113,6 +125,26 @@ namespace Boidsish {
 						);
 					}
 				}
+
+				// LOD levels share one allocation, each drawn from its own offset into it
+				std::vector<unsigned int> lod_indices = ConcatenateLods();
+				if (!lod_indices.empty()) {
+					lod_allocation = mb->AllocateStatic(0, static_cast<uint32_t>(lod_indices.size()));
+					if (lod_allocation.valid) {
+						lod_allocation.base_vertex = allocation.base_vertex;
+						mb->Upload(
+							lod_allocation,
+							nullptr,
+							0,
+							lod_indices.data(),
+							static_cast<uint32_t>(lod_indices.size())
+						);
+						for (auto& lod : lods) {
+							lod.first_index += lod_allocation.first_index;
+						}
+						BuildLodRanges(allocation.first_index);
+					}
+				}
 			}
 			return;
 		}
@@ -125,6 +157,13 @@ namespace Boidsish {
 			return;
 		}
 
+		PackedVertexData packed;
+		bool             use_packed = vertex_format == VertexFormat::Packed &&
+			MeshOptimizerUtil::PackVertices(vertices, packed);
+		if (vertex_format == VertexFormat::Packed && !use_packed) {
+			logger::WARNING("Mesh of {} vertices cannot be packed, uploading full vertices", vertices.size());
+		}
+
 		glGenVertexArrays(1, &VAO);
 		glGenBuffers(1, &VBO);
 		glGenBuffers(1, &EBO);
@@ -132,18 +171,42 @@ namespace Boidsish {
 		glBindVertexArray(VAO);
 		glBindBuffer(GL_ARRAY_BUFFER, VBO);
 
-		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+		if (use_packed) {
+			glBufferData(
+				GL_ARRAY_BUFFER,
+				packed.vertices.size() * sizeof(PackedVertex),
+				packed.vertices.data(),
+				GL_STATIC_DRAW
+			);
+		} else {
+			glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+		}
 
-		// Combine primary and shadow indices into a single EBO
+		// Combine primary, shadow and LOD indices into a single EBO
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-		size_t primary_size = indices.size() * sizeof(unsigned int);
-		size_t shadow_size = shadow_indices.size() * sizeof(unsigned int);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, primary_size + shadow_size, nullptr, GL_STATIC_DRAW);
+		std::vector<unsigned int> lod_indices = ConcatenateLods();
+		size_t                    primary_size = indices.size() * sizeof(unsigned int);
+		size_t                    shadow_size = shadow_indices.size() * sizeof(unsigned int);
+		size_t                    lod_size = lod_indices.size() * sizeof(unsigned int);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, primary_size + shadow_size + lod_size, nullptr, GL_STATIC_DRAW);
 		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, primary_size, indices.data());
 		if (!shadow_indices.empty()) {
 			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, primary_size, shadow_size, shadow_indices.data());
 			shadow_EBO = EBO; // Reuse the same EBO but with different offset (handled during draw)
 		}
+		if (!lod_indices.empty()) {
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, primary_size + shadow_size, lod_size, lod_indices.data());
+			for (auto& lod : lods) {
+				lod.first_index += static_cast<uint32_t>(indices.size() + shadow_indices.size());
+			}
+			BuildLodRanges(0);
+		}
+
+		if (use_packed) {
+			SetupPackedAttributes(packed);
+			glBindVertexArray(0);
+			return;
+		}
 
 		// Vertex Positions
 		glEnableVertexAttribArray(0);
@@ -169,6 +232,96 @@ namespace Boidsish {
 		glBindVertexArray(0);
 	}
 
+	std::vector<unsigned int> Mesh::ConcatenateLods() {
+		// first_index is left relative to the returned buffer; callers add where it lands
+		std::vector<unsigned int> result;
+		for (auto& lod : lods) {
+			lod.first_index = static_cast<uint32_t>(result.size());
+			result.insert(result.end(), lod.indices.begin(), lod.indices.end());
+		}
+		return result;
+	}
+
+	void Mesh::BuildLodRanges(uint32_t first_index) {
+		lod_ranges.clear();
+		lod_ranges.reserve(lods.size() + 1);
+		lod_ranges.push_back({first_index, static_cast<uint32_t>(indices.size()), 0.0f});
+		for (const auto& lod : lods) {
+			lod_ranges.push_back({lod.first_index, static_cast<uint32_t>(lod.indices.size()), lod.error});
+		}
+	}
+
+	void Mesh::SetupPackedAttributes(const PackedVertexData& packed) {
+		// Each attribute decodes to the type the shaders declare for the full layout
+		const GLsizei stride = sizeof(PackedVertex);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 4, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, position));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(PackedVertex, normal));
+		glEnableVertexAttribArray(2);
+		if (packed.half_tex_coords) {
+			glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, tex_coords));
+		} else {
+			glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, tex_coords));
+		}
+		glEnableVertexAttribArray(8);
+		glVertexAttribPointer(8, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(PackedVertex, color));
+
+		// Unskinned meshes bind a single kNoBone/zero-weight element instead of relying on the
+		// context-global generic values. A divisor no instance count reaches keeps every vertex
+		// and instance on that element (draws here never set a base instance).
+		static const PackedSkin kUnskinned = {
+			{PackedSkin::kNoBone, PackedSkin::kNoBone, PackedSkin::kNoBone, PackedSkin::kNoBone},
+			{0, 0, 0, 0}
+		};
+		const bool        skinned = !packed.skin.empty();
+		const PackedSkin* skin = skinned ? packed.skin.data() : &kUnskinned;
+		const size_t      skin_count = skinned ? packed.skin.size() : 1;
+
+		glGenBuffers(1, &skin_VBO);
+		glBindBuffer(GL_ARRAY_BUFFER, skin_VBO);
+		glBufferData(GL_ARRAY_BUFFER, skin_count * sizeof(PackedSkin), skin, GL_STATIC_DRAW);
+		// Unused slots hold kNoBone, which the shaders skip like any id past their bone limit
+		glEnableVertexAttribArray(9);
+		glVertexAttribIPointer(9, 4, GL_UNSIGNED_BYTE, sizeof(PackedSkin), (void*)offsetof(PackedSkin, bone_ids));
+		glEnableVertexAttribArray(10);
+		glVertexAttribPointer(
+			10,
+			4,
+			GL_UNSIGNED_BYTE,
+			GL_TRUE,
+			sizeof(PackedSkin),
+			(void*)offsetof(PackedSkin, weights)
+		);
+		if (!skinned) {
+			glVertexAttribDivisor(9, std::numeric_limits<GLuint>::max());
+			glVertexAttribDivisor(10, std::numeric_limits<GLuint>::max());
+		}
+	}
+
+	void Mesh::SetVertexFormat(VertexFormat format) {
+		if (format == vertex_format)
+			return;
+		if (allocation.valid) {
+			logger::WARNING("Mesh is already in the megabuffer, keeping its vertex format");
+			return;
+		}
+
+		bool uploaded = VAO != 0;
+		Cleanup();
+		vertex_format = format;
+		if (uploaded) {
+			setupMesh(nullptr);
+		}
+	}
+
+	size_t Mesh::GetVertexBytes() const {
+		PackedVertexData packed;
+		if (vertex_format == VertexFormat::Packed && MeshOptimizerUtil::PackVertices(vertices, packed))
+			return packed.ByteSize();
+		return vertices.size() * sizeof(Vertex);
+	}
+
 	Mesh::~Mesh() {
 		Cleanup();
 	}
@@ -183,13 +336,19 @@ namespace Boidsish {
 		if (EBO != 0 && !allocation.valid) {
 			glDeleteBuffers(1, &EBO);
 		}
+		if (skin_VBO != 0) {
+			glDeleteBuffers(1, &skin_VBO);
+		}
 
 		VAO = 0;
 		VBO = 0;
 		EBO = 0;
 		shadow_EBO = 0;
+		skin_VBO = 0;
 		allocation.valid = false;
 		shadow_allocation.valid = false;
+		lod_allocation.valid = false;
+		lod_ranges.clear();
 	}
 
 	void Mesh::UploadToGPU() {
@@ -399,6 +558,13 @@ namespace Boidsish {
 		}
 	}
 
+	void ModelData::BuildMeshlets() {
+		meshlets.resize(meshes.size());
+		for (size_t i = 0; i < meshes.size(); ++i) {
+			MeshOptimizerUtil::BuildMeshlets(meshes[i].vertices, meshes[i].indices, meshlets[i]);
+		}
+	}
+
 	// Model implementation
 	Model::Model(const std::string& path, bool no_cull): no_cull_(no_cull) {
 		m_data = AssetManager::GetInstance().GetModelData(path);
@@ -531,6 +697,14 @@ namespace Boidsish {
 			actual_dissolve_dist = dMin + dissolve_sweep_ * (dMax - dMin);
 		}
 
+		// LOD errors are in mesh space; the largest axis scale keeps them conservative in world space
+		float max_scale = std::max(
+			{glm::length(glm::vec3(model_matrix[0])),
+			 glm::length(glm::vec3(model_matrix[1])),
+			 glm::length(glm::vec3(model_matrix[2]))}
+		);
+		AABB lod_bounds = m_data->aabb.Transform(model_matrix);
+
 		for (const auto& mesh : m_data->meshes) {
 			RenderPacket packet;
 			packet.vao = mesh.getVAO();
@@ -551,6 +725,14 @@ namespace Boidsish {
 				packet.shadow_first_index = static_cast<uint32_t>(mesh.indices.size());
 			}
 
+			if (!mesh.GetLodRanges().empty()) {
+				packet.lods.Assign(mesh.GetLodRanges());
+				packet.lod_error_scale = max_scale;
+				packet.lod_center = (lod_bounds.min + lod_bounds.max) * 0.5f;
+				packet.lod_radius = glm::length(lod_bounds.max - lod_bounds.min) * 0.5f;
+				LodSelector::Apply(packet, context);
+			}
+
 			packet.draw_mode = GL_TRIANGLES;
 			packet.index_type = GL_UNSIGNED_INT;
 			packet.shader_id = shader ? shader->ID : 0;
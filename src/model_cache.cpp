@@ -0,0 +1,567 @@
+#include "model_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+#include "logger.h"
+#include "model.h"
+
+#if defined(_WIN32)
+	#include <iterator>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace Boidsish {
+
+	namespace {
+		constexpr size_t kArrayAlignment = 16;
+
+		struct SourceStamp {
+			uint64_t size = 0;
+			int64_t  mtime = 0;
+		};
+
+		struct Header {
+			uint32_t magic;
+			uint32_t version;
+			uint32_t vertex_size;
+			uint32_t bone_info_size;
+			uint32_t key_position_size;
+			uint32_t key_rotation_size;
+			uint32_t key_scale_size;
+			uint32_t reserved;
+			uint64_t source_size;
+			int64_t  source_mtime;
+			uint64_t options_hash;
+		};
+
+		static_assert(std::is_trivially_copyable_v<Vertex>);
+		static_assert(std::is_trivially_copyable_v<BoneInfo>);
+		static_assert(std::is_trivially_copyable_v<KeyPosition>);
+		static_assert(std::is_trivially_copyable_v<KeyRotation>);
+		static_assert(std::is_trivially_copyable_v<KeyScale>);
+
+		Header MakeHeader(const SourceStamp& stamp, uint64_t options_hash) {
+			Header header{};
+			header.magic = ModelCache::kMagic;
+			header.version = ModelCache::kVersion;
+			header.vertex_size = sizeof(Vertex);
+			header.bone_info_size = sizeof(BoneInfo);
+			header.key_position_size = sizeof(KeyPosition);
+			header.key_rotation_size = sizeof(KeyRotation);
+			header.key_scale_size = sizeof(KeyScale);
+			header.source_size = stamp.size;
+			header.source_mtime = stamp.mtime;
+			header.options_hash = options_hash;
+			return header;
+		}
+
+		SourceStamp StampOf(const std::string& path) {
+			std::error_code ec;
+			SourceStamp     stamp;
+			auto            size = std::filesystem::file_size(path, ec);
+			if (ec)
+				return stamp;
+			auto mtime = std::filesystem::last_write_time(path, ec);
+			if (ec)
+				return stamp;
+			stamp.size = size;
+			stamp.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+			return stamp;
+		}
+
+		uint64_t Fnv1a(const std::string& text) {
+			uint64_t hash = 0xcbf29ce484222325ull;
+			for (unsigned char c : text) {
+				hash ^= c;
+				hash *= 0x100000001b3ull;
+			}
+			return hash;
+		}
+
+		class BlobWriter {
+		public:
+			template <typename T>
+			void Pod(const T& value) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				Bytes(&value, sizeof(T));
+			}
+
+			void String(const std::string& s) {
+				Pod(static_cast<uint32_t>(s.size()));
+				Bytes(s.data(), s.size());
+			}
+
+			// Count, then the elements starting on an aligned offset
+			template <typename T>
+			void Array(const T* data, size_t count) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				Pod(static_cast<uint64_t>(count));
+				buffer_.resize((buffer_.size() + kArrayAlignment - 1) & ~(kArrayAlignment - 1), 0);
+				Bytes(data, count * sizeof(T));
+			}
+
+			template <typename T>
+			void Array(const std::vector<T>& v) {
+				Array(v.data(), v.size());
+			}
+
+			const std::vector<char>& buffer() const { return buffer_; }
+
+		private:
+			void Bytes(const void* data, size_t size) {
+				const char* p = static_cast<const char*>(data);
+				buffer_.insert(buffer_.end(), p, p + size);
+			}
+
+			std::vector<char> buffer_;
+		};
+
+		class BlobReader {
+		public:
+			BlobReader(const char* data, size_t size): begin_(data), cursor_(data), end_(data + size) {}
+
+			template <typename T>
+			bool Pod(T& value) {
+				if (!Has(sizeof(T)))
+					return false;
+				std::memcpy(&value, cursor_, sizeof(T));
+				cursor_ += sizeof(T);
+				return true;
+			}
+
+			bool String(std::string& s) {
+				uint32_t size = 0;
+				if (!Pod(size) || !Has(size))
+					return false;
+				s.assign(cursor_, size);
+				cursor_ += size;
+				return true;
+			}
+
+			// Returns a view of the aligned elements inside the mapping
+			template <typename T>
+			bool ArrayView(const T*& data, size_t& count) {
+				uint64_t n = 0;
+				if (!Pod(n))
+					return false;
+				size_t offset = cursor_ - begin_;
+				size_t aligned = (offset + kArrayAlignment - 1) & ~(kArrayAlignment - 1);
+				cursor_ = begin_ + std::min(aligned, size_t(end_ - begin_));
+				if (n > size_t(end_ - cursor_) / sizeof(T))
+					return false;
+				data = reinterpret_cast<const T*>(cursor_);
+				count = static_cast<size_t>(n);
+				cursor_ += count * sizeof(T);
+				return true;
+			}
+
+			template <typename T>
+			bool Array(std::vector<T>& out) {
+				const T* data = nullptr;
+				size_t   count = 0;
+				if (!ArrayView(data, count))
+					return false;
+				out.resize(count);
+				if (count > 0) {
+					std::memcpy(out.data(), data, count * sizeof(T));
+				}
+				return true;
+			}
+
+			// Guards against corrupt counts before anything is sized from them
+			bool Fits(uint64_t count, size_t min_element_size) const {
+				return count <= size_t(end_ - cursor_) / min_element_size;
+			}
+
+		private:
+			bool Has(size_t size) const { return size <= size_t(end_ - cursor_); }
+
+			const char* begin_;
+			const char* cursor_;
+			const char* end_;
+		};
+
+		// Read-only view of a whole file, memory-mapped where supported
+		class MappedFile {
+		public:
+			explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+				std::ifstream in(path, std::ios::binary);
+				if (in) {
+					fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+					data_ = fallback_.data();
+					size_ = fallback_.size();
+				}
+#else
+				int fd = ::open(path.c_str(), O_RDONLY);
+				if (fd < 0)
+					return;
+				struct stat st;
+				if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+					void* mapping = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+					if (mapping != MAP_FAILED) {
+						data_ = static_cast<const char*>(mapping);
+						size_ = static_cast<size_t>(st.st_size);
+					}
+				}
+				::close(fd);
+#endif
+			}
+
+			~MappedFile() {
+#if !defined(_WIN32)
+				if (data_) {
+					::munmap(const_cast<char*>(data_), size_);
+				}
+#endif
+			}
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			const char* data() const { return data_; }
+
+			size_t size() const { return size_; }
+
+		private:
+			const char* data_ = nullptr;
+			size_t      size_ = 0;
+#if defined(_WIN32)
+			std::vector<char> fallback_;
+#endif
+		};
+
+		void WriteNode(BlobWriter& out, const NodeData& node) {
+			out.String(node.name);
+			out.Pod(node.transformation);
+			out.Pod(static_cast<uint32_t>(node.children.size()));
+			for (const auto& child : node.children) {
+				WriteNode(out, child);
+			}
+		}
+
+		bool ReadNode(BlobReader& in, NodeData& node, int depth) {
+			uint32_t child_count = 0;
+			if (depth > 1024 || !in.String(node.name) || !in.Pod(node.transformation) || !in.Pod(child_count) ||
+			    !in.Fits(child_count, 72))
+				return false;
+			node.childrenCount = static_cast<int>(child_count);
+			node.children.resize(child_count);
+			for (auto& child : node.children) {
+				if (!ReadNode(in, child, depth + 1))
+					return false;
+			}
+			return true;
+		}
+
+		bool ReadBody(
+			BlobReader&                        in,
+			ModelData&                         data,
+			const ModelCache::TextureResolver& resolve_texture,
+			VertexFormat                       vertex_format
+		) {
+			glm::vec3 aabb_min, aabb_max;
+			if (!in.Pod(aabb_min) || !in.Pod(aabb_max) || !in.Pod(data.global_inverse_transform) ||
+			    !in.Pod(data.bone_count))
+				return false;
+			data.aabb = AABB(aabb_min, aabb_max);
+
+			// Embedded textures stay in the mapping; only their location is recorded here
+			struct EmbeddedView {
+				const unsigned char* bytes;
+				size_t               size;
+				uint32_t             width, height;
+			};
+
+			uint32_t embedded_count = 0;
+			if (!in.Pod(embedded_count) || !in.Fits(embedded_count, 20))
+				return false;
+			std::vector<EmbeddedView> embedded(embedded_count);
+			for (auto& view : embedded) {
+				std::string key;
+				if (!in.String(key) || !in.Pod(view.width) || !in.Pod(view.height) ||
+				    !in.ArrayView(view.bytes, view.size))
+					return false;
+			}
+
+			uint32_t mesh_count = 0;
+			if (!in.Pod(mesh_count) || !in.Fits(mesh_count, 32))
+				return false;
+			data.meshes.reserve(mesh_count);
+			for (uint32_t m = 0; m < mesh_count; ++m) {
+				std::vector<Vertex>       vertices;
+				std::vector<unsigned int> indices, shadow_indices;
+				if (!in.Array(vertices) || !in.Array(indices) || !in.Array(shadow_indices))
+					return false;
+
+				std::vector<Texture> textures;
+				uint32_t             texture_count = 0;
+				if (!in.Pod(texture_count) || !in.Fits(texture_count, 12))
+					return false;
+				for (uint32_t t = 0; t < texture_count; ++t) {
+					Texture texture{0, {}, {}};
+					int32_t embedded_index = -1;
+					if (!in.String(texture.type) || !in.String(texture.path) || !in.Pod(embedded_index))
+						return false;
+					if (embedded_index >= static_cast<int32_t>(embedded.size()))
+						return false;
+
+					ModelCache::TextureSource source{texture.type, texture.path};
+					if (embedded_index >= 0) {
+						const EmbeddedView& view = embedded[embedded_index];
+						source.embedded = view.bytes;
+						source.embedded_size = view.size;
+						source.width = view.width;
+						source.height = view.height;
+					}
+					if (resolve_texture && resolve_texture(source, texture.id)) {
+						textures.push_back(texture);
+					}
+				}
+
+				glm::vec3 diffuse, emissive;
+				float     opacity, roughness, metallic, ao;
+				uint8_t   has_vertex_colors = 0;
+				if (!in.Pod(diffuse) || !in.Pod(opacity) || !in.Pod(roughness) || !in.Pod(metallic) || !in.Pod(ao) ||
+				    !in.Pod(emissive) || !in.Pod(has_vertex_colors))
+					return false;
+
+				std::vector<MeshLod> lods;
+				uint32_t             lod_count = 0;
+				if (!in.Pod(lod_count) || !in.Fits(lod_count, 12))
+					return false;
+				lods.resize(lod_count);
+				for (auto& lod : lods) {
+					if (!in.Pod(lod.error) || !in.Array(lod.indices))
+						return false;
+				}
+
+				// Constructed in place (capacity is reserved): Mesh copies would duplicate the arrays
+				Mesh& mesh = data.meshes.emplace_back(
+					std::move(vertices),
+					std::move(indices),
+					std::move(textures),
+					std::move(shadow_indices),
+					std::move(lods),
+					vertex_format
+				);
+				mesh.diffuseColor = diffuse;
+				mesh.opacity = opacity;
+				mesh.roughness = roughness;
+				mesh.metallic = metallic;
+				mesh.ao = ao;
+				mesh.emissiveColor = emissive;
+				mesh.has_vertex_colors = has_vertex_colors != 0;
+			}
+
+			uint32_t meshlet_count = 0;
+			if (!in.Pod(meshlet_count) || (meshlet_count != 0 && meshlet_count != mesh_count))
+				return false;
+			data.meshlets.resize(meshlet_count);
+			for (auto& meshlets : data.meshlets) {
+				if (!in.Array(meshlets.meshlets) || !in.Array(meshlets.vertices) || !in.Array(meshlets.triangles))
+					return false;
+			}
+
+			uint32_t bone_count = 0;
+			if (!in.Pod(bone_count) || !in.Fits(bone_count, 4 + sizeof(BoneInfo)))
+				return false;
+			for (uint32_t b = 0; b < bone_count; ++b) {
+				std::string name;
+				BoneInfo    info;
+				if (!in.String(name) || !in.Pod(info))
+					return false;
+				data.bone_info_map.emplace(std::move(name), info);
+			}
+
+			if (!ReadNode(in, data.root_node, 0))
+				return false;
+
+			uint32_t animation_count = 0;
+			if (!in.Pod(animation_count) || !in.Fits(animation_count, 16))
+				return false;
+			data.animations.resize(animation_count);
+			for (auto& animation : data.animations) {
+				uint32_t channel_count = 0;
+				if (!in.String(animation.name) || !in.Pod(animation.duration) || !in.Pod(animation.ticksPerSecond) ||
+				    !in.Pod(channel_count) || !in.Fits(channel_count, 28))
+					return false;
+				animation.boneAnimations.resize(channel_count);
+				for (auto& channel : animation.boneAnimations) {
+					if (!in.String(channel.name) || !in.Array(channel.positions) || !in.Array(channel.rotations) ||
+					    !in.Array(channel.scales))
+						return false;
+					channel.numPositions = static_cast<int>(channel.positions.size());
+					channel.numRotations = static_cast<int>(channel.rotations.size());
+					channel.numScalings = static_cast<int>(channel.scales.size());
+					channel.localTransform = glm::mat4(1.0f);
+					channel.id = 0;
+				}
+			}
+			return true;
+		}
+	} // namespace
+
+	std::string ModelCache::CachePathFor(const std::string& source_path) {
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.bmdl", static_cast<unsigned long long>(Fnv1a(source_path)));
+		return std::string("model_cache/") + name;
+	}
+
+	bool ModelCache::Write(
+		const ModelData&                    data,
+		const std::vector<EmbeddedTexture>& embedded_textures,
+		const std::string&                  source_path,
+		uint64_t                            options_hash,
+		const std::string&                  cache_path
+	) {
+		BlobWriter out;
+		out.Pod(MakeHeader(StampOf(source_path), options_hash));
+
+		out.Pod(data.aabb.min);
+		out.Pod(data.aabb.max);
+		out.Pod(data.global_inverse_transform);
+		out.Pod(data.bone_count);
+
+		out.Pod(static_cast<uint32_t>(embedded_textures.size()));
+		for (const auto& texture : embedded_textures) {
+			out.String(texture.key);
+			out.Pod(texture.width);
+			out.Pod(texture.height);
+			out.Array(texture.bytes);
+		}
+
+		out.Pod(static_cast<uint32_t>(data.meshes.size()));
+		for (const auto& mesh : data.meshes) {
+			out.Array(mesh.vertices);
+			out.Array(mesh.indices);
+			out.Array(mesh.shadow_indices);
+
+			out.Pod(static_cast<uint32_t>(mesh.textures.size()));
+			for (const auto& texture : mesh.textures) {
+				int32_t embedded_index = -1;
+				for (size_t i = 0; i < embedded_textures.size(); ++i) {
+					if (embedded_textures[i].key == texture.path) {
+						embedded_index = static_cast<int32_t>(i);
+						break;
+					}
+				}
+				out.String(texture.type);
+				out.String(texture.path);
+				out.Pod(embedded_index);
+			}
+
+			out.Pod(mesh.diffuseColor);
+			out.Pod(mesh.opacity);
+			out.Pod(mesh.roughness);
+			out.Pod(mesh.metallic);
+			out.Pod(mesh.ao);
+			out.Pod(mesh.emissiveColor);
+			out.Pod(static_cast<uint8_t>(mesh.has_vertex_colors));
+
+			out.Pod(static_cast<uint32_t>(mesh.lods.size()));
+			for (const auto& lod : mesh.lods) {
+				out.Pod(lod.error);
+				out.Array(lod.indices);
+			}
+		}
+
+		// Empty when the model has no meshlets, otherwise one set per mesh
+		out.Pod(static_cast<uint32_t>(data.meshlets.size()));
+		for (const auto& meshlets : data.meshlets) {
+			out.Array(meshlets.meshlets);
+			out.Array(meshlets.vertices);
+			out.Array(meshlets.triangles);
+		}
+
+		out.Pod(static_cast<uint32_t>(data.bone_info_map.size()));
+		for (const auto& [name, info] : data.bone_info_map) {
+			out.String(name);
+			out.Pod(info);
+		}
+
+		WriteNode(out, data.root_node);
+
+		out.Pod(static_cast<uint32_t>(data.animations.size()));
+		for (const auto& animation : data.animations) {
+			out.String(animation.name);
+			out.Pod(animation.duration);
+			out.Pod(animation.ticksPerSecond);
+			out.Pod(static_cast<uint32_t>(animation.boneAnimations.size()));
+			for (const auto& channel : animation.boneAnimations) {
+				out.String(channel.name);
+				out.Array(channel.positions);
+				out.Array(channel.rotations);
+				out.Array(channel.scales);
+			}
+		}
+
+		std::error_code       ec;
+		std::filesystem::path target(cache_path);
+		if (target.has_parent_path()) {
+			std::filesystem::create_directories(target.parent_path(), ec);
+		}
+
+		// Write next to the target and rename, so readers never map a partial file
+		std::string temp_path = cache_path + ".tmp";
+		{
+			std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+			if (!file) {
+				logger::WARNING("Failed to open model cache for writing: {}", temp_path);
+				return false;
+			}
+			file.write(out.buffer().data(), static_cast<std::streamsize>(out.buffer().size()));
+			if (!file) {
+				logger::WARNING("Failed to write model cache: {}", temp_path);
+				std::filesystem::remove(temp_path, ec);
+				return false;
+			}
+		}
+		std::filesystem::rename(temp_path, cache_path, ec);
+		if (ec) {
+			logger::WARNING("Failed to move model cache into place: {} ({})", cache_path, ec.message());
+			std::filesystem::remove(temp_path, ec);
+			return false;
+		}
+		return true;
+	}
+
+	std::shared_ptr<ModelData> ModelCache::Read(
+		const std::string&     cache_path,
+		const std::string&     source_path,
+		uint64_t               options_hash,
+		const TextureResolver& resolve_texture,
+		VertexFormat           vertex_format
+	) {
+		MappedFile file(cache_path);
+		if (!file.data())
+			return nullptr;
+
+		BlobReader in(file.data(), file.size());
+		Header     header{};
+		Header     expected = MakeHeader(StampOf(source_path), options_hash);
+		if (!in.Pod(header) || std::memcmp(&header, &expected, sizeof(Header)) != 0) {
+			logger::LOG("Model cache is stale, re-importing: {}", source_path);
+			return nullptr;
+		}
+
+		auto data = std::make_shared<ModelData>();
+		if (!ReadBody(in, *data, resolve_texture, vertex_format)) {
+			logger::WARNING("Corrupted model cache file, deleting: {}", cache_path);
+			std::error_code ec;
+			std::filesystem::remove(cache_path, ec);
+			return nullptr;
+		}
+		return data;
+	}
+
+} // namespace Boidsish
@@ -1,6 +1,8 @@
 #include "path.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <numbers>
 #include <vector>
 
@@ -218,144 +220,371 @@ namespace Boidsish {
 		return model;
 	}
 
-	PathUpdateResult Path::CalculateUpdate(
-		const Vector3&   current_position,
-		const glm::quat& current_orientation,
-		int              current_segment_index,
-		float            current_t,
-		int              current_direction,
-		float            path_speed,
-		float            delta_time
-	) const {
-		if (waypoints_.size() < 2) {
-			return {Vector3(0, 0, 0), Vector3(0, 0, 0), glm::quat(), 1, 0, 0.0f};
+	namespace {
+		constexpr int kLeafSegments = 4;
+		constexpr int kCoarseSamples = 8;
+		constexpr int kNewtonIterations = 8;
+
+		float DistanceSquared(const AABB& bounds, const glm::vec3& point) {
+			glm::vec3 outside = glm::max(glm::max(bounds.min - point, point - bounds.max), glm::vec3(0.0f));
+			return glm::dot(outside, outside);
 		}
 
-		int   num_waypoints = waypoints_.size();
-		int   num_segments = (mode_ == PathMode::LOOP) ? num_waypoints : num_waypoints - 1;
-		float arrival_radius_sq = 0.05f * 0.05f;
-		float distance_to_travel = path_speed * delta_time;
+		// Roots in (0, 1) of a + b t + c t^2, returns how many were written
+		int UnitRoots(float a, float b, float c, float roots[2]) {
+			int count = 0;
+			auto keep = [&](float t) {
+				if (t > 0.0f && t < 1.0f)
+					roots[count++] = t;
+			};
+			if (std::abs(c) < 1e-8f) {
+				if (std::abs(b) > 1e-8f)
+					keep(-a / b);
+				return count;
+			}
+			float discriminant = b * b - 4.0f * a * c;
+			if (discriminant < 0.0f)
+				return 0;
+			float root = std::sqrt(discriminant);
+			keep((-b - root) / (2.0f * c));
+			keep((-b + root) / (2.0f * c));
+			return count;
+		}
+	} // namespace
 
-		int   new_segment_index = current_segment_index;
-		float new_t = current_t;
-		int   new_direction = current_direction;
+	void Path::RebuildSegments() const {
+		segments_dirty_ = false;
+		segments_.clear();
+		segment_nodes_.clear();
+		arc_table_.clear();
+		length_ = 0.0f;
+
+		int n = static_cast<int>(waypoints_.size());
+		if (n < 2)
+			return;
 
-		// Iteratively move along the path until the frame's travel distance is used up
-		while (distance_to_travel > 1e-6) {
-			Vector3 p0, p1, p2, p3;
+		int num_segments = (mode_ == PathMode::LOOP) ? n : n - 1;
+		segments_.reserve(num_segments);
+		arc_table_.reserve(num_segments * (kArcSamples + 1));
+		for (int i = 0; i < num_segments; ++i) {
+			glm::vec3 p0, p1, p2, p3;
 			if (mode_ == PathMode::LOOP) {
-				p0 = waypoints_[(new_segment_index - 1 + num_waypoints) % num_waypoints].position;
-				p1 = waypoints_[new_segment_index].position;
-				p2 = waypoints_[(new_segment_index + 1) % num_waypoints].position;
-				p3 = waypoints_[(new_segment_index + 2) % num_waypoints].position;
+				p0 = waypoints_[(i - 1 + n) % n].position;
+				p1 = waypoints_[i].position;
+				p2 = waypoints_[(i + 1) % n].position;
+				p3 = waypoints_[(i + 2) % n].position;
 			} else {
-				p1 = waypoints_[new_segment_index].position;
-				p2 = waypoints_[new_segment_index + 1].position;
-				if (new_segment_index > 0) {
-					p0 = waypoints_[new_segment_index - 1].position;
-				} else {
-					p0 = p1 - (p2 - p1);
+				p1 = waypoints_[i].position;
+				p2 = waypoints_[i + 1].position;
+				p0 = (i > 0) ? glm::vec3(waypoints_[i - 1].position) : (p1 - (p2 - p1));
+				p3 = (i < n - 2) ? glm::vec3(waypoints_[i + 2].position) : (p2 + (p2 - p1));
+			}
+
+			// Same polynomial as Spline::CatmullRom, expanded once
+			Segment segment;
+			segment.a = p1;
+			segment.b = 0.5f * (p2 - p0);
+			segment.c = 0.5f * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3);
+			segment.d = 0.5f * (-p0 + 3.0f * p1 - 3.0f * p2 + p3);
+
+			// Exact bounds: the endpoints plus any interior extrema, where a derivative component vanishes
+			segment.bounds = AABB(glm::min(p1, p2), glm::max(p1, p2));
+			for (int axis = 0; axis < 3; ++axis) {
+				float roots[2];
+				int   count = UnitRoots(segment.b[axis], 2.0f * segment.c[axis], 3.0f * segment.d[axis], roots);
+				for (int r = 0; r < count; ++r) {
+					float value = segment.Evaluate(roots[r])[axis];
+					segment.bounds.min[axis] = std::min(segment.bounds.min[axis], value);
+					segment.bounds.max[axis] = std::max(segment.bounds.max[axis], value);
 				}
-				if (new_segment_index < num_segments - 1) {
-					p3 = waypoints_[new_segment_index + 2].position;
-				} else {
-					p3 = p2 + (p2 - p1);
+			}
+
+			// Arc length table, each step integrated with five-point Gauss-Legendre quadrature of the speed
+			constexpr float kNodes[5] = {0.0469101f, 0.2307653f, 0.5f, 0.7692347f, 0.9530899f};
+			constexpr float kWeights[5] = {0.1184634f, 0.2393143f, 0.2844444f, 0.2393143f, 0.1184634f};
+			float           arc_length = 0.0f;
+			arc_table_.push_back({0.0f, segment.Speed(0.0f)});
+			for (int step = 0; step < kArcSamples; ++step) {
+				for (int k = 0; k < 5; ++k) {
+					arc_length += kWeights[k] * segment.Speed((step + kNodes[k]) / kArcSamples) / kArcSamples;
 				}
+				arc_table_.push_back({arc_length, segment.Speed(static_cast<float>(step + 1) / kArcSamples)});
 			}
+			segment.arc_start = length_;
+			segment.arc_length = arc_length;
+			length_ += arc_length;
+			segments_.push_back(segment);
+		}
+
+		segment_nodes_.reserve(2 * num_segments);
+		segment_nodes_.push_back({});
+		BuildSegmentNode(0, 0, num_segments);
+	}
+
+	void Path::BuildSegmentNode(int node, int begin, int end) const {
+		AABB bounds = segments_[begin].bounds;
+		for (int i = begin + 1; i < end; ++i) {
+			bounds.min = glm::min(bounds.min, segments_[i].bounds.min);
+			bounds.max = glm::max(bounds.max, segments_[i].bounds.max);
+		}
+		segment_nodes_[node].bounds = bounds;
+
+		if (end - begin <= kLeafSegments) {
+			segment_nodes_[node].first = begin;
+			segment_nodes_[node].count = end - begin;
+			return;
+		}
 
-			// Estimate segment length
-			float   segment_length = 0;
-			Vector3 prev_point = Spline::CatmullRom(0, p0, p1, p2, p3);
-			for (int i = 1; i <= 10; ++i) {
-				float   t = (float)i / 10.0f;
-				Vector3 curr_point = Spline::CatmullRom(t, p0, p1, p2, p3);
-				segment_length += (curr_point - prev_point).Magnitude();
-				prev_point = curr_point;
+		// Consecutive segments are neighbours in space, so halving the index range groups them well
+		int children = static_cast<int>(segment_nodes_.size());
+		segment_nodes_[node].first = children;
+		segment_nodes_[node].count = 0;
+		segment_nodes_.resize(segment_nodes_.size() + 2);
+		int mid = (begin + end) / 2;
+		BuildSegmentNode(children, begin, mid);
+		BuildSegmentNode(children + 1, mid, end);
+	}
+
+	float Path::ClosestOnSegment(const Segment& segment, const glm::vec3& point, glm::vec3& closest) {
+		float best_t = 0.0f;
+		float best = std::numeric_limits<float>::max();
+		for (int j = 0; j <= kCoarseSamples; ++j) {
+			float     t = static_cast<float>(j) / kCoarseSamples;
+			glm::vec3 offset = segment.Evaluate(t) - point;
+			float     dist_sq = glm::dot(offset, offset);
+			if (dist_sq < best) {
+				best = dist_sq;
+				best_t = t;
+			}
+		}
+
+		// Safeguarded Newton's method on f(t) = |C(t) - p|^2 / 2, where f' = C'.(C - p) and
+		// f'' = C''.(C - p) + C'.C'. The minimum lies within one sample spacing of the best sample;
+		// steps that would leave that bracket, or where f is not convex, bisect it instead.
+		float spacing = 1.0f / kCoarseSamples;
+		float lo = std::max(0.0f, best_t - spacing);
+		float hi = std::min(1.0f, best_t + spacing);
+		float t = best_t;
+		for (int iteration = 0; iteration < kNewtonIterations; ++iteration) {
+			glm::vec3 offset = segment.Evaluate(t) - point;
+			glm::vec3 velocity = segment.Derivative(t);
+			glm::vec3 acceleration = 2.0f * segment.c + 6.0f * t * segment.d;
+			float     slope = glm::dot(velocity, offset);
+			float     curvature = glm::dot(acceleration, offset) + glm::dot(velocity, velocity);
+			if (slope > 0.0f) {
+				hi = t;
+			} else {
+				lo = t;
 			}
-			if (segment_length < 1e-6) {
+			float next = 0.5f * (lo + hi);
+			if (curvature > 1e-8f) {
+				float newton = t - slope / curvature;
+				if (newton > lo && newton < hi)
+					next = newton;
+			}
+			bool converged = std::abs(next - t) < 1e-5f;
+			t = next;
+			if (converged)
 				break;
+		}
+
+		glm::vec3 refined = segment.Evaluate(t);
+		glm::vec3 offset = refined - point;
+		float     dist_sq = glm::dot(offset, offset);
+		if (dist_sq < best) {
+			best = dist_sq;
+			best_t = t;
+		}
+		closest = segment.Evaluate(best_t);
+		return best;
+	}
+
+	glm::vec3 Path::FindClosestPoint(const Vector3& point, int* segment_hint) const {
+		if (waypoints_.empty()) {
+			return glm::vec3(0.0f);
+		}
+
+		if (waypoints_.size() == 1) {
+			return glm::vec3(waypoints_[0].position.x, waypoints_[0].position.y, waypoints_[0].position.z);
+		}
+
+		if (segments_dirty_) {
+			RebuildSegments();
+		}
+
+		glm::vec3 target(point.x, point.y, point.z);
+		int       count = static_cast<int>(segments_.size());
+		float     min_dist_sq = std::numeric_limits<float>::max();
+		glm::vec3 closest_point(0.0f);
+		int       closest_segment = -1;
+		auto      visit = [&](int i) {
+			glm::vec3 candidate;
+			float     dist_sq = ClosestOnSegment(segments_[i], target, candidate);
+			if (dist_sq < min_dist_sq) {
+				min_dist_sq = dist_sq;
+				closest_point = candidate;
+				closest_segment = i;
 			}
+		};
 
-			float distance_remaining_on_segment = (new_direction > 0) ? (1.0f - new_t) * segment_length
-																	  : new_t * segment_length;
+		// Warm start from the previous segment and its neighbours. The distance found there usually
+		// prunes everything else in the tree.
+		int warm[3] = {-1, -1, -1};
+		int hint = segment_hint ? *segment_hint : -1;
+		if (hint >= 0 && hint < count) {
+			bool loop = mode_ == PathMode::LOOP;
+			warm[0] = hint;
+			warm[1] = (hint > 0 || loop) ? (hint - 1 + count) % count : -1;
+			warm[2] = (hint < count - 1 || loop) ? (hint + 1) % count : -1;
+			for (int i : warm) {
+				if (i >= 0)
+					visit(i);
+			}
+		}
 
-			if (distance_to_travel <= distance_remaining_on_segment) {
-				float t_advance = distance_to_travel / segment_length;
-				new_t += t_advance * new_direction;
-				distance_to_travel = 0.0f;
-			} else {
-				distance_to_travel -= distance_remaining_on_segment;
-				new_segment_index += new_direction;
-
-				if (new_segment_index >= num_segments) {
-					if (mode_ == PathMode::LOOP) {
-						new_segment_index = 0;
-					} else if (mode_ == PathMode::REVERSE) {
-						new_direction = -1;
-						new_segment_index = num_segments - 1;
-						new_t = 1.0f;
-					} else { // ONCE
-						new_segment_index = num_segments - 1;
-						new_t = 1.0f;
-						distance_to_travel = 0;
-					}
-				} else if (new_segment_index < 0) {
-					if (mode_ == PathMode::LOOP) {
-						new_segment_index = num_segments - 1;
-					} else if (mode_ == PathMode::REVERSE) {
-						new_direction = 1;
-						new_segment_index = 0;
-						new_t = 0.0f;
-					} else { // ONCE
-						new_segment_index = 0;
-						new_t = 0.0f;
-						distance_to_travel = 0;
-					}
+		int stack[64];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0) {
+			const SegmentNode& node = segment_nodes_[stack[--top]];
+			if (DistanceSquared(node.bounds, target) >= min_dist_sq)
+				continue;
+
+			if (node.count > 0) {
+				for (int i = node.first; i < node.first + node.count; ++i) {
+					if (i == warm[0] || i == warm[1] || i == warm[2])
+						continue;
+					if (DistanceSquared(segments_[i].bounds, target) < min_dist_sq)
+						visit(i);
 				}
-				new_t = (new_direction > 0) ? 0.0f : 1.0f;
+				continue;
 			}
+
+			// Visit the nearer child first so its result prunes the other
+			int near_child = node.first, far_child = node.first + 1;
+			if (DistanceSquared(segment_nodes_[far_child].bounds, target) <
+			    DistanceSquared(segment_nodes_[near_child].bounds, target)) {
+				std::swap(near_child, far_child);
+			}
+			stack[top++] = far_child;
+			stack[top++] = near_child;
+		}
+
+		if (segment_hint) {
+			*segment_hint = closest_segment;
 		}
+		return closest_point;
+	}
 
-		Vector3         p0, p1, p2, p3;
-		const Waypoint *next_w1, *next_w2;
+	float Path::GetLength() const {
+		if (segments_dirty_) {
+			RebuildSegments();
+		}
+		return length_;
+	}
 
-		if (mode_ == PathMode::LOOP) {
-			p0 = waypoints_[(new_segment_index - 1 + num_waypoints) % num_waypoints].position;
-			p1 = waypoints_[new_segment_index].position;
-			p2 = waypoints_[(new_segment_index + 1) % num_waypoints].position;
-			p3 = waypoints_[(new_segment_index + 2) % num_waypoints].position;
-			next_w1 = &waypoints_[new_segment_index];
-			next_w2 = &waypoints_[(new_segment_index + 1) % num_waypoints];
-		} else {
-			p1 = waypoints_[new_segment_index].position;
-			p2 = waypoints_[new_segment_index + 1].position;
-			if (new_segment_index > 0) {
-				p0 = waypoints_[new_segment_index - 1].position;
-			} else {
-				p0 = p1 - (p2 - p1);
+	float Path::SegmentParameter(int segment, float distance) const {
+		const ArcSample* table = &arc_table_[segment * (kArcSamples + 1)];
+		const ArcSample* after = std::upper_bound(
+			table + 1,
+			table + kArcSamples,
+			distance,
+			[](float d, const ArcSample& sample) { return d < sample.distance; }
+		);
+		int              step = static_cast<int>(after - table) - 1;
+		const ArcSample& lo = table[step];
+		const ArcSample& hi = table[step + 1];
+		float            span = hi.distance - lo.distance;
+		float            start = static_cast<float>(step) / kArcSamples;
+		if (span < 1e-9f) {
+			return start;
+		}
+
+		// Cubic Hermite interpolation of t(s), whose slope dt/ds is 1 / speed at each sample. Slopes are
+		// capped at 3 in the unit step, which keeps the interpolant monotonic near cusps.
+		float u = std::clamp((distance - lo.distance) / span, 0.0f, 1.0f);
+		float m0 = std::min(span * kArcSamples / std::max(lo.speed, 1e-6f), 3.0f);
+		float m1 = std::min(span * kArcSamples / std::max(hi.speed, 1e-6f), 3.0f);
+		float u2 = u * u, u3 = u2 * u;
+		float h = (u3 - 2.0f * u2 + u) * m0 + (3.0f * u2 - 2.0f * u3) + (u3 - u2) * m1;
+		return start + h / kArcSamples;
+	}
+
+	PathUpdateResult Path::Advance(const PathFollower& follower, float delta_time) const {
+		int   num_waypoints = waypoints_.size();
+		int   num_segments = segments_.size();
+		float arrival_radius_sq = 0.05f * 0.05f;
+		float distance_to_travel = follower.speed * delta_time;
+
+		int new_segment_index = std::clamp(follower.segment_index, 0, num_segments - 1);
+		int new_direction = follower.direction;
+
+		// Whole laps around a loop end where they started
+		if (mode_ == PathMode::LOOP && length_ > 1e-6f && distance_to_travel > length_) {
+			distance_to_travel = std::fmod(distance_to_travel, length_);
+		}
+
+		// The follower's t is the fraction of its segment's arc length already covered
+		float distance = std::clamp(follower.t, 0.0f, 1.0f) * segments_[new_segment_index].arc_length;
+		while (distance_to_travel > 1e-6f) {
+			float segment_length = segments_[new_segment_index].arc_length;
+			if (segment_length < 1e-6f) {
+				break;
 			}
-			if (new_segment_index < num_segments - 1) {
-				p3 = waypoints_[new_segment_index + 2].position;
-			} else {
-				p3 = p2 + (p2 - p1);
+
+			float distance_remaining_on_segment = (new_direction > 0) ? segment_length - distance : distance;
+			if (distance_to_travel <= distance_remaining_on_segment) {
+				distance += distance_to_travel * new_direction;
+				break;
+			}
+
+			distance_to_travel -= distance_remaining_on_segment;
+			new_segment_index += new_direction;
+			if (new_segment_index >= num_segments) {
+				if (mode_ == PathMode::LOOP) {
+					new_segment_index = 0;
+				} else if (mode_ == PathMode::REVERSE) {
+					new_direction = -1;
+					new_segment_index = num_segments - 1;
+				} else { // ONCE
+					new_segment_index = num_segments - 1;
+					distance = segments_[new_segment_index].arc_length;
+					break;
+				}
+			} else if (new_segment_index < 0) {
+				if (mode_ == PathMode::LOOP) {
+					new_segment_index = num_segments - 1;
+				} else if (mode_ == PathMode::REVERSE) {
+					new_direction = 1;
+					new_segment_index = 0;
+				} else { // ONCE
+					new_segment_index = 0;
+					distance = 0.0f;
+					break;
+				}
 			}
-			next_w1 = &waypoints_[new_segment_index];
-			next_w2 = &waypoints_[new_segment_index + 1];
+			distance = (new_direction > 0) ? 0.0f : segments_[new_segment_index].arc_length;
 		}
 
-		Vector3 target_position = Spline::CatmullRom(new_t, p0, p1, p2, p3);
-		Vector3 desired_velocity = (target_position - current_position).Normalized();
+		const Segment&  segment = segments_[new_segment_index];
+		const Waypoint& w1 = waypoints_[new_segment_index];
+		const Waypoint& w2 = waypoints_[(new_segment_index + 1) % num_waypoints];
+		float           new_t = segment.arc_length > 1e-6f ? std::min(distance / segment.arc_length, 1.0f) : 0.0f;
+		float           spline_t = SegmentParameter(new_segment_index, distance);
+
+		Vector3 target_position = segment.Evaluate(spline_t);
+		Vector3 desired_velocity = (target_position - follower.position).Normalized();
 
 		if (mode_ == PathMode::ONCE && new_segment_index == num_segments - 1 && new_t >= 1.0f) {
-			if ((waypoints_.back().position - current_position).MagnitudeSquared() < arrival_radius_sq) {
+			if ((waypoints_.back().position - follower.position).MagnitudeSquared() < arrival_radius_sq) {
 				desired_velocity.Set(0, 0, 0);
 			} else {
-				desired_velocity = (waypoints_.back().position - current_position).Normalized();
+				desired_velocity = (waypoints_.back().position - follower.position).Normalized();
 			}
 		}
 
-		Vector3 tangent = Spline::CatmullRomDerivative(new_t, p0, p1, p2, p3).Normalized() * (float)new_direction;
-		Vector3 up = next_w1->up * (1.0f - new_t) + next_w2->up * new_t;
+		Vector3 tangent = Vector3(segment.Derivative(spline_t)).Normalized() * (float)new_direction;
+		Vector3 up = w1.up * (1.0f - spline_t) + w2.up * spline_t;
 		Vector3 right = tangent.Cross(up);
 		if (right.MagnitudeSquared() < 1e-6) {
 			right = tangent.Cross(Vector3(0, 1, 0)).Normalized();
@@ -366,12 +595,8 @@ namespace Boidsish {
 		right.Normalize();
 		up = right.Cross(tangent).Normalized();
 
-		glm::mat4 rotationMatrix = glm::lookAt(
-			glm::vec3(0, 0, 0),
-			glm::vec3(tangent.x, tangent.y, tangent.z),
-			glm::vec3(up.x, up.y, up.z)
-		);
-		glm::quat desired_orientation = glm::conjugate(glm::quat_cast(rotationMatrix));
+		// The inverse of the lookAt rotation along the tangent, built from its basis directly
+		glm::quat desired_orientation = glm::quat_cast(glm::mat3(right, up, -tangent));
 
 		return {
 			target_position,
@@ -383,46 +608,40 @@ namespace Boidsish {
 		};
 	}
 
-	glm::vec3 Path::FindClosestPoint(const Vector3& point) const {
-		if (waypoints_.empty()) {
-			return glm::vec3(0.0f);
+	PathUpdateResult Path::CalculateUpdate(
+		const Vector3&   current_position,
+		const glm::quat& /* current_orientation */,
+		int              current_segment_index,
+		float            current_t,
+		int              current_direction,
+		float            path_speed,
+		float            delta_time
+	) const {
+		if (waypoints_.size() < 2) {
+			return {Vector3(0, 0, 0), Vector3(0, 0, 0), glm::quat(), 1, 0, 0.0f};
 		}
-
-		if (waypoints_.size() == 1) {
-			return glm::vec3(waypoints_[0].position.x, waypoints_[0].position.y, waypoints_[0].position.z);
+		if (segments_dirty_) {
+			RebuildSegments();
 		}
+		return Advance({current_position, current_segment_index, current_t, current_direction, path_speed}, delta_time);
+	}
 
-		float     min_dist_sq = std::numeric_limits<float>::max();
-		glm::vec3 closest_point;
-
-		int num_segments = (mode_ == PathMode::LOOP) ? waypoints_.size() : waypoints_.size() - 1;
-
-		for (int i = 0; i < num_segments; ++i) {
-			Vector3 p0, p1, p2, p3;
-			if (mode_ == PathMode::LOOP) {
-				p0 = waypoints_[(i - 1 + waypoints_.size()) % waypoints_.size()].position;
-				p1 = waypoints_[i].position;
-				p2 = waypoints_[(i + 1) % waypoints_.size()].position;
-				p3 = waypoints_[(i + 2) % waypoints_.size()].position;
-			} else {
-				p1 = waypoints_[i].position;
-				p2 = waypoints_[i + 1].position;
-				p0 = (i > 0) ? waypoints_[i - 1].position : (p1 - (p2 - p1));
-				p3 = (i < (int)waypoints_.size() - 2) ? waypoints_[i + 2].position : (p2 + (p2 - p1));
-			}
-
-			// Iterate along the segment to find the closest point
-			for (int j = 0; j <= 20; ++j) {
-				float   t = (float)j / 20.0f;
-				Vector3 spline_point = Spline::CatmullRom(t, p0, p1, p2, p3);
-				float   dist_sq = (spline_point - point).MagnitudeSquared();
-				if (dist_sq < min_dist_sq) {
-					min_dist_sq = dist_sq;
-					closest_point = glm::vec3(spline_point.x, spline_point.y, spline_point.z);
-				}
-			}
+	void Path::CalculateUpdates(
+		std::span<const PathFollower> followers,
+		float                         delta_time,
+		std::span<PathUpdateResult>   out
+	) const {
+		if (waypoints_.size() < 2) {
+			PathUpdateResult idle{Vector3(0, 0, 0), Vector3(0, 0, 0), glm::quat(), 1, 0, 0.0f};
+			std::fill_n(out.begin(), followers.size(), idle);
+			return;
+		}
+		if (segments_dirty_) {
+			RebuildSegments();
+		}
+		for (size_t i = 0; i < followers.size(); ++i) {
+			out[i] = Advance(followers[i], delta_time);
 		}
-		return closest_point;
 	}
 
 } // namespace Boidsish
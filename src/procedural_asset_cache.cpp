@@ -0,0 +1,104 @@
+#include "procedural_asset_cache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <type_traits>
+
+#include "ConfigManager.h"
+#include "mesh_optimizer_util.h"
+#include "model.h"
+#include "model_cache.h"
+
+namespace Boidsish {
+
+	namespace {
+		void HashBytes(uint64_t& hash, const void* data, size_t size) {
+			const auto* bytes = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; ++i) {
+				hash ^= bytes[i];
+				hash *= 0x100000001b3ull;
+			}
+		}
+
+		template <typename T>
+		void HashValue(uint64_t& hash, const T& value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			HashBytes(hash, &value, sizeof(T));
+		}
+
+		// ModelCache stamps caches with their source file; procedural models have none, so this
+		// names a file that does not exist and every cache records the same (empty) stamp
+		std::string SourceKey(ProceduralType type, unsigned int seed) {
+			return "procedural:" + std::to_string(static_cast<int>(type)) + ":" + std::to_string(seed);
+		}
+	} // namespace
+
+	ProceduralAssetCache::ProceduralAssetCache(std::string directory): directory_(std::move(directory)) {}
+
+	uint64_t ProceduralAssetCache::ConfigHash(ProceduralType type, const GeneratorConfig& generator_config) {
+		uint64_t hash = 0xcbf29ce484222325ull;
+		HashValue(hash, kGeneratorVersion);
+		HashValue(hash, type);
+
+		// Everything CreateModelDataFromGeometry and ProceduralMesher read must be part of this hash
+		auto& config = ConfigManager::GetInstance();
+		HashValue(hash, config.GetAppSettingBool("mesh_simplifier_enabled", false));
+		HashValue(hash, config.GetAppSettingFloat("mesh_simplifier_error_procedural", 0.05f));
+		HashValue(hash, config.GetAppSettingFloat("mesh_simplifier_target_ratio", 0.5f));
+		HashValue(hash, config.GetAppSettingInt("mesh_simplifier_aggression_procedural", 40));
+		HashValue(hash, config.GetAppSettingBool("mesh_optimizer_enabled", true));
+		HashValue(hash, config.GetAppSettingBool("mesh_optimizer_shadow_indices_enabled", true));
+		HashValue(hash, config.GetAppSettingBool("mesh_lod_enabled", true));
+		HashValue(hash, config.GetAppSettingInt("mesh_lod_count", 3));
+
+		// The growth settings of the types Generate() passes them to
+		if (type == ProceduralType::TreeSpring) {
+			HashValue(hash, generator_config.spring_plant);
+		} else if (type == ProceduralType::TreeSpaceColonization) {
+			HashValue(hash, generator_config.space_colonization);
+		}
+		return hash;
+	}
+
+	std::string ProceduralAssetCache::PathFor(ProceduralType type, unsigned int seed, uint64_t config_hash) const {
+		char name[64];
+		std::snprintf(
+			name,
+			sizeof(name),
+			"%d_%u_%016llx.bmdl",
+			static_cast<int>(type),
+			seed,
+			static_cast<unsigned long long>(config_hash)
+		);
+		return (std::filesystem::path(directory_) / name).string();
+	}
+
+	std::shared_ptr<ModelData>
+	ProceduralAssetCache::Load(ProceduralType type, unsigned int seed, uint64_t config_hash) const {
+		// Procedural meshes have no textures
+		auto data = ModelCache::Read(
+			PathFor(type, seed, config_hash),
+			SourceKey(type, seed),
+			config_hash,
+			[](const ModelCache::TextureSource&, unsigned int&) { return false; },
+			MeshOptimizerUtil::ConfiguredVertexFormat()
+		);
+		if (data) {
+			data->model_path = "procedural_cached_" + std::to_string(reinterpret_cast<uintptr_t>(data.get()));
+			if (data->meshlets.empty() && ConfigManager::GetInstance().GetAppSettingBool("meshlets_enabled", false)) {
+				data->BuildMeshlets();
+			}
+		}
+		return data;
+	}
+
+	bool ProceduralAssetCache::Store(
+		const ModelData& data,
+		ProceduralType   type,
+		unsigned int     seed,
+		uint64_t         config_hash
+	) const {
+		return ModelCache::Write(data, {}, SourceKey(type, seed), config_hash, PathFor(type, seed, config_hash));
+	}
+
+} // namespace Boidsish
@@ -1,4 +1,5 @@
 #include "procedural_audio.h"
+#include <algorithm>
 #include <cstring>
 
 namespace Boidsish {
@@ -35,7 +36,11 @@ namespace Boidsish {
 	};
 
 	ProceduralAudioSource::ProceduralAudioSource(ma_uint32 channels, ma_uint32 sampleRate)
-		: m_channels(channels), m_sampleRate(sampleRate) {
+		: m_channels(channels), m_sampleRate(sampleRate),
+		  m_planarBuffer(static_cast<size_t>(dsp::kBlockFrames) * channels), m_planes(channels) {
+		for (ma_uint32 c = 0; c < channels; ++c) {
+			m_planes[c] = m_planarBuffer.data() + static_cast<size_t>(c) * dsp::kBlockFrames;
+		}
 		m_base.pParent = this;
 		ma_data_source_config config = ma_data_source_config_init();
 		config.vtable = &g_ProceduralAudioSourceVTable;
@@ -46,4 +51,14 @@ namespace Boidsish {
 		ma_data_source_uninit(&m_base.ds);
 	}
 
+	void ProceduralAudioSource::OnRead(float* pOutput, ma_uint64 frameCount) {
+		while (frameCount > 0) {
+			ma_uint32 frames = static_cast<ma_uint32>(std::min<ma_uint64>(frameCount, dsp::kBlockFrames));
+			ma_uint32 planes = std::min(OnRenderBlock(m_planes.data(), frames), m_channels);
+			dsp::Interleave(m_planes.data(), planes, pOutput, m_channels, frames);
+			pOutput += static_cast<size_t>(frames) * m_channels;
+			frameCount -= frames;
+		}
+	}
+
 } // namespace Boidsish
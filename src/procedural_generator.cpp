@@ -1,21 +1,29 @@
 #include "procedural_generator.h"
 
+#include <algorithm>
+#include <bit>
 #include <numbers>
+#include <numeric>
 #include <random>
 
 #include "ConfigManager.h"
 #include "graphics.h"
+#include "lsystem.h"
 #include "mesh_optimizer_util.h"
+#include "procedural_asset_cache.h"
 #include "procedural_mesher.h"
 #include "procedural_optimizer.h"
 #include "procedural_refiner.h"
+#include "spatial_hash_grid.h"
 #include "spline.h"
 #include "terrain_deformation_manager.h"
 #include "terrain_deformations.h"
 #include "terrain_generator_interface.h"
+#include "thread_pool.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/norm.hpp>
+#include <poolstl/poolstl.hpp>
 
 namespace Boidsish {
 
@@ -32,9 +40,15 @@ namespace Boidsish {
 
 		struct SCAttractor {
 			glm::vec3 pos;
-			bool      active = true;
 		};
 
+		// Space colonization associates attractors on the pool in blocks once there are this many
+		constexpr size_t kParallelAttractorThreshold = 2048;
+		constexpr size_t kAttractorBlockSize = 512;
+
+		// Ends of a spring plant push each other apart within this distance
+		constexpr float kSpringRepulsionRadius = 4.0f;
+
 		struct SpringNode {
 			int       id;
 			int       parentId;
@@ -50,37 +64,6 @@ namespace Boidsish {
 			bool      isEnd = true;
 		};
 
-		struct LSystem {
-			std::string                 axiom;
-			std::map<char, std::string> rules;
-
-			std::string expand(int iterations) {
-				std::string current = axiom;
-				for (int i = 0; i < iterations; ++i) {
-					std::string next;
-					for (char c : current) {
-						if (rules.count(c))
-							next += rules.at(c);
-						else
-							next += c;
-					}
-					current = next;
-				}
-				return current;
-			}
-		};
-
-		std::map<char, std::string> ParseRules(const std::vector<std::string>& ruleStrings) {
-			std::map<char, std::string> rules;
-			for (const auto& rule : ruleStrings) {
-				size_t pos = rule.find('=');
-				if (pos != std::string::npos && pos > 0) {
-					rules[rule[0]] = rule.substr(pos + 1);
-				}
-			}
-			return rules;
-		}
-
 		void AddPuffball(
 			std::vector<Vertex>&       vertices,
 			std::vector<unsigned int>& indices,
@@ -280,7 +263,8 @@ namespace Boidsish {
 		}
 	} // namespace
 
-	std::shared_ptr<Model> ProceduralGenerator::Generate(ProceduralType type, unsigned int seed) {
+	std::shared_ptr<Model>
+	ProceduralGenerator::Generate(ProceduralType type, unsigned int seed, const GeneratorConfig& config) {
 		ProceduralIR ir;
 
 		switch (type) {
@@ -296,10 +280,10 @@ namespace Boidsish {
 			ir = GenerateTreeIR(seed);
 			break;
 		case ProceduralType::TreeSpaceColonization:
-			ir = GenerateSpaceColonizationTreeIR(seed);
+			ir = GenerateSpaceColonizationTreeIR(seed, config.space_colonization);
 			break;
 		case ProceduralType::TreeSpring:
-			ir = GenerateSpringPlantIR(seed);
+			ir = GenerateSpringPlantIR(seed, config.spring_plant);
 			break;
 		case ProceduralType::Critter:
 			ir = GenerateCritterIR(seed);
@@ -316,6 +300,36 @@ namespace Boidsish {
 		return ProceduralMesher::GenerateModel(ir);
 	}
 
+	std::vector<std::shared_ptr<Model>> ProceduralGenerator::GenerateVariants(
+		ProceduralType                type,
+		std::span<const unsigned int> seeds,
+		const ProceduralAssetCache*   cache,
+		const GeneratorConfig&        config
+	) {
+		// Reads the mesh settings here first, so the workers only look up registered keys
+		const uint64_t config_hash = ProceduralAssetCache::ConfigHash(type, config);
+
+		std::vector<std::shared_ptr<Model>> models(seeds.size());
+		std::vector<size_t>                 variants(seeds.size());
+		std::iota(variants.begin(), variants.end(), 0);
+		std::for_each(poolstl::par.on(pool), variants.begin(), variants.end(), [&](size_t i) {
+			PoolTaskScope scope;
+			if (cache) {
+				if (auto data = cache->Load(type, seeds[i], config_hash)) {
+					models[i] = std::make_shared<Model>(data, false);
+					models[i]->SetAllowMegabuffer(false);
+					return;
+				}
+			}
+
+			models[i] = Generate(type, seeds[i], config);
+			if (cache && models[i] && models[i]->GetData()) {
+				cache->Store(*models[i]->GetData(), type, seeds[i], config_hash);
+			}
+		});
+		return models;
+	}
+
 	std::shared_ptr<Model> ProceduralGenerator::GenerateSpringPlant(unsigned int seed, const SpringPlantConfig& config) {
 		auto ir = GenerateSpringPlantIR(seed, config);
 		ProceduralOptimizer::Optimize(ir);
@@ -427,18 +441,18 @@ namespace Boidsish {
 		if (custom_axiom.empty()) {
 			int ruleset = seed % 2;
 			if (ruleset == 0) {
-				lsys.axiom = "F";
-				lsys.rules['F'] = "FF-[+F+F]";
+				lsys.SetAxiom("F");
+				lsys.SetRule('F', "FF-[+F+F]");
 			} else {
-				lsys.axiom = "F";
-				lsys.rules['F'] = "F[+F]F[-F]F";
+				lsys.SetAxiom("F");
+				lsys.SetRule('F', "F[+F]F[-F]F");
 			}
 		} else {
-			lsys.axiom = custom_axiom;
-			lsys.rules = ParseRules(custom_rules);
+			lsys.SetAxiom(custom_axiom);
+			lsys.SetRules(custom_rules);
 		}
 
-		std::string expanded = lsys.expand(iterations);
+		auto symbols = lsys.Symbols(iterations);
 
 		struct TurtleStateIR {
 			glm::vec3 position;
@@ -464,7 +478,7 @@ namespace Boidsish {
 		float                     angle = 0.5f;
 		float                     step = 0.4f;
 
-		for (char c : expanded) {
+		for (char c : symbols) {
 			if (c == 'F') {
 				glm::vec3 next_pos = current.position + current.orientation * glm::vec3(0, step, 0);
 				float     next_thickness = current.thickness * 0.85f;
@@ -544,14 +558,16 @@ namespace Boidsish {
 		return ProceduralMesher::GenerateModel(ir);
 	}
 
-	std::shared_ptr<Model> ProceduralGenerator::GenerateSpaceColonizationTree(unsigned int seed) {
-		auto ir = GenerateSpaceColonizationTreeIR(seed);
+	std::shared_ptr<Model>
+	ProceduralGenerator::GenerateSpaceColonizationTree(unsigned int seed, const SpaceColonizationConfig& config) {
+		auto ir = GenerateSpaceColonizationTreeIR(seed, config);
 		ProceduralOptimizer::Optimize(ir);
 		ProceduralRefiner::Refine(ir);
 		return ProceduralMesher::GenerateModel(ir);
 	}
 
-	ProceduralIR ProceduralGenerator::GenerateSpaceColonizationTreeIR(unsigned int seed) {
+	ProceduralIR
+	ProceduralGenerator::GenerateSpaceColonizationTreeIR(unsigned int seed, const SpaceColonizationConfig& config) {
 		std::mt19937 gen(seed);
 
 		// Parameters
@@ -585,6 +601,7 @@ namespace Boidsish {
 			killDistance = 0.7f;
 			influenceRadius = 2.0f;
 		}
+		numAttractors = std::max(1, static_cast<int>(std::lround(numAttractors * config.attractor_density)));
 
 		std::vector<SCAttractor> attractors;
 		std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
@@ -638,7 +655,7 @@ namespace Boidsish {
 				);
 				crownBase = glm::vec3(0, 6, 0);
 			}
-			attractors.push_back({pos, true});
+			attractors.push_back({pos});
 		}
 
 		// Add lure attractors to guide trunk to crown
@@ -649,21 +666,35 @@ namespace Boidsish {
 				float t = (float)i / (float)numLures;
 				glm::vec3 lurePos = glm::vec3(0, trunkTopY + t * (crownBase.y - trunkTopY), 0);
 				lurePos += glm::vec3(dis(gen) * 0.5f, 0, dis(gen) * 0.5f);
-				attractors.push_back({lurePos, true});
+				attractors.push_back({lurePos});
 			}
 		}
 
 		std::vector<SCNode> nodes;
+		SpatialHashGrid     node_grid(influenceRadius);
 		// Root nodes (trunk) to reach the crown
 		nodes.push_back({0, -1, {0, 0, 0}});
+		node_grid.Insert(0, nodes[0].pos);
 		for (int i = 1; i <= initialTrunkNodes; ++i) {
 			nodes.push_back({i, i - 1, {0, (float)i * growthStep, 0}});
 			nodes[i - 1].children.push_back(i);
+			node_grid.Insert(i, nodes[i].pos);
 		}
 
+		// Attractors still waiting to be reached, in their original order
+		std::vector<int> active(attractors.size());
+		std::iota(active.begin(), active.end(), 0);
+		std::vector<int> closest(attractors.size());
+
+		// Association runs in blocks on the pool once there are enough attractors to pay for it
+		struct AttractorBlock {
+			size_t begin, end;
+		};
+		std::vector<AttractorBlock> blocks;
+
 		bool growthOccurred = true;
 		int  iterations = 0;
-		while (growthOccurred && iterations < 200) {
+		while (growthOccurred && iterations < config.max_iterations) {
 			growthOccurred = false;
 			iterations++;
 
@@ -673,24 +704,27 @@ namespace Boidsish {
 				n.attractorCount = 0;
 			}
 
-			// Association
-			for (size_t i = 0; i < attractors.size(); ++i) {
-				if (!attractors[i].active)
-					continue;
-
-				int   closestNode = -1;
-				float minDistSq = influenceRadius * influenceRadius;
-
-				for (size_t n = 0; n < nodes.size(); ++n) {
-					float d2 = glm::distance2(attractors[i].pos, nodes[n].pos);
-					if (d2 < minDistSq) {
-						minDistSq = d2;
-						closestNode = (int)n;
-					}
+			// Association: each attractor pulls on its nearest node within the influence radius
+			auto associate = [&](const AttractorBlock& block) {
+				for (size_t a = block.begin; a < block.end; ++a) {
+					closest[a] = node_grid.FindNearest(attractors[active[a]].pos, influenceRadius);
+				}
+			};
+			if (active.size() >= kParallelAttractorThreshold && !InPoolTask()) {
+				blocks.clear();
+				for (size_t a = 0; a < active.size(); a += kAttractorBlockSize) {
+					blocks.push_back({a, std::min(a + kAttractorBlockSize, active.size())});
 				}
+				std::for_each(poolstl::par.on(pool), blocks.begin(), blocks.end(), associate);
+			} else {
+				associate({0, active.size()});
+			}
 
+			// Accumulate in attractor order so the result does not depend on the scheduling
+			for (size_t a = 0; a < active.size(); ++a) {
+				int closestNode = closest[a];
 				if (closestNode != -1) {
-					nodes[closestNode].growthDir += glm::normalize(attractors[i].pos - nodes[closestNode].pos);
+					nodes[closestNode].growthDir += glm::normalize(attractors[active[a]].pos - nodes[closestNode].pos);
 					nodes[closestNode].attractorCount++;
 				}
 			}
@@ -702,13 +736,7 @@ namespace Boidsish {
 					glm::vec3 nextPos = nodes[i].pos + glm::normalize(nodes[i].growthDir) * growthStep;
 
 					// Avoid duplicates/overlapping nodes too close
-					bool tooClose = false;
-					for (size_t n = 0; n < nodes.size(); ++n) {
-						if (glm::distance2(nextPos, nodes[n].pos) < (growthStep * growthStep * 0.25f)) {
-							tooClose = true;
-							break;
-						}
-					}
+					bool tooClose = node_grid.AnyWithin(nextPos, growthStep * 0.5f);
 
 					if (!tooClose) {
 						SCNode newNode;
@@ -717,22 +745,14 @@ namespace Boidsish {
 						newNode.pos = nextPos;
 						nodes[i].children.push_back(newNode.id);
 						nodes.push_back(newNode);
+						node_grid.Insert(newNode.id, nextPos);
 						growthOccurred = true;
 					}
 				}
 			}
 
 			// Pruning
-			for (size_t i = 0; i < attractors.size(); ++i) {
-				if (!attractors[i].active)
-					continue;
-				for (const auto& n : nodes) {
-					if (glm::distance2(attractors[i].pos, n.pos) < (killDistance * killDistance)) {
-						attractors[i].active = false;
-						break;
-					}
-				}
-			}
+			std::erase_if(active, [&](int a) { return node_grid.AnyWithin(attractors[a].pos, killDistance); });
 		}
 
 		// Thickness calculation (Leonardo's Rule)
@@ -817,6 +837,9 @@ namespace Boidsish {
 
 		int nextId = 2;
 
+		SpatialHashGrid       end_grid(kSpringRepulsionRadius);
+		std::vector<uint64_t> neighbours; // One bit per node
+
 		for (int iter = 0; iter < config.iterations; ++iter) {
 			// Growth and Simulation Loop
 			float dt = 0.02f;
@@ -827,6 +850,15 @@ namespace Boidsish {
 			for (int step = 0; step < steps; ++step) {
 				std::vector<glm::vec3> forces(nodes.size(), glm::vec3(0.0f));
 
+				// Ends move every step, so the grid is refilled from the current positions
+				neighbours.resize((nodes.size() + 63) / 64);
+				end_grid.Clear();
+				for (size_t i = 0; i < nodes.size(); ++i) {
+					if (nodes[i].isEnd) {
+						end_grid.Insert(static_cast<int>(i), nodes[i].pos);
+					}
+				}
+
 				for (size_t i = 0; i < nodes.size(); ++i) {
 					if (nodes[i].parentId == -1)
 						continue;
@@ -863,18 +895,22 @@ namespace Boidsish {
 						forces[i] += glm::normalize(outward) * config.up_pull * 0.5f * node.flexibility;
 					}
 
-					// 5. Repulsion from other ends
+					// 5. Repulsion from other ends. The grid finds them, a bitmask over node indices puts
+					// them back in index order so the sum matches a plain scan.
 					if (node.isEnd) {
-						for (size_t j = 0; j < nodes.size(); ++j) {
-							if (i == j)
-								continue;
-							if (!nodes[j].isEnd)
-								continue;
-
-							glm::vec3 diff = node.pos - nodes[j].pos;
-							float     d2 = glm::length2(diff);
-							if (d2 < 16.0f && d2 > 0.0001f) {
-								forces[i] += (glm::normalize(diff) * config.spring_repulsion) / d2;
+						std::fill(neighbours.begin(), neighbours.end(), 0);
+						end_grid.ForEachWithin(node.pos, kSpringRepulsionRadius, [&](int j, float) {
+							neighbours[j >> 6] |= 1ull << (j & 63);
+						});
+						neighbours[i >> 6] &= ~(1ull << (i & 63));
+						for (size_t word = 0; word < neighbours.size(); ++word) {
+							for (uint64_t bits = neighbours[word]; bits != 0; bits &= bits - 1) {
+								size_t    j = word * 64 + std::countr_zero(bits);
+								glm::vec3 diff = node.pos - nodes[j].pos;
+								float     d2 = glm::length2(diff);
+								if (d2 > 0.0001f) {
+									forces[i] += (glm::normalize(diff) * config.spring_repulsion) / d2;
+								}
 							}
 						}
 					}
@@ -1041,19 +1077,19 @@ namespace Boidsish {
 		if (custom_axiom.empty()) {
 			int ruleset = seed % 2;
 			if (ruleset == 0) {
-				lsys.axiom = "X";
-				lsys.rules['X'] = "F[&+X][&/X][^-X][^\\X]";
-				lsys.rules['F'] = "SFF";
+				lsys.SetAxiom("X");
+				lsys.SetRule('X', "F[&+X][&/X][^-X][^\\X]");
+				lsys.SetRule('F', "SFF");
 			} else {
-				lsys.axiom = "X";
-				lsys.rules['X'] = "F[+X][-X][&X][^X]";
-				lsys.rules['F'] = "FF";
+				lsys.SetAxiom("X");
+				lsys.SetRule('X', "F[+X][-X][&X][^X]");
+				lsys.SetRule('F', "FF");
 			}
 		} else {
-			lsys.axiom = custom_axiom;
-			lsys.rules = ParseRules(custom_rules);
+			lsys.SetAxiom(custom_axiom);
+			lsys.SetRules(custom_rules);
 		}
-		std::string expanded = lsys.expand(iterations);
+		auto symbols = lsys.Symbols(iterations);
 
 		struct TurtleStateIR {
 			glm::vec3 position;
@@ -1070,7 +1106,7 @@ namespace Boidsish {
 		glm::vec3 woodCol(0.35f, 0.25f, 0.15f);
 		glm::vec3 leafCol(0.1f, 0.45f + dis(gen), 0.1f);
 
-		for (char c : expanded) {
+		for (char c : symbols) {
 			if (c == 'F') {
 				glm::vec3 nextPos = current.position + current.orientation * glm::vec3(0, step, 0);
 				nextPos += current.orientation * glm::vec3(dis(gen) * 0.2f, 0, dis(gen) * 0.2f);
@@ -1265,14 +1301,14 @@ namespace Boidsish {
 
 		LSystem lsys;
 		if (custom_axiom.empty()) {
-			lsys.axiom = "F";
-			lsys.rules['F'] = "F[+F]F[-F]F";
+			lsys.SetAxiom("F");
+			lsys.SetRule('F', "F[+F]F[-F]F");
 		} else {
-			lsys.axiom = custom_axiom;
-			lsys.rules = ParseRules(custom_rules);
+			lsys.SetAxiom(custom_axiom);
+			lsys.SetRules(custom_rules);
 		}
 
-		std::string expanded = lsys.expand(iterations);
+		auto symbols = lsys.Symbols(iterations);
 
 		struct TurtleStateIR {
 			glm::vec3 position;
@@ -1297,7 +1333,7 @@ namespace Boidsish {
 		float                     angle = 0.4f;
 		float                     step = 0.5f;
 
-		for (char c : expanded) {
+		for (char c : symbols) {
 			if (c == 'F') {
 				glm::vec3 next_pos = current.position + current.orientation * glm::vec3(0, step, 0);
 				float     next_thickness = current.thickness * 0.95f;
@@ -1408,7 +1444,13 @@ namespace Boidsish {
 			}
 		}
 
-		Mesh mesh(vertices, indices, {}, shadow_indices);
+		std::vector<MeshLod> lods;
+		if (config.GetAppSettingBool("mesh_lod_enabled", true)) {
+			int levels = config.GetAppSettingInt("mesh_lod_count", 3);
+			MeshOptimizerUtil::GenerateLods(vertices, indices, lods, levels, data->model_path);
+		}
+
+		Mesh mesh(vertices, indices, {}, shadow_indices, std::move(lods), MeshOptimizerUtil::ConfiguredVertexFormat());
 		mesh.diffuseColor = diffuseColor;
 		data->meshes.push_back(mesh);
 
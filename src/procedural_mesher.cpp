@@ -5,20 +5,31 @@
 #include <cmath>
 #include <map>
 #include <numbers>
+#include <numeric>
 #include <set>
 #include <utility>
 
 #include <glm/gtx/norm.hpp>
 
 #include "ConfigManager.h"
+#include "convex_hull.h"
 #include "mesh_optimizer_util.h"
+#include "spatial_hash_grid.h"
 #include "spline.h"
+#include "thread_pool.h"
+#include <poolstl/poolstl.hpp>
 
 namespace Boidsish {
 
 	namespace {
 		const float SPLINE_RADIUS_SCALE = 0.005f;
 
+		// Hub hull points closer than this are one point
+		constexpr float kHubWeldDistance = 1e-3f;
+
+		// Models with fewer tube chains and elements than this are meshed on the calling thread
+		constexpr size_t kParallelMeshPrimitives = 64;
+
 		struct BoneSegment {
 			int       parent_bone;
 			glm::mat4 offset;
@@ -347,25 +358,14 @@ namespace Boidsish {
 				return;
 			}
 
-			// Quick and dirty 3D convex hull using Delaunay logic
-			// (Simplified: we use the center and rings to form a volume)
-			// For a true manifold junction, we'll use a simplified version of Delaunay extraction.
-
-			// Build internal point set for Delaunay
-			std::vector<Vertex>       hull_verts;
-			std::vector<unsigned int> hull_indices;
-
-			// We need a unique set of points
+			// Weld coincident points; rings of tubes leaving at similar angles overlap
+			SpatialHashGrid        weld_grid(kHubWeldDistance);
 			std::vector<glm::vec3> unique_points;
 			for (const auto& p : points) {
-				bool duplicate = false;
-				for (const auto& up : unique_points) {
-					if (glm::distance2(p, up) < 1e-6f) {
-						duplicate = true;
-						break;
-					}
+				if (weld_grid.FindNearest(p, kHubWeldDistance) < 0) {
+					weld_grid.Insert(static_cast<int>(unique_points.size()), p);
+					unique_points.push_back(p);
 				}
-				if (!duplicate) unique_points.push_back(p);
 			}
 
 			if (unique_points.size() < 4) {
@@ -373,101 +373,25 @@ namespace Boidsish {
 				return;
 			}
 
-			auto circumsphere = [](const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d) {
-				glm::vec3 ba = b - a;
-				glm::vec3 ca = c - a;
-				glm::vec3 da = d - a;
-				float len_ba = glm::dot(ba, ba);
-				float len_ca = glm::dot(ca, ca);
-				float len_da = glm::dot(da, da);
-				glm::vec3 cross_cd = glm::cross(ca, da);
-				glm::vec3 cross_db = glm::cross(da, ba);
-				glm::vec3 cross_bc = glm::cross(ba, ca);
-				float denom = 2.0f * glm::dot(ba, cross_cd);
-				if (std::abs(denom) < 1e-10f) return std::make_pair(glm::vec3(0), -1.0f);
-				glm::vec3 offset = (len_ba * cross_cd + len_ca * cross_db + len_da * cross_bc) / denom;
-				return std::make_pair(a + offset, glm::dot(offset, offset));
-			};
-
-			struct Tet {
-				int v[4];
-				glm::vec3 center;
-				float r2;
-			};
+			// The junction is the convex hull of the rings and the center, flat shaded
+			ConvexHull hull;
+			hull.Build(unique_points);
+			for (const auto& tri : hull.GetTriangles()) {
+				glm::vec3 p0 = unique_points[tri[0]], p1 = unique_points[tri[1]], p2 = unique_points[tri[2]];
+				glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
 
-			std::vector<Tet> tets;
-
-			// Super-tetrahedron
-			glm::vec3 min_p = unique_points[0], max_p = unique_points[0];
-			for(const auto& p : unique_points) { min_p = glm::min(min_p, p); max_p = glm::max(max_p, p); }
-			glm::vec3 mid = (min_p + max_p) * 0.5f;
-			float dmax = glm::length(max_p - min_p) * 5.0f;
-			std::vector<glm::vec3> pts = unique_points;
-			pts.push_back(mid + glm::vec3(dmax, dmax, dmax));
-			pts.push_back(mid + glm::vec3(dmax, -dmax, -dmax));
-			pts.push_back(mid + glm::vec3(-dmax, dmax, -dmax));
-			pts.push_back(mid + glm::vec3(-dmax, -dmax, dmax));
-			int s0 = pts.size()-4, s1 = pts.size()-3, s2 = pts.size()-2, s3 = pts.size()-1;
-
-			auto res = circumsphere(pts[s0], pts[s1], pts[s2], pts[s3]);
-			tets.push_back({{s0, s1, s2, s3}, res.first, res.second});
-
-			for (int i = 0; i < (int)unique_points.size(); ++i) {
-				std::vector<Tet> bad;
-				std::vector<Tet> good;
-				for (const auto& t : tets) {
-					if (glm::distance2(pts[i], t.center) < t.r2 * (1.0f + 1e-6f)) bad.push_back(t);
-					else good.push_back(t);
-				}
-				std::map<std::array<int, 3>, int> faces;
-				for (const auto& t : bad) {
-					for (int j = 0; j < 4; ++j) {
-						std::array<int, 3> f = {t.v[j%4], t.v[(j+1)%4], t.v[(j+2)%4]};
-						std::sort(f.begin(), f.end());
-						faces[f]++;
-					}
-				}
-				tets = good;
-				for (auto const& [f, count] : faces) {
-					if (count == 1) {
-						auto r = circumsphere(pts[f[0]], pts[f[1]], pts[f[2]], pts[i]);
-						if (r.second >= 0) tets.push_back({{f[0], f[1], f[2], i}, r.first, r.second});
-					}
-				}
-			}
-
-			// Extract surface faces
-			std::map<std::array<int, 3>, int> face_counts;
-			for (const auto& t : tets) {
-				bool has_super = false;
-				for (int v : t.v) if (v >= (int)unique_points.size()) has_super = true;
-				if (has_super) continue;
-				for (int j = 0; j < 4; ++j) {
-					std::array<int, 3> f = {t.v[j%4], t.v[(j+1)%4], t.v[(j+2)%4]};
-					std::sort(f.begin(), f.end());
-					face_counts[f]++;
-				}
-			}
-
-			for (auto const& [f, count] : face_counts) {
-				if (count == 1) {
-					glm::vec3 p0 = pts[f[0]], p1 = pts[f[1]], p2 = pts[f[2]];
-					glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-					if (glm::dot(normal, p0 - center) < 0) { std::swap(p1, p2); normal = -normal; }
-
-					unsigned int base = (unsigned int)vertices.size();
-					for (const auto& p : {p0, p1, p2}) {
-						Vertex v;
-						v.Position = p;
-						v.Normal = normal;
-						v.Color = hub.color;
-						v.TexCoords = glm::vec2(0.5f); // Hubs use center of texture
-						vertices.push_back(v);
-					}
-					indices.push_back(base);
-					indices.push_back(base + 1);
-					indices.push_back(base + 2);
+				unsigned int base = (unsigned int)vertices.size();
+				for (const auto& p : {p0, p1, p2}) {
+					Vertex v;
+					v.Position = p;
+					v.Normal = normal;
+					v.Color = hub.color;
+					v.TexCoords = glm::vec2(0.5f); // Hubs use center of texture
+					vertices.push_back(v);
 				}
+				indices.push_back(base);
+				indices.push_back(base + 1);
+				indices.push_back(base + 2);
 			}
 		}
 
@@ -606,16 +530,34 @@ namespace Boidsish {
 
 		std::map<MaterialKey, MeshData> grouped_meshes;
 
-		struct SkinJob {
-			int              start_v;
-			int              end_v;
-			int              element_idx;
-			int              mode;
-			std::vector<int> segment_bones;
-			MaterialKey      material;
+		auto group_for = [&](const MaterialKey& mat) -> MeshData& {
+			if (grouped_meshes.find(mat) == grouped_meshes.end()) {
+				grouped_meshes[mat].material = mat;
+			}
+			return grouped_meshes[mat];
+		};
+
+		// A tube chain or a single element, meshed into its own buffers and then copied into its group
+		struct Primitive {
+			MeshData*    group;
+			int          element_idx;
+			SkinningMode mode;
+
+			// Tube chains only
+			std::vector<Vector3>   points;
+			std::vector<Vector3>   ups;
+			std::vector<float>     sizes;
+			std::vector<glm::vec3> colors;
+			std::vector<int>       segment_bones;
+
+			std::vector<Vertex>       vertices;
+			std::vector<unsigned int> indices;
+			size_t                    vertex_offset = 0;
+			size_t                    index_offset = 0;
 		};
 
-		std::vector<SkinJob> skin_jobs;
+		// Primitives in the order they are appended to their groups
+		std::vector<Primitive> primitives;
 
 		// Tubes handled via spline
 		std::vector<bool> handled(ir.elements.size(), false);
@@ -684,32 +626,13 @@ namespace Boidsish {
 				}
 
 				if (points.size() >= 2) {
-					if (grouped_meshes.find(mat) == grouped_meshes.end()) {
-						grouped_meshes[mat].material = mat;
-					}
-					auto&        group = grouped_meshes[mat];
-					int          v_start = (int)group.vertices.size();
-					auto         tube_data = Spline::GenerateTube(points, ups, sizes, colors, false, 10, 8);
-					unsigned int base = (unsigned int)group.vertices.size();
-					for (const auto& vd : tube_data) {
-						Vertex v;
-						v.Position = vd.pos;
-						v.Normal = vd.normal;
-						v.Color = vd.color;
-						v.TexCoords = vd.texCoords;
-						group.vertices.push_back(v);
-					}
-					for (unsigned int k = 0; k < (unsigned int)tube_data.size(); ++k)
-						group.indices.push_back(base + k);
-
-					SkinJob job;
-					job.start_v = v_start;
-					job.end_v = (int)group.vertices.size();
-					job.element_idx = i;
-					job.mode = (int)chain_mode;
-					job.segment_bones = std::move(segment_bones);
-					job.material = mat;
-					skin_jobs.push_back(std::move(job));
+					Primitive prim{&group_for(mat), i, chain_mode};
+					prim.points = std::move(points);
+					prim.ups = std::move(ups);
+					prim.sizes = std::move(sizes);
+					prim.colors = std::move(colors);
+					prim.segment_bones = std::move(segment_bones);
+					primitives.push_back(std::move(prim));
 				}
 			}
 		}
@@ -720,37 +643,12 @@ namespace Boidsish {
 				continue;
 
 			MaterialKey mat = {e.roughness, e.metallic, e.ao, e.emissiveColor};
-			if (grouped_meshes.find(mat) == grouped_meshes.end()) {
-				grouped_meshes[mat].material = mat;
-			}
-			auto& group = grouped_meshes[mat];
-			int   v_start = (int)group.vertices.size();
+			auto&       group = group_for(mat);
 
-			if (e.type == ProceduralElementType::Hub) {
-				GenerateHubMesh(group.vertices, group.indices, ir, i);
-			} else if (e.type == ProceduralElementType::Box) {
-				GenerateBox(group.vertices, group.indices, e.position, e.orientation, e.dimensions, e.color);
-			} else if (e.type == ProceduralElementType::Wedge) {
-				GenerateWedge(group.vertices, group.indices, e.position, e.orientation, e.dimensions, e.color);
-			} else if (e.type == ProceduralElementType::Pyramid) {
-				GeneratePyramid(group.vertices, group.indices, e.position, e.orientation, e.dimensions, e.color);
-			} else if (e.type == ProceduralElementType::Puffball) {
-				if (e.variant == 1)
-					GenerateUVSphere(
-						group.vertices,
-						group.indices,
-						e.position,
-						e.radius,
-						e.color,
-						8,
-						8,
-						glm::vec3(1.0f, 0.4f, 1.0f)
-					);
-				else
-					GenerateUVSphere(group.vertices, group.indices, e.position, e.radius, e.color, 4, 4);
-			} else {
+			if (e.type != ProceduralElementType::Hub && e.type != ProceduralElementType::Box &&
+			    e.type != ProceduralElementType::Wedge && e.type != ProceduralElementType::Pyramid &&
+			    e.type != ProceduralElementType::Puffball)
 				continue;
-			}
 
 			SkinningMode sm = e.skinning_mode;
 			if (sm == SkinningMode::Auto) {
@@ -759,16 +657,30 @@ namespace Boidsish {
 				else
 					sm = SkinningMode::Rigid;
 			}
-			skin_jobs.push_back({v_start, (int)group.vertices.size(), i, (int)sm, {}, mat});
+			primitives.push_back({&group, i, sm});
+		}
+
+		for (int i = 0; i < (int)ir.elements.size(); ++i) {
+			const auto& e = ir.elements[i];
+			if (e.type == ProceduralElementType::Leaf) {
+				MaterialKey mat = {e.roughness, e.metallic, e.ao, e.emissiveColor};
+				auto&       group = group_for(mat);
+				group.is_leaf = true;
+
+				SkinningMode sm = e.skinning_mode;
+				if (sm == SkinningMode::Auto)
+					sm = SkinningMode::Rigid;
+				primitives.push_back({&group, i, sm});
+			}
 		}
 
-		auto AddLeafGeom = [&](std::vector<Vertex>&       vertices,
-		                       std::vector<unsigned int>& indices,
-		                       glm::vec3                  pos,
-		                       glm::quat                  ori,
-		                       float                      size,
-		                       glm::vec3                  color,
-		                       int                        variant) {
+		auto AddLeafGeom = [](std::vector<Vertex>&       vertices,
+		                      std::vector<unsigned int>& indices,
+		                      glm::vec3                  pos,
+		                      glm::quat                  ori,
+		                      float                      size,
+		                      glm::vec3                  color,
+		                      int                        variant) {
 			unsigned int           base = (unsigned int)vertices.size();
 			std::vector<glm::vec3> pts;
 			if (variant == 1)
@@ -808,46 +720,59 @@ namespace Boidsish {
 			}
 		};
 
-		for (int i = 0; i < (int)ir.elements.size(); ++i) {
-			const auto& e = ir.elements[i];
-			if (e.type == ProceduralElementType::Leaf) {
-				MaterialKey mat = {e.roughness, e.metallic, e.ao, e.emissiveColor};
-				if (grouped_meshes.find(mat) == grouped_meshes.end()) {
-					grouped_meshes[mat].material = mat;
-				}
-				auto& group = grouped_meshes[mat];
-				group.is_leaf = true;
-				int v_start = (int)group.vertices.size();
-				AddLeafGeom(group.vertices, group.indices, e.position, e.orientation, e.radius, e.color, e.variant);
+		// Meshing and skinning read only the IR and the bones, so primitives are independent
+		auto mesh_primitive = [&](Primitive& prim) {
+			const auto& e = ir.elements[prim.element_idx];
+			auto&       verts = prim.vertices;
+			auto&       indices = prim.indices;
 
-				SkinningMode sm = e.skinning_mode;
-				if (sm == SkinningMode::Auto)
-					sm = SkinningMode::Rigid;
-				skin_jobs.push_back({v_start, (int)group.vertices.size(), i, (int)sm, {}, mat});
+			if (!prim.points.empty()) {
+				auto tube_data = Spline::GenerateTube(prim.points, prim.ups, prim.sizes, prim.colors, false, 10, 8);
+				verts.reserve(tube_data.size());
+				for (const auto& vd : tube_data) {
+					Vertex v;
+					v.Position = vd.pos;
+					v.Normal = vd.normal;
+					v.Color = vd.color;
+					v.TexCoords = vd.texCoords;
+					verts.push_back(v);
+				}
+				indices.resize(tube_data.size());
+				std::iota(indices.begin(), indices.end(), 0u);
+			} else if (e.type == ProceduralElementType::Hub) {
+				GenerateHubMesh(verts, indices, ir, prim.element_idx);
+			} else if (e.type == ProceduralElementType::Box) {
+				GenerateBox(verts, indices, e.position, e.orientation, e.dimensions, e.color);
+			} else if (e.type == ProceduralElementType::Wedge) {
+				GenerateWedge(verts, indices, e.position, e.orientation, e.dimensions, e.color);
+			} else if (e.type == ProceduralElementType::Pyramid) {
+				GeneratePyramid(verts, indices, e.position, e.orientation, e.dimensions, e.color);
+			} else if (e.type == ProceduralElementType::Puffball) {
+				if (e.variant == 1)
+					GenerateUVSphere(verts, indices, e.position, e.radius, e.color, 8, 8, glm::vec3(1.0f, 0.4f, 1.0f));
+				else
+					GenerateUVSphere(verts, indices, e.position, e.radius, e.color, 4, 4);
+			} else if (e.type == ProceduralElementType::Leaf) {
+				AddLeafGeom(verts, indices, e.position, e.orientation, e.radius, e.color, e.variant);
 			}
-		}
 
-		for (auto& job : skin_jobs) {
-			SkinningMode         mode = (SkinningMode)job.mode;
-			std::vector<Vertex>& verts = grouped_meshes[job.material].vertices;
-
-			if (!job.segment_bones.empty()) {
-				int num_segments = (int)job.segment_bones.size();
-				int total_verts = job.end_v - job.start_v;
-				int verts_per_segment = (num_segments > 0) ? (total_verts / num_segments) : total_verts;
-				for (int vi = job.start_v; vi < job.end_v; ++vi) {
-					int seg_idx = (verts_per_segment > 0) ? ((vi - job.start_v) / verts_per_segment) : 0;
+			int end_v = (int)verts.size();
+			if (!prim.segment_bones.empty()) {
+				int num_segments = (int)prim.segment_bones.size();
+				int verts_per_segment = (num_segments > 0) ? (end_v / num_segments) : end_v;
+				for (int vi = 0; vi < end_v; ++vi) {
+					int seg_idx = (verts_per_segment > 0) ? (vi / verts_per_segment) : 0;
 					seg_idx = std::min(seg_idx, num_segments - 1);
-					int bone_id = job.segment_bones[seg_idx];
+					int bone_id = prim.segment_bones[seg_idx];
 					if (bone_id != -1) {
 						verts[vi].m_BoneIDs[0] = bone_id;
 						verts[vi].m_Weights[0] = 1.0f;
 					}
 				}
-			} else if (mode == SkinningMode::Rigid) {
-				int bone_id = element_to_bone[job.element_idx];
+			} else if (prim.mode == SkinningMode::Rigid) {
+				int bone_id = element_to_bone[prim.element_idx];
 				if (bone_id == -1) {
-					int curr = job.element_idx;
+					int curr = prim.element_idx;
 					while (curr != -1) {
 						if (element_to_bone[curr] != -1) {
 							bone_id = element_to_bone[curr];
@@ -856,10 +781,51 @@ namespace Boidsish {
 						curr = ir.elements[curr].parent;
 					}
 				}
-				AssignRigidWeights(verts, job.start_v, job.end_v, bone_id);
-			} else if (mode == SkinningMode::Smooth) {
-				AssignBoneWeights(verts, bone_segments, job.start_v, job.end_v);
+				AssignRigidWeights(verts, 0, end_v, bone_id);
+			} else if (prim.mode == SkinningMode::Smooth) {
+				AssignBoneWeights(verts, bone_segments, 0, end_v);
 			}
+		};
+
+		// Each primitive's place in its group follows from the sizes of the ones before it
+		auto emit_primitive = [](Primitive& prim) {
+			std::copy(prim.vertices.begin(), prim.vertices.end(), prim.group->vertices.begin() + prim.vertex_offset);
+			const auto base = (unsigned int)prim.vertex_offset;
+			std::transform(
+				prim.indices.begin(),
+				prim.indices.end(),
+				prim.group->indices.begin() + prim.index_offset,
+				[base](unsigned int index) { return base + index; }
+			);
+			std::vector<Vertex>().swap(prim.vertices);
+			std::vector<unsigned int>().swap(prim.indices);
+		};
+
+		// Nested in a pool task (GenerateVariants), the pool's workers may all be waiting already
+		const bool parallel = primitives.size() >= kParallelMeshPrimitives && !InPoolTask();
+		if (parallel) {
+			std::for_each(poolstl::par.on(pool), primitives.begin(), primitives.end(), mesh_primitive);
+		} else {
+			std::for_each(primitives.begin(), primitives.end(), mesh_primitive);
+		}
+
+		std::map<const MeshData*, std::pair<size_t, size_t>> group_sizes;
+		for (auto& prim : primitives) {
+			auto& [vertex_count, index_count] = group_sizes[prim.group];
+			prim.vertex_offset = vertex_count;
+			prim.index_offset = index_count;
+			vertex_count += prim.vertices.size();
+			index_count += prim.indices.size();
+		}
+		for (auto& [key, group] : grouped_meshes) {
+			group.vertices.resize(group_sizes[&group].first);
+			group.indices.resize(group_sizes[&group].second);
+		}
+
+		if (parallel) {
+			std::for_each(poolstl::par.on(pool), primitives.begin(), primitives.end(), emit_primitive);
+		} else {
+			std::for_each(primitives.begin(), primitives.end(), emit_primitive);
 		}
 
 		glm::vec3 min(1e10f), max(-1e10f);
@@ -917,7 +883,19 @@ namespace Boidsish {
 				if (config.GetAppSettingBool("mesh_optimizer_shadow_indices_enabled", true))
 					MeshOptimizerUtil::GenerateShadowIndices(group.vertices, group.indices, shadow_indices);
 			}
-			Mesh m(group.vertices, group.indices, {}, shadow_indices);
+			std::vector<MeshLod> lods;
+			if (config.GetAppSettingBool("mesh_lod_enabled", true)) {
+				int levels = config.GetAppSettingInt("mesh_lod_count", 3);
+				MeshOptimizerUtil::GenerateLods(group.vertices, group.indices, lods, levels, data->model_path);
+			}
+			Mesh m(
+				group.vertices,
+				group.indices,
+				{},
+				shadow_indices,
+				std::move(lods),
+				MeshOptimizerUtil::ConfiguredVertexFormat()
+			);
 			m.diffuseColor = {1, 1, 1};
 			m.has_vertex_colors = true;
 			m.roughness = group.material.roughness;
@@ -930,6 +908,9 @@ namespace Boidsish {
 		for (auto& [key, group] : grouped_meshes) {
 			finalize_mesh(group);
 		}
+		if (ConfigManager::GetInstance().GetAppSettingBool("meshlets_enabled", false)) {
+			data->BuildMeshlets();
+		}
 
 		auto model = std::make_shared<Model>(data, false);
 		model->SetAllowMegabuffer(false);
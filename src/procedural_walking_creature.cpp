@@ -215,7 +215,21 @@ namespace Boidsish {
 		for (auto& leg : legs_) {
 			model_->SolveIK(leg.effector_name, leg.world_foot_pos, 0.01f, 20, leg.name + "_upper");
 		}
-		model_->UpdateAnimation(delta_time);
+		if (!crowd_) {
+			model_->UpdateAnimation(delta_time);
+		}
+	}
+
+	void ProceduralWalkingCreature::SetAnimationCrowd(AnimationCrowd* crowd) {
+		if (crowd == crowd_)
+			return;
+		if (crowd_) {
+			crowd_->Remove(crowd_handle_);
+		}
+		crowd_ = crowd;
+		if (crowd_) {
+			crowd_handle_ = crowd_->Add(model_);
+		}
 	}
 
 	void ProceduralWalkingCreature::UpdateMovement(float delta_time) {
@@ -8,56 +8,41 @@ namespace Boidsish {
 	RainAudioEffect::RainAudioEffect(AudioManager& audioManager)
 		: ProceduralAudioSource(2, 48000),
 		  m_audioManager(audioManager),
-		  m_xorshiftState(987654321) {
+		  m_noise(987654321) {
 	}
 
-	float RainAudioEffect::NextWhiteNoise() {
-		m_xorshiftState ^= m_xorshiftState << 13;
-		m_xorshiftState ^= m_xorshiftState >> 17;
-		m_xorshiftState ^= m_xorshiftState << 5;
-		return (static_cast<float>(m_xorshiftState) / static_cast<float>(0xFFFFFFFF)) * 2.0f - 1.0f;
-	}
-
-	void RainAudioEffect::OnRead(float* pOutput, ma_uint64 frameCount) {
+	ma_uint32 RainAudioEffect::OnRenderBlock(float* const* pPlanes, ma_uint32 frameCount) {
 		float intensity = m_intensity.load(std::memory_order_relaxed);
 		if (intensity <= 0.001f) {
-			for (ma_uint64 i = 0; i < frameCount * m_channels; ++i) {
-				pOutput[i] = 0.0f;
-			}
-			return;
+			return 0;
 		}
 
-		// Background rain wash (smooth hiss)
-		float washAlpha = 0.01f;
-		// Rain patter (sharper drops)
-		float patterAlpha = 0.07f;
-
-		for (ma_uint64 i = 0; i < frameCount; ++i) {
-			float white = NextWhiteNoise();
-
-			// Background wash: filtered white noise
-			m_lowWash = m_lowWash + washAlpha * (white - m_lowWash);
-			float wash = m_lowWash * 0.05f * intensity;
-
-			// Stochastic drops for the "patter" effect
-			float drop = 0.0f;
-			// Scale drop chance with intensity
-			float drop_chance = 0.0005f + intensity * 0.01f;
-
-			// Reuse some bits of xorshift for the drop chance
-			if ((static_cast<float>(m_xorshiftState & 0xFFFF) / 65535.0f) < drop_chance) {
-				drop = white * 0.2f * intensity;
-			}
-
-			// Filter the drops a bit to take the edge off
-			m_lowPatter = m_lowPatter + patterAlpha * (drop - m_lowPatter);
+		float*          out = pPlanes[0];
+		float*          drops = m_drops;
+		const float*    white = m_white;
+		const uint32_t* bits = m_bits;
+		m_noise.Fill(m_white, m_bits, frameCount);
+
+		// Background wash: filtered white noise (smooth hiss)
+		m_wash.Lowpass(white, out, frameCount, 0.01f);
+
+		// Stochastic drops for the "patter" effect, with a chance that scales with intensity.
+		// The low 16 bits of each noise sample's generator state decide whether it is a drop.
+		int32_t drop_limit = static_cast<int32_t>(std::ceil((0.0005f + intensity * 0.01f) * 65535.0f));
+		float   drop_gain = 0.2f * intensity;
+		for (ma_uint32 i = 0; i < frameCount; ++i) {
+			float is_drop = static_cast<float>(static_cast<int32_t>(bits[i] & 0xFFFF) < drop_limit);
+			drops[i] = white[i] * drop_gain * is_drop;
+		}
 
-			float sample = wash + m_lowPatter;
+		// Filter the drops a bit to take the edge off
+		m_patter.Lowpass(drops, drops, frameCount, 0.07f);
 
-			for (ma_uint32 c = 0; c < m_channels; ++c) {
-				pOutput[i * m_channels + c] = sample;
-			}
+		float wash_gain = 0.05f * intensity;
+		for (ma_uint32 i = 0; i < frameCount; ++i) {
+			out[i] = out[i] * wash_gain + drops[i];
 		}
+		return 1;
 	}
 
 	void RainAudioEffect::OnUpdate(float deltaTime, const AudioState& state) {
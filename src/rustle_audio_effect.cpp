@@ -10,40 +10,23 @@ namespace Boidsish {
 	RustleAudioEffect::RustleAudioEffect(AudioManager& audioManager)
 		: ProceduralAudioSource(2, 48000),
 		  m_audioManager(audioManager),
-		  m_xorshiftState(135792468) {
+		  m_noise(135792468) {
 	}
 
-	float RustleAudioEffect::NextWhiteNoise() {
-		m_xorshiftState ^= m_xorshiftState << 13;
-		m_xorshiftState ^= m_xorshiftState >> 17;
-		m_xorshiftState ^= m_xorshiftState << 5;
-		return (static_cast<float>(m_xorshiftState) / static_cast<float>(0xFFFFFFFF)) * 2.0f - 1.0f;
-	}
-
-	void RustleAudioEffect::OnRead(float* pOutput, ma_uint64 frameCount) {
+	ma_uint32 RustleAudioEffect::OnRenderBlock(float* const* pPlanes, ma_uint32 frameCount) {
 		float gain = m_gain.load(std::memory_order_relaxed);
 		float alpha = m_lowPassAlpha.load(std::memory_order_relaxed);
 
 		if (gain <= 0.0001f) {
-			for (ma_uint64 i = 0; i < frameCount * m_channels; ++i) {
-				pOutput[i] = 0.0f;
-			}
-			return;
+			return 0;
 		}
 
-		for (ma_uint64 i = 0; i < frameCount; ++i) {
-			float white = NextWhiteNoise();
-
-			// Simple high-pass filter by subtracting low-pass from signal
-			m_low = m_low + alpha * (white - m_low);
-			float highPass = white - m_low;
-
-			float sample = highPass * gain;
-
-			for (ma_uint32 c = 0; c < m_channels; ++c) {
-				pOutput[i * m_channels + c] = sample;
-			}
-		}
+		// Simple high-pass filter by subtracting low-pass from signal
+		float* out = pPlanes[0];
+		m_noise.Fill(out, nullptr, frameCount);
+		m_filter.Highpass(out, out, frameCount, alpha);
+		dsp::Scale(out, frameCount, gain);
+		return 1;
 	}
 
 	void RustleAudioEffect::OnUpdate(float deltaTime, const AudioState& state) {
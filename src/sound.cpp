@@ -16,14 +16,16 @@ namespace Boidsish {
 		float              volume,
 		bool               spatialized,
 		const glm::vec3&   position,
-		ma_sound_group*    group
+		ma_sound_group*    group,
+		ma_uint32          flags,
+		bool               start
 	) {
 		if (!engine) {
 			logger::ERROR("Sound created with null audio engine.");
 			return;
 		}
 
-		ma_result result = ma_sound_init_from_file(engine, filepath.c_str(), 0, group, NULL, &_sound);
+		ma_result result = ma_sound_init_from_file(engine, filepath.c_str(), flags, group, NULL, &_sound);
 		if (result != MA_SUCCESS) {
 			logger::ERROR("Failed to load sound file: {}", filepath);
 			return;
@@ -36,7 +38,9 @@ namespace Boidsish {
 			ma_sound_set_position(&_sound, position.x, position.y, position.z);
 		}
 
-		ma_sound_start(&_sound);
+		if (start) {
+			ma_sound_start(&_sound);
+		}
 		_initialized = true;
 	}
 
@@ -110,6 +114,21 @@ namespace Boidsish {
 		return ma_sound_at_end(&_sound) ? true : false;
 	}
 
+	float Sound::GetLengthSeconds() const {
+		float length = 0.0f;
+		if (_initialized && ma_sound_get_length_in_seconds(&_sound, &length) != MA_SUCCESS) {
+			length = 0.0f;
+		}
+		return length;
+	}
+
+	void Sound::Play(float start_seconds) {
+		if (_initialized) {
+			ma_sound_seek_to_second(&_sound, start_seconds);
+			ma_sound_start(&_sound);
+		}
+	}
+
 	void Sound::Stop() {
 		if (_initialized) {
 			ma_sound_stop(&_sound);
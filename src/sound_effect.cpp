@@ -5,12 +5,22 @@
 namespace Boidsish {
 
 	SoundEffect::SoundEffect(
-		std::shared_ptr<Sound> sound_handle,
-		const glm::vec3&       position,
-		const glm::vec3&       velocity,
-		float                  lifetime
+		const std::string& filepath,
+		const glm::vec3&   position,
+		const glm::vec3&   velocity,
+		float              volume,
+		bool               loop,
+		float              lifetime,
+		int                priority
 	):
-		sound_handle_(sound_handle), position_(position), velocity_(velocity), id_(count++), lifetime_(lifetime) {}
+		filepath_(filepath),
+		position_(position),
+		velocity_(velocity),
+		volume_(volume),
+		loop_(loop),
+		priority_(priority),
+		id_(count++),
+		lifetime_(lifetime) {}
 
 	void SoundEffect::SetPosition(const glm::vec3& pos) {
 		position_ = pos;
@@ -19,4 +29,11 @@ namespace Boidsish {
 		}
 	}
 
+	void SoundEffect::SetVolume(float volume) {
+		volume_ = volume;
+		if (sound_handle_) {
+			sound_handle_->SetVolume(volume);
+		}
+	}
+
 } // namespace Boidsish
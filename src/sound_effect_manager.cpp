@@ -1,21 +1,32 @@
 #include "sound_effect_manager.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "audio_manager.h"
+#include "audio_types.h"
 #include "profiler.h"
 #include "service_locator.h"
 #include "sound.h"
 
 namespace Boidsish {
 
-	SoundEffectManager::SoundEffectManager(ServiceLocator& loc): _audio_manager(loc.Get<AudioManager>().get()) {}
+	namespace {
+		// Effects quieter than this (-60 dB) are never given a voice
+		constexpr float kInaudible = 1e-3f;
+	} // namespace
+
+	SoundEffectManager::SoundEffectManager(ServiceLocator& loc, size_t voice_count):
+		_audio_manager(loc.Get<AudioManager>().get()), _voices(std::max<size_t>(voice_count, 1)) {
+		_max_audible = std::min(_max_audible, _voices.size());
+	}
 
 	SoundEffectManager::~SoundEffectManager() {
-		// Clear all effects before destruction to ensure Sound objects
+		// Clear all effects and voices before destruction to ensure Sound objects
 		// are released while AudioManager is still valid
 		std::lock_guard<std::mutex> lock(_mutex);
 		_effects.clear();
+		_voices.clear();
 	}
 
 	std::shared_ptr<SoundEffect> SoundEffectManager::AddEffect(
@@ -24,20 +35,28 @@ namespace Boidsish {
 		const glm::vec3&   velocity,
 		float              volume,
 		bool               loop,
-		float              lifetime
+		float              lifetime,
+		int                priority
 	) {
 		if (!_audio_manager) {
 			return nullptr;
 		}
 
-		auto sound_handle = _audio_manager->CreateSound(filepath, position, volume, loop);
-		if (!sound_handle) {
-			return nullptr;
-		}
+		auto effect = std::make_shared<SoundEffect>(filepath, position, velocity, volume, loop, lifetime, priority);
+		auto listener = _audio_manager->GetCurrentState().listener_pos;
 
-		auto                        effect = std::make_shared<SoundEffect>(sound_handle, position, velocity, lifetime);
 		std::lock_guard<std::mutex> lock(_mutex);
+		effect->length_ = SourceLength(filepath);
+		if (effect->length_ <= 0.0f) {
+			return nullptr; // Engine not running or the file failed to load
+		}
 		_effects.push_back(effect);
+
+		// Start immediately while the budget has room; otherwise the next Update ranks it
+		if (_audible_count < _max_audible && Audibility(*effect, listener) > kInaudible && AttachVoice(*effect)) {
+			effect->audible_frame_ = _frame;
+			++_audible_count;
+		}
 		return effect;
 	}
 
@@ -48,12 +67,114 @@ namespace Boidsish {
 		}
 	}
 
+	void SoundEffectManager::SetMaxAudibleVoices(size_t count) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_max_audible = std::min(count, _voices.size());
+	}
+
+	size_t SoundEffectManager::GetEffectCount() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _effects.size();
+	}
+
+	size_t SoundEffectManager::GetAudibleCount() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _audible_count;
+	}
+
+	float SoundEffectManager::Audibility(const SoundEffect& effect, const glm::vec3& listener) const {
+		// Matches miniaudio's default inverse-distance attenuation (min distance 1, rolloff 1)
+		return effect.volume_ / std::max(glm::distance(effect.position_, listener), 1.0f);
+	}
+
+	float SoundEffectManager::SourceLength(const std::string& filepath) {
+		auto it = _source_lengths.find(filepath);
+		if (it != _source_lengths.end()) {
+			return it->second;
+		}
+
+		// First use of this file: decode it into an empty voice so the first play finds it ready
+		auto  sound = _audio_manager->CreateVoice(filepath);
+		float length = sound && sound->IsValid() ? sound->GetLengthSeconds() : 0.0f;
+		if (length > 0.0f) {
+			auto empty = std::find_if(_voices.begin(), _voices.end(), [](const Voice& v) { return !v.sound; });
+			if (empty != _voices.end()) {
+				empty->sound = sound;
+				empty->filepath = filepath;
+			}
+		}
+		_source_lengths[filepath] = length;
+		return length;
+	}
+
+	bool SoundEffectManager::AttachVoice(SoundEffect& effect) {
+		// Prefer an idle voice already holding this file, then an empty one, then the least recently used
+		int chosen = -1, empty = -1, lru = -1;
+		for (int i = 0; i < static_cast<int>(_voices.size()); ++i) {
+			const Voice& voice = _voices[i];
+			if (voice.owner)
+				continue;
+			if (voice.sound && voice.filepath == effect.filepath_) {
+				chosen = i;
+				break;
+			}
+			if (!voice.sound) {
+				if (empty < 0)
+					empty = i;
+			} else if (lru < 0 || voice.last_used < _voices[lru].last_used) {
+				lru = i;
+			}
+		}
+
+		if (chosen < 0) {
+			chosen = empty >= 0 ? empty : lru;
+			if (chosen < 0) {
+				return false;
+			}
+			auto sound = _audio_manager->CreateVoice(effect.filepath_);
+			if (!sound || !sound->IsValid()) {
+				return false;
+			}
+			_voices[chosen].sound = sound;
+			_voices[chosen].filepath = effect.filepath_;
+		}
+
+		Voice& voice = _voices[chosen];
+		voice.owner = &effect;
+		effect.voice_ = chosen;
+		effect.sound_handle_ = voice.sound;
+
+		voice.sound->SetLooping(effect.loop_);
+		voice.sound->SetVolume(effect.volume_);
+		voice.sound->SetPosition(effect.position_);
+		float start = effect.loop_ ? std::fmod(effect.playback_time_, effect.length_) : effect.playback_time_;
+		voice.sound->Play(start);
+		return true;
+	}
+
+	void SoundEffectManager::DetachVoice(SoundEffect& effect) {
+		if (effect.voice_ < 0) {
+			return;
+		}
+
+		Voice& voice = _voices[effect.voice_];
+		voice.sound->Stop();
+		voice.owner = nullptr;
+		voice.last_used = _frame;
+		effect.voice_ = -1;
+		effect.sound_handle_.reset();
+	}
+
 	void SoundEffectManager::Update(float delta_time) {
 		PROJECT_PROFILE_SCOPE("SoundEffectManager::Update");
+		glm::vec3 listener = _audio_manager ? _audio_manager->GetCurrentState().listener_pos : glm::vec3(0.0f);
+
 		std::lock_guard<std::mutex> lock(_mutex);
-		// Update positions and lifetimes
+		++_frame;
+
+		// Update positions, lifetimes and playback time; virtual effects age like audible ones
 		for (auto& effect : _effects) {
-			if (effect && effect->IsActive()) {
+			if (effect->IsActive()) {
 				// Update lifetime
 				float lifetime = effect->GetLifetime();
 				if (lifetime > 0.0f) {
@@ -65,10 +186,18 @@ namespace Boidsish {
 					}
 				}
 
+				effect->playback_time_ += delta_time;
+				if (!effect->loop_ && effect->playback_time_ >= effect->length_) {
+					effect->SetActive(false);
+				}
+
 				// Update position
 				glm::vec3 new_pos = effect->GetPosition() + effect->GetVelocity() * delta_time;
 				effect->SetPosition(new_pos);
 			}
+			if (!effect->IsActive()) {
+				DetachVoice(*effect);
+			}
 		}
 
 		// Remove inactive or finished effects
@@ -76,13 +205,46 @@ namespace Boidsish {
 			std::remove_if(
 				_effects.begin(),
 				_effects.end(),
-				[](const std::shared_ptr<SoundEffect>& effect) {
-					return !effect || !effect->IsActive() ||
-						(effect->GetSoundHandle() && effect->GetSoundHandle()->IsDone());
-				}
+				[](const std::shared_ptr<SoundEffect>& effect) { return !effect->IsActive(); }
 			),
 			_effects.end()
 		);
+
+		// Rank by priority, then audibility, and keep the top of the budget
+		_ranked.clear();
+		for (auto& effect : _effects) {
+			float audibility = Audibility(*effect, listener);
+			if (audibility > kInaudible) {
+				_ranked.emplace_back(audibility, effect.get());
+			}
+		}
+		if (_ranked.size() > _max_audible) {
+			auto more_audible = [](const auto& a, const auto& b) {
+				if (a.second->priority_ != b.second->priority_) {
+					return a.second->priority_ > b.second->priority_;
+				}
+				return a.first > b.first;
+			};
+			std::nth_element(_ranked.begin(), _ranked.begin() + _max_audible, _ranked.end(), more_audible);
+			_ranked.resize(_max_audible);
+		}
+		for (auto& [audibility, effect] : _ranked) {
+			effect->audible_frame_ = _frame;
+		}
+
+		// Release voices that dropped out before claiming new ones, so the pool never overcommits
+		for (auto& effect : _effects) {
+			if (effect->voice_ >= 0 && effect->audible_frame_ != _frame) {
+				DetachVoice(*effect);
+			}
+		}
+
+		_audible_count = 0;
+		for (auto& [audibility, effect] : _ranked) {
+			if (effect->voice_ >= 0 || AttachVoice(*effect)) {
+				++_audible_count;
+			}
+		}
 	}
 
 } // namespace Boidsish
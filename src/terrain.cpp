@@ -2,6 +2,7 @@
 
 #include "graphics.h"
 #include <GL/glew.h>
+#include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <shader.h>
@@ -11,26 +12,13 @@ namespace Boidsish {
 	std::shared_ptr<Shader> Terrain::terrain_shader_ = nullptr;
 	ShaderHandle            Terrain::terrain_shader_handle = ShaderHandle(0);
 
-	Terrain::Terrain(
-		const std::vector<unsigned int>& indices,
-		const std::vector<glm::vec3>&    vertices,
-		const std::vector<glm::vec3>&    normals,
-		const std::vector<glm::vec2>&    biomes,
-		const PatchProxy&                proxy,
-		std::vector<float>               packed_height_normal,
-		std::vector<uint8_t>             packed_biomes
-	):
-		indices_(indices),
-		vertices(vertices),
-		normals(normals),
-		biomes(biomes),
+	Terrain::Terrain(TerrainChunkData surface, const PatchProxy& proxy):
 		proxy(proxy),
-		packed_height_normal(std::move(packed_height_normal)),
-		packed_biomes(std::move(packed_biomes)),
+		surface(std::move(surface)),
 		vao_(0),
 		vbo_(0),
 		ebo_(0),
-		index_count_(indices.size()),
+		index_count_(4),
 		managed_by_render_manager_(false) {
 		// Constructor now only initializes member variables
 		// setupMesh() must be called explicitly to upload to GPU (legacy mode)
@@ -47,30 +35,48 @@ namespace Boidsish {
 	}
 
 	std::vector<float> Terrain::GetInterleavedVertexData() const {
+		const int          resolution = surface.GetResolution();
 		std::vector<float> data;
-		data.reserve(vertices.size() * 8);
-		for (size_t i = 0; i < vertices.size(); ++i) {
-			data.push_back(vertices[i].x);
-			data.push_back(vertices[i].y);
-			data.push_back(vertices[i].z);
-			data.push_back(normals[i].x);
-			data.push_back(normals[i].y);
-			data.push_back(normals[i].z);
-			// Dummy texture coordinates
-			data.push_back(0.0f);
-			data.push_back(0.0f);
+		data.reserve(static_cast<size_t>(resolution) * resolution * 8);
+		for (int x = 0; x < resolution; ++x) {
+			for (int z = 0; z < resolution; ++z) {
+				glm::vec3 position = surface.GetPosition(x, z);
+				glm::vec3 normal = surface.GetNormal(x, z);
+				data.push_back(position.x);
+				data.push_back(position.y);
+				data.push_back(position.z);
+				data.push_back(normal.x);
+				data.push_back(normal.y);
+				data.push_back(normal.z);
+				// Dummy texture coordinates
+				data.push_back(0.0f);
+				data.push_back(0.0f);
+			}
 		}
 		return data;
 	}
 
+	std::vector<unsigned int> Terrain::GetIndices() const {
+		// Corners (0,0), (chunk_size, 0), (chunk_size, chunk_size), (0, chunk_size) of the X-major grid
+		const unsigned int res = static_cast<unsigned int>(surface.GetResolution());
+		const unsigned int last = res > 0 ? res - 1 : 0;
+		return {0, last * res, last * res + last, last};
+	}
+
 	void Terrain::setupMesh() {
 		if (managed_by_render_manager_) {
 			// Skip legacy GPU setup when managed by render manager
 			return;
 		}
 
+		// Safety check for OpenGL context - skip setup if no context is available (e.g. in tests)
+		if (glfwGetCurrentContext() == nullptr) {
+			return;
+		}
+
 		// Generate interleaved vertex data for GPU upload
-		vertex_data_ = GetInterleavedVertexData();
+		std::vector<float>        vertex_data = GetInterleavedVertexData();
+		std::vector<unsigned int> indices = GetIndices();
 
 		glGenVertexArrays(1, &vao_);
 		glGenBuffers(1, &vbo_);
@@ -79,10 +85,10 @@ namespace Boidsish {
 		glBindVertexArray(vao_);
 
 		glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-		glBufferData(GL_ARRAY_BUFFER, vertex_data_.size() * sizeof(float), &vertex_data_[0], GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, vertex_data.size() * sizeof(float), vertex_data.data(), GL_STATIC_DRAW);
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices_.size() * sizeof(unsigned int), &indices_[0], GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
 
 		// Position attribute
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
@@ -95,10 +101,6 @@ namespace Boidsish {
 		glEnableVertexAttribArray(2);
 
 		glBindVertexArray(0);
-
-		// Clear interleaved data after uploading to GPU, but keep vertices and normals for physics
-		vertex_data_.clear();
-		indices_.clear();
 	}
 
 	void Terrain::render() const {
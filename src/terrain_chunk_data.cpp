@@ -0,0 +1,119 @@
+#include "terrain_chunk_data.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Boidsish {
+
+	namespace {
+		constexpr float kHeightLevels = 65535.0f;
+		constexpr float kNormalScale = 32767.0f;
+
+		uint32_t ToSnorm16(float v) {
+			auto q = static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * kNormalScale));
+			return static_cast<uint16_t>(q);
+		}
+
+		float FromSnorm16(uint32_t bits) {
+			return std::max(static_cast<int16_t>(bits & 0xffff) / kNormalScale, -1.0f);
+		}
+
+		float SignNotZero(float v) {
+			return v >= 0.0f ? 1.0f : -1.0f;
+		}
+	} // namespace
+
+	TerrainChunkData::TerrainChunkData(
+		int                        resolution,
+		float                      cell_size,
+		std::span<const float>     heights,
+		std::span<const glm::vec3> normals,
+		std::span<const glm::vec2> biomes
+	):
+		resolution_(resolution),
+		cell_size_(cell_size) {
+		const size_t count = static_cast<size_t>(resolution) * resolution;
+		if (resolution <= 0 || heights.size() < count || normals.size() < count || biomes.size() < count) {
+			resolution_ = 0;
+			return;
+		}
+
+		auto [lowest, highest] = std::minmax_element(heights.begin(), heights.begin() + count);
+		min_y_ = *lowest;
+		max_y_ = *highest;
+		height_step_ = (max_y_ - min_y_) / kHeightLevels;
+		const float inv_step = height_step_ > 0.0f ? 1.0f / height_step_ : 0.0f;
+
+		heights_.resize(count);
+		normals_.resize(count);
+		biomes_.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			float level = std::round((heights[i] - min_y_) * inv_step);
+			heights_[i] = static_cast<uint16_t>(std::clamp(level, 0.0f, kHeightLevels));
+			normals_[i] = EncodeNormal(normals[i]);
+
+			auto low = static_cast<uint16_t>(std::clamp(biomes[i].x, 0.0f, 255.0f));
+			auto weight = static_cast<uint16_t>(std::clamp(biomes[i].y, 0.0f, 1.0f) * 255.0f + 0.5f);
+			biomes_[i] = static_cast<uint16_t>(low | (weight << 8));
+		}
+	}
+
+	std::vector<float> TerrainChunkData::GetHeights() const {
+		std::vector<float> heights(heights_.size());
+		for (size_t i = 0; i < heights_.size(); ++i) {
+			heights[i] = min_y_ + heights_[i] * height_step_;
+		}
+		return heights;
+	}
+
+	void TerrainChunkData::Unpack(std::vector<float>& height_normal, std::vector<uint8_t>& biomes) const {
+		height_normal.resize(heights_.size() * 4);
+		biomes.resize(biomes_.size() * 4);
+
+		float*   texel = height_normal.data();
+		uint8_t* biome_texel = biomes.data();
+		for (int z = 0; z < resolution_; ++z) {
+			for (int x = 0; x < resolution_; ++x) {
+				size_t    src = Index(x, z);
+				glm::vec3 normal = DecodeNormal(normals_[src]);
+				*texel++ = min_y_ + heights_[src] * height_step_;
+				*texel++ = normal.x;
+				*texel++ = normal.y;
+				*texel++ = normal.z;
+
+				*biome_texel++ = static_cast<uint8_t>(biomes_[src] & 0xff);
+				*biome_texel++ = static_cast<uint8_t>(biomes_[src] >> 8);
+				*biome_texel++ = 0; // bake_flag
+				*biome_texel++ = 0; // unused
+			}
+		}
+	}
+
+	size_t TerrainChunkData::GetMemoryUsage() const {
+		return heights_.capacity() * sizeof(uint16_t) + normals_.capacity() * sizeof(uint32_t) +
+			biomes_.capacity() * sizeof(uint16_t);
+	}
+
+	uint32_t TerrainChunkData::EncodeNormal(const glm::vec3& normal) {
+		// Project onto the octahedron |x| + |y| + |z| = 1, then fold the lower half over the diagonals
+		float     l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+		glm::vec3 n = l1 > 0.0f ? normal / l1 : glm::vec3(0.0f, 1.0f, 0.0f);
+		glm::vec2 oct(n.x, n.z);
+		if (n.y < 0.0f) {
+			oct = glm::vec2((1.0f - std::abs(n.z)) * SignNotZero(n.x), (1.0f - std::abs(n.x)) * SignNotZero(n.z));
+		}
+		return ToSnorm16(oct.x) | (ToSnorm16(oct.y) << 16);
+	}
+
+	glm::vec3 TerrainChunkData::DecodeNormal(uint32_t encoded) {
+		glm::vec2 oct(FromSnorm16(encoded), FromSnorm16(encoded >> 16));
+		glm::vec3 n(oct.x, 1.0f - std::abs(oct.x) - std::abs(oct.y), oct.y);
+		if (n.y < 0.0f) {
+			float x = n.x;
+			n.x = (1.0f - std::abs(n.z)) * SignNotZero(x);
+			n.z = (1.0f - std::abs(x)) * SignNotZero(n.z);
+		}
+		return glm::normalize(n);
+	}
+
+} // namespace Boidsish
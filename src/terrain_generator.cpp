@@ -21,6 +21,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <libmorton/morton.h>
+#include <poolstl/poolstl.hpp>
 
 namespace Boidsish {
 	bool isChunkInFrustum(
@@ -237,14 +238,7 @@ namespace Boidsish {
 
 				render_manager_->RegisterChunk(
 					chunk.key,
-					chunk.terrain->vertices,
-					chunk.terrain->normals,
-					chunk.terrain->biomes,
-					chunk.terrain->packed_height_normal,
-					chunk.terrain->packed_biomes,
-					chunk.terrain->GetIndices(),
-					chunk.terrain->proxy.minY,
-					chunk.terrain->proxy.maxY,
+					chunk.terrain->surface,
 					glm::vec3(chunk.key.first * scaled_chunk_size, 0, chunk.key.second * scaled_chunk_size),
 					world_scale_
 				);
@@ -276,6 +270,7 @@ namespace Boidsish {
 				render_manager_->UnregisterChunk(key);
 			}
 			chunk_cache_.erase(key);
+			chunk_snapshot_dirty_ = true;
 		}
 
 		std::vector<std::pair<int, int>> to_cancel;
@@ -298,6 +293,9 @@ namespace Boidsish {
 
 		ProcessPendingDeformations();
 
+		// Everything streamed in, regenerated or evicted this frame becomes visible to readers at once
+		PublishChunkSnapshot();
+
 		// Commit any pending buffer updates to the render manager
 		if (render_manager_) {
 			render_manager_->CommitUpdates();
@@ -353,20 +351,14 @@ namespace Boidsish {
 					try {
 						auto&                   future = const_cast<TaskHandle<TerrainGenerationResult>&>(pair.second);
 						TerrainGenerationResult result = future.get();
-						auto                    terrain_chunk = std::make_shared<Terrain>(
-							result.indices,
-							result.positions,
-							result.normals,
-							result.biomes,
-							result.proxy,
-							std::move(result.packed_height_normal),
-							std::move(result.packed_biomes)
-						);
+						auto                    terrain_chunk =
+							std::make_shared<Terrain>(std::move(result.surface), result.proxy);
 						terrain_chunk->SetPosition(
 							result.chunk_x * scaled_chunk_size,
 							0,
 							result.chunk_z * scaled_chunk_size
 						);
+						terrain_chunk->height_pyramid = std::move(result.height_pyramid);
 
 						if (render_manager_) {
 							terrain_chunk->SetManagedByRenderManager(true);
@@ -375,6 +367,7 @@ namespace Boidsish {
 						}
 
 						chunk_cache_[pair.first] = terrain_chunk;
+						chunk_snapshot_dirty_ = true;
 						completed_chunks.push_back(pair.first);
 					} catch (...) {
 						completed_chunks.push_back(pair.first);
@@ -388,6 +381,17 @@ namespace Boidsish {
 		}
 	}
 
+	void TerrainGenerator::PublishChunkSnapshot() {
+		std::lock_guard<std::recursive_mutex> lock(chunk_cache_mutex_);
+		if (!chunk_snapshot_dirty_) {
+			return;
+		}
+
+		// Readers holding the previous table keep it, and its chunks, alive until they drop it
+		chunk_snapshot_.store(std::make_shared<const ChunkTable>(chunk_cache_), std::memory_order_release);
+		chunk_snapshot_dirty_ = false;
+	}
+
 	void TerrainGenerator::WaitForAllChunks(const Frustum& frustum, const Camera& camera) {
 		logger::LOG("TerrainGenerator: Waiting for all chunks to load...");
 		float scaled_chunk_size = static_cast<float>(chunk_size_) * world_scale_;
@@ -419,14 +423,7 @@ namespace Boidsish {
 				if (!render_manager_->HasChunk(key)) {
 					render_manager_->RegisterChunk(
 						key,
-						terrain_chunk->vertices,
-						terrain_chunk->normals,
-						terrain_chunk->biomes,
-						terrain_chunk->packed_height_normal,
-						terrain_chunk->packed_biomes,
-						terrain_chunk->GetIndices(),
-						terrain_chunk->proxy.minY,
-						terrain_chunk->proxy.maxY,
+						terrain_chunk->surface,
 						glm::vec3(key.first * scaled_chunk_size, 0, key.second * scaled_chunk_size),
 						world_scale_
 					);
@@ -506,6 +503,10 @@ namespace Boidsish {
 			}
 		}
 		chunk_cache_.clear();
+		chunk_snapshot_dirty_ = true;
+
+		// Chunks built at the old scale must not be sampled with the new one, so don't wait for Update
+		PublishChunkSnapshot();
 
 		// Also clear visible chunks to prevent rendering stale data
 		{
@@ -709,7 +710,6 @@ namespace Boidsish {
 		std::vector<glm::vec3>              positions;
 		std::vector<glm::vec3>              normals;
 		std::vector<glm::vec2>              biomes_flat;
-		std::vector<unsigned int>           indices;
 		bool                                has_terrain = false;
 
 		// Check if this chunk has any deformations
@@ -809,6 +809,8 @@ namespace Boidsish {
 
 
 		// Generate vertices and normals
+		std::vector<float> heights;
+		heights.reserve(num_vertices_x * num_vertices_z);
 		positions.reserve(num_vertices_x * num_vertices_z);
 		normals.reserve(num_vertices_x * num_vertices_z);
 		biomes_flat.reserve(num_vertices_x * num_vertices_z);
@@ -819,21 +821,13 @@ namespace Boidsish {
 				float dx = heightmap[i][j][1];
 				float dz = heightmap[i][j][2];
 
+				heights.push_back(y);
 				positions.emplace_back(i * world_scale_, y, j * world_scale_);
 				normals.push_back(diffToNorm(dx, dz));
 				biomes_flat.push_back(biome_map[i][j]);
 			}
 		}
 
-		// Generate indices for a single quad patch covering the whole chunk.
-		// The corners are at (0,0), (chunk_size, 0), (chunk_size, chunk_size), (0, chunk_size).
-		// This matches the simplified instanced geometry in TerrainRenderManager.
-		indices.reserve(4);
-		indices.push_back(0);                                          // (0,0)
-		indices.push_back(chunk_size_ * num_vertices_z);               // (chunk_size, 0)
-		indices.push_back(chunk_size_ * num_vertices_z + chunk_size_); // (chunk_size, chunk_size)
-		indices.push_back(chunk_size_);                                // (0, chunk_size)
-
 		// Calculate aggregate data for the PatchProxy
 		PatchProxy proxy;
 		proxy.center = std::accumulate(positions.begin(), positions.end(), glm::vec3(0.0f)) / (float)positions.size();
@@ -859,30 +853,11 @@ namespace Boidsish {
 		}
 		proxy.radiusSq = max_dist_sq;
 
-		// Pre-pack heightmap and biome data for the renderer (Z-major transposition)
-		const int res = chunk_size_ + 1;
-		std::vector<float>   packed_height_normal;
-		std::vector<uint8_t> packed_biomes;
-		packed_height_normal.reserve(res * res * 4);
-		packed_biomes.reserve(res * res * 4);
-
-		for (int z = 0; z < res; ++z) {
-			for (int x = 0; x < res; ++x) {
-				int src_idx = x * res + z; // X-major
-
-				packed_height_normal.push_back(positions[src_idx].y);
-				packed_height_normal.push_back(normals[src_idx].x);
-				packed_height_normal.push_back(normals[src_idx].y);
-				packed_height_normal.push_back(normals[src_idx].z);
-
-				packed_biomes.push_back(static_cast<uint8_t>(biomes_flat[src_idx].x));
-				packed_biomes.push_back(static_cast<uint8_t>(biomes_flat[src_idx].y * 255.0f + 0.5f));
-				packed_biomes.push_back(0); // bake_flag
-				packed_biomes.push_back(0); // unused
-			}
-		}
-
-		return {indices, positions, normals, biomes_flat, packed_height_normal, packed_biomes, proxy, chunkX, chunkZ, true};
+		// Quantize into the chunk's resident format; the float grids above are dropped with this frame.
+		// The pyramid is built from the quantized heights so it bounds exactly what queries interpolate.
+		TerrainChunkData     surface(num_vertices_x, world_scale_, heights, normals, biomes_flat);
+		TerrainHeightPyramid height_pyramid(surface.GetHeights(), chunk_size_);
+		return {std::move(surface), proxy, chunkX, chunkZ, true, std::move(height_pyramid)};
 	}
 
 	bool
@@ -1297,18 +1272,28 @@ namespace Boidsish {
 		int chunk_x = static_cast<int>(std::floor(x / scaled_chunk_size));
 		int chunk_z = static_cast<int>(std::floor(z / scaled_chunk_size));
 
-		std::lock_guard<std::recursive_mutex> lock(chunk_cache_mutex_);
-
-		auto it = chunk_cache_.find({chunk_x, chunk_z});
-		if (it == chunk_cache_.end() || !it->second) {
+		auto chunk = FindCachedChunk(chunk_x, chunk_z);
+		if (!chunk) {
 			return std::nullopt; // Chunk not cached
 		}
 
-		const auto& terrain = it->second;
-		const auto& vertices = terrain->vertices;
-		const auto& normals = terrain->normals;
+		return SampleCachedChunk(*chunk, chunk_x, chunk_z, x, z);
+	}
+
+	std::shared_ptr<Terrain> TerrainGenerator::FindCachedChunk(int chunk_x, int chunk_z) const {
+		auto snapshot = LoadChunkSnapshot();
+		auto it = snapshot->find({chunk_x, chunk_z});
+		return it != snapshot->end() ? it->second : nullptr;
+	}
+
+	std::optional<std::tuple<float, glm::vec3>>
+	TerrainGenerator::SampleCachedChunk(const Terrain& terrain, int chunk_x, int chunk_z, float x, float z) const {
+		float       scaled_chunk_size = static_cast<float>(chunk_size_) * world_scale_;
+		const auto& surface = terrain.surface;
 
-		if (vertices.empty()) {
+		// Terrain mesh is generated with world_scale_ spacing between vertices
+		// The chunk has (chunk_size_ + 1) vertices along each edge
+		if (surface.IsEmpty() || surface.GetResolution() != chunk_size_ + 1) {
 			return std::nullopt;
 		}
 
@@ -1318,10 +1303,6 @@ namespace Boidsish {
 		float local_x = x - chunk_origin_x;
 		float local_z = z - chunk_origin_z;
 
-		// Terrain mesh is generated with world_scale_ spacing between vertices
-		// The chunk has (chunk_size_ + 1) vertices along each edge
-		int grid_size = chunk_size_ + 1;
-
 		// Find the grid cell in vertex units [0, chunk_size]
 		int ix = static_cast<int>(std::floor(local_x / world_scale_));
 		int iz = static_cast<int>(std::floor(local_z / world_scale_));
@@ -1330,17 +1311,6 @@ namespace Boidsish {
 		ix = std::clamp(ix, 0, chunk_size_ - 1);
 		iz = std::clamp(iz, 0, chunk_size_ - 1);
 
-		// Get the 4 corner vertex indices
-		int idx00 = ix * grid_size + iz;
-		int idx10 = ix * grid_size + (iz + 1);
-		int idx01 = (ix + 1) * grid_size + iz;
-		int idx11 = (ix + 1) * grid_size + (iz + 1);
-
-		// Bounds check
-		if (idx11 >= static_cast<int>(vertices.size())) {
-			return std::nullopt;
-		}
-
 		// Bilinear interpolation factors
 		float fx = (local_x / world_scale_) - static_cast<float>(ix);
 		float fz = (local_z / world_scale_) - static_cast<float>(iz);
@@ -1348,19 +1318,19 @@ namespace Boidsish {
 		fz = std::clamp(fz, 0.0f, 1.0f);
 
 		// Interpolate position (we really just need height, Y component)
-		glm::vec3 v00 = vertices[idx00];
-		glm::vec3 v10 = vertices[idx10];
-		glm::vec3 v01 = vertices[idx01];
-		glm::vec3 v11 = vertices[idx11];
+		glm::vec3 v00 = surface.GetPosition(ix, iz);
+		glm::vec3 v10 = surface.GetPosition(ix, iz + 1);
+		glm::vec3 v01 = surface.GetPosition(ix + 1, iz);
+		glm::vec3 v11 = surface.GetPosition(ix + 1, iz + 1);
 
 		// The "flat" position from standard bilinear interpolation
 		glm::vec3 q = bilerp(v00, v10, v11, v01, {fx, fz});
 
 		// Interpolate normal
-		glm::vec3 n00 = normals[idx00];
-		glm::vec3 n10 = normals[idx10];
-		glm::vec3 n01 = normals[idx01];
-		glm::vec3 n11 = normals[idx11];
+		glm::vec3 n00 = surface.GetNormal(ix, iz);
+		glm::vec3 n10 = surface.GetNormal(ix, iz + 1);
+		glm::vec3 n01 = surface.GetNormal(ix + 1, iz);
+		glm::vec3 n11 = surface.GetNormal(ix + 1, iz + 1);
 
 		glm::vec3 interpolatedNormal = bilerp(n00, n10, n11, n01, {fx, fz});
 		interpolatedNormal = glm::normalize(interpolatedNormal);
@@ -1368,13 +1338,118 @@ namespace Boidsish {
 		return std::make_tuple(q.y, interpolatedNormal);
 	}
 
+	std::vector<TerrainGenerator::ChunkQueryGroup>
+	TerrainGenerator::GroupQueriesByChunk(std::span<const glm::vec2> positions, std::vector<uint32_t>& order) const {
+		float scaled_chunk_size = static_cast<float>(chunk_size_) * world_scale_;
+
+		// Sort by packed chunk key so each chunk's queries are contiguous
+		std::vector<std::pair<uint64_t, uint32_t>> keyed(positions.size());
+		for (size_t i = 0; i < positions.size(); ++i) {
+			int cx = static_cast<int>(std::floor(positions[i].x / scaled_chunk_size));
+			int cz = static_cast<int>(std::floor(positions[i].y / scaled_chunk_size));
+			keyed[i] = {(static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cz),
+			            static_cast<uint32_t>(i)};
+		}
+		std::sort(keyed.begin(), keyed.end());
+
+		order.resize(keyed.size());
+		std::vector<ChunkQueryGroup> groups;
+		for (size_t i = 0; i < keyed.size(); ++i) {
+			order[i] = keyed[i].second;
+			if (groups.empty() || keyed[i].first != keyed[i - 1].first) {
+				groups.push_back(
+					{static_cast<int>(static_cast<int32_t>(keyed[i].first >> 32)),
+				     static_cast<int>(static_cast<int32_t>(keyed[i].first & 0xffffffffu)),
+				     i,
+				     i,
+				     nullptr}
+				);
+			}
+			groups.back().end = i + 1;
+		}
+
+		// One snapshot for the whole batch; the shared_ptrs keep chunks alive if they are evicted meanwhile
+		auto snapshot = LoadChunkSnapshot();
+		for (auto& group : groups) {
+			auto it = snapshot->find({group.chunk_x, group.chunk_z});
+			if (it != snapshot->end()) {
+				group.terrain = it->second;
+			}
+		}
+		return groups;
+	}
+
+	void TerrainGenerator::GetTerrainPropertiesBatch(std::span<const glm::vec2> points, std::span<TerrainSample> out)
+		const {
+		PROJECT_PROFILE_SCOPE("TerrainGenerator::GetTerrainPropertiesBatch");
+		std::vector<uint32_t> order;
+		auto                  groups = GroupQueriesByChunk(points, order);
+
+		auto sample_group = [&](const ChunkQueryGroup& group) {
+			for (size_t i = group.begin; i < group.end; ++i) {
+				uint32_t                                    q = order[i];
+				std::optional<std::tuple<float, glm::vec3>> cached;
+				if (group.terrain) {
+					cached = SampleCachedChunk(*group.terrain, group.chunk_x, group.chunk_z, points[q].x, points[q].y);
+				}
+				auto [height, normal] = cached.has_value() ? cached.value()
+														   : CalculateTerrainPropertiesAtPoint(points[q].x, points[q].y);
+				out[q] = {height, normal};
+			}
+		};
+		if (InPoolTask()) {
+			std::for_each(groups.begin(), groups.end(), sample_group);
+		} else {
+			std::for_each(poolstl::par.on(pool), groups.begin(), groups.end(), sample_group);
+		}
+	}
+
+	void TerrainGenerator::GetDistanceAboveTerrainBatch(std::span<const glm::vec3> points, std::span<float> out) const {
+		std::vector<glm::vec2> xz(points.size());
+		for (size_t i = 0; i < points.size(); ++i) {
+			xz[i] = glm::vec2(points[i].x, points[i].z);
+		}
+
+		std::vector<TerrainSample> samples(points.size());
+		GetTerrainPropertiesBatch(xz, samples);
+		for (size_t i = 0; i < points.size(); ++i) {
+			out[i] = points[i].y - samples[i].height;
+		}
+	}
+
+	void TerrainGenerator::RaycastBatch(std::span<const TerrainRay> rays, std::span<TerrainRayHit> out) const {
+		PROJECT_PROFILE_SCOPE("TerrainGenerator::RaycastBatch");
+		std::vector<glm::vec2> origins(rays.size());
+		for (size_t i = 0; i < rays.size(); ++i) {
+			origins[i] = glm::vec2(rays[i].origin.x, rays[i].origin.z);
+		}
+
+		// Rays leave their starting chunk, so the grouping is for locality and load balance;
+		// RaycastCached still resolves each chunk it crosses.
+		std::vector<uint32_t> order;
+		auto                  groups = GroupQueriesByChunk(origins, order);
+
+		auto cast_group = [&](const ChunkQueryGroup& group) {
+			for (size_t i = group.begin; i < group.end; ++i) {
+				const TerrainRay& ray = rays[order[i]];
+				TerrainRayHit&    hit = out[order[i]];
+				hit.hit = RaycastCached(ray.origin, ray.direction, ray.max_distance, hit.distance, hit.normal);
+			}
+		};
+		if (InPoolTask()) {
+			std::for_each(groups.begin(), groups.end(), cast_group);
+		} else {
+			std::for_each(poolstl::par.on(pool), groups.begin(), groups.end(), cast_group);
+		}
+	}
+
 	bool TerrainGenerator::IsPositionCached(float x, float z) const {
 		float scaled_chunk_size = static_cast<float>(chunk_size_) * world_scale_;
 		int   chunk_x = static_cast<int>(std::floor(x / scaled_chunk_size));
 		int   chunk_z = static_cast<int>(std::floor(z / scaled_chunk_size));
 
-		std::lock_guard<std::recursive_mutex> lock(chunk_cache_mutex_);
-		return chunk_cache_.find({chunk_x, chunk_z}) != chunk_cache_.end();
+		auto snapshot = LoadChunkSnapshot();
+		return snapshot->find({chunk_x, chunk_z}) != snapshot->end();
 	}
 
 	std::tuple<float, glm::vec3> TerrainGenerator::GetTerrainPropertiesAtPoint(float x, float z) const {
@@ -1434,40 +1509,62 @@ namespace Boidsish {
 	) const {
 		// Use smaller step size for more precision, adaptive based on terrain scale
 		float     step_size = 0.5f * world_scale_;
-		float     current_dist = 0.0f;
+		float     scaled_chunk_size = static_cast<float>(chunk_size_) * world_scale_;
 		glm::vec3 dir = glm::normalize(direction);
 
-		// Track if we're using cached data or not
-		bool all_cached = true;
-
-		// Ray marching with cache-preferring height queries
-		glm::vec3 prev_pos = origin;
-		float     prev_height = 0.0f;
-		bool      prev_valid = false;
+		auto properties_at = [this](const glm::vec3& pos) {
+			auto cached = InterpolateFromCachedChunk(pos.x, pos.z);
+			return cached.has_value() ? cached.value() : CalculateTerrainPropertiesAtPoint(pos.x, pos.z);
+		};
 
-		while (current_dist < max_distance) {
-			glm::vec3 current_pos = origin + dir * current_dist;
+		// The chunk under the ray is looked up once per chunk crossed rather than once per step
+		std::shared_ptr<Terrain> chunk;
+		int                      chunk_x = 0, chunk_z = 0;
+		bool                     chunk_known = false;
 
-			// Try to get height from cache
-			auto cached = InterpolateFromCachedChunk(current_pos.x, current_pos.z);
+		// Samples stay on the same k * step_size grid as a plain march, so the height pyramid only
+		// removes samples that could not have hit and the result is unchanged.
+		for (int step = 0;; ++step) {
+			float current_dist = static_cast<float>(step) * step_size;
+			if (current_dist >= max_distance)
+				break;
 
-			float     terrain_height;
-			glm::vec3 surface_normal;
+			glm::vec3 current_pos = origin + dir * current_dist;
+			int       cx = static_cast<int>(std::floor(current_pos.x / scaled_chunk_size));
+			int       cz = static_cast<int>(std::floor(current_pos.z / scaled_chunk_size));
+			if (!chunk_known || cx != chunk_x || cz != chunk_z) {
+				chunk = FindCachedChunk(cx, cz);
+				chunk_x = cx;
+				chunk_z = cz;
+				chunk_known = true;
+			}
 
-			if (cached.has_value()) {
-				std::tie(terrain_height, surface_normal) = cached.value();
-			} else {
-				// Fall back to procedural - note we're no longer fully cached
-				all_cached = false;
-				std::tie(terrain_height, surface_normal) = CalculateTerrainPropertiesAtPoint(
-					current_pos.x,
-					current_pos.z
-				);
+			std::optional<std::tuple<float, glm::vec3>> cached;
+			if (chunk) {
+				if (!chunk->height_pyramid.IsEmpty()) {
+					glm::vec3 chunk_origin(cx * scaled_chunk_size, 0.0f, cz * scaled_chunk_size);
+					float     clear_until =
+						chunk->height_pyramid.Skip(origin - chunk_origin, dir, current_dist, max_distance, world_scale_);
+					int next_step = static_cast<int>(std::ceil(clear_until / step_size));
+					if (static_cast<float>(next_step - 1) * step_size >= clear_until) {
+						--next_step; // Rounding in the division must not drop a sample that was not cleared
+					}
+					if (next_step > step) {
+						step = next_step - 1;
+						continue;
+					}
+				}
+				cached = SampleCachedChunk(*chunk, cx, cz, current_pos.x, current_pos.z);
 			}
 
+			float terrain_height = cached.has_value()
+				? std::get<0>(cached.value())
+				: std::get<0>(CalculateTerrainPropertiesAtPoint(current_pos.x, current_pos.z));
+
 			if (current_pos.y < terrain_height) {
-				// We found an intersection - refine with binary search
-				float start_dist = prev_valid ? (current_dist - step_size) : 0.0f;
+				// We found an intersection - refine with binary search. Any skipped previous
+				// sample was above the terrain, just like a marched one.
+				float start_dist = step > 0 ? (current_dist - step_size) : 0.0f;
 				float end_dist = current_dist;
 
 				constexpr int binary_search_steps = 8;
@@ -1475,15 +1572,7 @@ namespace Boidsish {
 					float     mid_dist = (start_dist + end_dist) * 0.5f;
 					glm::vec3 mid_pos = origin + dir * mid_dist;
 
-					auto  mid_cached = InterpolateFromCachedChunk(mid_pos.x, mid_pos.z);
-					float mid_height;
-					if (mid_cached.has_value()) {
-						mid_height = std::get<0>(mid_cached.value());
-					} else {
-						mid_height = std::get<0>(CalculateTerrainPropertiesAtPoint(mid_pos.x, mid_pos.z));
-					}
-
-					if (mid_pos.y < mid_height) {
+					if (mid_pos.y < std::get<0>(properties_at(mid_pos))) {
 						end_dist = mid_dist;
 					} else {
 						start_dist = mid_dist;
@@ -1493,21 +1582,9 @@ namespace Boidsish {
 				out_distance = (start_dist + end_dist) * 0.5f;
 
 				// Get the normal at the hit point
-				glm::vec3 hit_pos = origin + dir * out_distance;
-				auto      hit_cached = InterpolateFromCachedChunk(hit_pos.x, hit_pos.z);
-				if (hit_cached.has_value()) {
-					out_normal = std::get<1>(hit_cached.value());
-				} else {
-					out_normal = std::get<1>(CalculateTerrainPropertiesAtPoint(hit_pos.x, hit_pos.z));
-				}
-
+				out_normal = std::get<1>(properties_at(origin + dir * out_distance));
 				return true;
 			}
-
-			prev_pos = current_pos;
-			prev_height = terrain_height;
-			prev_valid = true;
-			current_dist += step_size;
 		}
 
 		return false; // No hit
@@ -1624,33 +1701,20 @@ namespace Boidsish {
 				if (pair.second.is_ready()) {
 					try {
 						TerrainGenerationResult result = pair.second.get();
-						auto                    new_terrain = std::make_shared<Terrain>(
-							result.indices,
-							result.positions,
-							result.normals,
-							result.biomes,
-							result.proxy,
-							std::move(result.packed_height_normal),
-							std::move(result.packed_biomes)
-						);
+						auto                    new_terrain =
+							std::make_shared<Terrain>(std::move(result.surface), result.proxy);
 						new_terrain->SetPosition(
 							result.chunk_x * scaled_chunk_size,
 							0,
 							result.chunk_z * scaled_chunk_size
 						);
+						new_terrain->height_pyramid = std::move(result.height_pyramid);
 
 						if (render_manager_) {
 							new_terrain->SetManagedByRenderManager(true);
 							render_manager_->RegisterChunk(
 								pair.first,
-								new_terrain->vertices,
-								new_terrain->normals,
-								new_terrain->biomes,
-								new_terrain->packed_height_normal,
-								new_terrain->packed_biomes,
-								new_terrain->GetIndices(),
-								new_terrain->proxy.minY,
-								new_terrain->proxy.maxY,
+								new_terrain->surface,
 								glm::vec3(result.chunk_x * scaled_chunk_size, 0, result.chunk_z * scaled_chunk_size),
 								world_scale_
 							);
@@ -1658,6 +1722,7 @@ namespace Boidsish {
 							new_terrain->setupMesh();
 						}
 						chunk_cache_[pair.first] = new_terrain;
+						chunk_snapshot_dirty_ = true;
 						completed_keys.push_back(pair.first);
 						any_completed = true;
 					} catch (...) {
@@ -0,0 +1,114 @@
+#include "terrain_height_pyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Boidsish {
+
+	TerrainHeightPyramid::TerrainHeightPyramid(const std::vector<glm::vec3>& vertices, int cells) {
+		std::vector<float> heights(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			heights[i] = vertices[i].y;
+		}
+		*this = TerrainHeightPyramid(heights, cells);
+	}
+
+	TerrainHeightPyramid::TerrainHeightPyramid(const std::vector<float>& heights, int cells) {
+		const int grid_size = cells + 1;
+		if (cells <= 0 || heights.size() < static_cast<size_t>(grid_size) * grid_size) {
+			return;
+		}
+		cells_ = cells;
+
+		for (int size = cells;; size = (size + 1) / 2) {
+			level_offsets_.push_back(heights_.size());
+			level_sizes_.push_back(size);
+			heights_.resize(heights_.size() + static_cast<size_t>(size) * size);
+			if (size == 1)
+				break;
+		}
+
+		for (int x = 0; x < cells; ++x) {
+			for (int z = 0; z < cells; ++z) {
+				float h00 = heights[x * grid_size + z];
+				float h01 = heights[x * grid_size + z + 1];
+				float h10 = heights[(x + 1) * grid_size + z];
+				float h11 = heights[(x + 1) * grid_size + z + 1];
+				heights_[static_cast<size_t>(x) * cells + z] = std::max({h00, h01, h10, h11});
+			}
+		}
+
+		for (int level = 1; level < GetLevelCount(); ++level) {
+			const int below = level_sizes_[level - 1];
+			const int size = level_sizes_[level];
+			for (int x = 0; x < size; ++x) {
+				for (int z = 0; z < size; ++z) {
+					// Odd sizes leave the last node with a single child along that axis
+					int   x1 = std::min(2 * x + 1, below - 1);
+					int   z1 = std::min(2 * z + 1, below - 1);
+					float h = std::max(
+						{GetMaxHeight(level - 1, 2 * x, 2 * z),
+					     GetMaxHeight(level - 1, x1, 2 * z),
+					     GetMaxHeight(level - 1, 2 * x, z1),
+					     GetMaxHeight(level - 1, x1, z1)}
+					);
+					heights_[level_offsets_[level] + static_cast<size_t>(x) * size + z] = h;
+				}
+			}
+		}
+	}
+
+	float TerrainHeightPyramid::Skip(
+		const glm::vec3& origin,
+		const glm::vec3& dir,
+		float            t,
+		float            t_end,
+		float            cell_size
+	) const {
+		if (IsEmpty()) {
+			return t;
+		}
+
+		const float inf = std::numeric_limits<float>::infinity();
+		const float inv_x = dir.x != 0.0f ? 1.0f / dir.x : inf;
+		const float inv_z = dir.z != 0.0f ? 1.0f / dir.z : inf;
+
+		while (t < t_end) {
+			glm::vec3 p = origin + dir * t;
+			int       cx = std::clamp(static_cast<int>(std::floor(p.x / cell_size)), 0, cells_ - 1);
+			int       cz = std::clamp(static_cast<int>(std::floor(p.z / cell_size)), 0, cells_ - 1);
+
+			float next = t;
+			for (int level = GetLevelCount() - 1; level >= 0; --level) {
+				int nx = cx >> level;
+				int nz = cz >> level;
+
+				// Distance at which the ray leaves this node's footprint
+				float span = static_cast<float>(1 << level) * cell_size;
+				float x_edge = dir.x > 0.0f ? std::min((nx + 1) * span, cells_ * cell_size) : nx * span;
+				float z_edge = dir.z > 0.0f ? std::min((nz + 1) * span, cells_ * cell_size) : nz * span;
+				float exit = t_end;
+				if (dir.x != 0.0f)
+					exit = std::min(exit, (x_edge - origin.x) * inv_x);
+				if (dir.z != 0.0f)
+					exit = std::min(exit, (z_edge - origin.z) * inv_z);
+
+				// The ray is linear, so its lowest point over the node is at an end of the segment
+				float lowest = std::min(p.y, origin.y + dir.y * exit);
+				if (lowest > GetMaxHeight(level, nx, nz)) {
+					next = exit;
+					break;
+				}
+			}
+
+			// Either the finest cell may be hit, or rounding put us on a node edge we cannot leave
+			if (next <= t) {
+				return t;
+			}
+			t = next;
+		}
+		return t_end;
+	}
+
+} // namespace Boidsish
@@ -399,11 +399,9 @@ namespace Boidsish {
 		reg.PublishTexture(Constants::TextureUnit::TerrainHeightmap(), heightmap_texture_, GL_TEXTURE_2D_ARRAY);
 	}
 
-	void TerrainRenderManager::UploadHeightmapSlice(
-		int                        slice,
-		const std::vector<float>&  packed_height_normal,
-		const std::vector<uint8_t>& packed_biomes
-	) {
+	void TerrainRenderManager::UploadHeightmapSlice(int slice, const TerrainChunkData& surface) {
+		surface.Unpack(upload_height_normal_, upload_biomes_);
+
 		glBindTexture(GL_TEXTURE_2D_ARRAY, raw_heightmap_texture_);
 		glTexSubImage3D(
 			GL_TEXTURE_2D_ARRAY,
@@ -416,7 +414,7 @@ namespace Boidsish {
 			1,                     // depth (one slice)
 			GL_RGBA,
 			GL_FLOAT,
-			packed_height_normal.data()
+			upload_height_normal_.data()
 		);
 
 		// Also upload to heightmap_texture_ as a fallback until baking is complete
@@ -432,7 +430,7 @@ namespace Boidsish {
 			1,
 			GL_RGBA,
 			GL_FLOAT,
-			packed_height_normal.data()
+			upload_height_normal_.data()
 		);
 
 		glBindTexture(GL_TEXTURE_2D_ARRAY, biome_texture_);
@@ -447,25 +445,22 @@ namespace Boidsish {
 			1,
 			GL_RGBA,
 			GL_UNSIGNED_BYTE,
-			packed_biomes.data()
+			upload_biomes_.data()
 		);
 
 		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 	}
 
 	void TerrainRenderManager::RegisterChunk(
-		std::pair<int, int>              chunk_key,
-		const std::vector<glm::vec3>&    positions,
-		const std::vector<glm::vec3>&    normals,
-		const std::vector<glm::vec2>&    biomes,
-		const std::vector<float>&        packed_height_normal,
-		const std::vector<uint8_t>&      packed_biomes,
-		const std::vector<unsigned int>& indices, // Not used in this implementation
-		float                            min_y,
-		float                            max_y,
-		const glm::vec3&                 world_offset,
-		float                            world_scale
+		std::pair<int, int>     chunk_key,
+		const TerrainChunkData& surface,
+		const glm::vec3&        world_offset,
+		float                   world_scale
 	) {
+		if (surface.IsEmpty() || surface.GetResolution() != heightmap_resolution_) {
+			return;
+		}
+
 		// Deferred eviction callback to avoid deadlock
 		// (caller may hold terrain generator's mutex, and callback needs that mutex)
 		bool                should_notify_eviction = false;
@@ -482,9 +477,9 @@ namespace Boidsish {
 			auto it = chunks_.find(chunk_key);
 			if (it != chunks_.end()) {
 				// Update existing chunk's heightmap
-				UploadHeightmapSlice(it->second.texture_slice, packed_height_normal, packed_biomes);
-				it->second.min_y = min_y;
-				it->second.max_y = max_y;
+				UploadHeightmapSlice(it->second.texture_slice, surface);
+				it->second.min_y = surface.GetMinY();
+				it->second.max_y = surface.GetMaxY();
 				it->second.update_count++;
 				grid_dirty_ = true;
 		needs_prep_ = true;
@@ -554,7 +549,7 @@ namespace Boidsish {
 			}
 
 			// Upload heightmap data
-			UploadHeightmapSlice(slice, packed_height_normal, packed_biomes);
+			UploadHeightmapSlice(slice, surface);
 
 			// Queue for baking
 			bake_queue_.push_back({glm::ivec2(chunk_key.first, chunk_key.second), slice, 0});
@@ -562,8 +557,8 @@ namespace Boidsish {
 			// Store chunk info
 			ChunkInfo info{};
 			info.texture_slice = slice;
-			info.min_y = min_y;
-			info.max_y = max_y;
+			info.min_y = surface.GetMinY();
+			info.max_y = surface.GetMaxY();
 			info.world_offset = glm::vec2(world_offset.x, world_offset.z);
 
 			chunks_[chunk_key] = info;
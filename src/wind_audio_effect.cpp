@@ -8,17 +8,10 @@ namespace Boidsish {
 	WindAudioEffect::WindAudioEffect(AudioManager& audioManager)
 		: ProceduralAudioSource(2, 48000),
 		  m_audioManager(audioManager),
-		  m_xorshiftState(123456789) {
+		  m_noise(123456789) {
 	}
 
-	float WindAudioEffect::NextWhiteNoise() {
-		m_xorshiftState ^= m_xorshiftState << 13;
-		m_xorshiftState ^= m_xorshiftState >> 17;
-		m_xorshiftState ^= m_xorshiftState << 5;
-		return (static_cast<float>(m_xorshiftState) / static_cast<float>(0xFFFFFFFF)) * 2.0f - 1.0f;
-	}
-
-	void WindAudioEffect::OnRead(float* pOutput, ma_uint64 frameCount) {
+	ma_uint32 WindAudioEffect::OnRenderBlock(float* const* pPlanes, ma_uint32 frameCount) {
 		// SVF coefficients from https://www.cytomic.com/files/dsp/SvfLinearTrapOptimised2.pdf
 		// simplified for real-time wind
 		float f = m_freq.load(std::memory_order_relaxed);
@@ -28,21 +21,12 @@ namespace Boidsish {
 		// Pre-calculate dampening from resonance
 		float damping = 1.0f / (res + 0.001f);
 
-		for (ma_uint64 i = 0; i < frameCount; ++i) {
-			float input = NextWhiteNoise();
-
-			// SVF Step
-			m_low = m_low + f * m_band;
-			float high = input - m_low - damping * m_band;
-			m_band = m_band + f * high;
-
-			// Use bandpass for a more "whistling" wind effect
-			float sample = m_band * gain;
-
-			for (ma_uint32 c = 0; c < m_channels; ++c) {
-				pOutput[i * m_channels + c] = sample;
-			}
-		}
+		// Use bandpass for a more "whistling" wind effect
+		float* out = pPlanes[0];
+		m_noise.Fill(out, nullptr, frameCount);
+		m_filter.Bandpass(out, out, frameCount, f, damping);
+		dsp::Scale(out, frameCount, gain);
+		return 1;
 	}
 
 	void WindAudioEffect::OnUpdate(float deltaTime, const AudioState& state) {
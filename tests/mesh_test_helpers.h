@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "geometry.h"
+#include <glm/glm.hpp>
+
+// UV sphere of unit radius, for tests that need a closed, evenly tessellated mesh
+inline void
+MakeSphere(int rings, int segments, std::vector<Boidsish::Vertex>& vertices, std::vector<unsigned int>& indices) {
+    for (int r = 0; r <= rings; ++r) {
+        float phi = 3.14159265f * r / rings;
+        for (int s = 0; s <= segments; ++s) {
+            float     theta = 2.0f * 3.14159265f * s / segments;
+            glm::vec3 p(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+            vertices.push_back({p, p, glm::vec2(float(s) / segments, float(r) / rings)});
+        }
+    }
+    for (int r = 0; r < rings; ++r) {
+        for (int s = 0; s < segments; ++s) {
+            unsigned int a = r * (segments + 1) + s;
+            unsigned int b = a + segments + 1;
+            // Counter-clockwise seen from outside
+            if (r != 0)
+                indices.insert(indices.end(), {a, a + 1, b});
+            if (r != rings - 1)
+                indices.insert(indices.end(), {a + 1, b + 1, b});
+        }
+    }
+}
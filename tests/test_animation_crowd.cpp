@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "animation_crowd.h"
+#include "animator.h"
+#include "model.h"
+#include "procedural_walking_creature.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Boidsish;
+
+namespace {
+    // A chain of bones, each with position and rotation tracks. Consecutive rotation keys
+    // swing by up to ~150 degrees and sometimes flip hemisphere to cover the slerp edge cases.
+    std::shared_ptr<ModelData> MakeChainModel(int bone_count, int key_count, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        auto data = std::make_shared<ModelData>();
+        std::string parent;
+        for (int b = 0; b < bone_count; ++b) {
+            std::string name = "bone" + std::to_string(b);
+            data->AddBone(name, parent, glm::translate(glm::mat4(1.0f), glm::vec3(0, 1, 0)));
+            parent = name;
+        }
+
+        for (int a = 0; a < 2; ++a) {
+            Animation anim;
+            anim.name = "anim" + std::to_string(a);
+            anim.duration = float(key_count);
+            anim.ticksPerSecond = 10;
+            for (int b = 0; b < bone_count; b += 1 + a) {
+                BoneAnimation track;
+                track.name = "bone" + std::to_string(b);
+                glm::vec3 axis = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0, 0, 2));
+                for (int k = 0; k < key_count; ++k) {
+                    float t = float(k);
+                    track.positions.push_back({glm::vec3(unit(rng), 1.0f + unit(rng), unit(rng)), t});
+                    glm::quat q = glm::angleAxis(unit(rng) * 2.6f, axis);
+                    track.rotations.push_back({(k % 3 == 2) ? -q : q, t});
+                    track.scales.push_back({glm::vec3(1.0f + 0.25f * unit(rng)), t});
+                }
+                track.numPositions = key_count;
+                track.numRotations = key_count;
+                track.numScalings = (b % 3 == 0) ? 1 : key_count;
+                anim.boneAnimations.push_back(track);
+            }
+            data->animations.push_back(anim);
+        }
+        return data;
+    }
+
+    void ExpectMatricesNear(const glm::mat4& a, const glm::mat4& b, float tolerance, const std::string& what) {
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                // Relative for translations far down the chain
+                float scale = std::max(1.0f, std::abs(b[c][r]));
+                ASSERT_NEAR(a[c][r], b[c][r], tolerance * scale) << what << " [" << c << "][" << r << "]";
+            }
+        }
+    }
+}
+
+TEST(AnimationCrowdTest, MatchesIndividualAnimators) {
+    task_thread_pool::task_thread_pool pool;
+    AnimationCrowd                     crowd(pool);
+
+    std::vector<std::shared_ptr<ModelData>> models = {MakeChainModel(12, 9, 1), MakeChainModel(5, 4, 2)};
+    std::vector<std::unique_ptr<Animator>>  batched, reference;
+
+    for (int i = 0; i < 150; ++i) {
+        auto data = models[i % 2];
+        for (auto* list : {&batched, &reference}) {
+            auto animator = std::make_unique<Animator>(data);
+            if (i % 7 != 0) {
+                animator->PlayAnimation((i / 2) % 2);
+            }
+            animator->UpdateAnimation(0.013f * i); // Stagger phases
+            if (i % 5 == 0) {
+                animator->SetBoneLocalTransform("bone2", glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, 0, 0)));
+            }
+            list->push_back(std::move(animator));
+        }
+        crowd.Add(batched.back().get());
+    }
+
+    for (int step = 0; step < 40; ++step) {
+        float dt = 0.021f + 0.01f * (step % 4);
+        crowd.Update(dt);
+        for (auto& animator : reference) {
+            animator->UpdateAnimation(dt);
+        }
+
+        EXPECT_EQ(crowd.GetLastStats().evaluated, batched.size());
+        for (size_t i = 0; i < batched.size(); ++i) {
+            const auto& got = batched[i]->GetFinalBoneMatrices();
+            const auto& want = reference[i]->GetFinalBoneMatrices();
+            ASSERT_EQ(got.size(), want.size());
+            for (size_t b = 0; b < 12; ++b) {
+                ExpectMatricesNear(got[b], want[b], 1e-4f, "step " + std::to_string(step) + " animator " +
+                                                                std::to_string(i) + " bone " + std::to_string(b));
+            }
+            EXPECT_FLOAT_EQ(batched[i]->GetCurrentTime(), reference[i]->GetCurrentTime());
+        }
+    }
+}
+
+TEST(AnimationCrowdTest, LodThrottlesDistantMembers) {
+    task_thread_pool::task_thread_pool pool;
+    AnimationCrowd                     crowd(pool);
+    auto                               data = MakeChainModel(4, 6, 3);
+
+    Animator near_animator(data), far_animator(data), reference(data);
+    for (Animator* a : {&near_animator, &far_animator, &reference}) {
+        a->PlayAnimation(0);
+    }
+    crowd.Add(&near_animator, glm::vec3(5, 0, 0));
+    auto far = crowd.Add(&far_animator, glm::vec3(1000, 0, 0));
+
+    AnimationLodSettings lod;
+    lod.enabled = true;
+    lod.min_update_rate = 4.0f; // Farthest members update every 0.25s
+    crowd.SetLodSettings(lod);
+
+    const float dt = 1.0f / 60.0f;
+    int         far_updates = 0;
+    for (int frame = 0; frame < 60; ++frame) {
+        float before = far_animator.GetCurrentTime();
+        crowd.Update(dt);
+        reference.UpdateAnimation(dt);
+        far_updates += far_animator.GetCurrentTime() != before;
+        EXPECT_FLOAT_EQ(near_animator.GetCurrentTime(), reference.GetCurrentTime());
+    }
+    EXPECT_GE(far_updates, 3);
+    EXPECT_LE(far_updates, 5);
+    EXPECT_GT(crowd.GetLastStats().skipped_by_lod + crowd.GetLastStats().evaluated, 0u);
+
+    // Throttled time is only deferred, never lost
+    crowd.SetPosition(far, glm::vec3(0.0f));
+    crowd.Update(0.0f);
+    EXPECT_NEAR(far_animator.GetCurrentTime(), reference.GetCurrentTime(), 1e-3f);
+}
+
+TEST(AnimationCrowdTest, WalkingCreaturesMatchIndividualUpdates) {
+    task_thread_pool::task_thread_pool pool;
+    AnimationCrowd                     crowd(pool);
+
+    std::vector<std::unique_ptr<ProceduralWalkingCreature>> crowded, reference;
+    for (int i = 0; i < 6; ++i) {
+        for (auto* list : {&crowded, &reference}) {
+            list->push_back(std::make_unique<ProceduralWalkingCreature>(i, i * 12.0f, 0.0f, 0.0f, 4.0f));
+            list->back()->SetTarget(glm::vec3(i * 12.0f + 10.0f, 0.0f, 10.0f - i * 3.0f));
+        }
+        crowded.back()->SetAnimationCrowd(&crowd);
+    }
+    EXPECT_EQ(crowd.Size(), crowded.size());
+
+    RenderContext context;
+    for (int frame = 0; frame < 30; ++frame) {
+        for (size_t i = 0; i < crowded.size(); ++i) {
+            crowded[i]->Update(0.016f);
+            reference[i]->Update(0.016f);
+        }
+        crowd.Update(0.016f);
+        EXPECT_EQ(crowd.GetLastStats().evaluated, crowded.size());
+
+        for (size_t i = 0; i < crowded.size(); ++i) {
+            std::vector<RenderPacket> got, want;
+            crowded[i]->GenerateRenderPackets(got, context);
+            reference[i]->GenerateRenderPackets(want, context);
+            ASSERT_EQ(got.size(), want.size());
+            for (size_t p = 0; p < got.size(); ++p) {
+                ASSERT_EQ(got[p].bone_matrices.size(), want[p].bone_matrices.size());
+                std::string what = "frame " + std::to_string(frame) + " creature " + std::to_string(i);
+                for (size_t b = 0; b < got[p].bone_matrices.size(); ++b) {
+                    ExpectMatricesNear(got[p].bone_matrices[b], want[p].bone_matrices[b], 1e-4f, what);
+                }
+            }
+        }
+    }
+
+    // Leaving the crowd hands evaluation back to Update()
+    crowded[0]->SetAnimationCrowd(nullptr);
+    EXPECT_EQ(crowd.Size(), crowded.size() - 1);
+    crowded.pop_back();
+    crowd.Update(0.016f);
+    EXPECT_EQ(crowd.Size(), crowded.size() - 1);
+}
+
+TEST(AnimationCrowdBenchmark, BonesPerSecond) {
+    const int bone_count = 60;
+    const int instance_count = 1000;
+    const int frames = 20;
+    auto      data = MakeChainModel(bone_count, 30, 4);
+
+    std::vector<std::unique_ptr<Animator>> animators;
+    for (int i = 0; i < instance_count; ++i) {
+        auto animator = std::make_unique<Animator>(data);
+        animator->PlayAnimation(i % 2);
+        animator->UpdateAnimation(0.0037f * i);
+        animators.push_back(std::move(animator));
+    }
+
+    auto bones_per_sec = [&](auto&& body) {
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; ++f) {
+            body();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return double(frames) * instance_count * (bone_count + 1) / seconds;
+    };
+
+    double serial = bones_per_sec([&] {
+        for (auto& animator : animators) {
+            animator->UpdateAnimation(1.0f / 60.0f);
+        }
+    });
+
+    task_thread_pool::task_thread_pool pool;
+    AnimationCrowd                     crowd(pool);
+    for (auto& animator : animators) {
+        crowd.Add(animator.get());
+    }
+    double batched = bones_per_sec([&] { crowd.Update(1.0f / 60.0f); });
+
+    std::cout << "[ BENCH    ] " << instance_count << " animators x " << bone_count
+              << " bones: serial " << serial / 1e6 << " M bones/s, crowd " << batched / 1e6 << " M bones/s ("
+              << pool.get_num_threads() << " threads)" << std::endl;
+    EXPECT_EQ(crowd.GetLastStats().evaluated, size_t(instance_count));
+}
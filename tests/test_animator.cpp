@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "animator.h"
+#include "model.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Boidsish;
+
+namespace {
+    // root -> arm -> hand, with a 4-key translation track on "arm"
+    std::shared_ptr<ModelData> MakeArmModel() {
+        auto data = std::make_shared<ModelData>();
+        data->AddBone("root", "", glm::mat4(1.0f));
+        data->AddBone("arm", "root", glm::translate(glm::mat4(1.0f), glm::vec3(0, 1, 0)));
+        data->AddBone("hand", "arm", glm::translate(glm::mat4(1.0f), glm::vec3(0, 1, 0)));
+
+        BoneAnimation track;
+        track.name = "arm";
+        track.positions = {
+            {glm::vec3(0, 0, 0), 0.0f},
+            {glm::vec3(10, 0, 0), 1.0f},
+            {glm::vec3(10, 10, 0), 2.0f},
+            {glm::vec3(0, 10, 0), 3.0f},
+        };
+        track.numPositions = 4;
+        track.numRotations = 0;
+        track.numScalings = 0;
+
+        Animation anim;
+        anim.name = "wave";
+        anim.duration = 4.0f;
+        anim.ticksPerSecond = 1;
+        anim.boneAnimations.push_back(track);
+        data->animations.push_back(anim);
+        return data;
+    }
+
+    glm::vec3 Translation(const glm::mat4& m) { return glm::vec3(m[3]); }
+}
+
+TEST(AnimatorTest, CompiledSkeletonIsTopological) {
+    auto data = MakeArmModel();
+    auto skeleton = CompiledSkeleton::Build(*data);
+
+    ASSERT_EQ(skeleton->size(), 4u); // unnamed root node + 3 bones
+    for (size_t i = 0; i < skeleton->size(); ++i) {
+        EXPECT_LT(skeleton->parents[i], (int)i);
+    }
+    int arm = skeleton->FindNode("arm");
+    ASSERT_GE(arm, 0);
+    EXPECT_EQ(skeleton->names[skeleton->parents[arm]], "root");
+    EXPECT_EQ(skeleton->channels[0][arm], 0);
+    EXPECT_EQ(skeleton->channels[0][skeleton->FindNode("hand")], -1);
+    EXPECT_NE(skeleton->bones[skeleton->FindNode("hand")], nullptr);
+}
+
+TEST(AnimatorTest, CursorSamplingMatchesKeysAcrossWrap) {
+    auto     data = MakeArmModel();
+    Animator animator(data);
+    animator.PlayAnimation("wave");
+
+    const glm::vec3 expected[] = {
+        {5, 0, 0},  // t = 0.5
+        {10, 5, 0}, // t = 1.5
+        {5, 10, 0}, // t = 2.5
+        {0, 10, 0}, // t = 3.5, past the last key: hold
+        {5, 0, 0},  // t = 0.5 after wrapping
+    };
+
+    animator.UpdateAnimation(0.5f);
+    for (int step = 0; step < 5; ++step) {
+        glm::vec3 arm = Translation(animator.GetBoneModelSpaceTransform("arm"));
+        // arm's parent (root) sits at the origin, so model space equals the sampled track
+        EXPECT_NEAR(arm.x, expected[step].x, 1e-4f) << "step " << step;
+        EXPECT_NEAR(arm.y, expected[step].y, 1e-4f) << "step " << step;
+
+        glm::vec3 hand = Translation(animator.GetBoneModelSpaceTransform("hand"));
+        EXPECT_NEAR(hand.y, expected[step].y + 1.0f, 1e-4f) << "step " << step;
+        animator.UpdateAnimation(1.0f);
+    }
+}
+
+TEST(AnimatorTest, OverridesSurviveSkeletonEdits) {
+    auto     data = MakeArmModel();
+    Animator animator(data);
+
+    glm::mat4 bent = glm::translate(glm::mat4(1.0f), glm::vec3(2, 0, 0));
+    animator.SetBoneLocalTransform("hand", bent);
+    animator.UpdateAnimation(0.0f);
+    EXPECT_NEAR(Translation(animator.GetBoneModelSpaceTransform("hand")).x, 2.0f, 1e-4f);
+
+    // Structural edit after binding: the animator recompiles and keeps the override
+    data->AddBone("finger", "hand", glm::translate(glm::mat4(1.0f), glm::vec3(0, 0.5f, 0)));
+    animator.UpdateAnimation(0.0f);
+    EXPECT_EQ(animator.GetBoneParentName("finger"), "hand");
+    glm::vec3 finger = Translation(animator.GetBoneModelSpaceTransform("finger"));
+    EXPECT_NEAR(finger.x, 2.0f, 1e-4f);
+    EXPECT_NEAR(finger.y, 1.5f, 1e-4f);
+
+    animator.ResetLocalOverrides();
+    animator.UpdateAnimation(0.0f);
+    EXPECT_NEAR(Translation(animator.GetBoneModelSpaceTransform("hand")).y, 2.0f, 1e-4f);
+}
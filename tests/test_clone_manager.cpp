@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "clone_manager.h"
+#include "dot.h"
+#include "service_locator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace Boidsish;
+
+namespace {
+    std::vector<std::shared_ptr<Dot>> MakeDots(int count, float spread, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> unit(-spread, spread);
+        std::vector<std::shared_ptr<Dot>>     dots;
+        for (int i = 0; i < count; ++i) {
+            dots.push_back(std::make_shared<Dot>(i + 1, unit(rng), unit(rng), unit(rng)));
+        }
+        return dots;
+    }
+
+    // The flat vector and remove_if the manager used before, for the benchmark baseline
+    struct FlatClones {
+        struct State {
+            glm::mat4                    model_matrix;
+            glm::vec3                    color;
+            float                        creation_time;
+            std::shared_ptr<const Shape> shape_ptr;
+        };
+
+        std::vector<State>   clones;
+        std::map<int, float> last_capture;
+
+        void Capture(const std::shared_ptr<const Shape>& shape, float time) {
+            auto last = last_capture.find(shape->GetId());
+            if (last != last_capture.end() && time - last->second < 0.2f) {
+                return;
+            }
+            last_capture[shape->GetId()] = time;
+            glm::vec3 color(shape->GetR(), shape->GetG(), shape->GetB());
+            clones.push_back({shape->GetModelMatrix(), color, time, shape});
+        }
+
+        void Update(float time, const glm::vec3& camera) {
+            clones.erase(
+                std::remove_if(
+                    clones.begin(),
+                    clones.end(),
+                    [&](const State& c) {
+                        glm::vec3 d = camera - glm::vec3(c.model_matrix[3]);
+                        return time - c.creation_time > 5.0f || glm::dot(d, d) > 100.0f * 100.0f;
+                    }
+                ),
+                clones.end()
+            );
+        }
+    };
+
+    template <typename F>
+    double TimeMs(F&& body) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TEST(CloneManagerTest, ExpiresOldestFirstAcrossRingWrap) {
+    ServiceLocator loc;
+    CloneManager   manager(loc);
+    auto           dots = MakeDots(34, 10.0f, 1);
+
+    // 20 captures grow the ring to 32 slots; after expiry frees the front, 14 more wrap around
+    for (int i = 0; i < 20; ++i) {
+        manager.CaptureClone(dots[i], i * 0.1f);
+    }
+    EXPECT_EQ(manager.GetCloneCount(), 20u);
+    EXPECT_EQ(manager.GetGroupCount(), 1u);
+
+    manager.Update(5.25f, glm::vec3(0.0f)); // Captures before t = 0.25 have expired
+    EXPECT_EQ(manager.GetCloneCount(), 17u);
+
+    for (int i = 20; i < 34; ++i) {
+        manager.CaptureClone(dots[i], 5.0f + i * 0.1f);
+    }
+    EXPECT_EQ(manager.GetCloneCount(), 31u);
+
+    manager.Update(6.95f, glm::vec3(0.0f)); // Before t = 1.95
+    EXPECT_EQ(manager.GetCloneCount(), 14u);
+    manager.Update(20.0f, glm::vec3(0.0f));
+    EXPECT_EQ(manager.GetCloneCount(), 0u);
+    EXPECT_EQ(manager.GetGroupCount(), 0u);
+}
+
+TEST(CloneManagerTest, PrunesDistantAndRespectsLimits) {
+    ServiceLocator loc;
+    CloneManager   manager(loc);
+
+    std::vector<std::shared_ptr<Dot>> dots;
+    for (int i = 0; i < 30; ++i) {
+        float x = (i % 3 == 0) ? 150.0f : 10.0f; // Every third clone is outside the 100 unit radius
+        dots.push_back(std::make_shared<Dot>(i + 1, x, 0.0f, 0.0f));
+    }
+    for (int i = 0; i < 30; ++i) {
+        manager.CaptureClone(dots[i], i * 0.1f);
+    }
+    manager.Update(3.0f, glm::vec3(0.0f));
+    EXPECT_EQ(manager.GetCloneCount(), 20u);
+
+    // Survivors keep their order, so expiry still pops exactly the oldest ones
+    manager.Update(5.45f, glm::vec3(0.0f)); // Before t = 0.45: survivors 1, 2, 4
+    EXPECT_EQ(manager.GetCloneCount(), 17u);
+
+    // The capture interval is per shape, the global limit across all of them
+    manager.CaptureClone(dots[1], 5.5f);
+    manager.CaptureClone(dots[1], 5.6f);
+    EXPECT_EQ(manager.GetCloneCount(), 18u);
+    manager.SetMaxClones(18);
+    manager.CaptureClone(dots[2], 5.6f);
+    EXPECT_EQ(manager.GetCloneCount(), 18u);
+}
+
+TEST(CloneManagerBenchmark, CaptureAndUpdate100k) {
+    ServiceLocator loc;
+    CloneManager   manager(loc);
+    manager.SetMaxClones(200000);
+    FlatClones flat;
+
+    // 5000 shapes captured every 0.25 s with a 5 s lifespan keeps about 100k clones alive
+    auto   dots = MakeDots(5000, 60.0f, 2);
+    double capture_ms = 0.0, update_ms = 0.0, flat_capture_ms = 0.0, flat_update_ms = 0.0;
+    int    measured = 0;
+    for (int frame = 0; frame < 40; ++frame) {
+        float     time = frame * 0.25f;
+        glm::vec3 camera(std::sin(time) * 20.0f, 0.0f, 0.0f);
+
+        double c = TimeMs([&] {
+            for (const auto& dot : dots) {
+                manager.CaptureClone(dot, time);
+            }
+        });
+        double u = TimeMs([&] { manager.Update(time, camera); });
+        double fc = TimeMs([&] {
+            for (const auto& dot : dots) {
+                flat.Capture(dot, time);
+            }
+        });
+        double fu = TimeMs([&] { flat.Update(time, camera); });
+
+        if (frame >= 30) {
+            capture_ms += c;
+            update_ms += u;
+            flat_capture_ms += fc;
+            flat_update_ms += fu;
+            ++measured;
+        }
+    }
+    EXPECT_EQ(manager.GetCloneCount(), flat.clones.size());
+    EXPECT_GT(manager.GetCloneCount(), 90000u);
+
+    std::cout << "[ BENCH    ] " << manager.GetCloneCount() << " clones: capture " << capture_ms / measured
+              << " ms, update " << update_ms / measured << " ms per frame (flat vector: capture "
+              << flat_capture_ms / measured << " ms, update " << flat_update_ms / measured << " ms)" << std::endl;
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "cluster_culler.h"
+#include "mesh_optimizer_util.h"
+#include "mesh_test_helpers.h"
+#include "model.h"
+#include "procedural_generator.h"
+#include "procedural_mesher.h"
+#include "procedural_optimizer.h"
+#include "procedural_refiner.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Boidsish;
+
+namespace {
+    // Triangles of each meshlet as mesh vertex indices, sorted for comparison
+    std::vector<std::vector<std::array<unsigned int, 3>>> MeshletTriangles(const MeshletData& data) {
+        std::vector<std::vector<std::array<unsigned int, 3>>> result;
+        for (const auto& m : data.meshlets) {
+            auto& tris = result.emplace_back();
+            for (uint32_t t = 0; t < m.triangle_count; ++t) {
+                std::array<unsigned int, 3> tri;
+                for (int k = 0; k < 3; ++k) {
+                    tri[k] = data.vertices[m.vertex_offset + data.triangles[m.triangle_offset + t * 3 + k]];
+                }
+                // Rotate the smallest index first, keeping the winding
+                std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+                tris.push_back(tri);
+            }
+        }
+        return result;
+    }
+
+    Frustum LookAt(const glm::vec3& eye, const glm::vec3& target) {
+        glm::mat4 view = glm::lookAt(eye, target, glm::vec3(0, 1, 0));
+        glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+        return Frustum::FromViewProjection(view, projection);
+    }
+}
+
+TEST(ClusterCullerTest, MeshletsCoverTheMesh) {
+    std::vector<Vertex>       vertices;
+    std::vector<unsigned int> indices;
+    MakeSphere(48, 64, vertices, indices);
+
+    MeshletData data;
+    MeshOptimizerUtil::BuildMeshlets(vertices, indices, data);
+    ASSERT_FALSE(data.empty());
+
+    std::vector<std::array<unsigned int, 3>> expected, built;
+    for (size_t t = 0; t < indices.size(); t += 3) {
+        std::array<unsigned int, 3> tri = {indices[t], indices[t + 1], indices[t + 2]};
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+        expected.push_back(tri);
+    }
+    auto per_meshlet = MeshletTriangles(data);
+    for (size_t i = 0; i < data.meshlets.size(); ++i) {
+        const Meshlet& m = data.meshlets[i];
+        EXPECT_LE(m.vertex_count, MeshletData::kMaxVertices);
+        EXPECT_LE(m.triangle_count, MeshletData::kMaxTriangles);
+        for (const auto& tri : per_meshlet[i]) {
+            for (unsigned int v : tri) {
+                EXPECT_LE(glm::distance(vertices[v].Position, m.center), m.radius * 1.0001f + 1e-5f);
+            }
+            built.push_back(tri);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(built.begin(), built.end());
+    EXPECT_EQ(built, expected);
+}
+
+TEST(ClusterCullerTest, CullsConservatively) {
+    auto data = std::make_shared<ModelData>();
+    {
+        std::vector<Vertex>       vertices;
+        std::vector<unsigned int> indices;
+        MakeSphere(48, 64, vertices, indices);
+        data->meshes.emplace_back(vertices, indices, std::vector<Texture>{});
+    }
+    data->BuildMeshlets();
+    ASSERT_EQ(data->meshlets.size(), 1u);
+    const auto& mesh = data->meshes[0];
+    auto        per_meshlet = MeshletTriangles(data->meshlets[0]);
+
+    glm::mat4 model = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, -10)), glm::vec3(2.0f));
+    glm::vec3 eye(3.0f, 1.0f, 0.0f);
+    Frustum   frustum = LookAt(eye, glm::vec3(0, 0, -10));
+
+    std::vector<std::vector<uint32_t>> visible;
+    ClusterCullStats stats = ClusterCuller::Cull(*data, model, frustum, eye, visible);
+    EXPECT_EQ(stats.meshlets, data->meshlets[0].meshlets.size());
+    EXPECT_EQ(stats.frustum_culled, 0u);
+    // Meshlets on the far side face away
+    EXPECT_GT(stats.cone_culled, 0u);
+
+    // Every front-facing triangle is in a kept meshlet
+    for (size_t i = 0; i < per_meshlet.size(); ++i) {
+        bool kept = std::find(visible[0].begin(), visible[0].end(), i) != visible[0].end();
+        if (kept)
+            continue;
+        for (const auto& tri : per_meshlet[i]) {
+            glm::vec3 p[3];
+            for (int k = 0; k < 3; ++k) {
+                p[k] = glm::vec3(model * glm::vec4(mesh.vertices[tri[k]].Position, 1.0f));
+            }
+            glm::vec3 n = glm::cross(p[1] - p[0], p[2] - p[0]);
+            EXPECT_LE(glm::dot(n, eye - p[0]), 1e-5f) << "meshlet " << i;
+        }
+    }
+
+    // Looking away leaves nothing, and non-uniform scale keeps every cone
+    stats = ClusterCuller::Cull(*data, model, LookAt(eye, eye * 2.0f), eye, visible);
+    EXPECT_EQ(stats.frustum_culled, stats.meshlets);
+    EXPECT_TRUE(visible[0].empty());
+
+    glm::mat4 stretched = glm::scale(model, glm::vec3(1.0f, 3.0f, 1.0f));
+    stats = ClusterCuller::Cull(*data, stretched, frustum, eye, visible);
+    EXPECT_EQ(stats.cone_culled, 0u);
+}
+
+TEST(ClusterCullerBenchmark, DenseScene) {
+    // Procedural structures and trees stand in for the city and terrain props
+    std::vector<std::shared_ptr<ModelData>> models;
+    for (auto ir : {ProceduralGenerator::GenerateStructureIR(1337), ProceduralGenerator::GenerateTreeIR(1337)}) {
+        ProceduralOptimizer::Optimize(ir);
+        ProceduralRefiner::Refine(ir);
+        auto model = ProceduralMesher::GenerateModel(ir);
+        ASSERT_NE(model, nullptr);
+        auto data = model->GetData();
+        if (data->meshlets.size() != data->meshes.size()) {
+            data->BuildMeshlets();
+        }
+        models.push_back(data);
+    }
+
+    struct Instance {
+        const ModelData* data;
+        glm::mat4        model;
+    };
+
+    std::mt19937                          rng(11);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<Instance>                 instances;
+    for (int x = 0; x < 32; ++x) {
+        for (int z = 0; z < 32; ++z) {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x * 12.0f - 192.0f, 0.0f, z * 12.0f - 192.0f));
+            model = glm::rotate(model, angle(rng), glm::vec3(0, 1, 0));
+            instances.push_back({models[(x + z) % models.size()].get(), model});
+        }
+    }
+
+    const glm::vec3 eye(0.0f, 6.0f, 0.0f);
+    size_t          object_triangles = 0, cluster_triangles = 0, meshlets = 0, frustum_culled = 0, cone_culled = 0;
+    double          object_ms = 0.0, cluster_ms = 0.0;
+
+    std::vector<std::vector<uint32_t>> visible;
+    for (int view = 0; view < 8; ++view) {
+        float   a = 6.2831853f * view / 8;
+        Frustum frustum = LookAt(eye, eye + glm::vec3(std::cos(a), -0.2f, std::sin(a)));
+        auto    start = std::chrono::steady_clock::now();
+        for (const auto& instance : instances) {
+            AABB bounds = instance.data->aabb.Transform(instance.model);
+            if (frustum.IsBoxInFrustum(bounds.min, bounds.max)) {
+                for (const auto& mesh : instance.data->meshes) {
+                    object_triangles += mesh.indices.size() / 3;
+                }
+            }
+        }
+        object_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (const auto& instance : instances) {
+            AABB bounds = instance.data->aabb.Transform(instance.model);
+            if (!frustum.IsBoxInFrustum(bounds.min, bounds.max))
+                continue;
+            ClusterCullStats stats = ClusterCuller::Cull(*instance.data, instance.model, frustum, eye, visible);
+            cluster_triangles += stats.triangles;
+            meshlets += stats.meshlets;
+            frustum_culled += stats.frustum_culled;
+            cone_culled += stats.cone_culled;
+        }
+        cluster_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    EXPECT_LE(cluster_triangles, object_triangles);
+    std::cout << "[ BENCH    ] " << instances.size() << " instances, 8 views: object culling " << object_triangles / 8
+              << " triangles/view in " << object_ms / 8 << " ms, cluster culling " << cluster_triangles / 8
+              << " triangles/view in " << cluster_ms / 8 << " ms (" << meshlets / 8 << " meshlets tested, "
+              << frustum_culled / 8 << " frustum culled, " << cone_culled / 8 << " cone culled)" << std::endl;
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "Config.h"
+#include "ConfigManager.h"
 #include <fstream>
 #include <cstdio>
 #include <algorithm>
@@ -59,3 +60,49 @@ TEST(ConfigTest, Sections) {
     EXPECT_EQ(s1.size(), 1);
     EXPECT_EQ(s1["K1"], "V1");
 }
+
+TEST(ConfigManagerTest, TypedBindingTracksSetter) {
+    auto& manager = ConfigManager::GetInstance();
+    manager.Initialize("Config Binding Test");
+
+    const auto& scale = manager.BindAppSettingFloat("binding_test_scale", 1.5f);
+    const auto& enabled = manager.BindAppSettingBool("binding_test_enabled", false);
+    EXPECT_EQ(&scale, &manager.BindAppSettingFloat("binding_test_scale", 1.5f));
+
+    manager.SetFloat("binding_test_scale", 2.5f);
+    manager.SetBool("binding_test_enabled", true);
+    EXPECT_FLOAT_EQ(scale.Get(), 2.5f);
+    EXPECT_TRUE(enabled);
+
+    manager.SetFloat("binding_test_scale", 0.25f);
+    EXPECT_FLOAT_EQ(scale, 0.25f);
+}
+
+TEST(ConfigManagerTest, ChangeListeners) {
+    auto& manager = ConfigManager::GetInstance();
+    manager.Initialize("Config Binding Test");
+
+    const auto& count = manager.BindAppSettingInt("binding_test_count", 0);
+    int         keyed_calls = 0;
+    int         seen_value = -1;
+    int         any_calls = 0;
+
+    auto keyed = manager.AddChangeListener("binding_test_count", [&](const std::string&) {
+        ++keyed_calls;
+        seen_value = count.Get();
+    });
+    auto any = manager.AddChangeListener("", [&](const std::string&) { ++any_calls; });
+
+    manager.SetInt("binding_test_count", 7);
+    manager.SetInt("binding_test_other", 1);
+    EXPECT_EQ(keyed_calls, 1);
+    EXPECT_EQ(seen_value, 7);
+    EXPECT_EQ(any_calls, 2);
+
+    manager.RemoveChangeListener(keyed);
+    manager.RemoveChangeListener(any);
+    manager.SetInt("binding_test_count", 8);
+    EXPECT_EQ(keyed_calls, 1);
+    EXPECT_EQ(any_calls, 2);
+    EXPECT_EQ(count.Get(), 8);
+}
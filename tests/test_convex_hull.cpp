@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "convex_hull.h"
+#include "procedural_generator.h"
+#include "procedural_mesher.h"
+#include "procedural_optimizer.h"
+#include "procedural_refiner.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+
+using namespace Boidsish;
+
+namespace {
+    std::vector<glm::vec3> MakeCloud(int count, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<glm::vec3>                points;
+        for (int i = 0; i < count; ++i) {
+            points.emplace_back(unit(rng), unit(rng), unit(rng));
+        }
+        return points;
+    }
+
+    // Closed, consistently wound, and no point above any face
+    void ExpectHull(const ConvexHull& hull, const std::vector<glm::vec3>& points) {
+        const auto& tris = hull.GetTriangles();
+        ASSERT_FALSE(tris.empty());
+
+        std::map<std::pair<int, int>, int> edges;
+        std::set<int>                      vertices;
+        for (const auto& t : tris) {
+            for (int i = 0; i < 3; ++i) {
+                edges[{t[i], t[(i + 1) % 3]}]++;
+                vertices.insert(t[i]);
+            }
+        }
+        for (const auto& [edge, count] : edges) {
+            EXPECT_EQ(count, 1);
+            EXPECT_EQ(edges.count({edge.second, edge.first}), 1u) << edge.first << " " << edge.second;
+        }
+        // Euler characteristic of a sphere
+        EXPECT_EQ(int(vertices.size()) - int(edges.size() / 2) + int(tris.size()), 2);
+
+        for (const auto& t : tris) {
+            glm::vec3 n = glm::normalize(glm::cross(points[t[1]] - points[t[0]], points[t[2]] - points[t[0]]));
+            for (const auto& p : points) {
+                ASSERT_LE(glm::dot(n, p - points[t[0]]), 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(ConvexHullTest, RandomClouds) {
+    for (int count : {4, 10, 100, 1000}) {
+        auto       points = MakeCloud(count, 17 + count);
+        ConvexHull hull;
+        hull.Build(points);
+        ExpectHull(hull, points);
+    }
+}
+
+TEST(ConvexHullTest, CubeWithInteriorAndCoplanarPoints) {
+    std::vector<glm::vec3> points;
+    for (int i = 0; i < 8; ++i) {
+        points.emplace_back(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f);
+    }
+    // Face centers and edge midpoints lie on the hull without being vertices of it
+    points.emplace_back(0.0f, 0.0f, 1.0f);
+    points.emplace_back(1.0f, 0.0f, 0.0f);
+    points.emplace_back(1.0f, 1.0f, 0.0f);
+    for (const auto& p : MakeCloud(50, 3)) {
+        points.push_back(p * 0.5f);
+    }
+
+    ConvexHull hull;
+    hull.Build(points);
+    ExpectHull(hull, points);
+    EXPECT_EQ(hull.GetTriangles().size(), 12u);
+    for (const auto& t : hull.GetTriangles()) {
+        for (int v : t) {
+            EXPECT_LT(v, 8);
+        }
+    }
+}
+
+TEST(ConvexHullTest, HubRings) {
+    // Points as GenerateHubMesh collects them: a center and an 8-point ring per tube
+    std::vector<glm::vec3> points = {glm::vec3(2.0f, 10.0f, -3.0f)};
+    const glm::vec3        dirs[] = {{0, 1, 0}, {0.7f, 0.7f, 0}, {0, -1, 0}, {-0.5f, 0.2f, 0.8f}};
+    for (glm::vec3 dir : dirs) {
+        dir = glm::normalize(dir);
+        glm::vec3 up_hint = std::abs(dir.y) < 0.9f ? glm::vec3(0, 1, 0) : glm::vec3(1, 0, 0);
+        glm::vec3 right = glm::normalize(glm::cross(dir, up_hint));
+        glm::vec3 up = glm::cross(right, dir);
+        for (int i = 0; i < 8; ++i) {
+            float a = 2.0f * 3.14159265f * i / 8;
+            points.push_back(points[0] + (right * std::cos(a) + up * std::sin(a)) * 0.05f);
+        }
+    }
+
+    ConvexHull hull;
+    hull.Build(points);
+    ExpectHull(hull, points);
+}
+
+TEST(ConvexHullTest, DegenerateInputLeavesHullEmpty) {
+    ConvexHull hull;
+    hull.Build({glm::vec3(0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0)});
+    EXPECT_TRUE(hull.IsEmpty());
+
+    std::vector<glm::vec3> plane;
+    for (const auto& p : MakeCloud(20, 5)) {
+        plane.emplace_back(p.x, 0.5f, p.z);
+    }
+    hull.Build(plane);
+    EXPECT_TRUE(hull.IsEmpty());
+}
+
+TEST(ConvexHullTest, HullAndMeshingBenchmark) {
+    for (int count : {100, 1000, 10000}) {
+        auto       points = MakeCloud(count, 9);
+        ConvexHull hull;
+        auto       start = std::chrono::steady_clock::now();
+        hull.Build(points);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[ BENCH    ] hull of " << count << " points: " << ms << " ms, " << hull.GetTriangles().size()
+                  << " triangles" << std::endl;
+    }
+
+    // Rocks are not built from an IR
+    const std::vector<std::pair<const char*, ProceduralIR (*)(unsigned int)>> generators = {
+        {"grass", [](unsigned int s) { return ProceduralGenerator::GenerateGrassIR(s); }},
+        {"flower", [](unsigned int s) { return ProceduralGenerator::GenerateFlowerIR(s); }},
+        {"tree", [](unsigned int s) { return ProceduralGenerator::GenerateTreeIR(s); }},
+        {"space colonization", [](unsigned int s) { return ProceduralGenerator::GenerateSpaceColonizationTreeIR(s); }},
+        {"spring", [](unsigned int s) { return ProceduralGenerator::GenerateSpringPlantIR(s); }},
+        {"critter", [](unsigned int s) { return ProceduralGenerator::GenerateCritterIR(s); }},
+        {"structure", [](unsigned int s) { return ProceduralGenerator::GenerateStructureIR(s); }},
+    };
+    for (const auto& [name, generate] : generators) {
+        auto ir = generate(1337);
+        ProceduralOptimizer::Optimize(ir);
+        ProceduralRefiner::Refine(ir);
+
+        auto start = std::chrono::steady_clock::now();
+        auto model = ProceduralMesher::GenerateModel(ir);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        ASSERT_NE(model, nullptr) << name;
+        std::cout << "[ BENCH    ] meshing " << name << " (" << ir.elements.size() << " elements): " << ms << " ms"
+                  << std::endl;
+    }
+}
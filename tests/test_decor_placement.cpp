@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "decor_placement.h"
+#include "terrain_chunk_data.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace Boidsish;
+
+namespace {
+    constexpr int   kGridSize = 32;
+    constexpr float kChunkSize = 32.0f;
+
+    // Rolling hills with one biome index per column band, so masks can select parts of the chunk
+    TerrainChunkData MakeChunk(float height_offset, int biome) {
+        const int              resolution = kGridSize + 1;
+        std::vector<float>     heights;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec2> biomes;
+        for (int x = 0; x < resolution; ++x) {
+            for (int z = 0; z < resolution; ++z) {
+                float h = height_offset + 6.0f * std::sin(x * 0.3f) * std::cos(z * 0.2f);
+                float dhdx = 1.8f * std::cos(x * 0.3f) * std::cos(z * 0.2f);
+                float dhdz = -1.2f * std::sin(x * 0.3f) * std::sin(z * 0.2f);
+                heights.push_back(h);
+                normals.push_back(glm::normalize(glm::vec3(-dhdx, 1.0f, -dhdz)));
+                biomes.emplace_back(static_cast<float>(biome), 0.0f);
+            }
+        }
+        return TerrainChunkData(resolution, 1.0f, heights, normals, biomes);
+    }
+
+    DecorTypeGPU MakeType() {
+        DecorTypeGPU t{};
+        t.density_scale = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+        t.height_slope = glm::vec4(-1000.0f, 1000.0f, 0.0f, 1.0f);
+        t.rotation = glm::vec4(0.0f);
+        t.aabb_min = glm::vec4(-0.5f, 0.0f, -0.5f, 0.0f);
+        t.aabb_max = glm::vec4(0.5f, 2.0f, 0.5f, 0.0f);
+        t.flags = glm::uvec4(0xffu, 1u, 0u, 0u);
+        return t;
+    }
+
+    PlacementGlobalsGPU MakeGlobals() {
+        PlacementGlobalsGPU g{};
+        g.camera_and_scale = glm::vec4(0.0f, 0.0f, 1.0f, 0.0f);
+        g.distance_params = glm::vec4(1000000.0f, 2000000.0f, 3000000.0f, 0.0f);
+        return g;
+    }
+
+    std::vector<glm::mat4> Place(const TerrainChunkData& chunk, const DecorTypeGPU& type, const glm::vec2& offset) {
+        std::vector<glm::mat4> out;
+        DecorPlacement::PlaceInChunk(chunk, type, 0, offset, kChunkSize, kGridSize, MakeGlobals(), out);
+        return out;
+    }
+}
+
+TEST(DecorPlacementTest, HashAndNoiseRanges) {
+    EXPECT_EQ(DecorPlacement::Hash(0), 0.0f);
+    for (uint32_t i = 1; i < 10000; ++i) {
+        float h = DecorPlacement::Hash(i * 2654435761u);
+        EXPECT_GE(h, 0.0f);
+        EXPECT_LE(h, 1.0f);
+
+        glm::vec2 p(i * 0.37f - 1500.0f, i * -0.91f + 300.0f);
+        float     n = DecorPlacement::SimplexNoise(p);
+        EXPECT_GE(n, -1.0f);
+        EXPECT_LE(n, 1.0f);
+        EXPECT_EQ(n, DecorPlacement::SimplexNoise(p));
+    }
+}
+
+TEST(DecorPlacementTest, DeterministicAndInsideChunk) {
+    auto            chunk = MakeChunk(10.0f, 2);
+    auto            type = MakeType();
+    const glm::vec2 offset(-64.0f, 96.0f);
+
+    auto a = Place(chunk, type, offset);
+    auto b = Place(chunk, type, offset);
+    ASSERT_FALSE(a.empty());
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i], b[i]);
+    }
+
+    for (const auto& m : a) {
+        // The local bottom (0, 0, 0) is placed on the surface inside the chunk
+        glm::vec3 p(m[3]);
+        EXPECT_GE(p.x, offset.x);
+        EXPECT_LT(p.x, offset.x + kChunkSize);
+        EXPECT_GE(p.z, offset.y);
+        EXPECT_LT(p.z, offset.y + kChunkSize);
+        EXPECT_GT(p.y, 10.0f - 6.5f);
+        EXPECT_LT(p.y, 10.0f + 6.5f);
+        EXPECT_NEAR(glm::length(glm::vec3(m[1])), 1.0f, 1e-4f);
+    }
+
+    // Full density and no distance falloff: at most one instance per cell
+    EXPECT_LE(a.size(), static_cast<size_t>(kGridSize * kGridSize));
+}
+
+TEST(DecorPlacementTest, RulesFilterInstances) {
+    auto            chunk = MakeChunk(10.0f, 2);
+    const glm::vec2 offset(0.0f, 0.0f);
+    const size_t    all = Place(chunk, MakeType(), offset).size();
+    ASSERT_GT(all, 0u);
+
+    auto other_biome = MakeType();
+    other_biome.flags.x = 1u << 3;
+    EXPECT_TRUE(Place(chunk, other_biome, offset).empty());
+
+    auto too_high = MakeType();
+    too_high.height_slope.x = 20.0f;
+    EXPECT_TRUE(Place(chunk, too_high, offset).empty());
+
+    auto flat_only = MakeType();
+    flat_only.height_slope.w = 0.02f;
+    auto flat = Place(chunk, flat_only, offset);
+    EXPECT_LT(flat.size(), all);
+
+    auto sparse = MakeType();
+    sparse.density_scale.x = sparse.density_scale.y = 0.25f;
+    EXPECT_LT(Place(chunk, sparse, offset).size(), all);
+
+    auto no_detail = MakeType();
+    no_detail.rotation.w = 1.0f; // Nothing lies within one unit of the camera at the origin
+    EXPECT_TRUE(Place(MakeChunk(10.0f, 2), no_detail, glm::vec2(100.0f, 100.0f)).empty());
+
+    // A surface that does not match the grid places nothing
+    std::vector<glm::mat4> out;
+    DecorPlacement::PlaceInChunk(TerrainChunkData(), MakeType(), 0, offset, kChunkSize, kGridSize, MakeGlobals(), out);
+    EXPECT_TRUE(out.empty());
+}
+
+TEST(DecorPlacementTest, PlacementBenchmark) {
+    auto      chunk = MakeChunk(10.0f, 2);
+    auto      type = MakeType();
+    const int chunks = 256;
+
+    size_t instances = 0;
+    auto   start = std::chrono::steady_clock::now();
+    for (int i = 0; i < chunks; ++i) {
+        instances += Place(chunk, type, glm::vec2(i * kChunkSize, 0.0f)).size();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[ BENCH    ] " << chunks << " chunks (" << kGridSize << "^2 cells), " << instances
+              << " instances: " << ms / chunks << " ms per chunk and type" << std::endl;
+}
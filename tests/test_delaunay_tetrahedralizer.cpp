@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "delaunay_tetrahedralizer.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+
+using namespace Boidsish;
+
+namespace {
+    std::vector<glm::vec3> MakeCloud(int count, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<glm::vec3>                points;
+        for (int i = 0; i < count; ++i) {
+            points.emplace_back(unit(rng), unit(rng), unit(rng));
+        }
+        return points;
+    }
+
+    // Every neighbour link is mutual and no point lies strictly inside any circumsphere
+    void ExpectDelaunay(const DelaunayTetrahedralizer& dt, const std::vector<glm::vec3>& points) {
+        const auto& tets = dt.GetTetrahedra();
+        ASSERT_FALSE(tets.empty());
+        for (size_t t = 0; t < tets.size(); ++t) {
+            for (int i = 0; i < 4; ++i) {
+                int u = tets[t].neighbors[i];
+                if (u >= 0) {
+                    EXPECT_EQ(std::count(tets[u].neighbors.begin(), tets[u].neighbors.end(), int(t)), 1);
+                }
+            }
+            for (size_t p = 0; p < points.size(); ++p) {
+                if (std::find(tets[t].vertices.begin(), tets[t].vertices.end(), int(p)) != tets[t].vertices.end())
+                    continue;
+                glm::vec3 d = points[p] - tets[t].circumcenter;
+                ASSERT_GE(glm::dot(d, d), tets[t].circumradius_sq * (1.0f - 1e-4f)) << "tet " << t << " point " << p;
+            }
+        }
+    }
+
+    // The full-scan Bowyer-Watson DelaunayBlob used before, for the benchmark baseline
+    size_t NaiveBowyerWatson(const std::vector<glm::vec3>& points) {
+        struct Tet {
+            std::array<int, 4> v;
+            glm::vec3          center;
+            float              radius_sq;
+        };
+
+        std::vector<glm::vec3> pos = points;
+        glm::vec3              lo(1e30f), hi(-1e30f);
+        for (const auto& p : points) {
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+        glm::vec3 mid = (lo + hi) * 0.5f;
+        float     s = std::max({hi.x - lo.x, hi.y - lo.y, hi.z - lo.z}) * 6.0f;
+        int       base = int(points.size());
+        pos.push_back(mid + glm::vec3(s, s, s));
+        pos.push_back(mid + glm::vec3(s, -s, -s));
+        pos.push_back(mid + glm::vec3(-s, s, -s));
+        pos.push_back(mid + glm::vec3(-s, -s, s));
+
+        auto sphere = [&](std::array<int, 4> v) {
+            glm::vec3 a = pos[v[0]], ba = pos[v[1]] - a, ca = pos[v[2]] - a, da = pos[v[3]] - a;
+            float     denom = 2.0f * glm::dot(ba, glm::cross(ca, da));
+            glm::vec3 offset = (glm::dot(ba, ba) * glm::cross(ca, da) + glm::dot(ca, ca) * glm::cross(da, ba) +
+                                glm::dot(da, da) * glm::cross(ba, ca)) /
+                denom;
+            return Tet{v, a + offset, glm::dot(offset, offset)};
+        };
+
+        std::vector<Tet> tets{sphere({base, base + 1, base + 2, base + 3})};
+        for (int i = 0; i < base; ++i) {
+            std::vector<Tet>                  good;
+            std::map<std::array<int, 3>, int> faces;
+            for (const auto& tet : tets) {
+                glm::vec3 d = pos[i] - tet.center;
+                if (glm::dot(d, d) < tet.radius_sq * (1.0f + 1e-6f)) {
+                    for (int skip = 0; skip < 4; ++skip) {
+                        std::array<int, 3> f;
+                        for (int k = 0, j = 0; k < 4; ++k) {
+                            if (k != skip)
+                                f[j++] = tet.v[k];
+                        }
+                        std::sort(f.begin(), f.end());
+                        faces[f]++;
+                    }
+                } else {
+                    good.push_back(tet);
+                }
+            }
+            tets = std::move(good);
+            for (const auto& [f, count] : faces) {
+                if (count == 1)
+                    tets.push_back(sphere({f[0], f[1], f[2], i}));
+            }
+        }
+        return std::count_if(tets.begin(), tets.end(), [&](const Tet& t) {
+            return *std::max_element(t.v.begin(), t.v.end()) < base;
+        });
+    }
+
+    template <typename F>
+    double TimeMs(F&& body) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TEST(DelaunayTetrahedralizerTest, EmptyCircumspheres) {
+    auto                    points = MakeCloud(400, 1);
+    DelaunayTetrahedralizer dt;
+    dt.Build(points);
+    EXPECT_EQ(dt.GetSkippedPointCount(), 0u);
+    ExpectDelaunay(dt, points);
+}
+
+TEST(DelaunayTetrahedralizerTest, DegenerateInput) {
+    // A lattice is full of cospherical points, and the duplicate must be skipped rather than break the mesh
+    std::vector<glm::vec3> points;
+    for (int x = 0; x < 5; ++x) {
+        for (int y = 0; y < 5; ++y) {
+            for (int z = 0; z < 5; ++z) {
+                points.emplace_back(x, y, z);
+            }
+        }
+    }
+    points.push_back(points[7]);
+
+    DelaunayTetrahedralizer dt;
+    dt.Build(points);
+    EXPECT_EQ(dt.GetSkippedPointCount(), 1u);
+    ExpectDelaunay(dt, points);
+
+    dt.Build({glm::vec3(0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0)});
+    EXPECT_TRUE(dt.GetTetrahedra().empty());
+}
+
+TEST(DelaunayTetrahedralizerTest, KineticUpdate) {
+    auto                    points = MakeCloud(300, 2);
+    DelaunayTetrahedralizer dt;
+    dt.Build(points);
+    auto before = dt.GetTetrahedra();
+
+    std::mt19937                          rng(3);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    // A tiny jitter keeps every tetrahedron, a large one forces a rebuild; both stay Delaunay
+    for (auto& p : points) {
+        p += glm::vec3(unit(rng), unit(rng), unit(rng)) * 1e-5f;
+    }
+    EXPECT_TRUE(dt.Update(points));
+    ASSERT_EQ(dt.GetTetrahedra().size(), before.size());
+    for (size_t t = 0; t < before.size(); ++t) {
+        EXPECT_EQ(dt.GetTetrahedra()[t].vertices, before[t].vertices);
+    }
+    ExpectDelaunay(dt, points);
+
+    for (auto& p : points) {
+        p += glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.3f;
+    }
+    EXPECT_FALSE(dt.Update(points));
+    ExpectDelaunay(dt, points);
+}
+
+TEST(DelaunayTetrahedralizerBenchmark, BuildAndUpdate) {
+    for (int count : {1000, 10000}) {
+        auto                    points = MakeCloud(count, 4);
+        DelaunayTetrahedralizer dt;
+        double                  build_ms = TimeMs([&] { dt.Build(points); });
+
+        for (auto& p : points) {
+            p *= 1.0f + 1e-7f;
+        }
+        bool   kept = false;
+        double update_ms = TimeMs([&] { kept = dt.Update(points); });
+
+        std::cout << "[ BENCH    ] " << count << " points: build " << build_ms << " ms ("
+                  << dt.GetTetrahedra().size() << " tets), kinetic update " << update_ms << " ms"
+                  << (kept ? "" : " (rebuilt)");
+        if (count <= 1000) {
+            size_t naive_tets = 0;
+            double naive_ms = TimeMs([&] { naive_tets = NaiveBowyerWatson(points); });
+            std::cout << ", full-scan Bowyer-Watson " << naive_ms << " ms (" << naive_tets << " tets)";
+        }
+        std::cout << std::endl;
+        EXPECT_GT(dt.GetTetrahedra().size(), size_t(count));
+    }
+}
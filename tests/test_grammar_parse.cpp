@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "grammar.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    Grammar MakeDialogueGrammar() { return Grammar("assets/dialogue_grammar.txt", "assets/dialogue_terminals.txt"); }
+
+    size_t CountTokens(const std::string& sentence) {
+        size_t count = 0;
+        bool   in_word = false;
+        for (char c : sentence) {
+            bool space = std::isspace(static_cast<unsigned char>(c));
+            count += !space && !in_word;
+            in_word = !space;
+        }
+        return count;
+    }
+}
+
+TEST(GrammarParseTest, ViterbiProbabilityOfKnownSentence) {
+    Grammar g = MakeDialogueGrammar();
+
+    // ROOT -> S -> NP VP, NP -> DET N, VP -> V_INTRANS, with each rule's share of its lhs weight
+    double expected = std::log(1.0 / 1.5) + std::log(1.0 / 3.2) + std::log(1.0 / 2.0) + std::log(1.0 / 3.0) +
+        std::log(1.0 / 4.1) + std::log(1.0 / 2.0);
+    EXPECT_NEAR(g.log_probability("The king glows"), expected, 1e-9);
+
+    EXPECT_EQ(g.log_probability("the the king glows"), -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(g.log_probability("glows the king"), -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(g.log_probability("the king glows", "NO_SUCH_SYMBOL"), -std::numeric_limits<double>::infinity());
+}
+
+TEST(GrammarParseTest, GeneratedSentencesParse) {
+    Grammar g = MakeDialogueGrammar();
+    for (int i = 0; i < 200; ++i) {
+        std::string sentence = g.generate();
+        double      log_prob = g.log_probability(sentence);
+        ASSERT_TRUE(std::isfinite(log_prob)) << sentence;
+        ASSERT_LE(log_prob, 0.0) << sentence;
+    }
+}
+
+TEST(GrammarParseTest, ParseAndModifyReinforcesUsedRules) {
+    Grammar g = MakeDialogueGrammar();
+    double  before = g.log_probability("she steals the cursed sword");
+    double  unrelated_before = g.log_probability("a king glows");
+    ASSERT_TRUE(std::isfinite(before));
+
+    g.parse_and_modify("she steals the cursed sword");
+    EXPECT_GT(g.log_probability("she steals the cursed sword"), before);
+    // Doubling the weights used above takes probability away from the alternatives
+    EXPECT_LT(g.log_probability("a king glows"), unrelated_before);
+}
+
+TEST(GrammarParseBenchmark, SentencesPerSecond) {
+    Grammar                  g = MakeDialogueGrammar();
+    std::vector<std::string> sentences;
+    size_t                   tokens = 0;
+    while (sentences.size() < 500) {
+        std::string sentence = g.generate();
+        if (CountTokens(sentence) <= 40) {
+            tokens += CountTokens(sentence);
+            sentences.push_back(sentence);
+        }
+    }
+
+    auto   start = std::chrono::steady_clock::now();
+    double sum = 0.0;
+    for (const auto& sentence : sentences) {
+        sum += g.log_probability(sentence);
+    }
+    double parse_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_TRUE(std::isfinite(sum));
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& sentence : sentences) {
+        g.parse_and_modify(sentence);
+    }
+    double modify_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[ BENCH    ] " << sentences.size() << " generated sentences, " << tokens / sentences.size()
+              << " tokens on average: " << sentences.size() / parse_s << " sentences/s parsed, "
+              << sentences.size() / modify_s << " sentences/s with parse_and_modify" << std::endl;
+}
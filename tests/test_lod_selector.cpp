@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include "lod_selector.h"
+#include "mesh_optimizer_util.h"
+#include "mesh_test_helpers.h"
+#include "model.h"
+#include "procedural_generator.h"
+#include "procedural_mesher.h"
+#include "procedural_optimizer.h"
+#include "procedural_refiner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Boidsish;
+
+namespace {
+    RenderContext MakeContext(const glm::vec3& eye, float lod_screen_error) {
+        RenderContext context;
+        context.view = glm::lookAt(eye, eye + glm::vec3(0, 0, -1), glm::vec3(0, 1, 0));
+        context.projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+        context.view_pos = eye;
+        context.frustum = Frustum::FromViewProjection(context.view, context.projection);
+        context.lod_screen_error = lod_screen_error;
+        return context;
+    }
+
+    // The ranges Mesh::GetLodRanges holds once uploaded, before upload offsets
+    std::vector<LodRange> MakeRanges(const Mesh& mesh) {
+        std::vector<LodRange> lods = {{0, static_cast<uint32_t>(mesh.indices.size()), 0.0f}};
+        for (const auto& lod : mesh.lods) {
+            lods.push_back({lod.first_index, static_cast<uint32_t>(lod.indices.size()), lod.error});
+        }
+        return lods;
+    }
+}
+
+TEST(LodSelectorTest, GeneratesCoarserLevels) {
+    std::vector<Vertex>       vertices;
+    std::vector<unsigned int> indices;
+    MakeSphere(48, 64, vertices, indices);
+
+    std::vector<MeshLod> lods;
+    MeshOptimizerUtil::GenerateLods(vertices, indices, lods, 3);
+    ASSERT_FALSE(lods.empty());
+    EXPECT_LE(lods.size(), 3u);
+
+    size_t previous_count = indices.size();
+    float  previous_error = 0.0f;
+    for (const auto& lod : lods) {
+        ASSERT_EQ(lod.indices.size() % 3, 0u);
+        EXPECT_LT(lod.indices.size(), previous_count);
+        EXPECT_GE(lod.error, previous_error);
+        for (unsigned int i : lod.indices) {
+            ASSERT_LT(i, vertices.size());
+        }
+        previous_count = lod.indices.size();
+        previous_error = lod.error;
+    }
+
+    MeshOptimizerUtil::GenerateLods(vertices, indices, lods, 0);
+    EXPECT_TRUE(lods.empty());
+}
+
+TEST(LodSelectorTest, SelectsCoarserLevelsWithDistance) {
+    const std::vector<LodRange> lods = {{0, 3000, 0.0f}, {3000, 1500, 0.01f}, {4500, 750, 0.05f}, {5250, 375, 0.2f}};
+    const glm::vec3             center(0.0f, 0.0f, -10.0f);
+
+    size_t previous = 0;
+    for (float distance : {2.0f, 10.0f, 50.0f, 200.0f, 1000.0f, 5000.0f}) {
+        RenderContext context = MakeContext(center + glm::vec3(0, 0, distance), 0.001f);
+        size_t        level = LodSelector::Select(lods, center, 1.0f, context);
+        EXPECT_GE(level, previous) << distance;
+        if (level > 0) {
+            EXPECT_LE(LodSelector::ScreenError(lods[level].error, center, 1.0f, context), 0.001f);
+        }
+        previous = level;
+    }
+    EXPECT_EQ(previous, lods.size() - 1);
+
+    // Inside the bounds, and with selection off, the full mesh is drawn
+    EXPECT_EQ(LodSelector::Select(lods, center, 1.0f, MakeContext(center, 0.001f)), 0u);
+    EXPECT_EQ(LodSelector::Select(lods, center, 1.0f, MakeContext(center + glm::vec3(0, 0, 5000), 0.0f)), 0u);
+
+    // Scaling the instance up scales its errors with it
+    RenderContext context = MakeContext(center + glm::vec3(0, 0, 200), 0.001f);
+    size_t        unscaled = LodSelector::Select(lods, center, 1.0f, context);
+    EXPECT_LT(LodSelector::Select(lods, center, 1.0f, context, 10.0f), unscaled);
+
+    RenderPacket packet;
+    packet.first_index = 0;
+    packet.index_count = 3000;
+    packet.lods.Assign(lods);
+    packet.lod_center = center;
+    packet.lod_radius = 1.0f;
+    LodSelector::Apply(packet, MakeContext(center + glm::vec3(0, 0, 5000), 0.001f));
+    EXPECT_EQ(packet.first_index, 5250u);
+    EXPECT_EQ(packet.index_count, 375u);
+
+    // Packets hold their ranges, so cached ones outlive a re-upload of the mesh
+    RenderPacket cached;
+    {
+        std::vector<LodRange> mesh_ranges = lods;
+        cached.lods.Assign(mesh_ranges);
+    }
+    LodSelector::Apply(cached, MakeContext(center + glm::vec3(0, 0, 5000), 0.001f));
+    EXPECT_EQ(cached.first_index, 5250u);
+}
+
+TEST(LodSelectorTest, KeepsFullAndCoarsestLevels) {
+    std::vector<LodRange> ranges;
+    for (uint32_t i = 0; i < LodRanges::kMaxLods + 2; ++i) {
+        ranges.push_back({i * 100, 100, static_cast<float>(i)});
+    }
+
+    LodRanges lods;
+    lods.Assign(ranges);
+    ASSERT_EQ(lods.count, LodRanges::kMaxLods);
+    EXPECT_EQ(lods.ranges[0].first_index, 0u);
+    EXPECT_EQ(lods.ranges[1].first_index, 300u);
+    EXPECT_EQ(lods.View().back().first_index, ranges.back().first_index);
+
+    lods.Assign({});
+    EXPECT_TRUE(lods.empty());
+}
+
+TEST(LodSelectorBenchmark, DenseScene) {
+    // Procedural structures and trees stand in for the city and terrain props
+    std::vector<std::shared_ptr<ModelData>>          models;
+    std::vector<std::vector<std::vector<LodRange>>> ranges; // Per model, per mesh
+    for (auto ir : {ProceduralGenerator::GenerateStructureIR(1337), ProceduralGenerator::GenerateTreeIR(1337)}) {
+        ProceduralOptimizer::Optimize(ir);
+        ProceduralRefiner::Refine(ir);
+        auto model = ProceduralMesher::GenerateModel(ir);
+        ASSERT_NE(model, nullptr);
+        models.push_back(model->GetData());
+        auto& model_ranges = ranges.emplace_back();
+        for (const auto& mesh : models.back()->meshes) {
+            model_ranges.push_back(MakeRanges(mesh));
+        }
+    }
+
+    struct Instance {
+        size_t    model_index;
+        glm::mat4 model;
+    };
+
+    std::mt19937                          rng(11);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<Instance>                 instances;
+    for (int x = 0; x < 32; ++x) {
+        for (int z = 0; z < 32; ++z) {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x * 12.0f - 192.0f, 0.0f, z * 12.0f - 192.0f));
+            model = glm::rotate(model, angle(rng), glm::vec3(0, 1, 0));
+            instances.push_back({(x + z) % models.size(), model});
+        }
+    }
+
+    const glm::vec3 eye(0.0f, 6.0f, 0.0f);
+    size_t          full_triangles = 0, lod_triangles = 0, coarser_draws = 0, draws = 0;
+    double          select_ms = 0.0;
+    for (int view = 0; view < 8; ++view) {
+        float         a = 6.2831853f * view / 8;
+        RenderContext context = MakeContext(eye, 0.001f);
+        context.view = glm::lookAt(eye, eye + glm::vec3(std::cos(a), -0.2f, std::sin(a)), glm::vec3(0, 1, 0));
+        context.frustum = Frustum::FromViewProjection(context.view, context.projection);
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& instance : instances) {
+            const ModelData& data = *models[instance.model_index];
+            AABB             bounds = data.aabb.Transform(instance.model);
+            if (!context.frustum.IsBoxInFrustum(bounds.min, bounds.max))
+                continue;
+            glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
+            float     radius = glm::length(bounds.max - bounds.min) * 0.5f;
+            for (size_t m = 0; m < data.meshes.size(); ++m) {
+                const auto& lods = ranges[instance.model_index][m];
+                size_t      level = LodSelector::Select(lods, center, radius, context);
+                full_triangles += data.meshes[m].indices.size() / 3;
+                lod_triangles += lods[level].index_count / 3;
+                coarser_draws += level > 0;
+                ++draws;
+            }
+        }
+        select_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    EXPECT_LE(lod_triangles, full_triangles);
+    std::cout << "[ BENCH    ] " << instances.size() << " instances, 8 views: full detail " << full_triangles / 8
+              << " triangles/view, with LODs " << lod_triangles / 8 << " triangles/view (" << coarser_draws / 8
+              << " of " << draws / 8 << " draws coarser, selection " << select_ms / 8 << " ms/view)" << std::endl;
+}
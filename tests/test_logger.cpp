@@ -3,6 +3,9 @@
 #include "Config.h"
 #include <fstream>
 #include <sstream>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 class TestBackend : public logger::BaseBackend {
 public:
@@ -97,3 +100,102 @@ TEST(LoggerTest, EarlyExit) {
     logger::INFO("Check formatting: {}", SideEffectGuard{&formatted});
     EXPECT_FALSE(formatted);
 }
+
+class CountingBackend : public logger::BaseBackend {
+public:
+    std::atomic<size_t> lines{0};
+    std::atomic<size_t> flushes{0};
+    bool render(const logger::LogLevel level, const std::string_view&) override {
+        if (!isEnabled(level)) return false;
+        lines.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    void flush() override { flushes.fetch_add(1, std::memory_order_relaxed); }
+};
+
+TEST(LoggerTest, AsyncMatchesSyncFormatting) {
+    logger::Logger<TestBackend> sync_logger;
+    logger::Logger<TestBackend> async_logger;
+    async_logger.startAsync();
+
+    auto log_all = [](auto& l) {
+        l.INFO("ints {} {} chars {}{} float {} bool {}", -42, 7u, 'x', (unsigned char)'y', 0.1f, true);
+        l.INFO("strings {} {} {}", "literal", std::string("owned"), std::string_view("view"));
+        l.WARNING("tuple {}", std::make_pair("foo", 42), 3.5, "extra");
+    };
+    log_all(sync_logger);
+    log_all(async_logger);
+    async_logger.flush();
+
+    // Trim the (file:line) suffix, which differs between the two call sites
+    auto strip = [](const std::string& s) { return s.substr(0, s.rfind(" (")); };
+    ASSERT_EQ(async_logger.backend.messages.size(), sync_logger.backend.messages.size());
+    for (size_t i = 0; i < sync_logger.backend.messages.size(); ++i) {
+        EXPECT_EQ(strip(async_logger.backend.messages[i]), strip(sync_logger.backend.messages[i]));
+    }
+    EXPECT_EQ(async_logger.asyncStats().written, 3u);
+}
+
+TEST(LoggerTest, AsyncDropPolicyAccountsForEveryRecord) {
+    logger::Logger<CountingBackend> l;
+    logger::AsyncOptions            options;
+    options.slots_per_thread = 4;
+    options.overflow = logger::OverflowPolicy::Drop;
+    l.startAsync(options);
+
+    const size_t attempts = 10000;
+    for (size_t i = 0; i < attempts; ++i) {
+        l.INFO("record {}", i);
+    }
+    l.flush();
+
+    auto stats = l.asyncStats();
+    EXPECT_EQ(stats.enqueued + stats.dropped, attempts);
+    EXPECT_EQ(stats.written, stats.enqueued);
+    EXPECT_EQ(l.backend.lines.load(), stats.written);
+}
+
+TEST(LoggerBenchmark, Throughput) {
+    const int    num_threads = 4;
+    const size_t per_thread = 50000;
+
+    auto run = [&](auto& l) {
+        auto                     start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&l, t, per_thread]() {
+                for (size_t i = 0; i < per_thread; ++i) {
+                    l.INFO("worker {} chunk {} height {}", t, i, 1.5f * i);
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        auto producers_done = std::chrono::steady_clock::now();
+        l.flush();
+        auto drained = std::chrono::steady_clock::now();
+        return std::make_pair(
+            std::chrono::duration<double>(producers_done - start).count(),
+            std::chrono::duration<double>(drained - start).count()
+        );
+    };
+
+    const double total = double(num_threads * per_thread);
+
+    logger::Logger<CountingBackend> sync_logger;
+    auto [sync_time, sync_drained] = run(sync_logger);
+    EXPECT_EQ(sync_logger.backend.lines.load(), num_threads * per_thread);
+
+    logger::Logger<CountingBackend> async_logger;
+    logger::AsyncOptions            options;
+    options.overflow = logger::OverflowPolicy::Block;
+    async_logger.startAsync(options);
+    auto [async_time, async_drained] = run(async_logger);
+    auto stats = async_logger.asyncStats();
+    EXPECT_EQ(stats.written, num_threads * per_thread);
+    EXPECT_EQ(stats.dropped, 0u);
+
+    std::cout << "[ BENCH    ] sync:  " << total / sync_time << " msgs/s on callers" << std::endl;
+    std::cout << "[ BENCH    ] async: " << total / async_time << " msgs/s on callers, " << total / async_drained
+              << " msgs/s end-to-end, " << stats.batches << " batches, " << stats.blocked << " producer stalls"
+              << std::endl;
+}
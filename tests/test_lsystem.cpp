@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "lsystem.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+
+using namespace Boidsish;
+
+namespace {
+    // The string-rebuilding expansion the generators used before
+    std::string ReferenceExpand(const std::string& axiom, const std::map<char, std::string>& rules, int iterations) {
+        std::string current = axiom;
+        for (int i = 0; i < iterations; ++i) {
+            std::string next;
+            for (char c : current) {
+                if (rules.count(c))
+                    next += rules.at(c);
+                else
+                    next += c;
+            }
+            current = next;
+        }
+        return current;
+    }
+
+    LSystem Make(const std::string& axiom, const std::map<char, std::string>& rules) {
+        LSystem lsys(axiom);
+        for (const auto& [symbol, replacement] : rules) {
+            lsys.SetRule(symbol, replacement);
+        }
+        return lsys;
+    }
+
+    const std::map<char, std::string> kTreeRules = {{'X', "F[&+X][&/X][^-X][^\\X]"}, {'F', "SFF"}};
+    const std::map<char, std::string> kCritterRules = {{'F', "F[+F]F[-F]F"}};
+}
+
+TEST(LSystemTest, MatchesReferenceExpansion) {
+    const std::map<char, std::string> erasing = {{'A', "AB"}, {'B', ""}, {'C', "CAC"}};
+    for (const auto& [axiom, rules] : {
+             std::pair{std::string("X"), kTreeRules},
+             std::pair{std::string("F"), kCritterRules},
+             std::pair{std::string("ABC"), erasing},
+         }) {
+        LSystem lsys = Make(axiom, rules);
+        for (int n = 0; n <= 6; ++n) {
+            std::string expected = ReferenceExpand(axiom, rules, n);
+            EXPECT_EQ(lsys.ExpandedLength(n), expected.size()) << axiom << " " << n;
+
+            std::string streamed;
+            for (char c : lsys.Symbols(n)) {
+                streamed += c;
+            }
+            EXPECT_EQ(streamed, expected) << axiom << " " << n;
+        }
+    }
+}
+
+TEST(LSystemTest, RulesFromStrings) {
+    LSystem lsys("AB");
+    lsys.SetRules({"A=AB", "=ignored", "B", "C=x=y"});
+    EXPECT_TRUE(lsys.HasRule('A'));
+    EXPECT_FALSE(lsys.HasRule('B'));
+    EXPECT_EQ(lsys.GetRule('C'), "x=y");
+    std::string expanded;
+    for (char c : lsys.Symbols(2)) {
+        expanded += c;
+    }
+    EXPECT_EQ(expanded, "ABBB");
+}
+
+TEST(LSystemTest, ExpansionBenchmark) {
+    for (const auto& [name, axiom, rules] : {
+             std::tuple{"tree", std::string("X"), kTreeRules},
+             std::tuple{"critter", std::string("F"), kCritterRules},
+         }) {
+        LSystem lsys = Make(axiom, rules);
+        for (int n = 3; n <= 7; ++n) {
+            auto ms_since = [](auto start) {
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            };
+
+            auto   start = std::chrono::steady_clock::now();
+            size_t reference = ReferenceExpand(axiom, rules, n).size();
+            double reference_ms = ms_since(start);
+
+            start = std::chrono::steady_clock::now();
+            size_t streamed = 0;
+            for (char c : lsys.Symbols(n)) {
+                streamed += c != 0;
+            }
+            double stream_ms = ms_since(start);
+
+            EXPECT_EQ(streamed, reference);
+            std::cout << "[ BENCH    ] " << name << " depth " << n << ", " << reference << " symbols: rebuild "
+                      << reference_ms << " ms, stream " << stream_ms << " ms" << std::endl;
+        }
+    }
+}
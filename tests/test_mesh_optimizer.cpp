@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
+#include "ConfigManager.h"
+#include "asset_manager.h"
 #include "mesh_optimizer_util.h"
 #include "geometry.h"
+#include "model.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <random>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -102,3 +110,148 @@ TEST(MeshOptimizerTest, SimplifyMesh) {
         EXPECT_LT(idx, vertices.size());
     }
 }
+
+namespace {
+    std::vector<Vertex> MakeRandomVertices(int count, glm::vec3 center, float size, bool skinned) {
+        std::mt19937                          rng(7);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<Vertex>                   vertices(count);
+        for (auto& v : vertices) {
+            v.Position = center + glm::vec3(unit(rng), unit(rng), unit(rng)) * size;
+            v.Normal = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.0f, 0.0f, 1e-3f));
+            v.TexCoords = glm::vec2(unit(rng), unit(rng)) * 0.5f + 0.5f;
+            v.Color = glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.5f + 0.5f;
+            if (skinned) {
+                v.m_BoneIDs[0] = int(rng() % 60);
+                v.m_BoneIDs[1] = int(rng() % 60);
+                v.m_Weights[0] = 0.75f;
+                v.m_Weights[1] = 0.25f;
+            }
+        }
+        return vertices;
+    }
+}
+
+TEST(MeshOptimizerTest, PackedVerticesRoundTrip) {
+    const float size = 2.0f;
+    auto        vertices = MakeRandomVertices(1000, glm::vec3(0.5f, 1.0f, 0.0f), size, true);
+
+    PackedVertexData packed;
+    ASSERT_TRUE(MeshOptimizerUtil::PackVertices(vertices, packed));
+    EXPECT_FALSE(packed.half_tex_coords);
+    ASSERT_EQ(packed.skin.size(), vertices.size());
+    EXPECT_EQ(packed.ByteSize(), vertices.size() * 28);
+
+    std::vector<Vertex> unpacked;
+    MeshOptimizerUtil::UnpackVertices(packed, unpacked);
+    ASSERT_EQ(unpacked.size(), vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& a = vertices[i];
+        const Vertex& b = unpacked[i];
+        for (int c = 0; c < 3; ++c) {
+            EXPECT_LE(std::abs(a.Position[c] - b.Position[c]), 2.0f * size / 1024.0f);
+            EXPECT_LE(std::abs(a.Color[c] - b.Color[c]), 0.5f / 255.0f + 1e-6f);
+        }
+        EXPECT_GT(glm::dot(a.Normal, glm::normalize(b.Normal)), 0.9999f);
+        EXPECT_LE(std::abs(a.TexCoords.x - b.TexCoords.x), 0.5f / 65535.0f + 1e-6f);
+        EXPECT_LE(std::abs(a.TexCoords.y - b.TexCoords.y), 0.5f / 65535.0f + 1e-6f);
+        for (int j = 0; j < MAX_BONE_INFLUENCE; ++j) {
+            EXPECT_EQ(a.m_BoneIDs[j], b.m_BoneIDs[j]);
+            EXPECT_LE(std::abs(a.m_Weights[j] - b.m_Weights[j]), 0.5f / 255.0f + 1e-6f);
+        }
+    }
+}
+
+TEST(MeshOptimizerTest, PackedVerticesLimits) {
+    PackedVertexData packed;
+
+    // Static meshes get no skin stream, and tiled UVs fall back to half floats
+    auto vertices = MakeRandomVertices(10, glm::vec3(0.0f), 1.0f, false);
+    vertices[3].TexCoords = glm::vec2(4.5f, -1.0f);
+    ASSERT_TRUE(MeshOptimizerUtil::PackVertices(vertices, packed));
+    EXPECT_TRUE(packed.skin.empty());
+    EXPECT_TRUE(packed.half_tex_coords);
+    std::vector<Vertex> unpacked;
+    MeshOptimizerUtil::UnpackVertices(packed, unpacked);
+    EXPECT_EQ(unpacked[3].TexCoords, glm::vec2(4.5f, -1.0f));
+    EXPECT_EQ(unpacked[3].m_BoneIDs[0], -1);
+
+    // A small mesh far from its origin loses too much to half floats
+    EXPECT_FALSE(MeshOptimizerUtil::PackVertices(MakeRandomVertices(10, glm::vec3(5000.0f), 1.0f, false), packed));
+
+    vertices = MakeRandomVertices(10, glm::vec3(0.0f), 1.0f, true);
+    vertices[0].m_BoneIDs[2] = 255;
+    EXPECT_FALSE(MeshOptimizerUtil::PackVertices(vertices, packed));
+}
+
+TEST(MeshOptimizerTest, PackedMeshFormat) {
+    auto vertices = MakeRandomVertices(100, glm::vec3(0.0f), 1.0f, false);
+    Mesh mesh(vertices, {0, 1, 2}, {});
+    EXPECT_EQ(mesh.GetVertexFormat(), VertexFormat::Full);
+    EXPECT_EQ(mesh.GetVertexBytes(), 100 * sizeof(Vertex));
+
+    mesh.SetVertexFormat(VertexFormat::Packed);
+    EXPECT_EQ(mesh.GetVertexBytes(), 100 * sizeof(PackedVertex));
+    Mesh copy(mesh);
+    EXPECT_EQ(copy.GetVertexFormat(), VertexFormat::Packed);
+    Mesh constructed(vertices, {0, 1, 2}, {}, {}, {}, VertexFormat::Packed);
+    EXPECT_EQ(constructed.GetVertexFormat(), VertexFormat::Packed);
+
+    // Meshes that cannot be packed are uploaded full
+    Mesh far(MakeRandomVertices(100, glm::vec3(5000.0f), 1.0f, false), {0, 1, 2}, {});
+    far.SetVertexFormat(VertexFormat::Packed);
+    EXPECT_EQ(far.GetVertexBytes(), 100 * sizeof(Vertex));
+}
+
+TEST(MeshOptimizerBenchmark, PackedVertexMemory) {
+    std::vector<std::string> assets;
+    if (std::filesystem::exists("assets")) {
+        for (const auto& entry : std::filesystem::directory_iterator("assets")) {
+            auto extension = entry.path().extension().string();
+            if (extension == ".obj" || extension == ".glb" || extension == ".fbx") {
+                assets.push_back(entry.path().string());
+            }
+        }
+    }
+    if (assets.empty()) {
+        GTEST_SKIP() << "No bundled model assets found";
+    }
+    std::sort(assets.begin(), assets.end());
+
+    auto& manager = AssetManager::GetInstance();
+    auto& config = ConfigManager::GetInstance();
+    bool was_headless = manager.IsHeadless();
+    bool cache_enabled = config.GetAppSettingBool("model_cache_enabled", true);
+    bool packed_enabled = config.GetAppSettingBool("packed_vertex_format_enabled", false);
+    manager.SetHeadless(true);
+    config.SetBool("model_cache_enabled", false);
+    config.SetBool("packed_vertex_format_enabled", true);
+    manager.Clear();
+
+    size_t total_full = 0, total_packed = 0;
+    for (const auto& path : assets) {
+        auto data = manager.GetModelData(path);
+        if (!data)
+            continue;
+        size_t full = 0, packed = 0, unpackable = 0;
+        for (const auto& mesh : data->meshes) {
+            EXPECT_EQ(mesh.GetVertexFormat(), VertexFormat::Packed);
+            full += mesh.vertices.size() * sizeof(Vertex);
+            packed += mesh.GetVertexBytes();
+            unpackable += mesh.GetVertexBytes() == mesh.vertices.size() * sizeof(Vertex) && !mesh.vertices.empty();
+        }
+        total_full += full;
+        total_packed += packed;
+        std::cout << "[ BENCH    ] " << path << ": " << full / 1024 << " KiB full, " << packed / 1024
+                  << " KiB packed, " << (full - packed) / 1024 << " KiB saved (" << unpackable << " of "
+                  << data->meshes.size() << " meshes kept full)" << std::endl;
+    }
+    std::cout << "[ BENCH    ] " << assets.size() << " models: " << total_full / 1024 << " KiB full, "
+              << total_packed / 1024 << " KiB packed" << std::endl;
+    EXPECT_LE(total_packed, total_full);
+
+    manager.Clear();
+    manager.SetHeadless(was_headless);
+    config.SetBool("packed_vertex_format_enabled", packed_enabled);
+    config.SetBool("model_cache_enabled", cache_enabled);
+}
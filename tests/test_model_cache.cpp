@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include "ConfigManager.h"
+#include "asset_manager.h"
+#include "model.h"
+#include "model_cache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Boidsish;
+
+namespace {
+    std::string WriteSourceFile(const std::string& path, const std::string& contents) {
+        std::ofstream(path, std::ios::binary) << contents;
+        return path;
+    }
+
+    std::shared_ptr<ModelData> MakeModel() {
+        auto data = std::make_shared<ModelData>();
+        data->AddBone("hip", "", glm::translate(glm::mat4(1.0f), glm::vec3(0, 1, 0)));
+        data->AddBone("knee", "hip", glm::translate(glm::mat4(1.0f), glm::vec3(0, -0.5f, 0)));
+        data->global_inverse_transform = glm::scale(glm::mat4(1.0f), glm::vec3(2.0f));
+        data->aabb = AABB(glm::vec3(-1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+
+        for (int m = 0; m < 2; ++m) {
+            std::vector<Vertex>       vertices(5 + m);
+            std::vector<unsigned int> indices;
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                vertices[i].Position = glm::vec3(float(i), float(m), -float(i));
+                vertices[i].Normal = glm::vec3(0, 1, 0);
+                vertices[i].TexCoords = glm::vec2(0.1f * i, 0.2f * m);
+                vertices[i].m_BoneIDs[0] = int(i % 2);
+                vertices[i].m_Weights[0] = 1.0f;
+                indices.push_back(unsigned(i));
+            }
+            std::vector<Texture> textures;
+            textures.push_back({7, "texture_diffuse", m == 0 ? "*0" : "skin.png"});
+            data->meshes.emplace_back(vertices, indices, textures, std::vector<unsigned int>{0, 1, 2});
+            data->meshes.back().diffuseColor = glm::vec3(0.25f, 0.5f, float(m));
+            data->meshes.back().roughness = 0.125f;
+            data->meshes.back().has_vertex_colors = m == 1;
+            if (m == 1) {
+                data->meshes.back().lods = {{{0, 1, 2}, 0.5f}, {{}, 2.0f}};
+            }
+        }
+
+        data->meshlets.resize(2);
+        Meshlet meshlet{glm::vec3(1.0f), 2.0f, glm::vec3(0.0f), 0.5f, glm::vec3(0, 1, 0), 1, 0, 0, 3};
+        data->meshlets[1].meshlets.push_back(meshlet);
+        data->meshlets[1].vertices = {0, 1, 2};
+        data->meshlets[1].triangles = {0, 1, 2};
+
+        Animation anim;
+        anim.name = "walk";
+        anim.duration = 4.0f;
+        anim.ticksPerSecond = 24;
+        BoneAnimation track;
+        track.name = "knee";
+        track.positions = {{glm::vec3(0, 0, 0), 0.0f}, {glm::vec3(0, 1, 0), 2.0f}};
+        track.rotations = {{glm::angleAxis(0.5f, glm::vec3(1, 0, 0)), 0.0f}};
+        track.scales = {{glm::vec3(1.0f), 0.0f}};
+        track.numPositions = 2;
+        track.numRotations = 1;
+        track.numScalings = 1;
+        anim.boneAnimations.push_back(track);
+        data->animations.push_back(anim);
+        return data;
+    }
+
+    class ModelCacheTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            dir_ = std::filesystem::temp_directory_path() / "boidsish_model_cache_test";
+            std::filesystem::remove_all(dir_);
+            std::filesystem::create_directories(dir_);
+        }
+
+        void TearDown() override { std::filesystem::remove_all(dir_); }
+
+        std::string Path(const std::string& name) const { return (dir_ / name).string(); }
+
+        std::filesystem::path dir_;
+    };
+}
+
+TEST_F(ModelCacheTest, RoundTrip) {
+    auto source = WriteSourceFile(Path("model.obj"), "o model\n");
+    auto cache = Path("model.bmdl");
+    auto original = MakeModel();
+
+    ModelCache::EmbeddedTexture embedded;
+    embedded.key = "*0";
+    embedded.width = 3;
+    embedded.bytes = {1, 2, 3};
+    ASSERT_TRUE(ModelCache::Write(*original, {embedded}, source, 42, cache));
+
+    std::vector<std::string> resolved;
+    auto loaded = ModelCache::Read(cache, source, 42, [&](const ModelCache::TextureSource& texture, unsigned int& id) {
+        resolved.push_back(texture.path);
+        if (texture.path == "*0") {
+            EXPECT_EQ(texture.embedded_size, 3u);
+            EXPECT_EQ(texture.embedded[2], 3);
+        } else {
+            EXPECT_EQ(texture.embedded, nullptr);
+        }
+        EXPECT_EQ(texture.type, "texture_diffuse");
+        id = 100 + unsigned(resolved.size());
+        return true;
+    });
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(resolved, (std::vector<std::string>{"*0", "skin.png"}));
+
+    ASSERT_EQ(loaded->meshes.size(), original->meshes.size());
+    for (size_t m = 0; m < loaded->meshes.size(); ++m) {
+        const auto& a = loaded->meshes[m];
+        const auto& b = original->meshes[m];
+        ASSERT_EQ(a.vertices.size(), b.vertices.size());
+        EXPECT_EQ(std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(Vertex)), 0);
+        EXPECT_EQ(a.indices, b.indices);
+        EXPECT_EQ(a.shadow_indices, b.shadow_indices);
+        ASSERT_EQ(a.textures.size(), 1u);
+        EXPECT_EQ(a.textures[0].id, 101 + m);
+        EXPECT_EQ(a.diffuseColor, b.diffuseColor);
+        EXPECT_EQ(a.roughness, b.roughness);
+        EXPECT_EQ(a.has_vertex_colors, b.has_vertex_colors);
+        ASSERT_EQ(a.lods.size(), b.lods.size());
+        for (size_t l = 0; l < a.lods.size(); ++l) {
+            EXPECT_EQ(a.lods[l].indices, b.lods[l].indices);
+            EXPECT_EQ(a.lods[l].error, b.lods[l].error);
+        }
+    }
+
+    ASSERT_EQ(loaded->meshlets.size(), original->meshlets.size());
+    EXPECT_TRUE(loaded->meshlets[0].empty());
+    ASSERT_EQ(loaded->meshlets[1].meshlets.size(), 1u);
+    const Meshlet& meshlet = loaded->meshlets[1].meshlets[0];
+    EXPECT_EQ(std::memcmp(&meshlet, original->meshlets[1].meshlets.data(), sizeof(Meshlet)), 0);
+    EXPECT_EQ(loaded->meshlets[1].vertices, original->meshlets[1].vertices);
+    EXPECT_EQ(loaded->meshlets[1].triangles, original->meshlets[1].triangles);
+
+    EXPECT_EQ(loaded->bone_count, 2);
+    ASSERT_EQ(loaded->bone_info_map.count("knee"), 1u);
+    EXPECT_EQ(loaded->bone_info_map["knee"].id, original->bone_info_map["knee"].id);
+    EXPECT_EQ(loaded->bone_info_map["knee"].offset, original->bone_info_map["knee"].offset);
+    EXPECT_EQ(loaded->global_inverse_transform, original->global_inverse_transform);
+    EXPECT_EQ(loaded->aabb.max, original->aabb.max);
+
+    const NodeData* knee = loaded->root_node.FindNode("knee");
+    ASSERT_NE(knee, nullptr);
+    EXPECT_EQ(knee->transformation, original->root_node.FindNode("knee")->transformation);
+    EXPECT_NE(loaded->root_node.FindNode("hip")->FindNode("knee"), nullptr);
+
+    ASSERT_EQ(loaded->animations.size(), 1u);
+    const auto& track = loaded->animations[0].boneAnimations[0];
+    EXPECT_EQ(loaded->animations[0].name, "walk");
+    EXPECT_EQ(loaded->animations[0].ticksPerSecond, 24);
+    EXPECT_EQ(track.name, "knee");
+    ASSERT_EQ(track.positions.size(), 2u);
+    EXPECT_EQ(track.positions[1].position, glm::vec3(0, 1, 0));
+    EXPECT_EQ(track.numPositions, 2);
+    EXPECT_EQ(track.rotations[0].orientation, original->animations[0].boneAnimations[0].rotations[0].orientation);
+}
+
+TEST_F(ModelCacheTest, RejectsStaleAndCorruptFiles) {
+    auto source = WriteSourceFile(Path("model.obj"), "o model\n");
+    auto cache = Path("model.bmdl");
+    auto resolve = [](const ModelCache::TextureSource&, unsigned int& id) {
+        id = 1;
+        return true;
+    };
+    ASSERT_TRUE(ModelCache::Write(*MakeModel(), {}, source, 1, cache));
+
+    // Different import options
+    EXPECT_EQ(ModelCache::Read(cache, source, 2, resolve), nullptr);
+    EXPECT_NE(ModelCache::Read(cache, source, 1, resolve), nullptr);
+
+    // Edited source
+    WriteSourceFile(source, "o model\nv 0 0 0\n");
+    EXPECT_EQ(ModelCache::Read(cache, source, 1, resolve), nullptr);
+    EXPECT_TRUE(std::filesystem::exists(cache));
+
+    // Truncated body is deleted
+    ASSERT_TRUE(ModelCache::Write(*MakeModel(), {}, source, 1, cache));
+    std::filesystem::resize_file(cache, std::filesystem::file_size(cache) / 2);
+    EXPECT_EQ(ModelCache::Read(cache, source, 1, resolve), nullptr);
+    EXPECT_FALSE(std::filesystem::exists(cache));
+
+    EXPECT_EQ(ModelCache::Read(Path("missing.bmdl"), source, 1, resolve), nullptr);
+}
+
+TEST(ModelCacheBenchmark, ColdVersusCachedLoad) {
+    std::vector<std::string> assets;
+    if (std::filesystem::exists("assets")) {
+        for (const auto& entry : std::filesystem::directory_iterator("assets")) {
+            auto extension = entry.path().extension().string();
+            if (extension == ".obj" || extension == ".glb" || extension == ".fbx") {
+                assets.push_back(entry.path().string());
+            }
+        }
+    }
+    if (assets.empty()) {
+        GTEST_SKIP() << "No bundled model assets found";
+    }
+    std::sort(assets.begin(), assets.end());
+
+    auto& manager = AssetManager::GetInstance();
+    auto& config = ConfigManager::GetInstance();
+    manager.SetHeadless(true);
+
+    auto load_all = [&](bool use_cache) {
+        config.SetBool("model_cache_enabled", use_cache);
+        manager.Clear();
+        size_t vertices = 0;
+        auto   start = std::chrono::steady_clock::now();
+        for (const auto& path : assets) {
+            if (auto data = manager.GetModelData(path)) {
+                for (const auto& mesh : data->meshes) {
+                    vertices += mesh.vertices.size();
+                }
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(ms, vertices);
+    };
+
+    auto [cold_ms, cold_vertices] = load_all(false);
+    for (const auto& path : assets) {
+        manager.BuildModelCache(path);
+    }
+    auto [cached_ms, cached_vertices] = load_all(true);
+
+    std::cout << "[ BENCH    ] " << assets.size() << " models, " << cold_vertices << " vertices: cold import "
+              << cold_ms << " ms, cached " << cached_ms << " ms" << std::endl;
+    EXPECT_EQ(cached_vertices, cold_vertices);
+
+    for (const auto& path : assets) {
+        std::filesystem::remove(ModelCache::CachePathFor(path));
+    }
+    manager.Clear();
+    manager.SetHeadless(false);
+    config.SetBool("model_cache_enabled", true);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include "path.h"
+#include "spline.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Boidsish;
+
+namespace {
+    std::shared_ptr<Path> MakeTour(int waypoints, PathMode mode, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> wobble(-8.0f, 8.0f);
+        auto                                  path = std::make_shared<Path>(1);
+        for (int i = 0; i < waypoints; ++i) {
+            float angle = 6.2831853f * i / waypoints;
+            float radius = 4.0f * waypoints;
+            path->AddWaypoint(
+                Vector3(std::cos(angle) * radius + wobble(rng), wobble(rng), std::sin(angle) * radius + wobble(rng))
+            );
+        }
+        path->SetMode(mode);
+        return path;
+    }
+
+    // The parameter-space stepping CalculateUpdate used before, for the benchmark baseline
+    PathUpdateResult ParameterStep(const Path& path, const PathFollower& f, float delta_time) {
+        const auto& waypoints = path.GetWaypoints();
+        int         n = static_cast<int>(waypoints.size());
+        int         num_segments = n;
+        auto        controls = [&](int i, Vector3& p0, Vector3& p1, Vector3& p2, Vector3& p3) {
+            p0 = waypoints[(i - 1 + n) % n].position;
+            p1 = waypoints[i].position;
+            p2 = waypoints[(i + 1) % n].position;
+            p3 = waypoints[(i + 2) % n].position;
+        };
+
+        int     segment = f.segment_index;
+        float   t = f.t;
+        float   distance_to_travel = f.speed * delta_time;
+        Vector3 p0, p1, p2, p3;
+        while (distance_to_travel > 1e-6) {
+            controls(segment, p0, p1, p2, p3);
+            float   segment_length = 0;
+            Vector3 prev_point = Spline::CatmullRom(0, p0, p1, p2, p3);
+            for (int i = 1; i <= 10; ++i) {
+                Vector3 curr_point = Spline::CatmullRom(i / 10.0f, p0, p1, p2, p3);
+                segment_length += (curr_point - prev_point).Magnitude();
+                prev_point = curr_point;
+            }
+            float remaining = (1.0f - t) * segment_length;
+            if (distance_to_travel <= remaining) {
+                t += distance_to_travel / segment_length;
+                distance_to_travel = 0.0f;
+            } else {
+                distance_to_travel -= remaining;
+                segment = (segment + 1) % num_segments;
+                t = 0.0f;
+            }
+        }
+
+        controls(segment, p0, p1, p2, p3);
+        Vector3 position = Spline::CatmullRom(t, p0, p1, p2, p3);
+        Vector3 tangent = Spline::CatmullRomDerivative(t, p0, p1, p2, p3).Normalized();
+        Vector3 up = waypoints[segment].up * (1.0f - t) + waypoints[(segment + 1) % n].up * t;
+        Vector3 right = tangent.Cross(up).Normalized();
+        up = right.Cross(tangent).Normalized();
+        glm::mat4 rotation = glm::lookAt(glm::vec3(0.0f), glm::vec3(tangent), glm::vec3(up));
+        glm::quat orientation = glm::conjugate(glm::quat_cast(rotation));
+        return {position, (position - f.position).Normalized(), orientation, 1, segment, t};
+    }
+}
+
+TEST(PathFollowTest, ConstantSpeedAcrossUnevenSpacing) {
+    // Waypoint gaps from 2 to 15 units; stepping in spline parameter would change speed 7-fold
+    Path path(1);
+    for (float x : {0.0f, 2.0f, 5.0f, 10.0f, 18.0f, 30.0f, 45.0f}) {
+        path.AddWaypoint(Vector3(x, std::sin(x * 0.2f) * 3.0f, 0.0f));
+    }
+
+    const float  speed = 5.0f, dt = 0.01f;
+    PathFollower follower{Vector3(0, 0, 0), 0, 0.0f, 1, speed};
+    Vector3      previous(0, 0, 0);
+    float        travelled = 0.0f;
+    int          steps = 0;
+    while (true) {
+        auto update =
+            path.CalculateUpdate(follower.position, glm::quat(), follower.segment_index, follower.t, 1, speed, dt);
+        float step = (update.position - previous).Magnitude();
+        if (update.new_segment_index == 5 && update.new_t >= 1.0f)
+            break;
+        if (steps > 0) {
+            ASSERT_NEAR(step, speed * dt, speed * dt * 0.01f) << "step " << steps;
+        }
+        travelled += step;
+        previous = update.position;
+        follower = {update.position, update.new_segment_index, update.new_t, update.new_direction, speed};
+        ASSERT_LT(++steps, 10000);
+    }
+    EXPECT_NEAR(travelled, path.GetLength(), path.GetLength() * 0.01f);
+
+    // Once a ONCE path is finished the follower stays at the end
+    auto done = path.CalculateUpdate(previous, glm::quat(), 5, 1.0f, 1, speed, dt);
+    EXPECT_EQ(done.new_segment_index, 5);
+    EXPECT_FLOAT_EQ(done.new_t, 1.0f);
+    EXPECT_NEAR(done.position.x, 45.0f, 1e-3f);
+}
+
+TEST(PathFollowTest, ReverseAndLoopEnds) {
+    auto reverse = MakeTour(12, PathMode::REVERSE, 1);
+    auto bounce = reverse->CalculateUpdate(Vector3(), glm::quat(), 10, 0.9f, 1, reverse->GetLength() * 0.05f, 1.0f);
+    EXPECT_EQ(bounce.new_direction, -1);
+    EXPECT_EQ(bounce.new_segment_index, 10);
+
+    // A whole lap ends where it started
+    auto loop = MakeTour(12, PathMode::LOOP, 1);
+    auto start = loop->CalculateUpdate(Vector3(), glm::quat(), 3, 0.25f, 1, 0.0f, 0.0f);
+    auto lap = loop->CalculateUpdate(Vector3(), glm::quat(), 3, 0.25f, 1, loop->GetLength() * 2.0f, 1.0f);
+    EXPECT_NEAR((lap.position - start.position).Magnitude(), 0.0f, 1e-2f);
+    auto back = loop->CalculateUpdate(Vector3(), glm::quat(), 0, 0.1f, -1, loop->GetLength() * 0.1f, 1.0f);
+    EXPECT_EQ(back.new_segment_index, 10);
+}
+
+TEST(PathFollowTest, BatchMatchesSingleUpdates) {
+    auto                      path = MakeTour(40, PathMode::REVERSE, 2);
+    std::mt19937              rng(3);
+    std::vector<PathFollower> followers;
+    for (int i = 0; i < 500; ++i) {
+        followers.push_back(
+            {Vector3(0, 0, 0),
+             static_cast<int>(rng() % 39),
+             (rng() % 1000) / 1000.0f,
+             (rng() % 2) ? 1 : -1,
+             1.0f + (rng() % 50)}
+        );
+    }
+    std::vector<PathUpdateResult> results(followers.size());
+    path->CalculateUpdates(followers, 0.5f, results);
+    for (size_t i = 0; i < followers.size(); ++i) {
+        const auto& f = followers[i];
+        auto        single =
+            path->CalculateUpdate(f.position, glm::quat(), f.segment_index, f.t, f.direction, f.speed, 0.5f);
+        ASSERT_EQ(results[i].new_segment_index, single.new_segment_index);
+        ASSERT_EQ(results[i].new_direction, single.new_direction);
+        ASSERT_EQ(results[i].new_t, single.new_t);
+    }
+}
+
+TEST(PathFollowBenchmark, HundredThousandFollowers) {
+    auto path = MakeTour(200, PathMode::LOOP, 4);
+    path->GetLength();
+
+    const int                             count = 100000;
+    std::mt19937                          rng(5);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<PathFollower>             batch(count), scalar;
+    for (auto& f : batch) {
+        f = {Vector3(0, 0, 0), static_cast<int>(unit(rng) * 199.0f), unit(rng), 1, 5.0f + 20.0f * unit(rng)};
+    }
+    scalar = batch;
+
+    std::vector<PathUpdateResult> results(count);
+    double                        batch_ms = 0.0, scalar_ms = 0.0;
+    const int                     frames = 5;
+    for (int frame = 0; frame < frames; ++frame) {
+        auto start = std::chrono::steady_clock::now();
+        path->CalculateUpdates(batch, 1.0f / 60.0f, results);
+        for (int i = 0; i < count; ++i) {
+            batch[i] = {results[i].position, results[i].new_segment_index, results[i].new_t, 1, batch[i].speed};
+        }
+        auto mid = std::chrono::steady_clock::now();
+        for (auto& f : scalar) {
+            auto update = ParameterStep(*path, f, 1.0f / 60.0f);
+            f = {update.position, update.new_segment_index, update.new_t, 1, f.speed};
+        }
+        auto end = std::chrono::steady_clock::now();
+        batch_ms += std::chrono::duration<double, std::milli>(mid - start).count();
+        scalar_ms += std::chrono::duration<double, std::milli>(end - mid).count();
+    }
+
+    for (const auto& r : results) {
+        ASSERT_TRUE(std::isfinite(r.position.x) && std::isfinite(r.orientation.w));
+    }
+    std::cout << "[ BENCH    ] " << count << " path followers: " << batch_ms / frames
+              << " ms per frame (per-entity parameter stepping: " << scalar_ms / frames << " ms)" << std::endl;
+}
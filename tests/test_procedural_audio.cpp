@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "audio_dsp.h"
+#include "audio_manager.h"
+#include "rain_audio_effect.h"
+#include "rustle_audio_effect.h"
+#include "service_locator.h"
+#include "wind_audio_effect.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace Boidsish;
+
+namespace {
+    std::vector<float> RandomSignal(size_t count, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<float>                    signal(count);
+        for (auto& s : signal) {
+            s = unit(rng);
+        }
+        return signal;
+    }
+
+    // The per-sample loops the effects used before the block layer, for the benchmark baseline
+    struct ScalarReference {
+        uint32_t state = 123456789;
+        float    a = 0.0f, b = 0.0f;
+
+        float White() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return (static_cast<float>(state) / static_cast<float>(0xFFFFFFFF)) * 2.0f - 1.0f;
+        }
+
+        void Rain(float* out, size_t frames, float intensity) {
+            for (size_t i = 0; i < frames; ++i) {
+                float white = White();
+                a += 0.01f * (white - a);
+                float drop = 0.0f;
+                if ((static_cast<float>(state & 0xFFFF) / 65535.0f) < 0.0005f + intensity * 0.01f) {
+                    drop = white * 0.2f * intensity;
+                }
+                b += 0.07f * (drop - b);
+                out[2 * i] = out[2 * i + 1] = a * 0.05f * intensity + b;
+            }
+        }
+
+        void Wind(float* out, size_t frames, float f, float damping, float gain) {
+            for (size_t i = 0; i < frames; ++i) {
+                a += f * b;
+                float high = White() - a - damping * b;
+                b += f * high;
+                out[2 * i] = out[2 * i + 1] = b * gain;
+            }
+        }
+
+        void Rustle(float* out, size_t frames, float alpha, float gain) {
+            for (size_t i = 0; i < frames; ++i) {
+                float white = White();
+                a += alpha * (white - a);
+                out[2 * i] = out[2 * i + 1] = (white - a) * gain;
+            }
+        }
+    };
+
+    // Best wall time of three runs rendering `seconds` of stereo 48 kHz audio in 480-frame callbacks
+    double RenderMs(const std::function<void(float*, size_t)>& render, double seconds) {
+        std::vector<float> buffer(480 * 2);
+        size_t             callbacks = static_cast<size_t>(seconds * 100.0);
+        double             best = 1e30;
+        for (int run = 0; run < 3; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < callbacks; ++i) {
+                render(buffer.data(), 480);
+            }
+            best = std::min(
+                best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+            );
+        }
+        return best;
+    }
+}
+
+TEST(AudioDspTest, FiltersMatchPerSampleRecurrence) {
+    auto input = RandomSignal(1001, 1);
+
+    // Uneven chunk sizes cover the four-sample groups and the scalar remainder
+    dsp::OnePoleFilter       lowpass;
+    dsp::StateVariableFilter bandpass;
+    std::vector<float>       low(input.size()), band(input.size());
+    for (size_t i = 0, chunk = 1; i < input.size(); i += chunk, chunk = chunk % 13 + 3) {
+        uint32_t n = static_cast<uint32_t>(std::min(chunk, input.size() - i));
+        lowpass.Lowpass(&input[i], &low[i], n, 0.07f);
+        bandpass.Bandpass(&input[i], &band[i], n, 0.05f, 0.8f);
+    }
+
+    float ref_low = 0.0f, svf_low = 0.0f, svf_band = 0.0f;
+    for (size_t i = 0; i < input.size(); ++i) {
+        ref_low += 0.07f * (input[i] - ref_low);
+        svf_low += 0.05f * svf_band;
+        svf_band += 0.05f * (input[i] - svf_low - 0.8f * svf_band);
+        ASSERT_NEAR(low[i], ref_low, 1e-4f) << i;
+        ASSERT_NEAR(band[i], svf_band, 1e-4f) << i;
+    }
+
+    // Highpass is the input minus the lowpass, in place
+    dsp::OnePoleFilter highpass;
+    auto               high = input;
+    highpass.Highpass(high.data(), high.data(), static_cast<uint32_t>(high.size()), 0.07f);
+    for (size_t i = 0; i < input.size(); ++i) {
+        ASSERT_NEAR(high[i], input[i] - low[i], 1e-4f) << i;
+    }
+}
+
+TEST(AudioDspTest, NoiseAndInterleave) {
+    dsp::NoiseGenerator noise(42);
+    std::vector<float>  white(10007);
+    noise.Fill(white.data(), nullptr, static_cast<uint32_t>(white.size()));
+    double sum = 0.0, sum_sq = 0.0;
+    for (float w : white) {
+        ASSERT_GE(w, -1.0f);
+        ASSERT_LT(w, 1.0f);
+        sum += w;
+        sum_sq += w * w;
+    }
+    EXPECT_NEAR(sum / white.size(), 0.0, 0.03);
+    EXPECT_NEAR(sum_sq / white.size(), 1.0 / 3.0, 0.02);
+
+    float        left[3] = {1, 2, 3}, right[3] = {4, 5, 6};
+    const float* planes[2] = {left, right};
+    float        out[9];
+    dsp::Interleave(planes, 2, out, 2, 3);
+    EXPECT_EQ(std::vector<float>(out, out + 6), (std::vector<float>{1, 4, 2, 5, 3, 6}));
+    dsp::Interleave(planes, 1, out, 3, 3);
+    EXPECT_EQ(std::vector<float>(out, out + 9), (std::vector<float>{1, 1, 1, 2, 2, 2, 3, 3, 3}));
+    dsp::Interleave(planes, 0, out, 3, 3);
+    EXPECT_EQ(std::vector<float>(out, out + 9), std::vector<float>(9, 0.0f));
+}
+
+TEST(AudioDspBenchmark, EffectRealTimeFactor) {
+    ServiceLocator loc;
+    AudioManager   audio(loc, true);
+    AudioState     state;
+    state.rain_intensity = 1.0f;
+    state.wind_strength = 1.0f;
+    state.grass_density = 1.0f;
+
+    RainAudioEffect   rain(audio);
+    WindAudioEffect   wind(audio);
+    RustleAudioEffect rustle(audio);
+    for (int i = 0; i < 50; ++i) {
+        rain.OnUpdate(0.1f, state);
+        wind.OnUpdate(0.1f, state);
+        rustle.OnUpdate(0.1f, state);
+    }
+
+    const double    seconds = 20.0;
+    ScalarReference reference;
+    struct Case {
+        const char*                           name;
+        std::function<void(float*, size_t)>   block;
+        std::function<void(float*, size_t)>   scalar;
+    } cases[] = {
+        {"rain",
+         [&](float* out, size_t n) { rain.OnRead(out, n); },
+         [&](float* out, size_t n) { reference.Rain(out, n, 1.0f); }},
+        {"wind",
+         [&](float* out, size_t n) { wind.OnRead(out, n); },
+         [&](float* out, size_t n) { reference.Wind(out, n, 0.045f, 1.0f / 0.901f, 0.5f); }},
+        {"rustle",
+         [&](float* out, size_t n) { rustle.OnRead(out, n); },
+         [&](float* out, size_t n) { reference.Rustle(out, n, 0.12f, 0.25f); }},
+    };
+
+    for (const auto& c : cases) {
+        double block_ms = RenderMs(c.block, seconds);
+        double scalar_ms = RenderMs(c.scalar, seconds);
+        std::cout << "[ BENCH    ] " << c.name << ": " << seconds * 1000.0 / block_ms << "x real time (block), "
+                  << seconds * 1000.0 / scalar_ms << "x real time (per-sample)" << std::endl;
+        EXPECT_GT(seconds * 1000.0 / block_ms, 1.0);
+    }
+
+    // The rendered signal stays bounded
+    std::vector<float> buffer(4800 * 2);
+    for (auto* source : std::initializer_list<ProceduralAudioSource*>{&rain, &wind, &rustle}) {
+        source->OnRead(buffer.data(), 4800);
+        for (float s : buffer) {
+            ASSERT_TRUE(std::isfinite(s));
+            ASSERT_LT(std::abs(s), 4.0f);
+        }
+    }
+}
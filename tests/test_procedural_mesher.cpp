@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "model.h"
+#include "procedural_generator.h"
+#include "procedural_mesher.h"
+#include "procedural_optimizer.h"
+#include "procedural_refiner.h"
+#include "thread_pool.h"
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+using namespace Boidsish;
+
+namespace {
+    struct NamedIR {
+        const char*  name;
+        ProceduralIR ir;
+    };
+
+    // The largest IRs the generators produce with their own configs
+    std::vector<NamedIR> MakeLargeIRs() {
+        SpaceColonizationConfig dense;
+        dense.attractor_density = 4.0f;
+
+        std::vector<NamedIR> irs;
+        irs.push_back({"tree depth 5", ProceduralGenerator::GenerateTreeIR(1337, "", {}, 5)});
+        irs.push_back({"critter depth 4", ProceduralGenerator::GenerateCritterIR(1337, "", {}, 4)});
+        irs.push_back({"flower depth 4", ProceduralGenerator::GenerateFlowerIR(1337, "", {}, 4)});
+        irs.push_back({"space colonization", ProceduralGenerator::GenerateSpaceColonizationTreeIR(1338, dense)});
+        irs.push_back({"spring", ProceduralGenerator::GenerateSpringPlantIR(1337)});
+        irs.push_back({"structure", ProceduralGenerator::GenerateStructureIR(1337)});
+        for (auto& [name, ir] : irs) {
+            ProceduralOptimizer::Optimize(ir);
+            ProceduralRefiner::Refine(ir);
+        }
+        return irs;
+    }
+
+    // Meshes on the calling thread, as GenerateVariants' workers do
+    std::shared_ptr<Model> GenerateSerial(const ProceduralIR& ir) {
+        PoolTaskScope scope;
+        return ProceduralMesher::GenerateModel(ir);
+    }
+
+    double TimeMs(const std::function<void()>& f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TEST(ProceduralMesherTest, ParallelMatchesSerial) {
+    for (const auto& [name, ir] : MakeLargeIRs()) {
+        auto parallel = ProceduralMesher::GenerateModel(ir);
+        auto serial = GenerateSerial(ir);
+        ASSERT_NE(parallel, nullptr) << name;
+        ASSERT_NE(serial, nullptr) << name;
+
+        EXPECT_EQ(parallel->GetData()->aabb.min, serial->GetData()->aabb.min) << name;
+        EXPECT_EQ(parallel->GetData()->aabb.max, serial->GetData()->aabb.max) << name;
+        const auto& a = parallel->getMeshes();
+        const auto& b = serial->getMeshes();
+        ASSERT_EQ(a.size(), b.size()) << name;
+        for (size_t m = 0; m < a.size(); ++m) {
+            ASSERT_EQ(a[m].vertices.size(), b[m].vertices.size()) << name;
+            EXPECT_EQ(std::memcmp(a[m].vertices.data(), b[m].vertices.data(), a[m].vertices.size() * sizeof(Vertex)), 0)
+                << name;
+            EXPECT_EQ(a[m].indices, b[m].indices) << name;
+            EXPECT_EQ(a[m].shadow_indices, b[m].shadow_indices) << name;
+        }
+    }
+}
+
+TEST(ProceduralMesherTest, MeshingBenchmark) {
+    for (const auto& [name, ir] : MakeLargeIRs()) {
+        double serial = TimeMs([&] { GenerateSerial(ir); });
+        double parallel = TimeMs([&] { ProceduralMesher::GenerateModel(ir); });
+        std::cout << "[ BENCH    ] " << name << " (" << ir.elements.size() << " elements): serial " << serial
+                  << " ms, parallel " << parallel << " ms" << std::endl;
+    }
+}
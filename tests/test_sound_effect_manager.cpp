@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "audio_manager.h"
+#include "service_locator.h"
+#include "sound_effect_manager.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace Boidsish;
+
+namespace {
+    const char* kClip = "assets/rocket_explosion.wav";
+
+    // Headless engine: miniaudio mixes on demand through ReadFrames, no device is opened
+    class SoundEffectManagerTest : public ::testing::Test {
+    protected:
+        void SetUp() override { loc.Register<AudioManager>(true); }
+
+        ServiceLocator loc;
+    };
+}
+
+TEST_F(SoundEffectManagerTest, BudgetKeepsNearestAndHighestPriority) {
+    SoundEffectManager manager(loc, 16);
+    manager.SetMaxAudibleVoices(4);
+    EXPECT_EQ(manager.GetMaxAudibleVoices(), 4u);
+
+    std::vector<std::shared_ptr<SoundEffect>> effects;
+    for (int i = 0; i < 12; ++i) {
+        effects.push_back(manager.AddEffect(kClip, glm::vec3(2.0f + i * 10.0f, 0, 0), glm::vec3(0), 1.0f, true));
+        ASSERT_NE(effects.back(), nullptr);
+    }
+    auto urgent = manager.AddEffect(kClip, glm::vec3(500, 0, 0), glm::vec3(0), 1.0f, true, -1.0f, 10);
+    ASSERT_NE(urgent, nullptr);
+
+    manager.Update(0.016f);
+    EXPECT_EQ(manager.GetEffectCount(), 13u);
+    EXPECT_EQ(manager.GetAudibleCount(), 4u);
+    EXPECT_FALSE(urgent->IsVirtual());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_FALSE(effects[i]->IsVirtual()) << i;
+    }
+    for (int i = 3; i < 12; ++i) {
+        EXPECT_TRUE(effects[i]->IsVirtual()) << i;
+    }
+
+    // A virtual effect keeps its clock and takes a voice once it becomes the nearest
+    effects[11]->SetPosition(glm::vec3(1, 0, 0));
+    manager.Update(0.016f);
+    EXPECT_FALSE(effects[11]->IsVirtual());
+    EXPECT_TRUE(effects[2]->IsVirtual());
+    EXPECT_NEAR(effects[11]->GetPlaybackTime(), 0.032f, 1e-5f);
+
+    manager.RemoveEffect(urgent);
+    manager.Update(0.016f);
+    EXPECT_EQ(manager.GetEffectCount(), 12u);
+    EXPECT_EQ(manager.GetAudibleCount(), 4u);
+}
+
+TEST_F(SoundEffectManagerTest, OneShotsFinishWhileVirtual) {
+    SoundEffectManager manager(loc, 4);
+    manager.SetMaxAudibleVoices(1);
+    auto heard = manager.AddEffect(kClip, glm::vec3(1, 0, 0));
+    auto culled = manager.AddEffect(kClip, glm::vec3(50, 0, 0));
+    ASSERT_NE(heard, nullptr);
+    ASSERT_NE(culled, nullptr);
+    EXPECT_FALSE(heard->IsVirtual());
+    EXPECT_TRUE(culled->IsVirtual());
+
+    for (int i = 0; i < 600 && manager.GetEffectCount() > 0; ++i) {
+        manager.Update(0.05f);
+    }
+    EXPECT_EQ(manager.GetEffectCount(), 0u);
+    EXPECT_FALSE(culled->IsActive());
+    EXPECT_EQ(manager.AddEffect("assets/does_not_exist.wav", glm::vec3(0)), nullptr);
+}
+
+TEST_F(SoundEffectManagerTest, MixCostBenchmark) {
+    auto   audio = loc.Get<AudioManager>();
+    size_t pool = 512;
+    std::vector<float> buffer(480 * 2);
+
+    for (size_t count : {8, 32, 128, 512}) {
+        for (size_t budget : {SoundEffectManager::kDefaultMaxAudibleVoices, count}) {
+            SoundEffectManager manager(loc, pool);
+            manager.SetMaxAudibleVoices(budget);
+            for (size_t i = 0; i < count; ++i) {
+                manager.AddEffect(kClip, glm::vec3(1.0f + i, 0, 0), glm::vec3(0), 1.0f, true);
+            }
+            manager.Update(0.01f);
+
+            // One second of 48 kHz output in 10 ms blocks, updating the manager per block
+            auto start = std::chrono::steady_clock::now();
+            for (int block = 0; block < 100; ++block) {
+                manager.Update(0.01f);
+                audio->ReadFrames(buffer.data(), 480);
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << "[ BENCH    ] " << count << " effects, budget " << budget << ": " << manager.GetAudibleCount()
+                      << " audible, 1 s mixed in " << ms << " ms" << std::endl;
+            EXPECT_EQ(manager.GetAudibleCount(), std::min(count, budget));
+            if (budget >= count) {
+                break;
+            }
+        }
+    }
+}
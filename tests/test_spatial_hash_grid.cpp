@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "procedural_generator.h"
+#include "spatial_hash_grid.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace Boidsish;
+
+namespace {
+    std::vector<glm::vec3> RandomPoints(int count, float spread, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> unit(-spread, spread);
+        std::vector<glm::vec3>                points;
+        for (int i = 0; i < count; ++i) {
+            points.emplace_back(unit(rng), unit(rng), unit(rng));
+        }
+        return points;
+    }
+
+    bool SameGeometry(const ProceduralIR& a, const ProceduralIR& b) {
+        if (a.elements.size() != b.elements.size())
+            return false;
+        for (size_t i = 0; i < a.elements.size(); ++i) {
+            const auto& x = a.elements[i];
+            const auto& y = b.elements[i];
+            if (x.type != y.type || x.position != y.position || x.end_position != y.end_position ||
+                x.radius != y.radius || x.end_radius != y.end_radius)
+                return false;
+        }
+        return true;
+    }
+
+    template <typename F>
+    double TimeMs(F&& body) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TEST(SpatialHashGridTest, MatchesLinearScan) {
+    // Duplicated points check the lowest-index tie break, negative coordinates the cell keys
+    auto points = RandomPoints(2000, 20.0f, 1);
+    points.push_back(points[10]);
+    points.push_back(points[500]);
+
+    SpatialHashGrid grid(1.5f);
+    for (size_t i = 0; i < points.size(); ++i) {
+        grid.Insert(static_cast<int>(i), points[i]);
+    }
+    EXPECT_EQ(grid.GetSize(), points.size());
+
+    for (const auto& query : RandomPoints(500, 22.0f, 2)) {
+        for (float radius : {0.5f, 1.5f, 4.0f}) {
+            int   nearest = -1;
+            float best = radius * radius;
+            int   within = 0;
+            for (size_t i = 0; i < points.size(); ++i) {
+                float d2 = glm::distance2(query, points[i]);
+                within += d2 < radius * radius;
+                if (d2 < best) {
+                    best = d2;
+                    nearest = static_cast<int>(i);
+                }
+            }
+
+            int found = 0;
+            grid.ForEachWithin(query, radius, [&](int, float) { ++found; });
+            ASSERT_EQ(grid.FindNearest(query, radius), nearest);
+            ASSERT_EQ(grid.AnyWithin(query, radius), within > 0);
+            ASSERT_EQ(found, within);
+        }
+    }
+    EXPECT_EQ(grid.FindNearest(points[10], 0.1f), 10);
+
+    grid.Clear();
+    EXPECT_EQ(grid.GetSize(), 0u);
+    EXPECT_EQ(grid.FindNearest(points[10], 1.0f), -1);
+    grid.Insert(7, points[10]);
+    EXPECT_EQ(grid.FindNearest(points[10], 1.0f), 7);
+}
+
+TEST(ProceduralGrowthTest, DenseTreesAreDeterministic) {
+    // Enough attractors to associate them on the thread pool
+    SpaceColonizationConfig config;
+    config.attractor_density = 6.0f;
+    config.max_iterations = 40;
+    auto first = ProceduralGenerator::GenerateSpaceColonizationTreeIR(1, config);
+    auto second = ProceduralGenerator::GenerateSpaceColonizationTreeIR(1, config);
+    EXPECT_GT(first.elements.size(), 100u);
+    EXPECT_TRUE(SameGeometry(first, second));
+}
+
+TEST(ProceduralGrowthBenchmark, GenerationTimeVsSize) {
+    for (float density : {1.0f, 2.0f, 4.0f, 8.0f}) {
+        SpaceColonizationConfig config;
+        config.attractor_density = density;
+        size_t elements = 0;
+        double ms = TimeMs([&] {
+            for (unsigned int seed = 0; seed < 6; ++seed) {
+                elements += ProceduralGenerator::GenerateSpaceColonizationTreeIR(seed, config).elements.size();
+            }
+        });
+        std::cout << "[ BENCH    ] space colonization, " << density << "x attractors: " << elements / 6
+                  << " elements per tree, " << ms / 6 << " ms per tree" << std::endl;
+    }
+
+    for (int iterations : {5, 6, 7, 8}) {
+        SpringPlantConfig config;
+        config.iterations = iterations;
+        config.branch_length_factor = 2.0f;
+        config.equilibrium_time = 2.0f;
+        config.size_limit = 40.0f;
+        size_t elements = 0;
+        double ms = TimeMs([&] {
+            for (unsigned int seed = 0; seed < 2; ++seed) {
+                elements += ProceduralGenerator::GenerateSpringPlantIR(seed, config).elements.size();
+            }
+        });
+        std::cout << "[ BENCH    ] spring plant, " << iterations << " generations: " << elements / 2
+                  << " elements per plant, " << ms / 2 << " ms per plant" << std::endl;
+    }
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "graphics.h"
+#include "terrain_generator.h"
+#include "thread_pool.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace Boidsish;
+
+namespace {
+    std::unique_ptr<TerrainGenerator> MakeLoadedTerrain() {
+        auto    gen = std::make_unique<TerrainGenerator>();
+        Frustum frustum;
+        for (auto& plane : frustum.planes) {
+            plane.normal = glm::vec3(0, 1, 0);
+            plane.distance = 1e10f; // Everything is visible
+        }
+        Camera camera;
+        camera.x = 0;
+        camera.y = 10;
+        camera.z = 0;
+        gen->WaitForAllChunks(frustum, camera);
+        return gen;
+    }
+
+    // A flock spread over the cached area, with a few members outside it to hit the procedural fallback
+    std::vector<glm::vec3> MakeFlock(int count, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<glm::vec3>                points;
+        for (int i = 0; i < count; ++i) {
+            float extent = (i % 50 == 0) ? 2000.0f : 250.0f;
+            points.emplace_back(unit(rng) * extent, 20.0f + 20.0f * unit(rng), unit(rng) * extent);
+        }
+        return points;
+    }
+}
+
+TEST(TerrainBatchTest, MatchesSingleQueries) {
+    auto gen = MakeLoadedTerrain();
+    auto points = MakeFlock(5000, 1);
+
+    std::vector<glm::vec2> xz;
+    for (const auto& p : points) {
+        xz.emplace_back(p.x, p.z);
+    }
+
+    std::vector<TerrainSample> samples(points.size());
+    std::vector<float>         distances(points.size());
+    gen->GetTerrainPropertiesBatch(xz, samples);
+    gen->GetDistanceAboveTerrainBatch(points, distances);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        auto [height, normal] = gen->GetTerrainPropertiesAtPoint(points[i].x, points[i].z);
+        ASSERT_EQ(samples[i].height, height) << i;
+        ASSERT_EQ(samples[i].normal, normal) << i;
+        ASSERT_EQ(distances[i], gen->GetDistanceAboveTerrain(points[i])) << i;
+    }
+
+    std::vector<TerrainRay> rays;
+    for (size_t i = 0; i < 2000; ++i) {
+        float yaw = float(i) * 0.61f;
+        rays.push_back({points[i], glm::normalize(glm::vec3(std::cos(yaw), -0.3f, std::sin(yaw))), 60.0f});
+    }
+    std::vector<TerrainRayHit> hits(rays.size());
+    gen->RaycastBatch(rays, hits);
+
+    int hit_count = 0;
+    for (size_t i = 0; i < rays.size(); ++i) {
+        float     distance = 0.0f;
+        glm::vec3 normal;
+        bool      hit = gen->RaycastCached(rays[i].origin, rays[i].direction, rays[i].max_distance, distance, normal);
+        ASSERT_EQ(hits[i].hit, hit) << i;
+        if (hit) {
+            EXPECT_EQ(hits[i].distance, distance);
+            EXPECT_EQ(hits[i].normal, normal);
+            ++hit_count;
+        }
+    }
+    EXPECT_GT(hit_count, 0);
+}
+
+TEST(TerrainBatchTest, RunsSeriallyInsidePoolTasks) {
+    auto gen = MakeLoadedTerrain();
+    auto points = MakeFlock(2000, 2);
+
+    std::vector<glm::vec2> xz;
+    for (const auto& p : points) {
+        xz.emplace_back(p.x, p.z);
+    }
+
+    // More batching tasks than workers: a nested fan-out would leave them all waiting
+    std::vector<std::vector<TerrainSample>> results(pool.get_num_threads() * 2);
+    std::vector<std::future<void>>          futures;
+    for (auto& samples : results) {
+        futures.push_back(pool.submit([&] {
+            PoolTaskScope scope;
+            samples.resize(xz.size());
+            gen->GetTerrainPropertiesBatch(xz, samples);
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    for (const auto& samples : results) {
+        for (size_t i = 0; i < points.size(); ++i) {
+            ASSERT_EQ(samples[i].height, std::get<0>(gen->GetTerrainPropertiesAtPoint(xz[i].x, xz[i].y))) << i;
+        }
+    }
+}
+
+TEST(TerrainBatchTest, EmptyBatch) {
+    TerrainGenerator           gen;
+    std::vector<TerrainSample> samples;
+    gen.GetTerrainPropertiesBatch({}, samples);
+    gen.RaycastBatch({}, std::span<TerrainRayHit>());
+    SUCCEED();
+}
+
+TEST(TerrainBatchBenchmark, FlockAvoidancePass) {
+    auto gen = MakeLoadedTerrain();
+    auto points = MakeFlock(20000, 2);
+
+    auto time_ms = [](auto&& body) {
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < 10; ++frame) {
+            body();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / 10.0;
+    };
+
+    std::vector<float> single(points.size()), batched(points.size());
+    double             single_ms = time_ms([&] {
+        for (size_t i = 0; i < points.size(); ++i) {
+            single[i] = gen->GetDistanceAboveTerrain(points[i]);
+        }
+    });
+    double             batch_ms = time_ms([&] { gen->GetDistanceAboveTerrainBatch(points, batched); });
+
+    std::cout << "[ BENCH    ] " << points.size() << " boids distance-above-terrain: per-entity " << single_ms
+              << " ms, batched " << batch_ms << " ms per pass" << std::endl;
+    EXPECT_EQ(single, batched);
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include "graphics.h"
+#include "terrain_chunk_data.h"
+#include "terrain_generator.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace Boidsish;
+
+namespace {
+    // The float grids TerrainGenerator used to keep resident, X-major like the chunk data
+    struct FloatGrid {
+        int                    resolution;
+        float                  cell_size;
+        std::vector<float>     heights;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec2> biomes;
+    };
+
+    FloatGrid MakeHills(int resolution, float cell_size, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> phase(0.0f, 6.2831853f);
+        float                                 px = phase(rng), pz = phase(rng);
+        FloatGrid                             grid{resolution, cell_size, {}, {}, {}};
+        for (int x = 0; x < resolution; ++x) {
+            for (int z = 0; z < resolution; ++z) {
+                float wx = x * cell_size, wz = z * cell_size;
+                float h = 80.0f * std::sin(wx * 0.05f + px) * std::cos(wz * 0.07f + pz) + 0.3f * wx - 40.0f;
+                float dhdx = 4.0f * std::cos(wx * 0.05f + px) * std::cos(wz * 0.07f + pz) + 0.3f;
+                float dhdz = -5.6f * std::sin(wx * 0.05f + px) * std::sin(wz * 0.07f + pz);
+                grid.heights.push_back(h);
+                grid.normals.push_back(glm::normalize(glm::vec3(-dhdx, 1.0f, -dhdz)));
+                grid.biomes.emplace_back(static_cast<float>((x + z) % 8), ((x * 7 + z * 3) % 256) / 255.0f);
+            }
+        }
+        return grid;
+    }
+
+    template <typename Height, typename Normal>
+    std::pair<float, glm::vec3> Bilinear(Height height, Normal normal, float cell_size, float x, float z, int cells) {
+        int       ix = std::clamp(static_cast<int>(std::floor(x / cell_size)), 0, cells - 1);
+        int       iz = std::clamp(static_cast<int>(std::floor(z / cell_size)), 0, cells - 1);
+        float     fx = std::clamp(x / cell_size - ix, 0.0f, 1.0f);
+        float     fz = std::clamp(z / cell_size - iz, 0.0f, 1.0f);
+        float     h0 = glm::mix(height(ix, iz), height(ix + 1, iz), fx);
+        float     h1 = glm::mix(height(ix, iz + 1), height(ix + 1, iz + 1), fx);
+        glm::vec3 n0 = glm::mix(normal(ix, iz), normal(ix + 1, iz), fx);
+        glm::vec3 n1 = glm::mix(normal(ix, iz + 1), normal(ix + 1, iz + 1), fx);
+        return {glm::mix(h0, h1, fz), glm::normalize(glm::mix(n0, n1, fz))};
+    }
+}
+
+TEST(TerrainChunkDataTest, NormalsRoundTrip) {
+    std::mt19937                          rng(1);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<glm::vec3>                normals = {
+        {0, 1, 0}, {0, -1, 0}, {1, 0, 0}, {-1, 0, 0}, {0, 0, 1}, {0, 0, -1}, glm::normalize(glm::vec3(1, -1, 1))
+    };
+    for (int i = 0; i < 10000; ++i) {
+        glm::vec3 n(unit(rng), unit(rng), unit(rng));
+        if (glm::length(n) > 1e-3f) {
+            normals.push_back(glm::normalize(n));
+        }
+    }
+    for (const auto& n : normals) {
+        glm::vec3 decoded = TerrainChunkData::DecodeNormal(TerrainChunkData::EncodeNormal(n));
+        ASSERT_NEAR(glm::length(decoded), 1.0f, 1e-5f);
+        ASSERT_LT(glm::length(decoded - n), 1e-4f) << n.x << " " << n.y << " " << n.z;
+    }
+}
+
+TEST(TerrainChunkDataTest, QueriesMatchFloatPath) {
+    const int        cells = 32;
+    FloatGrid        grid = MakeHills(cells + 1, 2.0f, 2);
+    TerrainChunkData chunk(grid.resolution, grid.cell_size, grid.heights, grid.normals, grid.biomes);
+    ASSERT_FALSE(chunk.IsEmpty());
+
+    // Heights are within half a quantization step, biomes keep their index and an 8-bit weight
+    float step = (chunk.GetMaxY() - chunk.GetMinY()) / 65535.0f;
+    for (int x = 0; x < grid.resolution; ++x) {
+        for (int z = 0; z < grid.resolution; ++z) {
+            size_t i = static_cast<size_t>(x) * grid.resolution + z;
+            ASSERT_NEAR(chunk.GetHeight(x, z), grid.heights[i], step * 0.5f + 1e-5f);
+            ASSERT_GT(glm::dot(chunk.GetNormal(x, z), grid.normals[i]), 0.999999f);
+            ASSERT_EQ(chunk.GetBiome(x, z).x, grid.biomes[i].x);
+            ASSERT_NEAR(chunk.GetBiome(x, z).y, grid.biomes[i].y, 0.5f / 255.0f + 1e-6f);
+            ASSERT_EQ(chunk.GetPosition(x, z).x, x * grid.cell_size);
+        }
+    }
+
+    std::mt19937                          rng(3);
+    std::uniform_real_distribution<float> coord(0.0f, cells * grid.cell_size);
+
+    auto float_height = [&](int x, int z) { return grid.heights[x * grid.resolution + z]; };
+    auto float_normal = [&](int x, int z) { return grid.normals[x * grid.resolution + z]; };
+    auto chunk_height = [&](int x, int z) { return chunk.GetHeight(x, z); };
+    auto chunk_normal = [&](int x, int z) { return chunk.GetNormal(x, z); };
+    for (int i = 0; i < 5000; ++i) {
+        float x = coord(rng), z = coord(rng);
+        auto [h_float, n_float] = Bilinear(float_height, float_normal, grid.cell_size, x, z, cells);
+        auto [h_chunk, n_chunk] = Bilinear(chunk_height, chunk_normal, grid.cell_size, x, z, cells);
+        ASSERT_NEAR(h_chunk, h_float, step * 0.5f + 1e-5f);
+        ASSERT_GT(glm::dot(n_chunk, n_float), 0.999999f);
+    }
+}
+
+TEST(TerrainChunkDataTest, UnpacksToTextureLayout) {
+    FloatGrid            grid = MakeHills(9, 1.0f, 4);
+    TerrainChunkData     chunk(grid.resolution, grid.cell_size, grid.heights, grid.normals, grid.biomes);
+    std::vector<float>   height_normal;
+    std::vector<uint8_t> biomes;
+    chunk.Unpack(height_normal, biomes);
+    ASSERT_EQ(height_normal.size(), 9u * 9u * 4u);
+    ASSERT_EQ(biomes.size(), 9u * 9u * 4u);
+
+    // Texels are Z-major, the grid X-major
+    for (int z = 0; z < 9; ++z) {
+        for (int x = 0; x < 9; ++x) {
+            size_t texel = (static_cast<size_t>(z) * 9 + x) * 4;
+            EXPECT_EQ(height_normal[texel], chunk.GetHeight(x, z));
+            EXPECT_EQ(height_normal[texel + 2], chunk.GetNormal(x, z).y);
+            EXPECT_EQ(biomes[texel], static_cast<uint8_t>(grid.biomes[x * 9 + z].x));
+            EXPECT_EQ(biomes[texel + 1], static_cast<uint8_t>(grid.biomes[x * 9 + z].y * 255.0f + 0.5f));
+            EXPECT_EQ(biomes[texel + 2], 0);
+        }
+    }
+
+    // A flat chunk has no height range to quantize over
+    std::vector<float> flat(grid.heights.size(), 12.5f);
+    TerrainChunkData   level(grid.resolution, grid.cell_size, flat, grid.normals, grid.biomes);
+    EXPECT_EQ(level.GetHeight(4, 4), 12.5f);
+}
+
+TEST(TerrainChunkDataTest, CachedQueriesMatchGeneratedHeights) {
+    TerrainGenerator gen;
+    Frustum          frustum;
+    for (auto& plane : frustum.planes) {
+        plane.normal = glm::vec3(0, 1, 0);
+        plane.distance = 1e10f; // Everything is visible
+    }
+    Camera camera;
+    camera.x = 0;
+    camera.y = 10;
+    camera.z = 0;
+    gen.WaitForAllChunks(frustum, camera);
+
+    const auto& chunks = gen.GetVisibleChunks();
+    ASSERT_FALSE(chunks.empty());
+
+    // At grid vertices the cached bilinear query returns the stored height, which should be the
+    // procedural height to within the chunk's quantization step
+    size_t resident = 0, checked = 0;
+    for (const auto& chunk : chunks) {
+        const auto& surface = chunk->surface;
+        resident += surface.GetMemoryUsage();
+        float step = (surface.GetMaxY() - surface.GetMinY()) / 65535.0f;
+        for (int x = 1; x < surface.GetResolution() - 1; x += 5) {
+            for (int z = 1; z < surface.GetResolution() - 1; z += 5) {
+                glm::vec3 p = surface.GetPosition(x, z) + glm::vec3(chunk->GetX(), 0.0f, chunk->GetZ());
+                auto [cached, cached_normal] = gen.GetTerrainPropertiesAtPoint(p.x, p.z);
+                auto [generated, generated_normal] = gen.CalculateTerrainPropertiesAtPoint(p.x, p.z);
+                ASSERT_NEAR(cached, generated, step * 0.5f + 1e-3f);
+                ASSERT_NEAR(glm::length(cached_normal), 1.0f, 1e-4f);
+                ++checked;
+            }
+        }
+    }
+    EXPECT_GT(checked, 0u);
+
+    // Per vertex: float position, normal and biome, RGBA float texel and RGBA8 biome texel
+    size_t vertices = chunks.size() * chunks.front()->surface.GetResolution() *
+        chunks.front()->surface.GetResolution();
+    size_t float_layout = vertices * (sizeof(glm::vec3) * 2 + sizeof(glm::vec2) + sizeof(float) * 4 + 4);
+    std::cout << "[ BENCH    ] " << chunks.size() << " chunks: " << resident / 1024 << " KiB resident ("
+              << float_layout / 1024 << " KiB in the float layout)" << std::endl;
+}
+
+TEST(TerrainChunkDataBenchmark, BilinearQueries) {
+    const int        cells = 32;
+    FloatGrid        grid = MakeHills(cells + 1, 1.0f, 5);
+    TerrainChunkData chunk(grid.resolution, grid.cell_size, grid.heights, grid.normals, grid.biomes);
+
+    std::mt19937                          rng(6);
+    std::uniform_real_distribution<float> coord(0.0f, static_cast<float>(cells));
+    std::vector<glm::vec2>                points(1000000);
+    for (auto& p : points) {
+        p = glm::vec2(coord(rng), coord(rng));
+    }
+
+    auto float_height = [&](int x, int z) { return grid.heights[x * grid.resolution + z]; };
+    auto float_normal = [&](int x, int z) { return grid.normals[x * grid.resolution + z]; };
+    auto chunk_height = [&](int x, int z) { return chunk.GetHeight(x, z); };
+    auto chunk_normal = [&](int x, int z) { return chunk.GetNormal(x, z); };
+
+    float sink = 0.0f;
+    auto  start = std::chrono::steady_clock::now();
+    for (const auto& p : points) {
+        sink += Bilinear(float_height, float_normal, 1.0f, p.x, p.y, cells).first;
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (const auto& p : points) {
+        sink -= Bilinear(chunk_height, chunk_normal, 1.0f, p.x, p.y, cells).first;
+    }
+    auto end = std::chrono::steady_clock::now();
+    EXPECT_TRUE(std::isfinite(sink));
+
+    size_t float_bytes = grid.heights.size() * (sizeof(glm::vec3) * 2 + sizeof(glm::vec2) + sizeof(float) * 4 + 4);
+    std::cout << "[ BENCH    ] 1M bilinear queries: quantized "
+              << std::chrono::duration<double, std::milli>(end - mid).count() << " ms, float "
+              << std::chrono::duration<double, std::milli>(mid - start).count() << " ms; chunk "
+              << chunk.GetMemoryUsage() << " bytes (float layout " << float_bytes << " bytes)" << std::endl;
+}
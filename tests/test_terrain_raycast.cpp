@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include "graphics.h"
+#include "terrain_generator.h"
+#include "terrain_height_pyramid.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace Boidsish;
+
+namespace {
+    float BilinearHeight(const std::vector<glm::vec3>& vertices, int cells, float cell_size, float x, float z) {
+        int   grid = cells + 1;
+        int   ix = std::clamp(int(std::floor(x / cell_size)), 0, cells - 1);
+        int   iz = std::clamp(int(std::floor(z / cell_size)), 0, cells - 1);
+        float fx = std::clamp(x / cell_size - ix, 0.0f, 1.0f);
+        float fz = std::clamp(z / cell_size - iz, 0.0f, 1.0f);
+        float h0 = glm::mix(vertices[ix * grid + iz].y, vertices[(ix + 1) * grid + iz].y, fx);
+        float h1 = glm::mix(vertices[ix * grid + iz + 1].y, vertices[(ix + 1) * grid + iz + 1].y, fx);
+        return glm::mix(h0, h1, fz);
+    }
+
+    // The marcher RaycastCached replaces: fixed half-cell steps, each sampling the cached height
+    bool MarchReference(const TerrainGenerator& gen, glm::vec3 origin, glm::vec3 dir, float max_distance, float& out) {
+        float step_size = 0.5f * gen.GetWorldScale();
+        dir = glm::normalize(dir);
+        for (int step = 0; step * step_size < max_distance; ++step) {
+            float     dist = step * step_size;
+            glm::vec3 pos = origin + dir * dist;
+            if (pos.y < std::get<0>(gen.GetTerrainPropertiesAtPoint(pos.x, pos.z))) {
+                float start = step > 0 ? dist - step_size : 0.0f;
+                float end = dist;
+                for (int i = 0; i < 8; ++i) {
+                    float     mid = (start + end) * 0.5f;
+                    glm::vec3 mid_pos = origin + dir * mid;
+                    if (mid_pos.y < std::get<0>(gen.GetTerrainPropertiesAtPoint(mid_pos.x, mid_pos.z))) {
+                        end = mid;
+                    } else {
+                        start = mid;
+                    }
+                }
+                out = (start + end) * 0.5f;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    struct TestRay {
+        glm::vec3 origin;
+        glm::vec3 dir;
+    };
+
+    // Look-ahead probes like SteeringProbe casts: a few metres to tens of metres above ground,
+    // mostly level with some pitched down into the terrain.
+    std::vector<TestRay> MakeProbeRays(const TerrainGenerator& gen, int count, float extent, unsigned seed) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<TestRay>                  rays;
+        for (int i = 0; i < count; ++i) {
+            float x = (unit(rng) * 2.0f - 1.0f) * extent;
+            float z = (unit(rng) * 2.0f - 1.0f) * extent;
+            float ground = std::get<0>(gen.GetTerrainPropertiesAtPoint(x, z));
+            float yaw = unit(rng) * 6.2831853f;
+            float pitch = -0.6f * unit(rng) * unit(rng);
+            rays.push_back(
+                {glm::vec3(x, ground + 2.0f + 40.0f * unit(rng), z),
+                 glm::vec3(std::cos(yaw) * std::cos(pitch), std::sin(pitch), std::sin(yaw) * std::cos(pitch))}
+            );
+        }
+        return rays;
+    }
+
+    std::unique_ptr<TerrainGenerator> MakeLoadedTerrain() {
+        auto    gen = std::make_unique<TerrainGenerator>();
+        Frustum frustum;
+        for (auto& plane : frustum.planes) {
+            plane.normal = glm::vec3(0, 1, 0);
+            plane.distance = 1e10f; // Everything is visible
+        }
+        Camera camera;
+        camera.x = 0;
+        camera.y = 10;
+        camera.z = 0;
+        gen->WaitForAllChunks(frustum, camera);
+        return gen;
+    }
+}
+
+TEST(TerrainHeightPyramidTest, BoundsEveryCell) {
+    const int                             cells = 13; // Odd sizes exercise the partial nodes
+    std::mt19937                          rng(7);
+    std::uniform_real_distribution<float> height(-5.0f, 20.0f);
+    std::vector<glm::vec3>                vertices;
+    for (int x = 0; x <= cells; ++x) {
+        for (int z = 0; z <= cells; ++z) {
+            vertices.emplace_back(float(x), height(rng), float(z));
+        }
+    }
+
+    TerrainHeightPyramid pyramid(vertices, cells);
+    ASSERT_FALSE(pyramid.IsEmpty());
+    ASSERT_EQ(pyramid.GetLevelSize(pyramid.GetLevelCount() - 1), 1);
+
+    float top = pyramid.GetMaxHeight(pyramid.GetLevelCount() - 1, 0, 0);
+    for (int level = 0; level < pyramid.GetLevelCount(); ++level) {
+        for (int x = 0; x < cells; ++x) {
+            for (int z = 0; z < cells; ++z) {
+                float h = std::max(
+                    {vertices[x * (cells + 1) + z].y,
+                     vertices[x * (cells + 1) + z + 1].y,
+                     vertices[(x + 1) * (cells + 1) + z].y,
+                     vertices[(x + 1) * (cells + 1) + z + 1].y}
+                );
+                EXPECT_GE(pyramid.GetMaxHeight(level, x >> level, z >> level), h);
+                if (level == 0) {
+                    EXPECT_EQ(pyramid.GetMaxHeight(0, x, z), h);
+                }
+            }
+        }
+    }
+    EXPECT_EQ(top, std::max_element(vertices.begin(), vertices.end(), [](auto& a, auto& b) { return a.y < b.y; })->y);
+}
+
+TEST(TerrainHeightPyramidTest, SkipNeverPassesTheSurface) {
+    const int                             cells = 32;
+    const float                           cell_size = 2.0f;
+    std::mt19937                          rng(11);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<glm::vec3>                vertices;
+    for (int x = 0; x <= cells; ++x) {
+        for (int z = 0; z <= cells; ++z) {
+            float h = 10.0f * std::sin(x * 0.3f) * std::cos(z * 0.2f) + (unit(rng) < 0.02f ? 25.0f : 0.0f);
+            vertices.emplace_back(x * cell_size, h, z * cell_size);
+        }
+    }
+    TerrainHeightPyramid pyramid(vertices, cells);
+    const float          extent = cells * cell_size;
+
+    int skipped_far = 0;
+    for (int i = 0; i < 2000; ++i) {
+        glm::vec3 origin(unit(rng) * extent, 5.0f + 30.0f * unit(rng), unit(rng) * extent);
+        glm::vec3 dir = glm::normalize(glm::vec3(unit(rng) - 0.5f, -0.4f * unit(rng), unit(rng) - 0.5f));
+        float     t_end = 80.0f;
+        float     clear = pyramid.Skip(origin, dir, 0.0f, t_end, cell_size);
+        ASSERT_GE(clear, 0.0f);
+        ASSERT_LE(clear, t_end);
+        skipped_far += clear > 4.0f * cell_size;
+
+        for (float t = 0.0f; t < clear; t += 0.05f) {
+            glm::vec3 p = origin + dir * t;
+            if (p.x < 0.0f || p.z < 0.0f || p.x > extent || p.z > extent)
+                break;
+            ASSERT_GT(p.y, BilinearHeight(vertices, cells, cell_size, p.x, p.z)) << "ray " << i << " t " << t;
+        }
+    }
+    EXPECT_GT(skipped_far, 100);
+}
+
+TEST(TerrainRaycastTest, MatchesFixedStepMarch) {
+    auto gen = MakeLoadedTerrain();
+    auto rays = MakeProbeRays(*gen, 2000, 150.0f, 3);
+
+    int hits = 0;
+    for (const auto& ray : rays) {
+        float     expected = 0.0f, got = 0.0f;
+        glm::vec3 normal;
+        bool      want_hit = MarchReference(*gen, ray.origin, ray.dir, 60.0f, expected);
+        bool      got_hit = gen->RaycastCached(ray.origin, ray.dir, 60.0f, got, normal);
+        ASSERT_EQ(got_hit, want_hit) << "origin " << ray.origin.x << "," << ray.origin.y << "," << ray.origin.z;
+        if (got_hit) {
+            EXPECT_NEAR(got, expected, 1e-3f);
+            EXPECT_NEAR(glm::length(normal), 1.0f, 1e-3f);
+            ++hits;
+        }
+    }
+    EXPECT_GT(hits, 0);
+}
+
+TEST(TerrainRaycastBenchmark, RaysPerSecond) {
+    auto gen = MakeLoadedTerrain();
+    auto rays = MakeProbeRays(*gen, 20000, 150.0f, 5);
+
+    auto rays_per_sec = [&](auto&& cast) {
+        int  hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& ray : rays) {
+            hits += cast(ray);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(rays.size() / seconds, hits);
+    };
+
+    auto [march_rate, march_hits] = rays_per_sec([&](const TestRay& ray) {
+        float dist;
+        return MarchReference(*gen, ray.origin, ray.dir, 60.0f, dist);
+    });
+    auto [pyramid_rate, pyramid_hits] = rays_per_sec([&](const TestRay& ray) {
+        float     dist;
+        glm::vec3 normal;
+        return gen->RaycastCached(ray.origin, ray.dir, 60.0f, dist, normal);
+    });
+
+    std::cout << "[ BENCH    ] " << rays.size() << " probe rays (60m): fixed-step march " << march_rate
+              << " rays/s, height pyramid " << pyramid_rate << " rays/s (" << pyramid_hits << " hits)" << std::endl;
+    EXPECT_EQ(pyramid_hits, march_hits);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "graphics.h"
+#include "terrain_generator.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace Boidsish;
+
+namespace {
+    Frustum MakeOpenFrustum() {
+        Frustum frustum;
+        for (auto& plane : frustum.planes) {
+            plane.normal = glm::vec3(0, 1, 0);
+            plane.distance = 1e10f; // Everything is visible
+        }
+        return frustum;
+    }
+
+    Camera MakeCamera(float x, float z) {
+        Camera camera;
+        camera.x = x;
+        camera.y = 10;
+        camera.z = z;
+        return camera;
+    }
+
+    struct ReaderStats {
+        std::atomic<long> queries{0};
+        std::atomic<long> cached{0};
+        std::atomic<bool> all_finite{true};
+    };
+
+    // Simulation-side reader: height queries and short probe rays around a moving point of interest
+    void RunReader(
+        const TerrainGenerator&   gen,
+        const std::atomic<float>& center_x,
+        const std::atomic<bool>&  stop,
+        ReaderStats&              stats,
+        unsigned                  seed
+    ) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        long                                  queries = 0, cached = 0;
+        bool                                  finite = true;
+        while (!stop.load(std::memory_order_relaxed)) {
+            for (int i = 0; i < 256; ++i) {
+                float x = center_x.load(std::memory_order_relaxed) + unit(rng) * 200.0f;
+                float z = unit(rng) * 200.0f;
+                auto [height, normal] = gen.GetTerrainPropertiesAtPoint(x, z);
+                cached += gen.IsPositionCached(x, z);
+                finite &= std::isfinite(height) && std::isfinite(normal.y);
+                if (i % 16 == 0) {
+                    float     distance = 0.0f;
+                    glm::vec3 hit_normal;
+                    glm::vec3 origin(x, height + 5.0f, z);
+                    gen.RaycastCached(origin, glm::vec3(1, -0.2f, 0), 30.0f, distance, hit_normal);
+                }
+                ++queries;
+            }
+        }
+        stats.queries += queries;
+        stats.cached += cached;
+        if (!finite) {
+            stats.all_finite = false;
+        }
+    }
+
+    // Queries per second across `readers` threads while `writer` runs on this thread for `duration`
+    template <typename Writer>
+    double
+    MeasureReaders(const TerrainGenerator& gen, int readers, double duration, Writer&& writer, ReaderStats& stats) {
+        std::atomic<bool>        stop{false};
+        std::atomic<float>       center_x{0.0f};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < readers; ++i) {
+            threads.emplace_back(
+                RunReader, std::cref(gen), std::cref(center_x), std::cref(stop), std::ref(stats), 17u + i
+            );
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto elapsed = [&] {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        while (elapsed() < duration) {
+            writer(elapsed(), center_x);
+        }
+        stop = true;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return stats.queries / elapsed();
+    }
+}
+
+TEST(TerrainSnapshotTest, PublishesOnUpdateAndScaleChange) {
+    TerrainGenerator gen;
+    Frustum          frustum = MakeOpenFrustum();
+    EXPECT_FALSE(gen.IsPositionCached(0.0f, 0.0f));
+
+    gen.WaitForAllChunks(frustum, MakeCamera(0, 0));
+    EXPECT_TRUE(gen.IsPositionCached(0.0f, 0.0f));
+
+    // Chunks built at the old scale are withdrawn immediately, not at the next Update
+    gen.SetWorldScale(2.0f);
+    EXPECT_FALSE(gen.IsPositionCached(0.0f, 0.0f));
+
+    gen.WaitForAllChunks(frustum, MakeCamera(0, 0));
+    EXPECT_TRUE(gen.IsPositionCached(0.0f, 0.0f));
+}
+
+TEST(TerrainSnapshotBenchmark, ReadersDuringStreaming) {
+    TerrainGenerator gen;
+    Frustum          frustum = MakeOpenFrustum();
+    gen.WaitForAllChunks(frustum, MakeCamera(0, 0));
+
+    const int readers = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+    ReaderStats idle_stats;
+    double      idle_rate = MeasureReaders(
+        gen,
+        readers,
+        0.5,
+        [](double, std::atomic<float>&) { std::this_thread::sleep_for(std::chrono::milliseconds(16)); },
+        idle_stats
+    );
+
+    // The camera flies along +x at ~300 m/s, streaming chunks in ahead and evicting them behind
+    ReaderStats streaming_stats;
+    int         frames = 0;
+    double      streaming_rate = MeasureReaders(
+        gen,
+        readers,
+        1.5,
+        [&](double t, std::atomic<float>& center_x) {
+            float x = static_cast<float>(t) * 300.0f;
+            center_x = x;
+            gen.Update(frustum, MakeCamera(x, 0));
+            ++frames;
+            std::this_thread::sleep_for(std::chrono::milliseconds(4));
+        },
+        streaming_stats
+    );
+
+    std::cout << "[ BENCH    ] " << readers << " reader threads: " << idle_rate << " queries/s idle, " << streaming_rate
+              << " queries/s while streaming (" << frames << " writer frames, "
+              << 100.0 * streaming_stats.cached / std::max(1L, streaming_stats.queries.load()) << "% cache hits)"
+              << std::endl;
+
+    EXPECT_TRUE(idle_stats.all_finite);
+    EXPECT_TRUE(streaming_stats.all_finite);
+    EXPECT_GT(streaming_stats.queries, 0);
+    EXPECT_GT(frames, 0);
+}
@@ -10,6 +10,7 @@ public:
     void Update(const Frustum&, const Camera&) override {}
     const std::vector<std::shared_ptr<Terrain>>& GetVisibleChunks() const override { return chunks_; }
     std::vector<std::shared_ptr<Terrain>> GetVisibleChunksCopy() const override { return chunks_; }
+    std::shared_ptr<Terrain> GetResidentChunk(std::pair<int, int>) const override { return nullptr; }
     void SetRenderManager(std::shared_ptr<TerrainRenderManager>) override {}
     std::shared_ptr<TerrainRenderManager> GetRenderManager() const override { return nullptr; }
     float GetMaxHeight() const override { return 100.0f; }
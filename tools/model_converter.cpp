@@ -5,14 +5,36 @@
 #include "ConfigManager.h"
 #include "asset_manager.h"
 #include "logger.h"
+#include "model_cache.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
 using namespace Boidsish;
 
 int main(int argc, char** argv) {
+	if (argc >= 4 && std::string(argv[1]) == "--cache") {
+		// The runtime looks the cache up by source path and import settings, so it is written where
+		// AssetManager reads it, with the settings of the app that will load it. Run this from the
+		// app's working directory and pass the model path exactly as the app does.
+		std::string inputPath = argv[2];
+		ConfigManager::GetInstance().Initialize(argv[3]);
+		AssetManager::GetInstance().SetHeadless(true);
+
+		std::string cachePath = ModelCache::CachePathFor(inputPath);
+		if (!AssetManager::GetInstance().BuildModelCache(inputPath, cachePath)) {
+			logger::ERROR("Failed to build model cache: {}", cachePath);
+			return 1;
+		}
+		logger::LOG("Successfully cached {} to {}", inputPath, cachePath);
+		return 0;
+	}
+
 	if (argc < 3) {
 		std::cout << "Usage: " << argv[0] << " <input_model> <output_model> [simplify_ratio]" << std::endl;
+		std::cout << "       " << argv[0] << " --cache <input_model> <app_name>" << std::endl;
+		std::cout << "--cache writes the binary model cache the app named by app_name (its window title) loads,"
+				  << std::endl;
+		std::cout << "without creating a GL context." << std::endl;
 		return 1;
 	}
 